@@ -2,6 +2,7 @@
 //**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
 #include "Animation/BsAnimation.h"
 #include "Animation/BsAnimationManager.h"
+#include "Animation/BsBakedAnimationPoses.h"
 #include "Animation/BsAnimationClip.h"
 #include "Animation/BsAnimationUtility.h"
 #include "Scene/BsSceneObject.h"
@@ -22,7 +23,8 @@ namespace bs
 	AnimationProxy::AnimationProxy(UINT64 id)
 		: id(id), layers(nullptr), numLayers(0), numSceneObjects(0), sceneObjectInfos(nullptr)
 		, sceneObjectTransforms(nullptr), morphChannelInfos(nullptr), morphShapeInfos(nullptr), numMorphChannels(0)
-		, numMorphShapes(0), numMorphVertices(0), morphChannelWeightsDirty(false), mCullEnabled(true), numGenericCurves(0)
+		, numMorphShapes(0), numMorphVertices(0), morphChannelWeightsDirty(false), mCullEnabled(true)
+		, mLODMetric(AnimLODMetric::ScreenSize), mHasLODPoses(false), mUpdatesSinceEvaluation(0), numGenericCurves(0)
 		, genericCurveOutputs(nullptr)
 	{ }
 
@@ -438,6 +440,7 @@ namespace bs
 					if (isClipValid)
 					{
 						state.curves = clipInfo.clip->getCurves();
+						state.compressedCurves = clipInfo.clip->_getCompressedCurves();
 						state.disabled = clipInfo.playbackType == AnimPlaybackType::None;
 					}
 					else
@@ -640,9 +643,53 @@ namespace bs
 		}
 	}
 
+	const Matrix4* AnimationProxy::getBakedPose() const
+	{
+		if (mBakedPoses == nullptr)
+			return nullptr;
+
+		const AnimationState& state = layers[0].states[0];
+		if (state.disabled)
+			return nullptr;
+
+		return mBakedPoses->getPose(state.time, state.loop);
+	}
+
+	void AnimationProxy::updateLODs(const Vector<AnimationLOD>& lods, AnimLODMetric metric)
+	{
+		mLODs = lods;
+		mLODMetric = metric;
+
+		mLODEvaluationMasks.resize(lods.size());
+		for (UINT32 i = 0; i < (UINT32)lods.size(); i++)
+			mLODEvaluationMasks[i] = skeletonMask.intersect(lods[i].mask);
+
+		// Evaluated poses only need to be remembered if some levels skip evaluations
+		bool needsPoses = false;
+		for (auto& lod : lods)
+			needsPoses |= lod.updateInterval > 1;
+
+		UINT32 numBones = (needsPoses && skeleton != nullptr) ? skeleton->getNumBones() : 0;
+		for (auto& pose : mLODPoses)
+		{
+			if (pose.numBones == numBones)
+				continue;
+
+			if (numBones > 0)
+				pose = LocalSkeletonPose(numBones);
+			else
+				pose = LocalSkeletonPose();
+		}
+
+		// Previously evaluated poses might have been evaluated with a different skeleton or scene object mapping
+		mHasLODPoses = false;
+		mUpdatesSinceEvaluation = 0;
+	}
+
 	Animation::Animation()
-		: mDefaultWrapMode(AnimWrapMode::Loop), mDefaultSpeed(1.0f), mCull(true), mDirty(AnimDirtyStateFlag::All)
-		, mGenericCurveValuesValid(false)
+		: mDefaultWrapMode(AnimWrapMode::Loop), mDefaultSpeed(1.0f), mCull(true), mLODMetric(AnimLODMetric::ScreenSize)
+		, mBakedPoseSampleRate(0), mDirty(AnimDirtyStateFlag::All), mBakedPoseSkeleton(nullptr), mBakedPoseCurves(nullptr)
+		, mBakedPoseVersion(0), mGenericCurveValuesValid(false)
 	{
 		mId = AnimationManager::instance().registerAnimation(this);
 		mAnimProxy = bs_shared_ptr_new<AnimationProxy>(mId);
@@ -731,6 +778,26 @@ namespace bs
 		mDirty |= AnimDirtyStateFlag::Culling;
 	}
 
+	void Animation::setLODs(const Vector<AnimationLOD>& lods)
+	{
+		mLODs = lods;
+
+		mDirty |= AnimDirtyStateFlag::LOD;
+	}
+
+	void Animation::setLODMetric(AnimLODMetric metric)
+	{
+		mLODMetric = metric;
+
+		mDirty |= AnimDirtyStateFlag::LOD;
+	}
+
+	void Animation::setBakedPoseSampleRate(UINT32 sampleRate)
+	{
+		mBakedPoseSampleRate = sampleRate;
+		mBakedPoses = nullptr;
+	}
+
 	void Animation::play(const HAnimationClip& clip)
 	{
 		AnimationClipInfo* clipInfo = addClip(clip, (UINT32)-1);
@@ -1287,6 +1354,9 @@ namespace bs
 			mDirty.unset(AnimDirtyStateFlag::Culling);
 		}
 
+		bool lodDirty = mDirty.isSet(AnimDirtyStateFlag::LOD);
+		mDirty.unset(AnimDirtyStateFlag::LOD);
+
 		auto getAnimatedSOList = [&]()
 		{
 			Vector<AnimatedSceneObject> animatedSO(mSceneObjects.size());
@@ -1325,6 +1395,11 @@ namespace bs
 				mAnimProxy->updateMorphChannelWeights(mMorphChannelWeights);
 		}
 
+		if (lodDirty || didFullRebuild)
+			mAnimProxy->updateLODs(mLODs, mLODMetric);
+
+		mAnimProxy->mBakedPoses = findBakedPoses();
+
 		// Check if there are dirty transforms
 		if (!didFullRebuild)
 		{
@@ -1366,6 +1441,59 @@ namespace bs
 		mDirty = AnimDirtyState();
 	}
 
+	SPtr<BakedAnimationPoses> Animation::findBakedPoses()
+	{
+		auto isBakingSupported = [this]()
+		{
+			if (mBakedPoseSampleRate == 0 || mSkeleton == nullptr || mClipInfos.size() != 1 || 
+				mSkeletonMask.hasDisabledBones())
+				return false;
+
+			const AnimationClipInfo& clipInfo = mClipInfos[0];
+			if (clipInfo.playbackType != AnimPlaybackType::Normal || !clipInfo.clip.isLoaded() || 
+				clipInfo.clip->isAdditive())
+				return false;
+
+			// Baked poses contain the clip evaluated on its own, at full weight
+			if (mAnimProxy->numLayers != 1 || mAnimProxy->layers[0].numStates != 1)
+				return false;
+
+			const AnimationState& state = mAnimProxy->layers[0].states[0];
+			if (!Math::approxEquals(state.weight, 1.0f))
+				return false;
+
+			// Bones mapped to scene objects require the local pose, which is not baked
+			for (UINT32 i = 0; i < mAnimProxy->numSceneObjects; i++)
+			{
+				if (mAnimProxy->sceneObjectInfos[i].boneIdx != -1)
+					return false;
+			}
+
+			return true;
+		};
+
+		if (!isBakingSupported())
+		{
+			mBakedPoses = nullptr;
+			return nullptr;
+		}
+
+		// Cached poses keep their skeleton and curves referenced by the AnimationManager, so the pointers below cannot
+		// be reused by other objects while the poses are cached
+		const AnimationClip& clip = *mClipInfos[0].clip;
+		const AnimationCurves* curves = clip.getCurves().get();
+		if (mBakedPoses == nullptr || mBakedPoseSkeleton != mSkeleton.get() || mBakedPoseCurves != curves || 
+			mBakedPoseVersion != clip.getVersion())
+		{
+			mBakedPoses = AnimationManager::instance().getBakedPoses(mSkeleton, clip, mBakedPoseSampleRate);
+			mBakedPoseSkeleton = mSkeleton.get();
+			mBakedPoseCurves = curves;
+			mBakedPoseVersion = clip.getVersion();
+		}
+
+		return mBakedPoses;
+	}
+
 	void Animation::updateFromProxy()
 	{
 		HSceneObject rootSO;
@@ -13,6 +13,8 @@
 
 namespace bs
 {
+	class BakedAnimationPoses;
+
 	/** @addtogroup Animation-Internal
 	 *  @{
 	 */
@@ -32,7 +34,8 @@ namespace bs
 		Layout = 1 << 1,
 		All = 1 << 2,
 		Culling = 1 << 3,
-		MorphWeights = 1 << 4
+		MorphWeights = 1 << 4,
+		LOD = 1 << 5
 	};
 
 	typedef Flags<AnimDirtyStateFlag> AnimDirtyState;
@@ -115,6 +118,44 @@ namespace bs
 		HAnimationClip botRightClip;
 	};
 
+	/** Determines which value is compared against AnimationLOD::threshold when picking an animation level of detail. */
+	enum class AnimLODMetric
+	{
+		/** 
+		 * Size of the animation bounds on screen, as a fraction of the viewport height. Levels are used while the size is
+		 * larger or equal to their threshold. 
+		 */
+		ScreenSize,
+		/** 
+		 * Distance from the closest camera to the animation bounds. Levels are used while the distance is smaller or equal
+		 * to their threshold. 
+		 */
+		Distance
+	};
+
+	/** Determines how often and how many bones of an animation are evaluated at a specific level of detail. */
+	struct AnimationLOD
+	{
+		/** Screen size or distance (depending on the AnimLODMetric used) up to which this level is used. */
+		float threshold = 0.0f;
+
+		/** Number of animation updates between two evaluations of the skeleton pose. 1 evaluates on every update. */
+		UINT32 updateInterval = 1;
+
+		/** 
+		 * Determines which bones are evaluated. Disabled bones aren't animated and keep their bind pose relative to their
+		 * parent bone.
+		 */
+		SkeletonMask mask;
+
+		/**
+		 * If true, updates that don't evaluate the skeleton pose interpolate between the last two evaluated poses. This
+		 * results in smooth movement, but delays the animation by up to @p updateInterval updates. If false the last
+		 * evaluated pose is used until the next evaluation.
+		 */
+		bool interpolate = true;
+	};
+
 	/** Contains a mapping between a scene object and an animation curve it is animated with. */
 	struct AnimatedSceneObject
 	{
@@ -223,9 +264,23 @@ namespace bs
 		 */
 		void updateTime(const Vector<AnimationClipInfo>& clipInfos);
 
+		/**
+		 * Updates the levels of detail used for evaluating the skeleton pose. Must be called after rebuild() if the
+		 * skeleton or skeleton mask changed.
+		 *
+		 * @note	Should be called from the sim thread when the caller is sure the animation thread is not using it.
+		 */
+		void updateLODs(const Vector<AnimationLOD>& lods, AnimLODMetric metric);
+
 		/** Destroys all dynamically allocated objects. */
 		void clear();
 
+		/** 
+		 * Returns the final bone transforms from the baked poses assigned to the proxy, at the current animation time.
+		 * Returns null if the proxy has no baked poses assigned.
+		 */
+		const Matrix4* getBakedPose() const;
+
 		UINT64 id;
 
 		// Skeletal animation
@@ -249,6 +304,17 @@ namespace bs
 		AABox mBounds;
 		bool mCullEnabled;
 
+		// Level of detail
+		Vector<AnimationLOD> mLODs;
+		Vector<SkeletonMask> mLODEvaluationMasks; /**< Intersection of the skeleton mask and per-level masks. */
+		AnimLODMetric mLODMetric;
+		LocalSkeletonPose mLODPoses[2]; /**< Two most recently evaluated poses, the oldest one first. */
+		bool mHasLODPoses;
+		UINT32 mUpdatesSinceEvaluation;
+
+		// Baked poses, used instead of evaluating the skeleton pose if assigned
+		SPtr<BakedAnimationPoses> mBakedPoses;
+
 		// Evaluation results
 		LocalSkeletonPose skeletonPose;
 		LocalSkeletonPose sceneObjectPose;
@@ -312,6 +378,34 @@ namespace bs
 		 */
 		void setCulling(bool cull);
 
+		/**
+		 * Sets levels of detail used for evaluating the skeleton pose, ordered from the most to the least detailed. The
+		 * first level whose threshold is satisfied is used, or the last level if none are. Levels are picked using the
+		 * bounds provided in setBounds(). If no levels are set, all bones are evaluated on every animation update.
+		 */
+		void setLODs(const Vector<AnimationLOD>& lods);
+
+		/** Returns levels of detail set by setLODs(). */
+		const Vector<AnimationLOD>& getLODs() const { return mLODs; }
+
+		/** Determines which value is used for picking the level of detail from the levels set by setLODs(). */
+		void setLODMetric(AnimLODMetric metric);
+
+		/** @copydoc setLODMetric */
+		AnimLODMetric getLODMetric() const { return mLODMetric; }
+
+		/**
+		 * Enables use of baked poses when the animation plays a single clip, without any blending, bone mask or bones
+		 * mapped to scene objects. Skeleton poses of the clip are then evaluated once at the provided sample rate, and
+		 * shared with all animations playing the same clip on the same skeleton. Each pose displays the sample closest
+		 * to the current time. Greatly reduces the cost of many animations playing the same clip, at the cost of memory
+		 * and precision. Set to zero to disable (default).
+		 */
+		void setBakedPoseSampleRate(UINT32 sampleRate);
+
+		/** @copydoc setBakedPoseSampleRate */
+		UINT32 getBakedPoseSampleRate() const { return mBakedPoseSampleRate; }
+
 		/** 
 		 * Plays the specified animation clip. 
 		 *
@@ -481,6 +575,13 @@ namespace bs
 		 */
 		void updateAnimProxy(float timeDelta);
 
+		/** 
+		 * Returns shared baked poses for the currently playing clip, if baked poses are enabled and the current animation
+		 * state allows them to be used. Must be called after the animation proxy was updated. Poses are retrieved from
+		 * the AnimationManager only when the skeleton, clip or clip version changes, and are cached otherwise.
+		 */
+		SPtr<BakedAnimationPoses> findBakedPoses();
+
 		/**
 		 * Applies any outputs stored in the animation proxy (as written by the animation thread), and uses them to update
 		 * the animation state on the simulation thread. Caller must ensure that the animation thread has finished
@@ -509,8 +610,16 @@ namespace bs
 		float mDefaultSpeed;
 		AABox mBounds;
 		bool mCull;
+		Vector<AnimationLOD> mLODs;
+		AnimLODMetric mLODMetric;
+		UINT32 mBakedPoseSampleRate;
 		AnimDirtyState mDirty;
 
+		SPtr<BakedAnimationPoses> mBakedPoses;
+		const Skeleton* mBakedPoseSkeleton;
+		const AnimationCurves* mBakedPoseCurves;
+		UINT64 mBakedPoseVersion;
+
 		SPtr<Skeleton> mSkeleton;
 		SkeletonMask mSkeletonMask;
 		SPtr<MorphShapes> mMorphShapes;
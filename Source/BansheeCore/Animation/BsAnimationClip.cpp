@@ -139,12 +139,49 @@ namespace bs
 	void AnimationClip::setCurves(const AnimationCurves& curves)
 	{
 		*mCurves = curves;
+		mCompressedCurves = nullptr;
 
 		buildNameMapping();
 		calculateLength();
 		mVersion++;
 	}
 
+	void AnimationClip::compress(UINT32 sampleRate)
+	{
+		if (sampleRate == 0)
+			sampleRate = mSampleRate;
+
+		SPtr<CompressedAnimationCurves> compressedCurves = CompressedAnimationCurves::create(*mCurves, sampleRate);
+
+		// Keep the curve names so name mapping and curve indices remain the same, but drop the now unused keyframes
+		SPtr<AnimationCurves> curves = bs_shared_ptr_new<AnimationCurves>();
+		for (auto& entry : mCurves->position)
+			curves->position.push_back({ entry.name, entry.flags, TAnimationCurve<Vector3>() });
+
+		for (auto& entry : mCurves->rotation)
+			curves->rotation.push_back({ entry.name, entry.flags, TAnimationCurve<Quaternion>() });
+
+		for (auto& entry : mCurves->scale)
+			curves->scale.push_back({ entry.name, entry.flags, TAnimationCurve<Vector3>() });
+
+		curves->generic = mCurves->generic;
+
+		mCurves = curves;
+		mCompressedCurves = compressedCurves;
+
+		buildNameMapping();
+		calculateLength();
+		mVersion++;
+	}
+
+	AnimationCompressionStats AnimationClip::getCompressionStats() const
+	{
+		if (mCompressedCurves == nullptr)
+			return AnimationCompressionStats();
+
+		return mCompressedCurves->getStats();
+	}
+
 	bool AnimationClip::hasRootMotion() const
 	{
 		return mRootMotion != nullptr && 
@@ -166,6 +203,9 @@ namespace bs
 
 		for (auto& entry : mCurves->generic)
 			mLength = std::max(mLength, entry.curve.getLength());
+
+		if (mCompressedCurves != nullptr)
+			mLength = std::max(mLength, mCompressedCurves->getLength());
 	}
 
 	void AnimationClip::buildNameMapping()
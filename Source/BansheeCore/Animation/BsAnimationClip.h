@@ -7,6 +7,7 @@
 #include "Math/BsVector3.h"
 #include "Math/BsQuaternion.h"
 #include "Animation/BsAnimationCurve.h"
+#include "Animation/BsCompressedAnimationCurves.h"
 
 namespace bs
 {
@@ -242,6 +243,26 @@ namespace bs
 		 */
 		UINT64 getVersion() const { return mVersion; }
 
+		/**
+		 * Replaces the position, rotation and scale curves of the clip with a compressed representation, significantly
+		 * reducing their size at the cost of precision. The curves are resampled at uniform intervals, so any keyframes in
+		 * between the samples are lost. Compressed curves keep their names in getCurves(), but contain no keyframes.
+		 * Generic curves are not affected. Assigning new curves through setCurves() removes the compressed data.
+		 *
+		 * @param[in]	sampleRate	Number of samples per second to resample the curves with. If zero the clip's sample
+		 *							rate is used.
+		 */
+		void compress(UINT32 sampleRate = 0);
+
+		/** Checks are the position, rotation and scale curves of the clip stored in a compressed representation. */
+		bool isCompressed() const { return mCompressedCurves != nullptr; }
+
+		/** 
+		 * Returns information about the size and precision of the compressed curves. Returns zeroed stats if the clip
+		 * is not compressed.
+		 */
+		AnimationCompressionStats getCompressionStats() const;
+
 		/** 
 		 * Creates an animation clip with no curves. After creation make sure to register some animation curves before
 		 * using it. 
@@ -273,6 +294,12 @@ namespace bs
 		static SPtr<AnimationClip> _createPtr(const SPtr<AnimationCurves>& curves, bool isAdditive = false, 
 			UINT32 sampleRate = 1, const SPtr<RootMotion>& rootMotion = nullptr);
 
+		/** 
+		 * Returns the compressed representation of the position, rotation and scale curves, or null if the clip is not
+		 * compressed. When present it should be used for evaluating those curves instead of getCurves().
+		 */
+		SPtr<CompressedAnimationCurves> _getCompressedCurves() const { return mCompressedCurves; }
+
 		/** @} */
 
 	protected:
@@ -298,6 +325,12 @@ namespace bs
 		 */
 		SPtr<AnimationCurves> mCurves;
 
+		/** 
+		 * Compressed version of the position, rotation and scale curves in mCurves, if the clip is compressed. Immutable
+		 * for the same reason as mCurves.
+		 */
+		SPtr<CompressedAnimationCurves> mCompressedCurves;
+
 		/**
 		 * A set of curves containing motion of the root bone. If this is non-empty it should be true that mCurves does not
 		 * contain animation curves for the root bone. Root motion will not be evaluated through normal animation process
@@ -3,7 +3,10 @@
 #include "Animation/BsAnimationManager.h"
 #include "Animation/BsAnimation.h"
 #include "Animation/BsAnimationClip.h"
+#include "Animation/BsBakedAnimationPoses.h"
 #include "Threading/BsTaskScheduler.h"
+#include "Threading/BsParallel.h"
+#include "Utility/BsTimer.h"
 #include "Utility/BsTime.h"
 #include "Scene/BsSceneManager.h"
 #include "Renderer/BsCamera.h"
@@ -13,9 +16,36 @@
 
 namespace bs
 {
+	/** Copies all bone transforms from one local pose to another. Both poses must have the same number of bones. */
+	static void copyPose(const LocalSkeletonPose& source, LocalSkeletonPose& dest)
+	{
+		assert(source.numBones == dest.numBones);
+
+		UINT32 numBones = source.numBones;
+		memcpy(dest.positions, source.positions, sizeof(Vector3) * numBones);
+		memcpy(dest.rotations, source.rotations, sizeof(Quaternion) * numBones);
+		memcpy(dest.scales, source.scales, sizeof(Vector3) * numBones);
+		memcpy(dest.hasOverride, source.hasOverride, sizeof(bool) * numBones);
+	}
+
+	/** 
+	 * Interpolates bone transforms between two local poses. Overrides are taken from the second pose. All poses must
+	 * have the same number of bones. 
+	 */
+	static void interpolatePose(const LocalSkeletonPose& a, const LocalSkeletonPose& b, float t, LocalSkeletonPose& output)
+	{
+		for (UINT32 i = 0; i < output.numBones; i++)
+		{
+			output.positions[i] = Vector3::lerp(t, a.positions[i], b.positions[i]);
+			output.rotations[i] = Quaternion::lerp(t, a.rotations[i], b.rotations[i]);
+			output.scales[i] = Vector3::lerp(t, a.scales[i], b.scales[i]);
+			output.hasOverride[i] = b.hasOverride[i];
+		}
+	}
+
 	AnimationManager::AnimationManager()
 		: mNextId(1), mUpdateRate(1.0f / 60.0f), mAnimationTime(0.0f), mLastAnimationUpdateTime(0.0f)
-		, mNextAnimationUpdateTime(0.0f), mPaused(false), mWorkerStarted(false), mPoseReadBufferIdx(1)
+		, mNextAnimationUpdateTime(0.0f), mUpdateCount(0), mPaused(false), mWorkerStarted(false), mPoseReadBufferIdx(1)
 		, mPoseWriteBufferIdx(0), mDataReady(false)
 	{
 		mAnimationWorker = Task::create("Animation", std::bind(&AnimationManager::evaluateAnimation, this));
@@ -51,6 +81,8 @@ namespace bs
 		WorkerState state = mWorkerState.load(std::memory_order_acquire);
 		assert(state == WorkerState::DataReady);
 
+		mStats = mEvaluationStats;
+
 		// Trigger events
 		for (auto& anim : mAnimations)
 		{
@@ -83,20 +115,50 @@ namespace bs
 			mProxies.push_back(anim.second->mAnimProxy);
 		}
 
+		// Release baked poses that haven't been used in a while. Poses referenced only by the cache aren't used by any
+		// animation proxy.
+		for (auto iter = mBakedPoses.begin(); iter != mBakedPoses.end();)
+		{
+			const BakedPoseEntry& entry = iter->second;
+			if (entry.poses.use_count() == 1 && (mUpdateCount - entry.lastUsedUpdate) > BAKED_POSE_RELEASE_DELAY)
+				iter = mBakedPoses.erase(iter);
+			else
+				++iter;
+		}
+
 		mCullFrustums.clear();
+		mLODViews.clear();
 
 		auto& allCameras = gSceneManager().getAllCameras();
 		for(auto& entry : allCameras)
 		{
-			bool isOverlayCamera = entry.second->getRenderSettings()->overlayOnly;
+			const SPtr<Camera>& camera = entry.second;
+
+			bool isOverlayCamera = camera->getRenderSettings()->overlayOnly;
 			if (isOverlayCamera)
 				continue;
 
 			// TODO: Not checking if camera and animation renderable's layers match. If we checked more animations could
 			// be culled.
-			mCullFrustums.push_back(entry.second->getWorldFrustum());
+			mCullFrustums.push_back(camera->getWorldFrustum());
+
+			LODView lodView;
+			lodView.position = camera->getTransform().getPosition();
+			lodView.perspective = camera->getProjectionType() == PT_PERSPECTIVE;
+
+			if (lodView.perspective)
+			{
+				float tanHalfVertFOV = Math::tan(camera->getHorzFOV() * 0.5f) / camera->getAspectRatio();
+				lodView.sizeScale = 1.0f / tanHalfVertFOV;
+			}
+			else
+				lodView.sizeScale = 2.0f / camera->getOrthoWindowHeight();
+
+			mLODViews.push_back(lodView);
 		}
 
+		mUpdateCount++;
+
 		// Make sure thread finishes writing all changes to the anim proxies as they will be read by the animation thread
 		mWorkerStarted = true;
 		mWorkerState.store(WorkerState::Started, std::memory_order_release);
@@ -117,57 +179,132 @@ namespace bs
 		// No need for locking, as we are sure that only postUpdate() writes to the proxy buffer, and increments the write
 		// buffer index. And it's called sequentially ensuring previous call to evaluate finishes.
 
+		Timer timer;
+
+		// Calculate where each animation's bones start in the output buffer up front, so the animations can be evaluated
+		// in parallel, each writing only to its own part of the buffer
+		UINT32 numProxies = (UINT32)mProxies.size();
+		mProxyBoneOffsets.resize(numProxies);
+		mBakedPoseOutputs.clear();
+
 		UINT32 totalNumBones = 0;
-		for (auto& anim : mProxies)
+		for (UINT32 i = 0; i < numProxies; i++)
 		{
-			if (anim->skeleton != nullptr)
-				totalNumBones += anim->skeleton->getNumBones();
+			mProxyBoneOffsets[i] = totalNumBones;
+
+			if (mProxies[i]->skeleton == nullptr)
+				continue;
+
+			// Animations displaying the same baked pose all reference a single copy of it
+			UINT32 numBones = mProxies[i]->skeleton->getNumBones();
+
+			const Matrix4* bakedPose = mProxies[i]->getBakedPose();
+			if (bakedPose != nullptr)
+			{
+				auto insertResult = mBakedPoseOutputs.insert(std::make_pair(bakedPose, 
+					BakedPoseOutput { totalNumBones, numBones }));
+
+				if (!insertResult.second)
+				{
+					mProxyBoneOffsets[i] = insertResult.first->second.boneStartIdx;
+					continue;
+				}
+			}
+
+			totalNumBones += numBones;
 		}
 
 		RendererAnimationData& renderData = mAnimData[mPoseWriteBufferIdx];
 		
 		UINT32 prevPoseBufferIdx = (mPoseWriteBufferIdx + CoreThread::NUM_SYNC_BUFFERS - 1) % CoreThread::NUM_SYNC_BUFFERS;
-		RendererAnimationData& prevRenderData = mAnimData[prevPoseBufferIdx];
+		const RendererAnimationData& prevRenderData = mAnimData[prevPoseBufferIdx];
 		
 		mPoseWriteBufferIdx = (mPoseWriteBufferIdx + 1) % CoreThread::NUM_SYNC_BUFFERS;
 
 		renderData.transforms.resize(totalNumBones);
 		renderData.infos.clear();
 
-		UINT32 curBoneIdx = 0;
-		for(auto& anim : mProxies)
+		for (auto& entry : mBakedPoseOutputs)
 		{
-			if(anim->mCullEnabled)
+			const BakedPoseOutput& output = entry.second;
+			memcpy(&renderData.transforms[output.boneStartIdx], entry.first, sizeof(Matrix4) * output.numBones);
+		}
+
+		mProxyResults.resize(numProxies);
+
+		Matrix4* transforms = renderData.transforms.data();
+		parallelFor(0, numProxies, PROXY_GRAIN_SIZE,
+			[this, transforms, &prevRenderData](UINT32 i)
+		{
+			ProxyEvaluationResult& result = mProxyResults[i];
+			result.hasAnimInfo = evaluateProxy(mProxies[i].get(), mProxyBoneOffsets[i], transforms, prevRenderData,
+				result.animInfo, result.interpolated);
+		});
+
+		UINT32 numEvaluated = 0;
+		UINT32 numInterpolated = 0;
+		for (UINT32 i = 0; i < numProxies; i++)
+		{
+			ProxyEvaluationResult& result = mProxyResults[i];
+			if (!result.hasAnimInfo)
+				continue;
+
+			renderData.infos[mProxies[i]->id] = result.animInfo;
+
+			numEvaluated++;
+			if (result.interpolated)
+				numInterpolated++;
+		}
+
+		mEvaluationStats.evaluationTime = timer.getMicroseconds() / 1000.0f;
+		mEvaluationStats.numAnimations = numProxies;
+		mEvaluationStats.numEvaluated = numEvaluated;
+		mEvaluationStats.numInterpolated = numInterpolated;
+
+		// Increments counter and ensures all writes are recorded
+		mWorkerState.store(WorkerState::DataReady, std::memory_order_release);
+		mDataReadyCount.fetch_add(1, std::memory_order_acq_rel);
+	}
+
+	bool AnimationManager::evaluateProxy(AnimationProxy* anim, UINT32 boneStartIdx, Matrix4* transforms,
+		const RendererAnimationData& prevRenderData, RendererAnimationData::AnimInfo& animInfo, bool& interpolated)
+	{
+		interpolated = false;
+
+		if(anim->mCullEnabled)
+		{
+			bool isVisible = false;
+			for(auto& frustum : mCullFrustums)
 			{
-				bool isVisible = false;
-				for(auto& frustum : mCullFrustums)
+				if(frustum.intersects(anim->mBounds))
 				{
-					if(frustum.intersects(anim->mBounds))
-					{
-						isVisible = true;
-						break;
-					}
+					isVisible = true;
+					break;
 				}
-
-				if (!isVisible)
-					continue;
 			}
 
-			RendererAnimationData::AnimInfo animInfo;
-			bool hasAnimInfo = false;
+			if (!isVisible)
+				return false;
+		}
+
+		animInfo = RendererAnimationData::AnimInfo();
+		bool hasAnimInfo = false;
 
-			// Evaluate skeletal animation
-			if (anim->skeleton != nullptr)
-			{
-				UINT32 numBones = anim->skeleton->getNumBones();
+		// Evaluate skeletal animation
+		if (anim->skeleton != nullptr)
+		{
+			UINT32 numBones = anim->skeleton->getNumBones();
 
-				RendererAnimationData::PoseInfo& poseInfo = animInfo.poseInfo;
-				poseInfo.animId = anim->id;
-				poseInfo.startIdx = curBoneIdx;
-				poseInfo.numBones = numBones;
+			RendererAnimationData::PoseInfo& poseInfo = animInfo.poseInfo;
+			poseInfo.animId = anim->id;
+			poseInfo.startIdx = boneStartIdx;
+			poseInfo.numBones = numBones;
 
+			// Baked poses are copied to the output buffer up front, as they can be shared between multiple animations
+			if (anim->getBakedPose() == nullptr)
+			{
 				memset(anim->skeletonPose.hasOverride, 0, sizeof(bool) * anim->skeletonPose.numBones);
-				Matrix4* boneDst = renderData.transforms.data() + curBoneIdx;
+				Matrix4* boneDst = transforms + boneStartIdx;
 
 				// Copy transforms from mapped scene objects
 				UINT32 boneTfrmIdx = 0;
@@ -184,132 +321,187 @@ namespace bs
 				}
 
 				// Animate bones
-				anim->skeleton->getPose(boneDst, anim->skeletonPose, anim->skeletonMask, anim->layers, anim->numLayers);
-
-				curBoneIdx += numBones;
-				hasAnimInfo = true;
-			}
-			else
-			{
-				RendererAnimationData::PoseInfo& poseInfo = animInfo.poseInfo;
-				poseInfo.animId = anim->id;
-				poseInfo.startIdx = 0;
-				poseInfo.numBones = 0;
+				interpolated = _evaluateSkeleton(anim, _getLOD(*anim, mLODViews), mUpdateCount, boneDst);
 			}
 
-			// Reset mapped SO transform
-			for (UINT32 i = 0; i < anim->sceneObjectPose.numBones; i++)
-			{
-				anim->sceneObjectPose.positions[i] = Vector3::ZERO;
-				anim->sceneObjectPose.rotations[i] = Quaternion::IDENTITY;
-				anim->sceneObjectPose.scales[i] = Vector3::ONE;
-			}
+			hasAnimInfo = true;
+		}
+		else
+		{
+			RendererAnimationData::PoseInfo& poseInfo = animInfo.poseInfo;
+			poseInfo.animId = anim->id;
+			poseInfo.startIdx = 0;
+			poseInfo.numBones = 0;
+		}
+
+		// Reset mapped SO transform
+		for (UINT32 i = 0; i < anim->sceneObjectPose.numBones; i++)
+		{
+			anim->sceneObjectPose.positions[i] = Vector3::ZERO;
+			anim->sceneObjectPose.rotations[i] = Quaternion::IDENTITY;
+			anim->sceneObjectPose.scales[i] = Vector3::ONE;
+		}
 
-			// Update mapped scene objects
-			memset(anim->sceneObjectPose.hasOverride, 1, sizeof(bool) * anim->numSceneObjects);
+		// Update mapped scene objects
+		memset(anim->sceneObjectPose.hasOverride, 1, sizeof(bool) * anim->numSceneObjects);
 
-			// Update scene object transforms
-			for(UINT32 i = 0; i < anim->numSceneObjects; i++)
-			{
-				const AnimatedSceneObjectInfo& soInfo = anim->sceneObjectInfos[i];
+		// Update scene object transforms
+		for(UINT32 i = 0; i < anim->numSceneObjects; i++)
+		{
+			const AnimatedSceneObjectInfo& soInfo = anim->sceneObjectInfos[i];
 
-				// We already evaluated bones
-				if (soInfo.boneIdx != -1)
-					continue;
+			// We already evaluated bones
+			if (soInfo.boneIdx != -1)
+				continue;
 
-				if (soInfo.layerIdx == -1 || soInfo.stateIdx == -1)
-					continue;
+			if (soInfo.layerIdx == -1 || soInfo.stateIdx == -1)
+				continue;
 
-				const AnimationState& state = anim->layers[soInfo.layerIdx].states[soInfo.stateIdx];
-				if (state.disabled)
-					continue;
+			const AnimationState& state = anim->layers[soInfo.layerIdx].states[soInfo.stateIdx];
+			if (state.disabled)
+				continue;
 
+			{
+				UINT32 curveIdx = soInfo.curveIndices.position;
+				if (curveIdx != (UINT32)-1)
 				{
-					UINT32 curveIdx = soInfo.curveIndices.position;
-					if (curveIdx != (UINT32)-1)
+					if (state.compressedCurves != nullptr)
+					{
+						anim->sceneObjectPose.positions[curveIdx] = 
+							state.compressedCurves->evaluatePosition(curveIdx, state.time, state.loop);
+					}
+					else
 					{
 						const TAnimationCurve<Vector3>& curve = state.curves->position[curveIdx].curve;
 						anim->sceneObjectPose.positions[curveIdx] = curve.evaluate(state.time, state.positionCaches[curveIdx], state.loop);
-						anim->sceneObjectPose.hasOverride[curveIdx] = false;
 					}
+
+					anim->sceneObjectPose.hasOverride[curveIdx] = false;
 				}
+			}
 
+			{
+				UINT32 curveIdx = soInfo.curveIndices.rotation;
+				if (curveIdx != (UINT32)-1)
 				{
-					UINT32 curveIdx = soInfo.curveIndices.rotation;
-					if (curveIdx != (UINT32)-1)
+					if (state.compressedCurves != nullptr)
+					{
+						anim->sceneObjectPose.rotations[curveIdx] = 
+							state.compressedCurves->evaluateRotation(curveIdx, state.time, state.loop);
+					}
+					else
 					{
 						const TAnimationCurve<Quaternion>& curve = state.curves->rotation[curveIdx].curve;
 						anim->sceneObjectPose.rotations[curveIdx] = curve.evaluate(state.time, state.rotationCaches[curveIdx], state.loop);
-						anim->sceneObjectPose.rotations[curveIdx].normalize();
-						anim->sceneObjectPose.hasOverride[curveIdx] = false;
 					}
+
+					anim->sceneObjectPose.rotations[curveIdx].normalize();
+					anim->sceneObjectPose.hasOverride[curveIdx] = false;
 				}
+			}
 
+			{
+				UINT32 curveIdx = soInfo.curveIndices.scale;
+				if (curveIdx != (UINT32)-1)
 				{
-					UINT32 curveIdx = soInfo.curveIndices.scale;
-					if (curveIdx != (UINT32)-1)
+					if (state.compressedCurves != nullptr)
+					{
+						anim->sceneObjectPose.scales[curveIdx] = 
+							state.compressedCurves->evaluateScale(curveIdx, state.time, state.loop);
+					}
+					else
 					{
 						const TAnimationCurve<Vector3>& curve = state.curves->scale[curveIdx].curve;
 						anim->sceneObjectPose.scales[curveIdx] = curve.evaluate(state.time, state.scaleCaches[curveIdx], state.loop);
-						anim->sceneObjectPose.hasOverride[curveIdx] = false;
 					}
+
+					anim->sceneObjectPose.hasOverride[curveIdx] = false;
 				}
 			}
+		}
 
-			// Update generic curves
-			// Note: No blending for generic animations, just use first animation
-			if (anim->numLayers > 0 && anim->layers[0].numStates > 0)
+		// Update generic curves
+		// Note: No blending for generic animations, just use first animation
+		if (anim->numLayers > 0 && anim->layers[0].numStates > 0)
+		{
+			const AnimationState& state = anim->layers[0].states[0];
+			if (!state.disabled)
 			{
-				const AnimationState& state = anim->layers[0].states[0];
-				if (!state.disabled)
+				UINT32 numCurves = (UINT32)state.curves->generic.size();
+				for (UINT32 i = 0; i < numCurves; i++)
 				{
-					UINT32 numCurves = (UINT32)state.curves->generic.size();
-					for (UINT32 i = 0; i < numCurves; i++)
-					{
-						const TAnimationCurve<float>& curve = state.curves->generic[i].curve;
-						anim->genericCurveOutputs[i] = curve.evaluate(state.time, state.genericCaches[i], state.loop);
-					}
+					const TAnimationCurve<float>& curve = state.curves->generic[i].curve;
+					anim->genericCurveOutputs[i] = curve.evaluate(state.time, state.genericCaches[i], state.loop);
 				}
 			}
+		}
+
+		// Update morph shapes
+		if(anim->numMorphShapes > 0)
+		{
+			auto iterFind = prevRenderData.infos.find(anim->id);
+			if (iterFind != prevRenderData.infos.end())
+				animInfo.morphShapeInfo = iterFind->second.morphShapeInfo;
+			else
+				animInfo.morphShapeInfo.version = 1; // 0 is considered invalid version
 
-			// Update morph shapes
-			if(anim->numMorphShapes > 0)
+			// Recalculate weights if curves are present
+			bool hasMorphCurves = false;
+			for(UINT32 i = 0; i < anim->numMorphChannels; i++)
 			{
-				auto iterFind = prevRenderData.infos.find(anim->id);
-				if (iterFind != prevRenderData.infos.end())
-					animInfo.morphShapeInfo = iterFind->second.morphShapeInfo;
+				MorphChannelInfo& channelInfo = anim->morphChannelInfos[i];
+				if(channelInfo.weightCurveIdx != (UINT32)-1)
+				{
+					channelInfo.weight = Math::clamp01(anim->genericCurveOutputs[channelInfo.weightCurveIdx]);
+					hasMorphCurves = true;
+				}
+
+				float frameWeight;
+				if (channelInfo.frameCurveIdx != (UINT32)-1)
+				{
+					frameWeight = Math::clamp01(anim->genericCurveOutputs[channelInfo.frameCurveIdx]);
+					hasMorphCurves = true;
+				}
 				else
-					animInfo.morphShapeInfo.version = 1; // 0 is considered invalid version
+					frameWeight = 0.0f;
 
-				// Recalculate weights if curves are present
-				bool hasMorphCurves = false;
-				for(UINT32 i = 0; i < anim->numMorphChannels; i++)
+				if(channelInfo.shapeCount == 1)
 				{
-					MorphChannelInfo& channelInfo = anim->morphChannelInfos[i];
-					if(channelInfo.weightCurveIdx != (UINT32)-1)
-					{
-						channelInfo.weight = Math::clamp01(anim->genericCurveOutputs[channelInfo.weightCurveIdx]);
-						hasMorphCurves = true;
-					}
+					MorphShapeInfo& shapeInfo = anim->morphShapeInfos[channelInfo.shapeStart];
 
-					float frameWeight;
-					if (channelInfo.frameCurveIdx != (UINT32)-1)
+					// Blend between base shape and the only available frame
+					float relative = frameWeight - shapeInfo.frameWeight;
+					if (relative <= 0.0f)
 					{
-						frameWeight = Math::clamp01(anim->genericCurveOutputs[channelInfo.frameCurveIdx]);
-						hasMorphCurves = true;
+						float diff = shapeInfo.frameWeight;
+						if (diff > 0.0f)
+						{
+							float t = -relative / diff;
+							shapeInfo.finalWeight = 1.0f - std::min(t, 1.0f);
+						}
+						else
+							shapeInfo.finalWeight = 1.0f;
 					}
-					else
-						frameWeight = 0.0f;
-
-					if(channelInfo.shapeCount == 1)
+					else // If past the final frame we clamp
+						shapeInfo.finalWeight = 1.0f;
+				}
+				else if(channelInfo.shapeCount > 1)
+				{
+					for(UINT32 j = 0; j < channelInfo.shapeCount - 1; j++)
 					{
-						MorphShapeInfo& shapeInfo = anim->morphShapeInfos[channelInfo.shapeStart];
+						float prevShapeWeight;
+						if (j > 0)
+							prevShapeWeight = anim->morphShapeInfos[j - 1].frameWeight;
+						else
+							prevShapeWeight = 0.0f; // Base shape, blend between it and the first frame
+
+						float nextShapeWeight = anim->morphShapeInfos[j + 1].frameWeight;
+						MorphShapeInfo& shapeInfo = anim->morphShapeInfos[j];
 
-						// Blend between base shape and the only available frame
 						float relative = frameWeight - shapeInfo.frameWeight;
 						if (relative <= 0.0f)
 						{
-							float diff = shapeInfo.frameWeight;
+							float diff = shapeInfo.frameWeight - prevShapeWeight;
 							if (diff > 0.0f)
 							{
 								float t = -relative / diff;
@@ -318,157 +510,279 @@ namespace bs
 							else
 								shapeInfo.finalWeight = 1.0f;
 						}
-						else // If past the final frame we clamp
-							shapeInfo.finalWeight = 1.0f;
-					}
-					else if(channelInfo.shapeCount > 1)
-					{
-						for(UINT32 j = 0; j < channelInfo.shapeCount - 1; j++)
+						else
 						{
-							float prevShapeWeight;
-							if (j > 0)
-								prevShapeWeight = anim->morphShapeInfos[j - 1].frameWeight;
-							else
-								prevShapeWeight = 0.0f; // Base shape, blend between it and the first frame
-
-							float nextShapeWeight = anim->morphShapeInfos[j + 1].frameWeight;
-							MorphShapeInfo& shapeInfo = anim->morphShapeInfos[j];
-
-							float relative = frameWeight - shapeInfo.frameWeight;
-							if (relative <= 0.0f)
+							float diff = nextShapeWeight - shapeInfo.frameWeight;
+							if (diff > 0.0f)
 							{
-								float diff = shapeInfo.frameWeight - prevShapeWeight;
-								if (diff > 0.0f)
-								{
-									float t = -relative / diff;
-									shapeInfo.finalWeight = 1.0f - std::min(t, 1.0f);
-								}
-								else
-									shapeInfo.finalWeight = 1.0f;
+								float t = relative / diff;
+								shapeInfo.finalWeight = std::min(t, 1.0f);
 							}
 							else
-							{
-								float diff = nextShapeWeight - shapeInfo.frameWeight;
-								if (diff > 0.0f)
-								{
-									float t = relative / diff;
-									shapeInfo.finalWeight = std::min(t, 1.0f);
-								}
-								else
-									shapeInfo.finalWeight = 0.0f;
-							}
+								shapeInfo.finalWeight = 0.0f;
 						}
+					}
 
-						// Last frame
-						{
-							UINT32 lastFrame = channelInfo.shapeStart + channelInfo.shapeCount - 1;
-							MorphShapeInfo& prevShapeInfo = anim->morphShapeInfos[lastFrame - 1];
-							MorphShapeInfo& shapeInfo = anim->morphShapeInfos[lastFrame];
+					// Last frame
+					{
+						UINT32 lastFrame = channelInfo.shapeStart + channelInfo.shapeCount - 1;
+						MorphShapeInfo& prevShapeInfo = anim->morphShapeInfos[lastFrame - 1];
+						MorphShapeInfo& shapeInfo = anim->morphShapeInfos[lastFrame];
 
-							float relative = frameWeight - shapeInfo.frameWeight;
-							if (relative <= 0.0f)
+						float relative = frameWeight - shapeInfo.frameWeight;
+						if (relative <= 0.0f)
+						{
+							float diff = shapeInfo.frameWeight - prevShapeInfo.frameWeight;
+							if (diff > 0.0f)
 							{
-								float diff = shapeInfo.frameWeight - prevShapeInfo.frameWeight;
-								if (diff > 0.0f)
-								{
-									float t = -relative / diff;
-									shapeInfo.finalWeight = 1.0f - std::min(t, 1.0f);
-								}
-								else
-									shapeInfo.finalWeight = 1.0f;
+								float t = -relative / diff;
+								shapeInfo.finalWeight = 1.0f - std::min(t, 1.0f);
 							}
-							else // If past the final frame we clamp
+							else
 								shapeInfo.finalWeight = 1.0f;
 						}
+						else // If past the final frame we clamp
+							shapeInfo.finalWeight = 1.0f;
 					}
+				}
+
+				for(UINT32 j = 0; j < channelInfo.shapeCount; j++)
+				{
+					MorphShapeInfo& shapeInfo = anim->morphShapeInfos[channelInfo.shapeStart + j];
+					shapeInfo.finalWeight *= channelInfo.weight;
+				}
+			}
+
+			// Generate morph shape vertices
+			if(anim->morphChannelWeightsDirty || hasMorphCurves)
+			{
+				SPtr<MeshData> meshData = bs_shared_ptr_new<MeshData>(anim->numMorphVertices, 0, mBlendShapeVertexDesc);
+
+				UINT8* bufferData = meshData->getData();
+				memset(bufferData, 0, meshData->getSize());
 
-					for(UINT32 j = 0; j < channelInfo.shapeCount; j++)
+				UINT32 tempDataSize = (sizeof(Vector3) + sizeof(float)) * anim->numMorphVertices;
+				UINT8* tempData = (UINT8*)bs_stack_alloc(tempDataSize);
+				memset(tempData, 0, tempDataSize);
+
+				Vector3* tempNormals = (Vector3*)tempData;
+				float* accumulatedWeight = (float*)(tempData + sizeof(Vector3) * anim->numMorphVertices);
+
+				UINT8* positions = meshData->getElementData(VES_POSITION, 1, 1);
+				UINT8* normals = meshData->getElementData(VES_NORMAL, 1, 1);
+
+				UINT32 stride = mBlendShapeVertexDesc->getVertexStride(1);
+
+				for(UINT32 i = 0; i < anim->numMorphShapes; i++)
+				{
+					const MorphShapeInfo& info = anim->morphShapeInfos[i];
+					float absWeight = Math::abs(info.finalWeight);
+
+					if (absWeight < 0.0001f)
+						continue;
+
+					const Vector<MorphVertex>& morphVertices = info.shape->getVertices();
+					UINT32 numVertices = (UINT32)morphVertices.size();
+					for(UINT32 j = 0; j < numVertices; j++)
 					{
-						MorphShapeInfo& shapeInfo = anim->morphShapeInfos[channelInfo.shapeStart + j];
-						shapeInfo.finalWeight *= channelInfo.weight;
+						const MorphVertex& vertex = morphVertices[j];
+
+						Vector3* destPos = (Vector3*)(positions + vertex.sourceIdx * stride);
+						*destPos += vertex.deltaPosition * info.finalWeight;
+
+						tempNormals[vertex.sourceIdx] += vertex.deltaNormal * info.finalWeight;
+						accumulatedWeight[vertex.sourceIdx] += absWeight;
 					}
 				}
 
-				// Generate morph shape vertices
-				if(anim->morphChannelWeightsDirty || hasMorphCurves)
+				for(UINT32 i = 0; i < anim->numMorphVertices; i++)
 				{
-					SPtr<MeshData> meshData = bs_shared_ptr_new<MeshData>(anim->numMorphVertices, 0, mBlendShapeVertexDesc);
+					PackedNormal* destNrm = (PackedNormal*)(normals + i * stride);
 
-					UINT8* bufferData = meshData->getData();
-					memset(bufferData, 0, meshData->getSize());
+					if (accumulatedWeight[i] > 0.0001f)
+					{
+						Vector3 normal = tempNormals[i] / accumulatedWeight[i];
+						normal /= 2.0f; // Accumulated normal is in range [-2, 2] but our normal packing method assumes [-1, 1] range
 
-					UINT32 tempDataSize = (sizeof(Vector3) + sizeof(float)) * anim->numMorphVertices;
-					UINT8* tempData = (UINT8*)bs_stack_alloc(tempDataSize);
-					memset(tempData, 0, tempDataSize);
+						MeshUtility::packNormals(&normal, (UINT8*)destNrm, 1, sizeof(Vector3), stride);
+						destNrm->w = (UINT8)(std::min(1.0f, accumulatedWeight[i]) * 255.999f);
+					}
+					else
+					{
+						*destNrm = { 127, 127, 127, 0 };
+					}
+				}
 
-					Vector3* tempNormals = (Vector3*)tempData;
-					float* accumulatedWeight = (float*)(tempData + sizeof(Vector3) * anim->numMorphVertices);
+				bs_stack_free(tempData);
 
-					UINT8* positions = meshData->getElementData(VES_POSITION, 1, 1);
-					UINT8* normals = meshData->getElementData(VES_NORMAL, 1, 1);
+				animInfo.morphShapeInfo.meshData = meshData;
 
-					UINT32 stride = mBlendShapeVertexDesc->getVertexStride(1);
+				animInfo.morphShapeInfo.version++;
+				anim->morphChannelWeightsDirty = false;
+			}
 
-					for(UINT32 i = 0; i < anim->numMorphShapes; i++)
-					{
-						const MorphShapeInfo& info = anim->morphShapeInfos[i];
-						float absWeight = Math::abs(info.finalWeight);
+			hasAnimInfo = true;
+		}
+		else
+			animInfo.morphShapeInfo.version = 1;
 
-						if (absWeight < 0.0001f)
-							continue;
+		return hasAnimInfo;
+	}
 
-						const Vector<MorphVertex>& morphVertices = info.shape->getVertices();
-						UINT32 numVertices = (UINT32)morphVertices.size();
-						for(UINT32 j = 0; j < numVertices; j++)
-						{
-							const MorphVertex& vertex = morphVertices[j];
+	bool AnimationManager::_evaluateSkeleton(AnimationProxy* anim, UINT32 lodIdx, UINT32 updateIdx, Matrix4* pose)
+	{
+		const SPtr<Skeleton>& skeleton = anim->skeleton;
+		if (anim->mLODs.empty())
+		{
+			skeleton->getPose(pose, anim->skeletonPose, anim->skeletonMask, anim->layers, anim->numLayers);
+			return false;
+		}
 
-							Vector3* destPos = (Vector3*)(positions + vertex.sourceIdx * stride);
-							*destPos += vertex.deltaPosition * info.finalWeight;
+		const AnimationLOD& lod = anim->mLODs[lodIdx];
+		bool reusePoses = lod.updateInterval > 1;
 
-							tempNormals[vertex.sourceIdx] += vertex.deltaNormal * info.finalWeight;
-							accumulatedWeight[vertex.sourceIdx] += absWeight;
-						}
-					}
+		bool evaluate = true;
+		if (reusePoses && anim->mHasLODPoses)
+		{
+			anim->mUpdatesSinceEvaluation++;
 
-					for(UINT32 i = 0; i < anim->numMorphVertices; i++)
-					{
-						PackedNormal* destNrm = (PackedNormal*)(normals + i * stride);
+			// Animations are offset by their ID, so animations with the same update interval don't all get evaluated on
+			// the same update
+			evaluate = ((updateIdx + (UINT32)anim->id) % lod.updateInterval) == 0 ||
+				anim->mUpdatesSinceEvaluation >= lod.updateInterval;
+		}
 
-						if (accumulatedWeight[i] > 0.0001f)
-						{
-							Vector3 normal = tempNormals[i] / accumulatedWeight[i];
-							normal /= 2.0f; // Accumulated normal is in range [-2, 2] but our normal packing method assumes [-1, 1] range
+		if (evaluate)
+		{
+			skeleton->getLocalPose(anim->skeletonPose, anim->mLODEvaluationMasks[lodIdx], anim->layers, anim->numLayers);
 
-							MeshUtility::packNormals(&normal, (UINT8*)destNrm, 1, sizeof(Vector3), stride);
-							destNrm->w = (UINT8)(std::min(1.0f, accumulatedWeight[i]) * 255.999f);
-						}
-						else
-						{
-							*destNrm = { 127, 127, 127, 0 };
-						}
-					}
+			// Bones disabled by the level of detail follow their parent
+			const LocalSkeletonPose& bindPose = skeleton->getLocalBindPose();
+			for (UINT32 i = 0; i < bindPose.numBones; i++)
+			{
+				if (lod.mask.isEnabled(i) || !anim->skeletonMask.isEnabled(i))
+					continue;
 
-					bs_stack_free(tempData);
+				anim->skeletonPose.positions[i] = bindPose.positions[i];
+				anim->skeletonPose.rotations[i] = bindPose.rotations[i];
+				anim->skeletonPose.scales[i] = bindPose.scales[i];
+			}
 
-					animInfo.morphShapeInfo.meshData = meshData;
+			if (reusePoses)
+			{
+				std::swap(anim->mLODPoses[0], anim->mLODPoses[1]);
+				copyPose(anim->skeletonPose, anim->mLODPoses[1]);
 
-					animInfo.morphShapeInfo.version++;
-					anim->morphChannelWeightsDirty = false;
+				if (!anim->mHasLODPoses)
+				{
+					copyPose(anim->skeletonPose, anim->mLODPoses[0]);
+					anim->mHasLODPoses = true;
 				}
 
-				hasAnimInfo = true;
+				anim->mUpdatesSinceEvaluation = 0;
 			}
 			else
-				animInfo.morphShapeInfo.version = 1;
+				anim->mHasLODPoses = false;
+		}
 
-			if (hasAnimInfo)
-				renderData.infos[anim->id] = animInfo;
+		if (reusePoses)
+		{
+			if (lod.interpolate)
+			{
+				float t = std::min(anim->mUpdatesSinceEvaluation / (float)lod.updateInterval, 1.0f);
+				interpolatePose(anim->mLODPoses[0], anim->mLODPoses[1], t, anim->skeletonPose);
+			}
+			else if (!evaluate)
+				copyPose(anim->mLODPoses[1], anim->skeletonPose);
 		}
 
-		// Increments counter and ensures all writes are recorded
-		mWorkerState.store(WorkerState::DataReady, std::memory_order_release);
-		mDataReadyCount.fetch_add(1, std::memory_order_acq_rel);
+		skeleton->getPose(pose, anim->skeletonPose);
+		return !evaluate;
+	}
+
+	UINT32 AnimationManager::_getLOD(const AnimationProxy& anim, const Vector<LODView>& views)
+	{
+		if (views.empty())
+			return 0;
+
+		Vector3 center = anim.mBounds.getCenter();
+		float radius = anim.mBounds.getRadius();
+
+		float distance = std::numeric_limits<float>::max();
+		float screenSize = 0.0f;
+		for (auto& view : views)
+		{
+			float centerDistance = view.position.distance(center);
+			distance = std::min(distance, std::max(centerDistance - radius, 0.0f));
+
+			float viewScreenSize = radius * view.sizeScale;
+			if (view.perspective)
+				viewScreenSize /= std::max(centerDistance, 0.0001f);
+
+			screenSize = std::max(screenSize, viewScreenSize);
+		}
+
+		UINT32 numLODs = (UINT32)anim.mLODs.size();
+		for (UINT32 i = 0; i < numLODs; i++)
+		{
+			const AnimationLOD& lod = anim.mLODs[i];
+
+			bool matches;
+			if (anim.mLODMetric == AnimLODMetric::ScreenSize)
+				matches = screenSize >= lod.threshold;
+			else
+				matches = distance <= lod.threshold;
+
+			if (matches)
+				return i;
+		}
+
+		return numLODs - 1;
+	}
+
+	SPtr<BakedAnimationPoses> AnimationManager::getBakedPoses(const SPtr<Skeleton>& skeleton, const AnimationClip& clip,
+		UINT32 sampleRate)
+	{
+		SPtr<AnimationCurves> curves = clip.getCurves();
+
+		BakedPoseKey key;
+		key.skeleton = skeleton.get();
+		key.curves = curves.get();
+		key.version = clip.getVersion();
+		key.sampleRate = sampleRate;
+
+		auto iterFind = mBakedPoses.find(key);
+		if (iterFind != mBakedPoses.end())
+		{
+			iterFind->second.lastUsedUpdate = mUpdateCount;
+			return iterFind->second.poses;
+		}
+
+		BakedPoseEntry entry;
+		entry.poses = BakedAnimationPoses::create(skeleton, clip, sampleRate);
+		entry.skeleton = skeleton;
+		entry.curves = curves;
+		entry.lastUsedUpdate = mUpdateCount;
+
+		mBakedPoses[key] = entry;
+		return entry.poses;
+	}
+
+	size_t AnimationManager::BakedPoseKey::HashFunction::operator()(const BakedPoseKey& key) const
+	{
+		size_t hash = 0;
+		hash_combine(hash, key.skeleton);
+		hash_combine(hash, key.curves);
+		hash_combine(hash, key.version);
+		hash_combine(hash, key.sampleRate);
+
+		return hash;
+	}
+
+	bool AnimationManager::BakedPoseKey::EqualFunction::operator()(const BakedPoseKey& lhs, const BakedPoseKey& rhs) const
+	{
+		return lhs.skeleton == rhs.skeleton && lhs.curves == rhs.curves && lhs.version == rhs.version && 
+			lhs.sampleRate == rhs.sampleRate;
 	}
 
 	void AnimationManager::waitUntilComplete()
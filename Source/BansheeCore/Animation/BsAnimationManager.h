@@ -11,6 +11,7 @@
 namespace bs
 {
 	struct AnimationProxy;
+	class BakedAnimationPoses;
 
 	/** @addtogroup Animation-Internal
 	 *  @{
@@ -50,6 +51,29 @@ namespace bs
 		Vector<Matrix4> transforms;
 	};
 
+	/** Contains statistics about the most recently completed animation evaluation. */
+	struct AnimationStats
+	{
+		AnimationStats()
+			: evaluationTime(0.0f), numAnimations(0), numEvaluated(0), numInterpolated(0)
+		{ }
+
+		/** Time it took to evaluate all the animations, in milliseconds. */
+		float evaluationTime;
+
+		/** Total number of animations considered for evaluation. */
+		UINT32 numAnimations;
+
+		/** Number of animations that were evaluated (i.e. that weren't culled). */
+		UINT32 numEvaluated;
+
+		/** 
+		 * Number of evaluated animations that reused previously evaluated skeleton poses instead of evaluating them, due
+		 * to their level of detail. 
+		 */
+		UINT32 numInterpolated;
+	};
+
 	/** 
 	 * Keeps track of all active animations, queues animation thread tasks and synchronizes data between simulation, core
 	 * and animation threads.
@@ -57,6 +81,19 @@ namespace bs
 	class BS_CORE_EXPORT AnimationManager : public Module<AnimationManager>
 	{
 	public:
+		/** Information about a camera used for picking animation levels of detail. */
+		struct LODView
+		{
+			Vector3 position;
+
+			/**
+			 * Converts bounds radius into a fraction of the viewport height. For perspective cameras the radius must
+			 * also be divided by the distance to the camera.
+			 */
+			float sizeScale;
+			bool perspective;
+		};
+
 		AnimationManager();
 
 		/** Pauses or resumes the animation evaluation. */
@@ -99,6 +136,50 @@ namespace bs
 		 */
 		const RendererAnimationData& getRendererData();
 
+		/** 
+		 * Returns statistics about the most recently completed animation evaluation. Updated by preUpdate().
+		 *
+		 * @note	Simulation thread only.
+		 */
+		const AnimationStats& getStats() const { return mStats; }
+
+		/**
+		 * Returns poses of the skeleton animated by the provided clip, sampled at the provided rate. Poses are baked on the
+		 * first request, and shared between all requests for the same skeleton, clip curves, clip version and sample rate.
+		 * Poses that aren't used by any animation are released after a while.
+		 *
+		 * @note	Simulation thread only.
+		 */
+		SPtr<BakedAnimationPoses> getBakedPoses(const SPtr<Skeleton>& skeleton, const AnimationClip& clip, 
+			UINT32 sampleRate);
+
+	public: // ***** INTERNAL ******
+		/** @name Internal
+		 *  @{
+		 */
+
+		/**
+		 * Outputs the skeleton pose of an animation proxy at the provided level of detail. Depending on the level the
+		 * pose is either evaluated or derived from the previously evaluated poses.
+		 *
+		 * @param[in]		anim		Animation proxy to evaluate the skeleton pose for. Must have a skeleton.
+		 * @param[in]		lodIdx		Index of the level of detail to use. Ignored if the proxy has no levels of detail.
+		 * @param[in]		updateIdx	Index of the current animation update. Determines on which updates animations with
+		 *								an update interval larger than one are evaluated.
+		 * @param[in, out]	pose		Output pose containing the bone transforms. Must already contain transforms for
+		 *								bones overriden by scene objects.
+		 * @return						True if the pose was derived from previously evaluated poses.
+		 */
+		static bool _evaluateSkeleton(AnimationProxy* anim, UINT32 lodIdx, UINT32 updateIdx, Matrix4* pose);
+
+		/**
+		 * Picks a level of detail for the animation proxy, based on its bounds and the provided views. Returns the first
+		 * level if no views are provided.
+		 */
+		static UINT32 _getLOD(const AnimationProxy& anim, const Vector<LODView>& views);
+
+		/** @} */
+
 	private:
 		friend class Animation;
 
@@ -110,6 +191,57 @@ namespace bs
 			DataReady
 		};
 
+		/** Output of a single animation proxy evaluation. */
+		struct ProxyEvaluationResult
+		{
+			RendererAnimationData::AnimInfo animInfo;
+			bool hasAnimInfo = false;
+			bool interpolated = false;
+		};
+
+		/** Identifies a set of baked poses. */
+		struct BakedPoseKey
+		{
+			class HashFunction
+			{
+			public:
+				size_t operator()(const BakedPoseKey& key) const;
+			};
+
+			class EqualFunction
+			{
+			public:
+				bool operator()(const BakedPoseKey& lhs, const BakedPoseKey& rhs) const;
+			};
+
+			const Skeleton* skeleton;
+			const AnimationCurves* curves;
+			UINT64 version;
+			UINT32 sampleRate;
+		};
+
+		/** Baked poses, along with references that keep the key pointers valid while the entry exists. */
+		struct BakedPoseEntry
+		{
+			SPtr<BakedAnimationPoses> poses;
+			SPtr<Skeleton> skeleton;
+			SPtr<AnimationCurves> curves;
+			UINT32 lastUsedUpdate;
+		};
+
+		/** Location of a baked pose in the output transform buffer. */
+		struct BakedPoseOutput
+		{
+			UINT32 boneStartIdx;
+			UINT32 numBones;
+		};
+
+		/** Number of animation proxies evaluated sequentially by a single animation worker. */
+		static const UINT32 PROXY_GRAIN_SIZE = 4;
+
+		/** Number of animation updates after which baked poses that aren't used by any animation are released. */
+		static const UINT32 BAKED_POSE_RELEASE_DELAY = 600;
+
 		/** 
 		 * Registers a new animation and returns a unique ID for it. Must be called whenever an Animation is constructed. 
 		 */
@@ -121,6 +253,21 @@ namespace bs
 		/** Worker method ran on the animation thread that evaluates all animation at the provided time. */
 		void evaluateAnimation();
 
+		/**
+		 * Evaluates a single animation proxy. Called in parallel for different proxies from the animation worker.
+		 *
+		 * @param[in]	anim			Animation proxy to evaluate.
+		 * @param[in]	boneStartIdx	Index in @p transforms at which to write the proxy's skeleton pose.
+		 * @param[in]	transforms		Global joint transform buffer for all skeletons.
+		 * @param[in]	prevRenderData	Animation data evaluated on the previous frame.
+		 * @param[out]	animInfo		Information about the evaluated animation data.
+		 * @param[out]	interpolated	True if the skeleton pose was derived from previously evaluated poses.
+		 * @return						True if the animation produced data and @p animInfo was populated, false if it
+		 *								was culled or produced no data.
+		 */
+		bool evaluateProxy(AnimationProxy* anim, UINT32 boneStartIdx, Matrix4* transforms,
+			const RendererAnimationData& prevRenderData, RendererAnimationData::AnimInfo& animInfo, bool& interpolated);
+
 		UINT64 mNextId;
 		UnorderedMap<UINT64, Animation*> mAnimations;
 		
@@ -128,16 +275,24 @@ namespace bs
 		float mAnimationTime;
 		float mLastAnimationUpdateTime;
 		float mNextAnimationUpdateTime;
+		UINT32 mUpdateCount;
 		bool mPaused;
+		AnimationStats mStats;
 
 		bool mWorkerStarted;
 		SPtr<Task> mAnimationWorker;
 		SPtr<VertexDataDesc> mBlendShapeVertexDesc;
+		UnorderedMap<BakedPoseKey, BakedPoseEntry, BakedPoseKey::HashFunction, BakedPoseKey::EqualFunction> mBakedPoses;
 
 		// Animation thread
 		Vector<SPtr<AnimationProxy>> mProxies;
 		Vector<ConvexVolume> mCullFrustums;
+		Vector<LODView> mLODViews;
 		RendererAnimationData mAnimData[CoreThread::NUM_SYNC_BUFFERS];
+		Vector<UINT32> mProxyBoneOffsets;
+		UnorderedMap<const Matrix4*, BakedPoseOutput> mBakedPoseOutputs;
+		Vector<ProxyEvaluationResult> mProxyResults;
+		AnimationStats mEvaluationStats;
 
 		UINT32 mPoseReadBufferIdx;
 		UINT32 mPoseWriteBufferIdx;
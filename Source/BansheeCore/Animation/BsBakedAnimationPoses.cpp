@@ -0,0 +1,56 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "Animation/BsBakedAnimationPoses.h"
+#include "Animation/BsAnimationClip.h"
+#include "Animation/BsSkeleton.h"
+#include "Animation/BsSkeletonMask.h"
+
+namespace bs
+{
+	const Matrix4* BakedAnimationPoses::getPose(float time, bool loop) const
+	{
+		UINT32 lastPose = mNumPoses - 1;
+		if (lastPose == 0 || mLength <= 0.0f)
+			return mPoses.data();
+
+		if (loop)
+		{
+			time = std::fmod(time, mLength);
+			if (time < 0.0f)
+				time += mLength;
+		}
+		else
+			time = Math::clamp(time, 0.0f, mLength);
+
+		UINT32 poseIdx = std::min((UINT32)Math::roundToInt(time / mLength * lastPose), lastPose);
+		return mPoses.data() + poseIdx * mNumBones;
+	}
+
+	SPtr<BakedAnimationPoses> BakedAnimationPoses::create(const SPtr<Skeleton>& skeleton, const AnimationClip& clip,
+		UINT32 sampleRate)
+	{
+		BakedAnimationPoses* rawPtr = new (bs_alloc<BakedAnimationPoses>()) BakedAnimationPoses();
+		SPtr<BakedAnimationPoses> output = bs_shared_ptr<BakedAnimationPoses>(rawPtr);
+
+		// Both the first and the last frame are stored, so clamped animations end on their exact last frame
+		UINT32 numIntervals = std::max(1U, (UINT32)Math::ceilToInt(clip.getLength() * sampleRate));
+
+		output->mNumBones = skeleton->getNumBones();
+		output->mNumPoses = numIntervals + 1;
+		output->mLength = clip.getLength();
+		output->mPoses.resize(output->mNumBones * output->mNumPoses);
+
+		LocalSkeletonPose localPose(output->mNumBones);
+		SkeletonMask mask;
+		for (UINT32 i = 0; i < output->mNumPoses; i++)
+		{
+			float time = output->mLength * i / (float)numIntervals;
+			Matrix4* pose = output->mPoses.data() + i * output->mNumBones;
+
+			memset(localPose.hasOverride, 0, sizeof(bool) * output->mNumBones);
+			skeleton->getPose(pose, localPose, mask, clip, time, false);
+		}
+
+		return output;
+	}
+}
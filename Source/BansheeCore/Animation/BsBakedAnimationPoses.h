@@ -0,0 +1,59 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Math/BsMatrix4.h"
+
+namespace bs
+{
+	/** @addtogroup Animation-Internal
+	 *  @{
+	 */
+
+	/**
+	 * Skeleton poses of a single animation clip, sampled at uniform intervals. Each pose contains the final bone
+	 * transforms, in the same format as output by Skeleton::getPose(). Allows animations that play the same clip on the
+	 * same skeleton to share the evaluated poses, instead of evaluating them separately.
+	 *
+	 * @note	Immutable after creation so it may be used on multiple threads.
+	 */
+	class BS_CORE_EXPORT BakedAnimationPoses
+	{
+	public:
+		/**
+		 * Returns the bone transforms of the pose sampled closest to the provided time.
+		 *
+		 * @param[in]	time	Time to retrieve the pose for, in seconds.
+		 * @param[in]	loop	Determines should the time be looped (wrapped) if it goes past the clip start/end.
+		 * @return				Array of getNumBones() bone transforms.
+		 */
+		const Matrix4* getPose(float time, bool loop) const;
+
+		/** Returns the number of bones in each pose. */
+		UINT32 getNumBones() const { return mNumBones; }
+
+		/** Returns the number of stored poses. */
+		UINT32 getNumPoses() const { return mNumPoses; }
+
+		/**
+		 * Evaluates the provided animation clip at uniform intervals and stores the resulting poses.
+		 *
+		 * @param[in]	skeleton	Skeleton to evaluate the poses for.
+		 * @param[in]	clip		Clip to evaluate. Must not be additive.
+		 * @param[in]	sampleRate	Number of poses to store per second of the clip.
+		 */
+		static SPtr<BakedAnimationPoses> create(const SPtr<Skeleton>& skeleton, const AnimationClip& clip,
+			UINT32 sampleRate);
+
+	private:
+		BakedAnimationPoses() = default;
+
+		UINT32 mNumBones = 0;
+		UINT32 mNumPoses = 0;
+		float mLength = 0.0f;
+		Vector<Matrix4> mPoses;
+	};
+
+	/** @} */
+}
@@ -0,0 +1,499 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "Animation/BsCompressedAnimationCurves.h"
+#include "Animation/BsAnimationClip.h"
+#include "Animation/BsAnimationUtility.h"
+#include "RTTI/BsCompressedAnimationCurvesRTTI.h"
+
+namespace bs
+{
+	/** Maximum value of a quantized position or scale component. */
+	static const float VECTOR_QUANT_MAX = 65535.0f;
+
+	/** Maximum value of a quantized rotation component. Top bit of a component is reserved for the omitted index. */
+	static const float ROTATION_QUANT_MAX = 32767.0f;
+
+	/** Largest value any of the three smallest components of a normalized quaternion can have. */
+	static const float ROTATION_COMPONENT_MAX = 0.70710678f;
+
+	/** Differences in curve values smaller than this are not considered changes. */
+	static const float CONSTANT_EPSILON = 1e-6f;
+
+	/** Quantizes a value in the [0, 1] range. */
+	static UINT16 quantize(float value, float quantMax)
+	{
+		return (UINT16)Math::roundToInt(Math::clamp01(value) * quantMax);
+	}
+
+	/** Quantizes a vector within the provided range and writes it to the frame. */
+	static void encodeVector(const Vector3& value, const Vector3& min, const Vector3& extent, UINT16* frame,
+		UINT32 numSlots, UINT32 slot)
+	{
+		for (UINT32 i = 0; i < 3; i++)
+		{
+			float normalized = extent[i] > 0.0f ? (value[i] - min[i]) / extent[i] : 0.0f;
+			frame[numSlots * i + slot] = quantize(normalized, VECTOR_QUANT_MAX);
+		}
+	}
+
+	/** Quantizes a rotation by storing its three smallest components, and writes it to the frame. */
+	static void encodeRotation(const Quaternion& value, UINT16* frame, UINT32 numSlots, UINT32 slot)
+	{
+		Quaternion rotation = Quaternion::normalize(value);
+
+		UINT32 largestIdx = 0;
+		for (UINT32 i = 1; i < 4; i++)
+		{
+			if (std::abs(rotation[i]) > std::abs(rotation[largestIdx]))
+				largestIdx = i;
+		}
+
+		// q and -q represent the same rotation, so make the omitted component positive to be able to restore it
+		if (rotation[largestIdx] < 0.0f)
+			rotation = -rotation;
+
+		UINT32 componentIdx = 0;
+		for (UINT32 i = 0; i < 4; i++)
+		{
+			if (i == largestIdx)
+				continue;
+
+			float normalized = (rotation[i] + ROTATION_COMPONENT_MAX) / (2.0f * ROTATION_COMPONENT_MAX);
+			frame[numSlots * componentIdx + slot] = quantize(normalized, ROTATION_QUANT_MAX);
+			componentIdx++;
+		}
+
+		// Store the index of the omitted component in the top bits of the first two components
+		frame[slot] |= (UINT16)((largestIdx >> 1) << 15);
+		frame[numSlots + slot] |= (UINT16)((largestIdx & 1) << 15);
+	}
+
+	/** Returns the angle between two rotations, in radians. */
+	static float getAngleBetween(const Quaternion& a, const Quaternion& b)
+	{
+		float dot = std::abs(Quaternion::normalize(a).dot(Quaternion::normalize(b)));
+		return 2.0f * Math::acos(std::min(dot, 1.0f)).valueRadians();
+	}
+
+	/** Calculates a range containing all the provided values. */
+	static void calcRange(const Vector<Vector3>& values, Vector3& min, Vector3& extent)
+	{
+		min = values[0];
+		Vector3 max = values[0];
+
+		for (auto& entry : values)
+		{
+			min = Vector3::min(min, entry);
+			max = Vector3::max(max, entry);
+		}
+
+		extent = max - min;
+		for (UINT32 i = 0; i < 3; i++)
+		{
+			if (extent[i] <= CONSTANT_EPSILON)
+				extent[i] = 0.0f;
+		}
+	}
+
+	void CompressedAnimationCurves::evaluate(float time, bool loop, Vector3* positions, Quaternion* rotations,
+		Vector3* scales) const
+	{
+		UINT32 frameIdxA, frameIdxB;
+		float t;
+		findFrames(time, loop, frameIdxA, frameIdxB, t);
+
+		const UINT16* frameA = getFrame(frameIdxA);
+		const UINT16* frameB = getFrame(frameIdxB);
+
+		// Interpolate directly between the quantized values, and scale to the curve range once
+		auto decodeVectors = [t](const UINT16* dataA, const UINT16* dataB, UINT32 numSlots, const Vector<UINT32>& slots,
+			const Vector<Vector3>& mins, const Vector<Vector3>& extents, Vector3* output)
+		{
+			UINT32 numCurves = (UINT32)slots.size();
+			for (UINT32 i = 0; i < numCurves; i++)
+			{
+				UINT32 slot = slots[i];
+				if (slot == (UINT32)-1)
+				{
+					output[i] = mins[i];
+					continue;
+				}
+
+				Vector3 normalized;
+				for (UINT32 j = 0; j < 3; j++)
+				{
+					UINT32 idx = numSlots * j + slot;
+					normalized[j] = (dataA[idx] + (dataB[idx] - (float)dataA[idx]) * t) * (1.0f / VECTOR_QUANT_MAX);
+				}
+
+				output[i] = mins[i] + normalized * extents[i];
+			}
+		};
+
+		decodeVectors(frameA, frameB, mNumAnimatedPositions, mPositionSlots, mPositionMin, mPositionExtent, positions);
+
+		const UINT16* rotationsA = frameA + mNumAnimatedPositions * 3;
+		const UINT16* rotationsB = frameB + mNumAnimatedPositions * 3;
+
+		UINT32 numRotationCurves = (UINT32)mRotationSlots.size();
+		for (UINT32 i = 0; i < numRotationCurves; i++)
+		{
+			UINT32 slot = mRotationSlots[i];
+			if (slot == (UINT32)-1)
+			{
+				rotations[i] = mRotationConstants[i];
+				continue;
+			}
+
+			Quaternion a = decodeRotation(rotationsA, mNumAnimatedRotations, slot);
+			Quaternion b = decodeRotation(rotationsB, mNumAnimatedRotations, slot);
+
+			rotations[i] = Quaternion::lerp(t, a, b);
+		}
+
+		const UINT16* scalesA = rotationsA + mNumAnimatedRotations * 3;
+		const UINT16* scalesB = rotationsB + mNumAnimatedRotations * 3;
+
+		decodeVectors(scalesA, scalesB, mNumAnimatedScales, mScaleSlots, mScaleMin, mScaleExtent, scales);
+	}
+
+	Vector3 CompressedAnimationCurves::evaluatePosition(UINT32 curveIdx, float time, bool loop) const
+	{
+		UINT32 slot = mPositionSlots[curveIdx];
+		if (slot == (UINT32)-1)
+			return mPositionMin[curveIdx];
+
+		UINT32 frameIdxA, frameIdxB;
+		float t;
+		findFrames(time, loop, frameIdxA, frameIdxB, t);
+
+		const Vector3& min = mPositionMin[curveIdx];
+		const Vector3& extent = mPositionExtent[curveIdx];
+
+		Vector3 a = decodeVector(getFrame(frameIdxA), mNumAnimatedPositions, slot, min, extent);
+		Vector3 b = decodeVector(getFrame(frameIdxB), mNumAnimatedPositions, slot, min, extent);
+
+		return Vector3::lerp(t, a, b);
+	}
+
+	Quaternion CompressedAnimationCurves::evaluateRotation(UINT32 curveIdx, float time, bool loop) const
+	{
+		UINT32 slot = mRotationSlots[curveIdx];
+		if (slot == (UINT32)-1)
+			return mRotationConstants[curveIdx];
+
+		UINT32 frameIdxA, frameIdxB;
+		float t;
+		findFrames(time, loop, frameIdxA, frameIdxB, t);
+
+		UINT32 offset = mNumAnimatedPositions * 3;
+		Quaternion a = decodeRotation(getFrame(frameIdxA) + offset, mNumAnimatedRotations, slot);
+		Quaternion b = decodeRotation(getFrame(frameIdxB) + offset, mNumAnimatedRotations, slot);
+
+		return Quaternion::lerp(t, a, b);
+	}
+
+	Vector3 CompressedAnimationCurves::evaluateScale(UINT32 curveIdx, float time, bool loop) const
+	{
+		UINT32 slot = mScaleSlots[curveIdx];
+		if (slot == (UINT32)-1)
+			return mScaleMin[curveIdx];
+
+		UINT32 frameIdxA, frameIdxB;
+		float t;
+		findFrames(time, loop, frameIdxA, frameIdxB, t);
+
+		const Vector3& min = mScaleMin[curveIdx];
+		const Vector3& extent = mScaleExtent[curveIdx];
+
+		UINT32 offset = (mNumAnimatedPositions + mNumAnimatedRotations) * 3;
+		Vector3 a = decodeVector(getFrame(frameIdxA) + offset, mNumAnimatedScales, slot, min, extent);
+		Vector3 b = decodeVector(getFrame(frameIdxB) + offset, mNumAnimatedScales, slot, min, extent);
+
+		return Vector3::lerp(t, a, b);
+	}
+
+	void CompressedAnimationCurves::findFrames(float time, bool loop, UINT32& frameA, UINT32& frameB, float& t) const
+	{
+		AnimationUtility::wrapTime(time, 0.0f, mLength, loop);
+
+		float frame = time * mSampleRate;
+		frameA = std::min((UINT32)std::max(Math::floorToInt(frame), 0), mNumFrames - 1);
+		frameB = std::min(frameA + 1, mNumFrames - 1);
+		t = Math::clamp01(frame - (float)frameA);
+	}
+
+	Vector3 CompressedAnimationCurves::decodeVector(const UINT16* frame, UINT32 numSlots, UINT32 slot,
+		const Vector3& min, const Vector3& extent) const
+	{
+		Vector3 normalized(
+			frame[slot] / VECTOR_QUANT_MAX,
+			frame[numSlots + slot] / VECTOR_QUANT_MAX,
+			frame[numSlots * 2 + slot] / VECTOR_QUANT_MAX);
+
+		return min + normalized * extent;
+	}
+
+	Quaternion CompressedAnimationCurves::decodeRotation(const UINT16* frame, UINT32 numSlots, UINT32 slot) const
+	{
+		UINT16 a = frame[slot];
+		UINT16 b = frame[numSlots + slot];
+		UINT16 c = frame[numSlots * 2 + slot];
+
+		UINT32 largestIdx = ((a >> 15) << 1) | (b >> 15);
+
+		float components[3];
+		components[0] = (a & 0x7FFF) / ROTATION_QUANT_MAX;
+		components[1] = (b & 0x7FFF) / ROTATION_QUANT_MAX;
+		components[2] = (c & 0x7FFF) / ROTATION_QUANT_MAX;
+
+		Quaternion output;
+		float sqrdSum = 0.0f;
+
+		UINT32 componentIdx = 0;
+		for (UINT32 i = 0; i < 4; i++)
+		{
+			if (i == largestIdx)
+				continue;
+
+			float value = (components[componentIdx] * 2.0f - 1.0f) * ROTATION_COMPONENT_MAX;
+			output[i] = value;
+			sqrdSum += value * value;
+
+			componentIdx++;
+		}
+
+		output[largestIdx] = std::sqrt(std::max(0.0f, 1.0f - sqrdSum));
+		return output;
+	}
+
+	UINT32 CompressedAnimationCurves::calcCompressedSize() const
+	{
+		UINT32 size = (UINT32)mFrameData.size() * sizeof(UINT16);
+		size += (UINT32)(mPositionSlots.size() + mRotationSlots.size() + mScaleSlots.size()) * sizeof(UINT32);
+		size += (UINT32)(mPositionMin.size() + mPositionExtent.size()) * sizeof(Vector3);
+		size += (UINT32)(mScaleMin.size() + mScaleExtent.size()) * sizeof(Vector3);
+		size += (UINT32)mRotationConstants.size() * sizeof(Quaternion);
+
+		return size;
+	}
+
+	void CompressedAnimationCurves::calcErrors(const AnimationCurves& curves)
+	{
+		mStats.maxPositionError = 0.0f;
+		mStats.maxRotationError = 0.0f;
+		mStats.maxScaleError = 0.0f;
+
+		// Check at every sample (quantization error) and halfway in between samples (resampling error)
+		UINT32 numChecks = mNumFrames * 2 - 1;
+		float checkInterval = mNumFrames > 1 ? mLength / (numChecks - 1) : 0.0f;
+
+		for (UINT32 i = 0; i < numChecks; i++)
+		{
+			float time = i * checkInterval;
+
+			for (UINT32 j = 0; j < (UINT32)curves.position.size(); j++)
+			{
+				Vector3 source = curves.position[j].curve.evaluate(time, false);
+				Vector3 compressed = evaluatePosition(j, time, false);
+
+				mStats.maxPositionError = std::max(mStats.maxPositionError, source.distance(compressed));
+			}
+
+			for (UINT32 j = 0; j < (UINT32)curves.rotation.size(); j++)
+			{
+				const TAnimationCurve<Quaternion>& curve = curves.rotation[j].curve;
+				if (curve.getNumKeyFrames() == 0)
+					continue;
+
+				Quaternion source = curve.evaluate(time, false);
+				Quaternion compressed = evaluateRotation(j, time, false);
+
+				mStats.maxRotationError = std::max(mStats.maxRotationError, getAngleBetween(source, compressed));
+			}
+
+			for (UINT32 j = 0; j < (UINT32)curves.scale.size(); j++)
+			{
+				Vector3 source = curves.scale[j].curve.evaluate(time, false);
+				Vector3 compressed = evaluateScale(j, time, false);
+
+				mStats.maxScaleError = std::max(mStats.maxScaleError, source.distance(compressed));
+			}
+		}
+	}
+
+	SPtr<CompressedAnimationCurves> CompressedAnimationCurves::create(const AnimationCurves& curves, UINT32 sampleRate)
+	{
+		SPtr<CompressedAnimationCurves> output = createEmpty();
+
+		float length = 0.0f;
+		UINT32 uncompressedSize = 0;
+		for (auto& entry : curves.position)
+		{
+			length = std::max(length, entry.curve.getLength());
+			uncompressedSize += entry.curve.getNumKeyFrames() * sizeof(TKeyframe<Vector3>);
+		}
+
+		for (auto& entry : curves.rotation)
+		{
+			length = std::max(length, entry.curve.getLength());
+			uncompressedSize += entry.curve.getNumKeyFrames() * sizeof(TKeyframe<Quaternion>);
+		}
+
+		for (auto& entry : curves.scale)
+		{
+			length = std::max(length, entry.curve.getLength());
+			uncompressedSize += entry.curve.getNumKeyFrames() * sizeof(TKeyframe<Vector3>);
+		}
+
+		// Samples are spread evenly so the last one falls exactly at the end of the clip
+		UINT32 numFrames = 1;
+		if (length > 0.0f)
+			numFrames = std::max(1, Math::ceilToInt(length * std::max(sampleRate, 1U))) + 1;
+
+		output->mLength = length;
+		output->mNumFrames = numFrames;
+		output->mSampleRate = numFrames > 1 ? (numFrames - 1) / length : 1.0f;
+
+		Vector<float> sampleTimes(numFrames);
+		for (UINT32 i = 0; i < numFrames; i++)
+			sampleTimes[i] = std::min(i / output->mSampleRate, length);
+
+		// Sample all the curves, and determine their ranges
+		auto sampleVectorCurves = [&](const Vector<TNamedAnimationCurve<Vector3>>& input, Vector<Vector<Vector3>>& samples,
+			Vector<UINT32>& slots, Vector<Vector3>& mins, Vector<Vector3>& extents, UINT32& numAnimated)
+		{
+			UINT32 numCurves = (UINT32)input.size();
+			samples.resize(numCurves);
+			slots.resize(numCurves);
+			mins.resize(numCurves);
+			extents.resize(numCurves);
+
+			numAnimated = 0;
+			for (UINT32 i = 0; i < numCurves; i++)
+			{
+				samples[i].resize(numFrames);
+				for (UINT32 j = 0; j < numFrames; j++)
+					samples[i][j] = input[i].curve.evaluate(sampleTimes[j], false);
+
+				calcRange(samples[i], mins[i], extents[i]);
+
+				if (extents[i] == Vector3::ZERO)
+					slots[i] = (UINT32)-1;
+				else
+					slots[i] = numAnimated++;
+			}
+		};
+
+		Vector<Vector<Vector3>> positionSamples;
+		sampleVectorCurves(curves.position, positionSamples, output->mPositionSlots, output->mPositionMin,
+			output->mPositionExtent, output->mNumAnimatedPositions);
+
+		Vector<Vector<Vector3>> scaleSamples;
+		sampleVectorCurves(curves.scale, scaleSamples, output->mScaleSlots, output->mScaleMin, output->mScaleExtent,
+			output->mNumAnimatedScales);
+
+		UINT32 numRotationCurves = (UINT32)curves.rotation.size();
+		Vector<Vector<Quaternion>> rotationSamples(numRotationCurves);
+		output->mRotationSlots.resize(numRotationCurves);
+		output->mRotationConstants.resize(numRotationCurves, Quaternion::ZERO);
+		output->mNumAnimatedRotations = 0;
+
+		for (UINT32 i = 0; i < numRotationCurves; i++)
+		{
+			const TAnimationCurve<Quaternion>& curve = curves.rotation[i].curve;
+
+			// Empty curves evaluate to zero, which can't be normalized. Keep it as is so blending treats it the same way.
+			if (curve.getNumKeyFrames() == 0)
+			{
+				output->mRotationSlots[i] = (UINT32)-1;
+				continue;
+			}
+
+			Vector<Quaternion>& samples = rotationSamples[i];
+			samples.resize(numFrames);
+
+			bool isConstant = true;
+			for (UINT32 j = 0; j < numFrames; j++)
+			{
+				samples[j] = Quaternion::normalize(curve.evaluate(sampleTimes[j], false));
+
+				if (std::abs(samples[j].dot(samples[0])) < 1.0f - CONSTANT_EPSILON)
+					isConstant = false;
+			}
+
+			if (isConstant)
+			{
+				output->mRotationSlots[i] = (UINT32)-1;
+				output->mRotationConstants[i] = samples[0];
+			}
+			else
+				output->mRotationSlots[i] = output->mNumAnimatedRotations++;
+		}
+
+		// Quantize the animated curves into per-frame blocks
+		UINT32 numAnimatedPositions = output->mNumAnimatedPositions;
+		UINT32 numAnimatedRotations = output->mNumAnimatedRotations;
+		UINT32 numAnimatedScales = output->mNumAnimatedScales;
+
+		output->mFrameStride = (numAnimatedPositions + numAnimatedRotations + numAnimatedScales) * 3;
+		output->mFrameData.resize(output->mFrameStride * numFrames, 0);
+
+		for (UINT32 i = 0; i < numFrames; i++)
+		{
+			UINT16* positionData = output->mFrameData.data() + i * output->mFrameStride;
+			UINT16* rotationData = positionData + numAnimatedPositions * 3;
+			UINT16* scaleData = rotationData + numAnimatedRotations * 3;
+
+			for (UINT32 j = 0; j < (UINT32)output->mPositionSlots.size(); j++)
+			{
+				UINT32 slot = output->mPositionSlots[j];
+				if (slot != (UINT32)-1)
+				{
+					encodeVector(positionSamples[j][i], output->mPositionMin[j], output->mPositionExtent[j], positionData,
+						numAnimatedPositions, slot);
+				}
+			}
+
+			for (UINT32 j = 0; j < numRotationCurves; j++)
+			{
+				UINT32 slot = output->mRotationSlots[j];
+				if (slot != (UINT32)-1)
+					encodeRotation(rotationSamples[j][i], rotationData, numAnimatedRotations, slot);
+			}
+
+			for (UINT32 j = 0; j < (UINT32)output->mScaleSlots.size(); j++)
+			{
+				UINT32 slot = output->mScaleSlots[j];
+				if (slot != (UINT32)-1)
+				{
+					encodeVector(scaleSamples[j][i], output->mScaleMin[j], output->mScaleExtent[j], scaleData,
+						numAnimatedScales, slot);
+				}
+			}
+		}
+
+		output->mStats.uncompressedSize = uncompressedSize;
+		output->mStats.compressedSize = output->calcCompressedSize();
+		output->calcErrors(curves);
+
+		return output;
+	}
+
+	SPtr<CompressedAnimationCurves> CompressedAnimationCurves::createEmpty()
+	{
+		CompressedAnimationCurves* rawPtr = new (bs_alloc<CompressedAnimationCurves>()) CompressedAnimationCurves();
+
+		return bs_shared_ptr<CompressedAnimationCurves>(rawPtr);
+	}
+
+	RTTITypeBase* CompressedAnimationCurves::getRTTIStatic()
+	{
+		return CompressedAnimationCurvesRTTI::instance();
+	}
+
+	RTTITypeBase* CompressedAnimationCurves::getRTTI() const
+	{
+		return getRTTIStatic();
+	}
+}
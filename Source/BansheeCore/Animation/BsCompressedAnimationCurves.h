@@ -0,0 +1,163 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Reflection/BsIReflectable.h"
+#include "Math/BsVector3.h"
+#include "Math/BsQuaternion.h"
+
+namespace bs
+{
+	struct AnimationCurves;
+
+	/** @addtogroup Animation
+	 *  @{
+	 */
+
+	/** Information about the size and precision of a compressed animation clip. */
+	struct AnimationCompressionStats
+	{
+		/** Size of the position, rotation and scale keyframes before compression, in bytes. */
+		UINT32 uncompressedSize = 0;
+
+		/** Size of the compressed position, rotation and scale data, in bytes. */
+		UINT32 compressedSize = 0;
+
+		/** Maximum distance between a compressed and a source position, measured at and in between the samples. */
+		float maxPositionError = 0.0f;
+
+		/** Maximum angle between a compressed and a source rotation, in radians, measured at and in between the samples. */
+		float maxRotationError = 0.0f;
+
+		/** Maximum distance between a compressed and a source scale, measured at and in between the samples. */
+		float maxScaleError = 0.0f;
+	};
+
+	/** @} */
+
+	/** @addtogroup Animation-Internal
+	 *  @{
+	 */
+
+	/**
+	 * Lossy representation of the position, rotation and scale curves of an animation clip. Curves are uniformly sampled
+	 * and quantized to 16 bits per component. Positions and scales are quantized within the value range of their curve,
+	 * and rotations are stored using the three smallest quaternion components. Curves that don't change over the length
+	 * of the clip are stored as a single value.
+	 *
+	 * Sampled values are stored in one block per frame, so all curves of a single frame can be decoded from contiguous
+	 * memory. Within a block values are split by component, so all X components of all position curves come first,
+	 * followed by all Y components, and so on.
+	 *
+	 * @note	Immutable after creation so it may be used on multiple threads.
+	 */
+	class BS_CORE_EXPORT CompressedAnimationCurves : public IReflectable
+	{
+	public:
+		/**
+		 * Evaluates all curves at the specified time. Output arrays must be large enough to store a value for each
+		 * position, rotation and scale curve.
+		 */
+		void evaluate(float time, bool loop, Vector3* positions, Quaternion* rotations, Vector3* scales) const;
+
+		/** Evaluates a single position curve at the specified time. */
+		Vector3 evaluatePosition(UINT32 curveIdx, float time, bool loop) const;
+
+		/** Evaluates a single rotation curve at the specified time. */
+		Quaternion evaluateRotation(UINT32 curveIdx, float time, bool loop) const;
+
+		/** Evaluates a single scale curve at the specified time. */
+		Vector3 evaluateScale(UINT32 curveIdx, float time, bool loop) const;
+
+		/** Returns the number of position curves. */
+		UINT32 getNumPositionCurves() const { return (UINT32)mPositionSlots.size(); }
+
+		/** Returns the number of rotation curves. */
+		UINT32 getNumRotationCurves() const { return (UINT32)mRotationSlots.size(); }
+
+		/** Returns the number of scale curves. */
+		UINT32 getNumScaleCurves() const { return (UINT32)mScaleSlots.size(); }
+
+		/** Returns the length of the compressed data, in seconds. */
+		float getLength() const { return mLength; }
+
+		/** Returns information about the size and precision of the compressed data. */
+		const AnimationCompressionStats& getStats() const { return mStats; }
+
+		/**
+		 * Compresses the position, rotation and scale curves from the provided curve set.
+		 *
+		 * @param[in]	curves		Curves to compress. Generic curves are ignored.
+		 * @param[in]	sampleRate	Number of samples per second to sample the curves with.
+		 */
+		static SPtr<CompressedAnimationCurves> create(const AnimationCurves& curves, UINT32 sampleRate);
+
+	private:
+		CompressedAnimationCurves() = default;
+
+		/** Wraps or clamps time and finds the two frames to interpolate between, as well as the interpolation factor. */
+		void findFrames(float time, bool loop, UINT32& frameA, UINT32& frameB, float& t) const;
+
+		/** Decodes a quantized vector from the provided frame. */
+		Vector3 decodeVector(const UINT16* frame, UINT32 numSlots, UINT32 slot, const Vector3& min,
+			const Vector3& extent) const;
+
+		/** Decodes a quantized rotation from the provided frame. */
+		Quaternion decodeRotation(const UINT16* frame, UINT32 numSlots, UINT32 slot) const;
+
+		/** Returns the start of the stored data for the provided frame. */
+		const UINT16* getFrame(UINT32 frame) const { return mFrameData.data() + frame * mFrameStride; }
+
+		/** Calculates the size of the compressed data, in bytes. */
+		UINT32 calcCompressedSize() const;
+
+		/** Calculates the compression errors by comparing the compressed data against the source curves. */
+		void calcErrors(const AnimationCurves& curves);
+
+		float mSampleRate = 1.0f;
+		float mLength = 0.0f;
+		UINT32 mNumFrames = 0;
+		UINT32 mFrameStride = 0;
+
+		UINT32 mNumAnimatedPositions = 0;
+		UINT32 mNumAnimatedRotations = 0;
+		UINT32 mNumAnimatedScales = 0;
+
+		/** Per-curve index of the curve's values within a frame, or -1 if the curve is constant. */
+		Vector<UINT32> mPositionSlots;
+		Vector<UINT32> mRotationSlots;
+		Vector<UINT32> mScaleSlots;
+
+		/** Per-curve quantization range. For constant curves the minimum holds the value and extent is zero. */
+		Vector<Vector3> mPositionMin;
+		Vector<Vector3> mPositionExtent;
+		Vector<Vector3> mScaleMin;
+		Vector<Vector3> mScaleExtent;
+
+		/** Per-curve value of rotation curves that are constant. */
+		Vector<Quaternion> mRotationConstants;
+
+		/** Quantized values of animated curves, one block of mFrameStride values per frame. */
+		Vector<UINT16> mFrameData;
+
+		AnimationCompressionStats mStats;
+
+		/************************************************************************/
+		/* 								SERIALIZATION                      		*/
+		/************************************************************************/
+	public:
+		friend class CompressedAnimationCurvesRTTI;
+		static RTTITypeBase* getRTTIStatic();
+		RTTITypeBase* getRTTI() const override;
+
+		/**
+		 * Creates CompressedAnimationCurves with no data. You must populate its data manually.
+		 *
+		 * @note	For serialization use only.
+		 */
+		static SPtr<CompressedAnimationCurves> createEmpty();
+	};
+
+	/** @} */
+}
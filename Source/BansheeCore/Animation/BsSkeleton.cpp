@@ -3,6 +3,7 @@
 #include "Animation/BsSkeleton.h"
 #include "Animation/BsAnimationClip.h"
 #include "Animation/BsSkeletonMask.h"
+#include "Math/BsSIMD.h"
 #include "RTTI/BsSkeletonRTTI.h"
 
 namespace bs
@@ -84,6 +85,237 @@ namespace bs
 		return *this;
 	}
 
+	/** Adds @p values multiplied by @p weight to @p output. */
+	static void blendPositions(Vector3* output, const Vector3* values, float weight, UINT32 count)
+	{
+		// Vectors are tightly packed, so they can be processed as a flat array of floats
+		static_assert(sizeof(Vector3) == sizeof(float) * 3, "Vector3 must be tightly packed.");
+
+		float* dst = &output[0].x;
+		const float* src = &values[0].x;
+		UINT32 numFloats = count * 3;
+
+		SIMDFloat4 simdWeight = SIMD::splat(weight);
+
+		UINT32 i = 0;
+		for (; i + 4 <= numFloats; i += 4)
+			SIMD::store(dst + i, SIMD::madd(SIMD::load(dst + i), SIMD::load(src + i), simdWeight));
+
+		for (; i < numFloats; i++)
+			dst[i] += src[i] * weight;
+	}
+
+	/** Multiplies @p output with @p factors, component-wise. */
+	static void blendScales(Vector3* output, const Vector3* factors, UINT32 count)
+	{
+		float* dst = &output[0].x;
+		const float* src = &factors[0].x;
+		UINT32 numFloats = count * 3;
+
+		UINT32 i = 0;
+		for (; i + 4 <= numFloats; i += 4)
+			SIMD::store(dst + i, SIMD::mul(SIMD::load(dst + i), SIMD::load(src + i)));
+
+		for (; i < numFloats; i++)
+			dst[i] *= src[i];
+	}
+
+	/** Loads four rotations and transposes them so each output value contains a single component of all four. */
+	static void loadRotations(const Quaternion* a, const Quaternion* b, const Quaternion* c, const Quaternion* d,
+		SIMDFloat4& x, SIMDFloat4& y, SIMDFloat4& z, SIMDFloat4& w)
+	{
+		x = SIMD::load(&a->x);
+		y = SIMD::load(&b->x);
+		z = SIMD::load(&c->x);
+		w = SIMD::load(&d->x);
+
+		SIMD::transpose(x, y, z, w);
+	}
+
+	/** Inverse of loadRotations(). */
+	static void storeRotations(Quaternion* a, Quaternion* b, Quaternion* c, Quaternion* d,
+		SIMDFloat4 x, SIMDFloat4 y, SIMDFloat4 z, SIMDFloat4 w)
+	{
+		SIMD::transpose(x, y, z, w);
+
+		SIMD::store(&a->x, x);
+		SIMD::store(&b->x, y);
+		SIMD::store(&c->x, z);
+		SIMD::store(&d->x, w);
+	}
+
+	/**
+	 * Adds weighted rotations in @p values to the rotations of bones at @p indices in @p output. Rotations are negated
+	 * where required so they are added along the shortest path.
+	 */
+	static void blendRotations(Quaternion* output, const UINT32* indices, const Quaternion* values, float weight,
+		UINT32 count)
+	{
+		static_assert(sizeof(Quaternion) == sizeof(float) * 4, "Quaternion must be tightly packed.");
+
+		SIMDFloat4 simdWeight = SIMD::splat(weight);
+		SIMDFloat4 zero = SIMD::zero();
+
+		UINT32 i = 0;
+		for (; i + 4 <= count; i += 4)
+		{
+			Quaternion* o0 = &output[indices[i + 0]];
+			Quaternion* o1 = &output[indices[i + 1]];
+			Quaternion* o2 = &output[indices[i + 2]];
+			Quaternion* o3 = &output[indices[i + 3]];
+
+			SIMDFloat4 ox, oy, oz, ow;
+			loadRotations(o0, o1, o2, o3, ox, oy, oz, ow);
+
+			SIMDFloat4 vx, vy, vz, vw;
+			loadRotations(&values[i + 0], &values[i + 1], &values[i + 2], &values[i + 3], vx, vy, vz, vw);
+
+			SIMDFloat4 dot = SIMD::mul(ox, vx);
+			dot = SIMD::madd(dot, oy, vy);
+			dot = SIMD::madd(dot, oz, vz);
+			dot = SIMD::madd(dot, ow, vw);
+
+			// Adding zero turns -0 into +0, so only a strictly negative dot product flips the rotation
+			SIMDFloat4 factor = SIMD::flipSign(simdWeight, SIMD::add(dot, zero));
+
+			ox = SIMD::madd(ox, vx, factor);
+			oy = SIMD::madd(oy, vy, factor);
+			oz = SIMD::madd(oz, vz, factor);
+			ow = SIMD::madd(ow, vw, factor);
+
+			storeRotations(o0, o1, o2, o3, ox, oy, oz, ow);
+		}
+
+		for (; i < count; i++)
+		{
+			Quaternion& rotation = output[indices[i]];
+			Quaternion value = values[i] * weight;
+
+			if (value.dot(rotation) < 0.0f)
+				value = -value;
+
+			rotation += value;
+		}
+	}
+
+	/**
+	 * Applies rotations in @p values on top of the rotations of bones at @p indices in @p output. Each rotation is first
+	 * interpolated from identity using @p weight.
+	 */
+	static void blendRotationsAdditive(Quaternion* output, const UINT32* indices, const Quaternion* values, float weight,
+		UINT32 count)
+	{
+		SIMDFloat4 simdWeight = SIMD::splat(weight);
+		SIMDFloat4 simdInvWeight = SIMD::splat(1.0f - weight);
+		SIMDFloat4 zero = SIMD::zero();
+		SIMDFloat4 one = SIMD::splat(1.0f);
+
+		UINT32 i = 0;
+		for (; i + 4 <= count; i += 4)
+		{
+			Quaternion* o[4];
+			for (UINT32 j = 0; j < 4; j++)
+			{
+				o[j] = &output[indices[i + j]];
+
+				bool isAssigned = o[j]->w != 0.0f;
+				if (!isAssigned)
+					*o[j] = Quaternion::IDENTITY;
+			}
+
+			SIMDFloat4 ox, oy, oz, ow;
+			loadRotations(o[0], o[1], o[2], o[3], ox, oy, oz, ow);
+
+			SIMDFloat4 vx, vy, vz, vw;
+			loadRotations(&values[i + 0], &values[i + 1], &values[i + 2], &values[i + 3], vx, vy, vz, vw);
+
+			// Quaternion::lerp(weight, IDENTITY, value). Dot product with identity is just the w component.
+			SIMDFloat4 lx = SIMD::mul(vx, simdWeight);
+			SIMDFloat4 ly = SIMD::mul(vy, simdWeight);
+			SIMDFloat4 lz = SIMD::mul(vz, simdWeight);
+			SIMDFloat4 lw = SIMD::madd(SIMD::flipSign(simdInvWeight, SIMD::add(vw, zero)), vw, simdWeight);
+
+			SIMDFloat4 lenSqrd = SIMD::mul(lx, lx);
+			lenSqrd = SIMD::madd(lenSqrd, ly, ly);
+			lenSqrd = SIMD::madd(lenSqrd, lz, lz);
+			lenSqrd = SIMD::madd(lenSqrd, lw, lw);
+
+			SIMDFloat4 invLength = SIMD::div(one, SIMD::sqrt(lenSqrd));
+			lx = SIMD::mul(lx, invLength);
+			ly = SIMD::mul(ly, invLength);
+			lz = SIMD::mul(lz, invLength);
+			lw = SIMD::mul(lw, invLength);
+
+			// output * value
+			SIMDFloat4 nx = SIMD::mul(ow, lx);
+			nx = SIMD::madd(nx, ox, lw);
+			nx = SIMD::madd(nx, oy, lz);
+			nx = SIMD::sub(nx, SIMD::mul(oz, ly));
+
+			SIMDFloat4 ny = SIMD::mul(ow, ly);
+			ny = SIMD::madd(ny, oy, lw);
+			ny = SIMD::madd(ny, oz, lx);
+			ny = SIMD::sub(ny, SIMD::mul(ox, lz));
+
+			SIMDFloat4 nz = SIMD::mul(ow, lz);
+			nz = SIMD::madd(nz, oz, lw);
+			nz = SIMD::madd(nz, ox, ly);
+			nz = SIMD::sub(nz, SIMD::mul(oy, lx));
+
+			SIMDFloat4 nw = SIMD::mul(ow, lw);
+			nw = SIMD::sub(nw, SIMD::mul(ox, lx));
+			nw = SIMD::sub(nw, SIMD::mul(oy, ly));
+			nw = SIMD::sub(nw, SIMD::mul(oz, lz));
+
+			storeRotations(o[0], o[1], o[2], o[3], nx, ny, nz, nw);
+		}
+
+		for (; i < count; i++)
+		{
+			Quaternion& rotation = output[indices[i]];
+
+			bool isAssigned = rotation.w != 0.0f;
+			if (!isAssigned)
+				rotation = Quaternion::IDENTITY;
+
+			rotation *= Quaternion::lerp(weight, Quaternion::IDENTITY, values[i]);
+		}
+	}
+
+	/** Normalizes all rotations in the provided array. Rotations that were never assigned are set to identity. */
+	static void normalizeRotations(Quaternion* rotations, UINT32 count)
+	{
+		for (UINT32 i = 0; i < count; i++)
+		{
+			bool isAssigned = rotations[i].w != 0.0f;
+			if (!isAssigned)
+				rotations[i] = Quaternion::IDENTITY;
+		}
+
+		SIMDFloat4 one = SIMD::splat(1.0f);
+
+		UINT32 i = 0;
+		for (; i + 4 <= count; i += 4)
+		{
+			Quaternion* r = &rotations[i];
+
+			SIMDFloat4 x, y, z, w;
+			loadRotations(r + 0, r + 1, r + 2, r + 3, x, y, z, w);
+
+			SIMDFloat4 lenSqrd = SIMD::mul(w, w);
+			lenSqrd = SIMD::madd(lenSqrd, x, x);
+			lenSqrd = SIMD::madd(lenSqrd, y, y);
+			lenSqrd = SIMD::madd(lenSqrd, z, z);
+
+			SIMDFloat4 invLength = SIMD::div(one, SIMD::sqrt(lenSqrd));
+			storeRotations(r + 0, r + 1, r + 2, r + 3, SIMD::mul(x, invLength), SIMD::mul(y, invLength),
+				SIMD::mul(z, invLength), SIMD::mul(w, invLength));
+		}
+
+		for (; i < count; i++)
+			rotations[i].normalize();
+	}
+
 	Skeleton::Skeleton()
 		: mNumBones(0), mInvBindPoses(nullptr), mBoneInfo(nullptr)
 	{ }
@@ -97,6 +329,8 @@ namespace bs
 			mBoneInfo[i].name = bones[i].name;
 			mBoneInfo[i].parent = bones[i].parent;
 		}
+
+		initialize();
 	}
 
 	Skeleton::~Skeleton()
@@ -124,6 +358,7 @@ namespace bs
 
 			AnimationState state;
 			state.curves = clip.getCurves();
+			state.compressedCurves = clip._getCompressedCurves();
 			state.boneToCurveMapping = boneToCurveMapping.data();
 			state.loop = loop;
 			state.weight = 1.0f;
@@ -152,11 +387,16 @@ namespace bs
 		bs_frame_clear();
 	}
 
-	void Skeleton::getPose(Matrix4* pose, LocalSkeletonPose& localPose, const SkeletonMask& mask, 
+	void Skeleton::getPose(Matrix4* pose, LocalSkeletonPose& localPose, const SkeletonMask& mask,
 		const AnimationStateLayer* layers, UINT32 numLayers)
 	{
-		// Note: If more performance is required this method could be optimized with vector instructions
+		getLocalPose(localPose, mask, layers, numLayers);
+		getPose(pose, localPose);
+	}
 
+	void Skeleton::getLocalPose(LocalSkeletonPose& localPose, const SkeletonMask& mask, const AnimationStateLayer* layers,
+		UINT32 numLayers)
+	{
 		assert(localPose.numBones == mNumBones);
 
 		for(UINT32 i = 0; i < mNumBones; i++)
@@ -166,9 +406,28 @@ namespace bs
 			localPose.scales[i] = Vector3::ONE;
 		}
 
-		// Note: For a possible performance improvement consider keeping an array of only active (non-disabled) bones and
-		// just iterate over them without mask checks. Possibly also a list of active curve mappings to avoid those checks
-		// as well.
+		// Positions and scales of a single state are evaluated into arrays indexed by bone, so they can be blended with
+		// the pose as a whole. Bones without a curve keep neutral values (zero offset, unit scale). Rotations are kept in
+		// a packed list instead, since bones without a rotation curve must be left untouched.
+		UINT32 bufferSize = (sizeof(Vector3) * 2 + sizeof(Quaternion) + sizeof(UINT32) * 2) * mNumBones;
+		UINT8* buffer = (UINT8*)bs_stack_alloc(bufferSize);
+
+		Vector3* statePositions = (Vector3*)buffer;
+		Vector3* stateScales = statePositions + mNumBones;
+		Quaternion* stateRotations = (Quaternion*)(stateScales + mNumBones);
+		UINT32* rotationBones = (UINT32*)(stateRotations + mNumBones);
+		UINT32* activeBones = rotationBones + mNumBones;
+
+		UINT32 numActiveBones = 0;
+		for (UINT32 i = 0; i < mNumBones; i++)
+		{
+			statePositions[i] = Vector3::ZERO;
+			stateScales[i] = Vector3::ONE;
+
+			if (mask.isEnabled(i))
+				activeBones[numActiveBones++] = i;
+		}
+
 		for(UINT32 i = 0; i < numLayers; i++)
 		{
 			const AnimationStateLayer& layer = layers[i];
@@ -197,139 +456,179 @@ namespace bs
 				if (Math::approxEquals(normWeight, 0.0f))
 					continue;
 
-				for (UINT32 k = 0; k < mNumBones; k++)
+				// Compressed curves are decoded all at once, as values for all curves of a frame are stored together
+				UINT8* decodedBuffer = nullptr;
+				Vector3* decodedPositions = nullptr;
+				Quaternion* decodedRotations = nullptr;
+				Vector3* decodedScales = nullptr;
+				if (state.compressedCurves != nullptr)
 				{
-					if (!mask.isEnabled(k))
-						continue;
+					const CompressedAnimationCurves& compressed = *state.compressedCurves;
+					UINT32 numPositions = compressed.getNumPositionCurves();
+					UINT32 numRotations = compressed.getNumRotationCurves();
+					UINT32 numScales = compressed.getNumScaleCurves();
 
-					const AnimationCurveMapping& mapping = state.boneToCurveMapping[k];
-					UINT32 curveIdx = mapping.position;
-					if (curveIdx != (UINT32)-1)
-					{
-						const TAnimationCurve<Vector3>& curve = state.curves->position[curveIdx].curve;
-						localPose.positions[k] += curve.evaluate(state.time, state.positionCaches[curveIdx], state.loop) * normWeight;
+					decodedBuffer = (UINT8*)bs_stack_alloc(sizeof(Vector3) * (numPositions + numScales) +
+						sizeof(Quaternion) * numRotations);
 
-						localPose.hasOverride[k] = false;
-					}
+					decodedPositions = (Vector3*)decodedBuffer;
+					decodedRotations = (Quaternion*)(decodedPositions + numPositions);
+					decodedScales = (Vector3*)(decodedRotations + numRotations);
+
+					compressed.evaluate(state.time, state.loop, decodedPositions, decodedRotations, decodedScales);
 				}
 
-				for (UINT32 k = 0; k < mNumBones; k++)
+				bool hasPositions = false;
+				bool hasScales = false;
+				UINT32 numRotations = 0;
+				for (UINT32 k = 0; k < numActiveBones; k++)
 				{
-					if (!mask.isEnabled(k))
-						continue;
+					UINT32 boneIdx = activeBones[k];
+					const AnimationCurveMapping& mapping = state.boneToCurveMapping[boneIdx];
 
-					const AnimationCurveMapping& mapping = state.boneToCurveMapping[k];
-					UINT32 curveIdx = mapping.scale;
+					UINT32 curveIdx = mapping.position;
 					if (curveIdx != (UINT32)-1)
 					{
-						const TAnimationCurve<Vector3>& curve = state.curves->scale[curveIdx].curve;
-						localPose.scales[k] *= curve.evaluate(state.time, state.scaleCaches[curveIdx], state.loop) * normWeight;
+						if (decodedPositions != nullptr)
+							statePositions[boneIdx] = decodedPositions[curveIdx];
+						else
+						{
+							const TAnimationCurve<Vector3>& curve = state.curves->position[curveIdx].curve;
+							statePositions[boneIdx] = curve.evaluate(state.time, state.positionCaches[curveIdx], state.loop);
+						}
 
-						localPose.hasOverride[k] = false;
+						localPose.hasOverride[boneIdx] = false;
+						hasPositions = true;
 					}
-				}
+					else
+						statePositions[boneIdx] = Vector3::ZERO;
 
-				if(layer.additive)
-				{
-					for (UINT32 k = 0; k < mNumBones; k++)
+					curveIdx = mapping.scale;
+					if (curveIdx != (UINT32)-1)
 					{
-						if (!mask.isEnabled(k))
-							continue;
-
-						const AnimationCurveMapping& mapping = state.boneToCurveMapping[k];
-						UINT32 curveIdx = mapping.rotation;
-						if (curveIdx != (UINT32)-1)
+						Vector3 value;
+						if (decodedScales != nullptr)
+							value = decodedScales[curveIdx];
+						else
 						{
-							bool isAssigned = localPose.rotations[k].w != 0.0f;
-							if (!isAssigned)
-								localPose.rotations[k] = Quaternion::IDENTITY;
-
-							const TAnimationCurve<Quaternion>& curve = state.curves->rotation[curveIdx].curve;
+							const TAnimationCurve<Vector3>& curve = state.curves->scale[curveIdx].curve;
+							value = curve.evaluate(state.time, state.scaleCaches[curveIdx], state.loop);
+						}
 
-							Quaternion value = curve.evaluate(state.time, state.rotationCaches[curveIdx], state.loop);
-							value = Quaternion::lerp(normWeight, Quaternion::IDENTITY, value);
+						stateScales[boneIdx] = value * normWeight;
 
-							localPose.rotations[k] *= value;
-							localPose.hasOverride[k] = false;
-						}
+						localPose.hasOverride[boneIdx] = false;
+						hasScales = true;
 					}
-				}
-				else
-				{
-					for (UINT32 k = 0; k < mNumBones; k++)
-					{
-						if (!mask.isEnabled(k))
-							continue;
+					else
+						stateScales[boneIdx] = Vector3::ONE;
 
-						const AnimationCurveMapping& mapping = state.boneToCurveMapping[k];
-						UINT32 curveIdx = mapping.rotation;
-						if (curveIdx != (UINT32)-1)
+					curveIdx = mapping.rotation;
+					if (curveIdx != (UINT32)-1)
+					{
+						if (decodedRotations != nullptr)
+							stateRotations[numRotations] = decodedRotations[curveIdx];
+						else
 						{
 							const TAnimationCurve<Quaternion>& curve = state.curves->rotation[curveIdx].curve;
-							Quaternion value = curve.evaluate(state.time, state.rotationCaches[curveIdx], state.loop) * normWeight;
-
-							if (value.dot(localPose.rotations[k]) < 0.0f)
-								value = -value;
-							
-							localPose.rotations[k] += value;
-							localPose.hasOverride[k] = false;
+							stateRotations[numRotations] = curve.evaluate(state.time, state.rotationCaches[curveIdx],
+								state.loop);
 						}
+
+						rotationBones[numRotations++] = boneIdx;
+						localPose.hasOverride[boneIdx] = false;
 					}
 				}
+
+				if (decodedBuffer != nullptr)
+					bs_stack_free(decodedBuffer);
+
+				if (hasPositions)
+					blendPositions(localPose.positions, statePositions, normWeight, mNumBones);
+
+				if (hasScales)
+					blendScales(localPose.scales, stateScales, mNumBones);
+
+				if (layer.additive)
+					blendRotationsAdditive(localPose.rotations, rotationBones, stateRotations, normWeight, numRotations);
+				else
+					blendRotations(localPose.rotations, rotationBones, stateRotations, normWeight, numRotations);
 			}
 		}
 
-		// Calculate local pose matrices
-		UINT32 isGlobalBytes = sizeof(bool) * mNumBones;
-		bool* isGlobal = (bool*)bs_stack_alloc(isGlobalBytes);
-		memset(isGlobal, 0, isGlobalBytes);
+		bs_stack_free(buffer);
+
+		normalizeRotations(localPose.rotations, mNumBones);
+	}
+
+	void Skeleton::getPose(Matrix4* pose, const LocalSkeletonPose& localPose) const
+	{
+		assert(localPose.numBones == mNumBones);
 
+		// Calculate local pose matrices
 		for(UINT32 i = 0; i < mNumBones; i++)
 		{
-			bool isAssigned = localPose.rotations[i].w != 0.0f;
-			if (!isAssigned)
-				localPose.rotations[i] = Quaternion::IDENTITY;
-			else
-				localPose.rotations[i].normalize();
-
 			if (localPose.hasOverride[i])
-			{
-				isGlobal[i] = true;
 				continue;
-			}
 
 			pose[i] = Matrix4::TRS(localPose.positions[i], localPose.rotations[i], localPose.scales[i]);
 		}
 
-		// Calculate global poses
-		// Note: For a possible performance improvement consider sorting bones in such order so that parents (and overrides)
-		// always come before children, we no isGlobal check is needed.
-		std::function<void(UINT32)> calcGlobal = [&](UINT32 boneIdx)
+		// Calculate global poses. Parents always come before their children in the evaluation order, so the parent
+		// transform is already global when the child is reached. Overriden bones are already in global space.
+		for (auto& boneIdx : mEvaluationOrder)
 		{
 			UINT32 parentBoneIdx = mBoneInfo[boneIdx].parent;
-			if (parentBoneIdx == (UINT32)-1)
-			{
-				isGlobal[boneIdx] = true;
-				return;
-			}
+			if (parentBoneIdx == (UINT32)-1 || localPose.hasOverride[boneIdx])
+				continue;
 
-			if (!isGlobal[parentBoneIdx])
-				calcGlobal(parentBoneIdx);
+			pose[boneIdx] = pose[parentBoneIdx].concatenateAffine(pose[boneIdx]);
+		}
 
-			pose[boneIdx] = pose[parentBoneIdx] * pose[boneIdx];
-			isGlobal[boneIdx] = true;
-		};
+		for (UINT32 i = 0; i < mNumBones; i++)
+			pose[i] = pose[i] * mInvBindPoses[i];
+	}
 
+	void Skeleton::initialize()
+	{
+		// Local bind pose, calculated from the inverse bind poses of the bone and its parent
+		mLocalBindPose = LocalSkeletonPose(mNumBones);
 		for (UINT32 i = 0; i < mNumBones; i++)
 		{
-			if (!isGlobal[i])
-				calcGlobal(i);
+			Matrix4 bindPose = mInvBindPoses[i].inverseAffine();
+
+			UINT32 parentBoneIdx = mBoneInfo[i].parent;
+			if (parentBoneIdx != (UINT32)-1)
+				bindPose = mInvBindPoses[parentBoneIdx] * bindPose;
+
+			bindPose.decomposition(mLocalBindPose.positions[i], mLocalBindPose.rotations[i], mLocalBindPose.scales[i]);
+			mLocalBindPose.hasOverride[i] = false;
 		}
 
+		// Evaluation order
+		mEvaluationOrder.clear();
+		mEvaluationOrder.reserve(mNumBones);
+
+		Vector<bool> isAdded(mNumBones, false);
+		Vector<UINT32> chain;
 		for (UINT32 i = 0; i < mNumBones; i++)
-			pose[i] = pose[i] * mInvBindPoses[i];
+		{
+			// Walk up to the first ancestor already in the list, then add the chain in parent-first order
+			UINT32 boneIdx = i;
+			while (boneIdx != (UINT32)-1 && !isAdded[boneIdx])
+			{
+				chain.push_back(boneIdx);
+				boneIdx = mBoneInfo[boneIdx].parent;
+			}
 
-		bs_stack_free(isGlobal);
+			for (auto iter = chain.rbegin(); iter != chain.rend(); ++iter)
+			{
+				mEvaluationOrder.push_back(*iter);
+				isAdded[*iter] = true;
+			}
+
+			chain.clear();
+		}
 	}
 
 	UINT32 Skeleton::getRootBoneIndex() const
@@ -12,6 +12,7 @@
 namespace bs
 {
 	class SkeletonMask;
+	class CompressedAnimationCurves;
 
 	/** @addtogroup Animation-Internal
 	 *  @{
@@ -41,6 +42,7 @@ namespace bs
 	struct AnimationState
 	{
 		SPtr<AnimationCurves> curves; /**< All curves in the animation clip. */
+		SPtr<CompressedAnimationCurves> compressedCurves; /**< Compressed bone curves, if the clip is compressed. */
 		AnimationCurveMapping* boneToCurveMapping; /**< Mapping of bone indices to curve indices for quick lookup .*/
 		AnimationCurveMapping* soToCurveMapping; /**< Mapping of scene object indices to curve indices for quick lookup. */
 
@@ -150,6 +152,29 @@ namespace bs
 		void getPose(Matrix4* pose, LocalSkeletonPose& localPose, const SkeletonMask& mask, 
 			const AnimationStateLayer* layers, UINT32 numLayers);
 
+		/** 
+		 * Outputs local transforms of all bones, as specified by the provided set of animation curves.
+		 *
+		 * @param[out]	localPose	Output pose containing the local transforms. Must be pre-allocated with enough space
+		 *							to hold all the bone data of this skeleton.
+		 * @param[in]	mask		Mask that filters which skeleton bones are enabled or disabled.
+		 * @param[in]	layers		One or multiple layers, containing one or multiple animation states to evaluate.
+		 * @param[in]	numLayers	Number of layers in the @p layers array.
+		 */
+		void getLocalPose(LocalSkeletonPose& localPose, const SkeletonMask& mask, const AnimationStateLayer* layers, 
+			UINT32 numLayers);
+
+		/** 
+		 * Outputs a skeleton pose containing required transforms for transforming the skeleton to the provided local
+		 * transforms.
+		 *
+		 * @param[in, out]	pose		Output pose containing the requested transforms. Must be pre-allocated with enough
+		 *								space to hold all the bone matrices of this skeleton. Bones marked as overriden in
+		 *								@p localPose must already contain their final transforms.
+		 * @param[in]		localPose	Local transforms of all bones, with normalized rotations.
+		 */
+		void getPose(Matrix4* pose, const LocalSkeletonPose& localPose) const;
+
 		/** Returns the total number of bones in the skeleton. */
 		BS_SCRIPT_EXPORT(pr:getter,n:NumBones)
 		UINT32 getNumBones() const { return mNumBones; }
@@ -163,6 +188,9 @@ namespace bs
 		/** Returns the inverse bind pose for the bone at the provided index. */
 		const Matrix4& getInvBindPose(UINT32 idx) const { return mInvBindPoses[idx]; }
 
+		/** Returns the local transforms of all bones when the skeleton is in its bind pose. */
+		const LocalSkeletonPose& getLocalBindPose() const { return mLocalBindPose; }
+
 		/** 
 		 * Creates a new Skeleton. 
 		 *
@@ -175,9 +203,16 @@ namespace bs
 		Skeleton();
 		Skeleton(BONE_DESC* bones, UINT32 numBones);
 
+		/** Calculates the local bind pose and the bone evaluation order from the bone information. */
+		void initialize();
+
 		UINT32 mNumBones;
 		Matrix4* mInvBindPoses;
 		SkeletonBoneInfo* mBoneInfo;
+		LocalSkeletonPose mLocalBindPose;
+
+		/** Bone indices sorted so that parents always come before their children. */
+		Vector<UINT32> mEvaluationOrder;
 
 		/************************************************************************/
 		/* 								SERIALIZATION                      		*/
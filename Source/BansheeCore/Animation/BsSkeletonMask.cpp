@@ -17,6 +17,22 @@ namespace bs
 		return !mIsDisabled[boneIdx];
 	}
 
+	bool SkeletonMask::hasDisabledBones() const
+	{
+		return std::find(mIsDisabled.begin(), mIsDisabled.end(), true) != mIsDisabled.end();
+	}
+
+	SkeletonMask SkeletonMask::intersect(const SkeletonMask& other) const
+	{
+		UINT32 numBones = (UINT32)std::max(mIsDisabled.size(), other.mIsDisabled.size());
+
+		SkeletonMask output(numBones);
+		for (UINT32 i = 0; i < numBones; i++)
+			output.mIsDisabled[i] = !isEnabled(i) || !other.isEnabled(i);
+
+		return output;
+	}
+
 	SkeletonMaskBuilder::SkeletonMaskBuilder(const SPtr<Skeleton>& skeleton)
 		:mSkeleton(skeleton), mMask(skeleton->getNumBones())
 	{ }
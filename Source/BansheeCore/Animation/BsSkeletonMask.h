@@ -26,6 +26,12 @@ namespace bs
 		 */
 		bool isEnabled(UINT32 boneIdx) const;
 
+		/** Checks if any of the bones are disabled by the mask. */
+		bool hasDisabledBones() const;
+
+		/** Returns a mask in which a bone is enabled only if it is enabled in both this and the @p other mask. */
+		SkeletonMask intersect(const SkeletonMask& other) const;
+
 	private:
 		friend class SkeletonMaskBuilder;
 
@@ -16,6 +16,7 @@
 #include "Utility/BsDynLib.h"
 #include "Utility/BsDynLibManager.h"
 #include "Scene/BsSceneManager.h"
+#include "Scene/BsTransformHierarchy.h"
 #include "Importer/BsImporter.h"
 #include "Resources/BsResources.h"
 #include "Mesh/BsMesh.h"
@@ -79,6 +80,7 @@ namespace bs
 		StringTableManager::shutDown();
 		Resources::shutDown();
 		GameObjectManager::shutDown();
+		TransformHierarchy::shutDown();
 		ResourceListenerManager::shutDown();
 		RenderStateManager::shutDown();
 
@@ -133,7 +135,10 @@ namespace bs
 		MessageHandler::startUp();
 		ProfilerCPU::startUp();
 		ProfilingManager::startUp();
-		ThreadPool::startUp<TThreadPool<ThreadBansheePolicy>>((numWorkerThreads));
+		// Task scheduler workers hold on to their pool threads, so leave room for them on top of the engine's own threads
+		UINT32 maxPoolThreads = TaskScheduler::MAX_WORKERS + 16;
+
+		ThreadPool::startUp<TThreadPool<ThreadBansheePolicy>>(numWorkerThreads, maxPoolThreads);
 		TaskScheduler::startUp();
 		TaskScheduler::instance().removeWorker();
 		RenderStats::startUp();
@@ -144,6 +149,7 @@ namespace bs
 		DynLibManager::startUp();
 		CoreObjectManager::startUp();
 		GameObjectManager::startUp();
+		TransformHierarchy::startUp();
 		Resources::startUp();
 		ResourceListenerManager::startUp();
 		GpuProgramManager::startUp();
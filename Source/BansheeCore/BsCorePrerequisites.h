@@ -580,6 +580,7 @@ namespace bs
 		TID_SceneActor = 1140,
 		TID_AudioListener = 1141,
 		TID_AudioSource = 1142,
+		TID_CompressedAnimationCurves = 1143,
 
 		// Moved from Engine layer
 		TID_CCamera = 30000,
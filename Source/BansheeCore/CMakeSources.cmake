@@ -57,6 +57,7 @@ set(BS_BANSHEECORE_INC_CORETHREAD
 	"CoreThread/BsCoreObjectManager.h"
 	"CoreThread/BsCoreObject.h"
 	"CoreThread/BsCommandQueue.h"
+	"CoreThread/BsCommandBuffer.h"
 	"CoreThread/BsCoreObjectCore.h"
 )
 
@@ -81,6 +82,7 @@ set(BS_BANSHEECORE_INC_SCENE
 	"Scene/BsPrefabDiff.h"
 	"Scene/BsPrefabUtility.h"
 	"Scene/BsTransform.h"
+	"Scene/BsTransformHierarchy.h"
 	"Scene/BsSceneActor.h"
 )
 
@@ -175,6 +177,7 @@ set(BS_BANSHEECORE_INC_RENDERAPI_MANAGERS
 )
 
 set(BS_BANSHEECORE_SRC_CORETHREAD
+	"CoreThread/BsCommandBuffer.cpp"
 	"CoreThread/BsCommandQueue.cpp"
 	"CoreThread/BsCoreObject.cpp"
 	"CoreThread/BsCoreObjectManager.cpp"
@@ -204,6 +207,7 @@ set(BS_BANSHEECORE_INC_MATERIAL
 
 set(BS_BANSHEECORE_INC_RESOURCES
 	"Resources/BsResources.h"
+	"Resources/BsAsyncResourceLoader.h"
 	"Resources/BsResourceManifest.h"
 	"Resources/BsResourceHandle.h"
 	"Resources/BsResource.h"
@@ -356,6 +360,7 @@ set(BS_BANSHEECORE_INC_RTTI
 	"RTTI/BsAnimationClipRTTI.h"
 	"RTTI/BsAnimationCurveRTTI.h"
 	"RTTI/BsSkeletonRTTI.h"
+	"RTTI/BsCompressedAnimationCurvesRTTI.h"
 	"RTTI/BsCCameraRTTI.h"
 	"RTTI/BsCameraRTTI.h"
 	"RTTI/BsRenderSettingsRTTI.h"
@@ -399,6 +404,7 @@ set(BS_BANSHEECORE_SRC_RESOURCES
 	"Resources/BsResourceHandle.cpp"
 	"Resources/BsResourceManifest.cpp"
 	"Resources/BsResources.cpp"
+	"Resources/BsAsyncResourceLoader.cpp"
 	"Resources/BsResourceMetaData.cpp"
 	"Resources/BsSavedResourceData.cpp"
 	"Resources/BsIResourceListener.cpp"
@@ -533,6 +539,7 @@ set(BS_BANSHEECORE_SRC_SCENE
 	"Scene/BsPrefabDiff.cpp"
 	"Scene/BsPrefabUtility.cpp"
 	"Scene/BsTransform.cpp"
+	"Scene/BsTransformHierarchy.cpp"
 	"Scene/BsSceneActor.cpp"
 )
 
@@ -566,6 +573,8 @@ set(BS_BANSHEECORE_INC_ANIMATION
 	"Animation/BsAnimationUtility.h"
 	"Animation/BsSkeletonMask.h"
 	"Animation/BsMorphShapes.h"
+	"Animation/BsCompressedAnimationCurves.h"
+	"Animation/BsBakedAnimationPoses.h"
 )
 
 set(BS_BANSHEECORE_SRC_ANIMATION
@@ -577,6 +586,8 @@ set(BS_BANSHEECORE_SRC_ANIMATION
 	"Animation/BsAnimationUtility.cpp"
 	"Animation/BsSkeletonMask.cpp"
 	"Animation/BsMorphShapes.cpp"
+	"Animation/BsCompressedAnimationCurves.cpp"
+	"Animation/BsBakedAnimationPoses.cpp"
 )
 
 set(BS_BANSHEECORE_INC_PLATFORM
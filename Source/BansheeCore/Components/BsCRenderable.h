@@ -57,6 +57,18 @@ namespace bs
 		BS_SCRIPT_EXPORT(n:Layers,pr:getter)
 		UINT64 getLayer() const { return mInternal->getLayer(); }
 
+		/** @copydoc Renderable::setOccluderBounds */
+		void setOccluderBounds(const AABox& bounds) { mInternal->setOccluderBounds(bounds); }
+
+		/** @copydoc Renderable::getOccluderBounds */
+		const AABox& getOccluderBounds() const { return mInternal->getOccluderBounds(); }
+
+		/** @copydoc Renderable::setUseAsOccluder */
+		void setUseAsOccluder(bool enable) { mInternal->setUseAsOccluder(enable); }
+
+		/** @copydoc Renderable::getUseAsOccluder */
+		bool getUseAsOccluder() const { return mInternal->getUseAsOccluder(); }
+
 		/**	Gets world bounds of the mesh rendered by this object. */
 		BS_SCRIPT_EXPORT(n:Bounds,pr:getter)
 		Bounds getBounds() const;
@@ -0,0 +1,159 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "CoreThread/BsCommandBuffer.h"
+#include "Debug/BsDebug.h"
+
+namespace bs
+{
+	void resolveIncompleteOp(AsyncOp& asyncOp)
+	{
+		LOGDBG("Async operation return value wasn't resolved properly. Resolving automatically to nullptr. " \
+			"Make sure to complete the operation before returning from the command callback method.");
+		asyncOp._completeOperation(nullptr);
+	}
+
+	CommandBuffer::~CommandBuffer()
+	{
+		CommandList pending = flush();
+		cancel(pending);
+
+		freeBlocks(mFreeBlocks);
+		freeBlocks(mReleasedBlocks.exchange(nullptr));
+	}
+
+	CommandBuffer::CommandList CommandBuffer::flush()
+	{
+		CommandList output;
+		output.first = mFirst;
+		output.numCommands = mNumCommands;
+
+		mFirst = nullptr;
+		mLast = nullptr;
+		mNumCommands = 0;
+
+		return output;
+	}
+
+	void CommandBuffer::playback(const CommandList& commands, const std::function<void(UINT32)>& notifyCallback)
+	{
+		Block* block = commands.first;
+		while (block != nullptr)
+		{
+			UINT8* data = getBlockData(block);
+			UINT32 offset = 0;
+			while (offset < block->used)
+			{
+				QueuedCommand* command = (QueuedCommand*)(data + offset);
+				offset += command->size;
+
+				bool notify = command->notifyWhenComplete;
+				UINT32 callbackId = command->callbackId;
+
+				command->execute(command);
+
+				if (notify && notifyCallback != nullptr)
+					notifyCallback(callbackId);
+			}
+
+			Block* next = block->next;
+			releaseBlock(block);
+			block = next;
+		}
+	}
+
+	void CommandBuffer::cancel(const CommandList& commands)
+	{
+		Block* block = commands.first;
+		while (block != nullptr)
+		{
+			UINT8* data = getBlockData(block);
+			UINT32 offset = 0;
+			while (offset < block->used)
+			{
+				QueuedCommand* command = (QueuedCommand*)(data + offset);
+				offset += command->size;
+
+				command->destroy(command);
+			}
+
+			Block* next = block->next;
+			releaseBlock(block);
+			block = next;
+		}
+	}
+
+	void* CommandBuffer::allocate(UINT32 size)
+	{
+		size = getCommandSize(size);
+		if (mLast == nullptr || (mLast->capacity - mLast->used) < size)
+		{
+			Block* block = allocateBlock(size > BLOCK_SIZE ? size : BLOCK_SIZE);
+
+			if (mLast != nullptr)
+				mLast->next = block;
+			else
+				mFirst = block;
+
+			mLast = block;
+		}
+
+		void* output = getBlockData(mLast) + mLast->used;
+		mLast->used += size;
+		mNumCommands++;
+
+		return output;
+	}
+
+	CommandBuffer::Block* CommandBuffer::allocateBlock(UINT32 capacity)
+	{
+		Block* block = nullptr;
+		if (capacity == BLOCK_SIZE)
+		{
+			if (mFreeBlocks == nullptr)
+				mFreeBlocks = mReleasedBlocks.exchange(nullptr, std::memory_order_acquire);
+
+			if (mFreeBlocks != nullptr)
+			{
+				block = mFreeBlocks;
+				mFreeBlocks = block->next;
+			}
+		}
+
+		if (block == nullptr)
+		{
+			block = (Block*)bs_alloc_aligned(getCommandSize(sizeof(Block)) + capacity, COMMAND_ALIGNMENT);
+			block->capacity = capacity;
+		}
+
+		block->next = nullptr;
+		block->used = 0;
+
+		return block;
+	}
+
+	void CommandBuffer::releaseBlock(Block* block)
+	{
+		if (block->capacity != BLOCK_SIZE)
+		{
+			bs_free_aligned(block);
+			return;
+		}
+
+		Block* head = mReleasedBlocks.load(std::memory_order_relaxed);
+		do
+		{
+			block->next = head;
+		} while (!mReleasedBlocks.compare_exchange_weak(head, block, std::memory_order_release, 
+			std::memory_order_relaxed));
+	}
+
+	void CommandBuffer::freeBlocks(Block* first)
+	{
+		while (first != nullptr)
+		{
+			Block* next = first->next;
+			bs_free_aligned(first);
+			first = next;
+		}
+	}
+}
@@ -0,0 +1,226 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Threading/BsAsyncOp.h"
+#include <atomic>
+
+namespace bs
+{
+	/** @addtogroup CoreThread-Internal
+	 *  @{
+	 */
+
+	/**
+	 * Header of a single command stored in a CommandBuffer. The command callback is stored inline, directly after the
+	 * header, by one of the types deriving from this one.
+	 */
+	struct QueuedCommand
+	{
+		/** Executes the command callback and destroys the command. */
+		void (*execute)(QueuedCommand* command);
+
+		/** Destroys the command without executing it. */
+		void (*destroy)(QueuedCommand* command);
+
+		/** Size of the command in bytes, including the header and any padding up to the next command. */
+		UINT32 size;
+
+		UINT32 callbackId;
+		bool notifyWhenComplete;
+
+#if BS_DEBUG_MODE
+		UINT32 debugId;
+#endif
+	};
+
+	/** Resolves an async operation that wasn't resolved by its command callback to a null value. */
+	BS_CORE_EXPORT void resolveIncompleteOp(AsyncOp& asyncOp);
+
+	/** Command storing a callback that doesn't return a value. */
+	template<class Fn>
+	struct TQueuedCommand : QueuedCommand
+	{
+		template<class FnArg>
+		TQueuedCommand(FnArg&& callback)
+			:callback(std::forward<FnArg>(callback))
+		{
+			execute = &TQueuedCommand::executeImpl;
+			destroy = &TQueuedCommand::destroyImpl;
+		}
+
+		static void executeImpl(QueuedCommand* command)
+		{
+			TQueuedCommand* typedCommand = static_cast<TQueuedCommand*>(command);
+			typedCommand->callback();
+			typedCommand->~TQueuedCommand();
+		}
+
+		static void destroyImpl(QueuedCommand* command)
+		{
+			static_cast<TQueuedCommand*>(command)->~TQueuedCommand();
+		}
+
+		Fn callback;
+	};
+
+	/** Command storing a callback that returns a value through an AsyncOp. */
+	template<class Fn>
+	struct TQueuedReturnCommand : QueuedCommand
+	{
+		template<class FnArg>
+		TQueuedReturnCommand(FnArg&& callback, const AsyncOp& asyncOp)
+			:callback(std::forward<FnArg>(callback)), asyncOp(asyncOp)
+		{
+			execute = &TQueuedReturnCommand::executeImpl;
+			destroy = &TQueuedReturnCommand::destroyImpl;
+		}
+
+		static void executeImpl(QueuedCommand* command)
+		{
+			TQueuedReturnCommand* typedCommand = static_cast<TQueuedReturnCommand*>(command);
+			typedCommand->callback(typedCommand->asyncOp);
+
+			if(!typedCommand->asyncOp.hasCompleted())
+				resolveIncompleteOp(typedCommand->asyncOp);
+
+			typedCommand->~TQueuedReturnCommand();
+		}
+
+		static void destroyImpl(QueuedCommand* command)
+		{
+			static_cast<TQueuedReturnCommand*>(command)->~TQueuedReturnCommand();
+		}
+
+		Fn callback;
+		AsyncOp asyncOp;
+	};
+
+	/**
+	 * Stores commands, along with their callbacks, inline in a ring of fixed size memory blocks, avoiding any per-command
+	 * allocations.
+	 *
+	 * Commands are added to the buffer on a single producer thread, which then periodically hands them over in bulk to a
+	 * single consumer thread by calling flush(). The consumer executes the commands using playback(), after which their
+	 * memory blocks are returned to the producer for reuse. Block handover in both directions is lock-free, and no
+	 * other synchronization is performed.
+	 */
+	class BS_CORE_EXPORT CommandBuffer
+	{
+		/** Memory block containing a sequence of commands. Command data follows the block header. */
+		struct Block
+		{
+			Block* next;
+			UINT32 capacity;
+			UINT32 used;
+		};
+
+	public:
+		/** Size of a single memory block, in bytes. Commands larger than this are allocated a separate block. */
+		static const UINT32 BLOCK_SIZE = 64 * 1024;
+
+		/** Alignment of commands within a block. Command callbacks cannot require alignment larger than this. */
+		static const UINT32 COMMAND_ALIGNMENT = 16;
+
+		/** A sequence of commands handed over from the producer to the consumer by flush(). */
+		struct CommandList
+		{
+			Block* first = nullptr;
+			UINT32 numCommands = 0;
+		};
+
+		CommandBuffer() = default;
+		~CommandBuffer();
+
+		CommandBuffer(const CommandBuffer&) = delete;
+		CommandBuffer& operator=(const CommandBuffer&) = delete;
+
+		/**
+		 * Allocates a new command with the provided callback at the end of the buffer. Must only be called from the
+		 * producer thread. Returns the command header which the caller should fill out.
+		 */
+		template<class Fn>
+		QueuedCommand* push(Fn&& callback)
+		{
+			typedef TQueuedCommand<typename std::decay<Fn>::type> CommandType;
+			static_assert(alignof(CommandType) <= COMMAND_ALIGNMENT, "Command callback alignment is not supported.");
+
+			CommandType* command = new (allocate(sizeof(CommandType))) CommandType(std::forward<Fn>(callback));
+
+			command->size = getCommandSize(sizeof(CommandType));
+			return command;
+		}
+
+		/**
+		 * Allocates a new command with the provided callback, that returns a value through @p asyncOp, at the end of the
+		 * buffer. Must only be called from the producer thread. Returns the command header which the caller should fill
+		 * out.
+		 */
+		template<class Fn>
+		QueuedCommand* pushReturn(Fn&& callback, const AsyncOp& asyncOp)
+		{
+			typedef TQueuedReturnCommand<typename std::decay<Fn>::type> CommandType;
+			static_assert(alignof(CommandType) <= COMMAND_ALIGNMENT, "Command callback alignment is not supported.");
+
+			CommandType* command = new (allocate(sizeof(CommandType))) 
+				CommandType(std::forward<Fn>(callback), asyncOp);
+
+			command->size = getCommandSize(sizeof(CommandType));
+			return command;
+		}
+
+		/**
+		 * Removes all the commands from the buffer and returns them so they can be passed to the consumer thread. Must only
+		 * be called from the producer thread.
+		 */
+		CommandList flush();
+
+		/**
+		 * Executes all the commands in the list, in order, and returns their memory to the producer. Must only be called
+		 * from the consumer thread.
+		 *
+		 * @param[in]	commands		Commands returned by flush().
+		 * @param[in]	notifyCallback	Optional callback to trigger after a command with the notifyWhenComplete flag
+		 *								executes. Receives the callback ID of the command.
+		 */
+		void playback(const CommandList& commands, const std::function<void(UINT32)>& notifyCallback = nullptr);
+
+		/** Destroys all commands in the list without executing them, and returns their memory to the producer. */
+		void cancel(const CommandList& commands);
+
+		/** Returns the number of commands added since the last call to flush(). */
+		UINT32 getNumCommands() const { return mNumCommands; }
+
+	private:
+		/** Returns the memory for a command of the specified size, at the end of the buffer. */
+		void* allocate(UINT32 size);
+
+		/** Returns the number of bytes a command of the specified size takes up in a block. */
+		static UINT32 getCommandSize(UINT32 size)
+		{
+			return (size + COMMAND_ALIGNMENT - 1) & ~(COMMAND_ALIGNMENT - 1);
+		}
+
+		/** Returns a pointer to the command data of a block. */
+		static UINT8* getBlockData(Block* block) { return (UINT8*)block + getCommandSize(sizeof(Block)); }
+
+		/** Retrieves a free block from the blocks returned by the consumer, or allocates a new one. */
+		Block* allocateBlock(UINT32 capacity);
+
+		/** Returns a block from the consumer to the producer. Oversized blocks are freed instead. */
+		void releaseBlock(Block* block);
+
+		/** Frees all blocks in a list linked through Block::next. */
+		static void freeBlocks(Block* first);
+
+		Block* mFirst = nullptr;
+		Block* mLast = nullptr;
+		UINT32 mNumCommands = 0;
+
+		Block* mFreeBlocks = nullptr; // Producer thread only
+		std::atomic<Block*> mReleasedBlocks { nullptr }; // Pushed by the consumer, taken by the producer
+	};
+
+	/** @} */
+}
@@ -12,7 +12,6 @@ namespace bs
 		:mMyThreadId(threadId), mMaxDebugIdx(0)
 	{
 		mAsyncOpSyncData = bs_shared_ptr_new<AsyncOpSyncData>();
-		mCommands = bs_new<bs::Queue<QueuedCommand>>();
 
 		{
 			Lock lock(CommandQueueBreakpointMutex);
@@ -25,137 +24,50 @@ namespace bs
 		:mMyThreadId(threadId)
 	{
 		mAsyncOpSyncData = bs_shared_ptr_new<AsyncOpSyncData>();
-		mCommands = bs_new<bs::Queue<QueuedCommand>>();
 	}
 #endif
 
 	CommandQueueBase::~CommandQueueBase()
-	{
-		if(mCommands != nullptr)
-			bs_delete(mCommands);
-
-		while(!mEmptyCommandQueues.empty())
-		{
-			bs_delete(mEmptyCommandQueues.top());
-			mEmptyCommandQueues.pop();
-		}
-	}
+	{ }
 
-	AsyncOp CommandQueueBase::queueReturn(std::function<void(AsyncOp&)> commandCallback, bool _notifyWhenComplete, UINT32 _callbackId)
+	void CommandQueueBase::initCommand(QueuedCommand* command, bool notifyWhenComplete, UINT32 callbackId)
 	{
 #if BS_DEBUG_MODE
 		breakIfNeeded(mCommandQueueIdx, mMaxDebugIdx);
 
-		QueuedCommand newCommand(commandCallback, mMaxDebugIdx++, mAsyncOpSyncData, _notifyWhenComplete, _callbackId);
-#else
-		QueuedCommand newCommand(commandCallback, mAsyncOpSyncData, _notifyWhenComplete, _callbackId);
-#endif
-
-		mCommands->push(newCommand);
-
-#if BS_FORCE_SINGLETHREADED_RENDERING
-		Queue<QueuedCommand>* commands = flush();
-		playback(commands);
+		command->debugId = mMaxDebugIdx++;
 #endif
 
-		return newCommand.asyncOp;
+		command->notifyWhenComplete = notifyWhenComplete;
+		command->callbackId = callbackId;
 	}
 
-	void CommandQueueBase::queue(std::function<void()> commandCallback, bool _notifyWhenComplete, UINT32 _callbackId)
+	CommandBuffer::CommandList CommandQueueBase::flush()
 	{
-#if BS_DEBUG_MODE
-		breakIfNeeded(mCommandQueueIdx, mMaxDebugIdx);
-
-		QueuedCommand newCommand(commandCallback, mMaxDebugIdx++, _notifyWhenComplete, _callbackId);
-#else
-		QueuedCommand newCommand(commandCallback, _notifyWhenComplete, _callbackId);
-#endif
-
-		mCommands->push(newCommand);
-
-#if BS_FORCE_SINGLETHREADED_RENDERING
-		Queue<QueuedCommand>* commands = flush();
-		playback(commands);
-#endif
+		return mCommands.flush();
 	}
 
-	bs::Queue<QueuedCommand>* CommandQueueBase::flush()
-	{
-		bs::Queue<QueuedCommand>* oldCommands = mCommands;
-
-		if(!mEmptyCommandQueues.empty())
-		{
-			mCommands = mEmptyCommandQueues.top();
-			mEmptyCommandQueues.pop();
-		}
-		else
-		{
-			mCommands = bs_new<bs::Queue<QueuedCommand>>();
-		}
-
-		return oldCommands;
-	}
-
-	void CommandQueueBase::playbackWithNotify(bs::Queue<QueuedCommand>* commands, std::function<void(UINT32)> notifyCallback)
+	void CommandQueueBase::playbackWithNotify(const CommandBuffer::CommandList& commands, 
+		std::function<void(UINT32)> notifyCallback)
 	{
 		THROW_IF_NOT_CORE_THREAD;
 
-		if(commands == nullptr)
-			return;
-
-		while(!commands->empty())
-		{
-			QueuedCommand& command = commands->front();
-
-			if(command.returnsValue)
-			{
-				AsyncOp& op = command.asyncOp;
-				command.callbackWithReturnValue(op);
-
-				if(!command.asyncOp.hasCompleted())
-				{
-					LOGDBG("Async operation return value wasn't resolved properly. Resolving automatically to nullptr. " \
-						"Make sure to complete the operation before returning from the command callback method.");
-					command.asyncOp._completeOperation(nullptr);
-				}
-			}
-			else
-			{
-				command.callback();
-			}
-
-			if(command.notifyWhenComplete && notifyCallback != nullptr)
-			{
-				notifyCallback(command.callbackId);
-			}
-
-			commands->pop();
-		}
-
-		mEmptyCommandQueues.push(commands);
+		mCommands.playback(commands, notifyCallback);
 	}
 
-	void CommandQueueBase::playback(bs::Queue<QueuedCommand>* commands)
+	void CommandQueueBase::playback(const CommandBuffer::CommandList& commands)
 	{
 		playbackWithNotify(commands, std::function<void(UINT32)>());
 	}
 
 	void CommandQueueBase::cancelAll()
 	{
-		bs::Queue<QueuedCommand>* commands = flush();
-
-		while(!commands->empty())
-			commands->pop();
-
-		mEmptyCommandQueues.push(commands);
+		mCommands.cancel(mCommands.flush());
 	}
 
 	bool CommandQueueBase::isEmpty()
 	{
-		if(mCommands != nullptr && mCommands->size() > 0)
-			return false;
-
-		return true;
+		return mCommands.getNumCommands() == 0;
 	}
 
 	void CommandQueueBase::throwInvalidThreadException(const String& message) const
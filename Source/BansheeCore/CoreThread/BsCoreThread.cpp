@@ -94,7 +94,7 @@ namespace bs
 		while(true)
 		{
 			// Wait until we get some ready commands
-			Queue<QueuedCommand>* commands = nullptr;
+			CommandBuffer::CommandList commands;
 			{
 				Lock lock(mCommandQueueMutex);
 
@@ -184,67 +184,50 @@ namespace bs
 		getQueue()->submitToCoreThread(blockUntilComplete);
 	}
 
-	AsyncOp CoreThread::queueReturnCommand(std::function<void(AsyncOp&)> commandCallback, CoreThreadQueueFlags flags)
+	AsyncOp CoreThread::queueInternalReturnCommand(std::function<void(AsyncOp&)> commandCallback, 
+		bool blockUntilComplete)
 	{
-		assert(BS_THREAD_CURRENT_ID != getCoreThreadId() && "Cannot queue commands on the core thread for the core thread");
-
-		if (!flags.isSet(CTQF_InternalQueue))
-			return getQueue()->queueReturnCommand(commandCallback);
-		else
+		AsyncOp op;
+		UINT32 commandId = -1;
 		{
-			bool blockUntilComplete = flags.isSet(CTQF_BlockUntilComplete);
+			Lock lock(mCommandQueueMutex);
 
-			AsyncOp op;
-			UINT32 commandId = -1;
+			if (blockUntilComplete)
 			{
-				Lock lock(mCommandQueueMutex);
-
-				if (blockUntilComplete)
-				{
-					commandId = mMaxCommandNotifyId++;
-					op = mCommandQueue->queueReturn(commandCallback, true, commandId);
-				}
-				else
-					op = mCommandQueue->queueReturn(commandCallback);
+				commandId = mMaxCommandNotifyId++;
+				op = mCommandQueue->queueReturn(std::move(commandCallback), true, commandId);
 			}
+			else
+				op = mCommandQueue->queueReturn(std::move(commandCallback));
+		}
 
-			mCommandReadyCondition.notify_all();
+		mCommandReadyCondition.notify_all();
 
-			if (blockUntilComplete)
-				blockUntilCommandCompleted(commandId);
+		if (blockUntilComplete)
+			blockUntilCommandCompleted(commandId);
 
-			return op;
-		}
+		return op;
 	}
 
-	void CoreThread::queueCommand(std::function<void()> commandCallback, CoreThreadQueueFlags flags)
+	void CoreThread::queueInternalCommand(std::function<void()> commandCallback, bool blockUntilComplete)
 	{
-		assert(BS_THREAD_CURRENT_ID != getCoreThreadId() && "Cannot queue commands on the core thread for the core thread");
-
-		if (!flags.isSet(CTQF_InternalQueue))
-			getQueue()->queueCommand(commandCallback);
-		else
+		UINT32 commandId = -1;
 		{
-			bool blockUntilComplete = flags.isSet(CTQF_BlockUntilComplete);
+			Lock lock(mCommandQueueMutex);
 
-			UINT32 commandId = -1;
+			if (blockUntilComplete)
 			{
-				Lock lock(mCommandQueueMutex);
-
-				if (blockUntilComplete)
-				{
-					commandId = mMaxCommandNotifyId++;
-					mCommandQueue->queue(commandCallback, true, commandId);
-				}
-				else
-					mCommandQueue->queue(commandCallback);
+				commandId = mMaxCommandNotifyId++;
+				mCommandQueue->queue(std::move(commandCallback), true, commandId);
 			}
+			else
+				mCommandQueue->queue(std::move(commandCallback));
+		}
 
-			mCommandReadyCondition.notify_all();
+		mCommandReadyCondition.notify_all();
 
-			if (blockUntilComplete)
-				blockUntilCommandCompleted(commandId);
-		}
+		if (blockUntilComplete)
+			blockUntilCommandCompleted(commandId);
 	}
 
 	void CoreThread::update()
@@ -96,7 +96,16 @@ namespace bs
 		 * @see		CommandQueue::queueReturn()
 		 * @note	Thread safe
 		 */
-		AsyncOp queueReturnCommand(std::function<void(AsyncOp&)> commandCallback, CoreThreadQueueFlags flags = CTQF_Default);
+		template<class Fn>
+		AsyncOp queueReturnCommand(Fn&& commandCallback, CoreThreadQueueFlags flags = CTQF_Default)
+		{
+			assert(BS_THREAD_CURRENT_ID != getCoreThreadId() && "Cannot queue commands on the core thread for the core thread");
+
+			if (!flags.isSet(CTQF_InternalQueue))
+				return getQueue()->queueReturnCommand(std::forward<Fn>(commandCallback));
+
+			return queueInternalReturnCommand(std::forward<Fn>(commandCallback), flags.isSet(CTQF_BlockUntilComplete));
+		}
 
 		/**
 		 * Queues a new command that will be added to the global command queue. 
@@ -107,7 +116,16 @@ namespace bs
 		 * @see		CommandQueue::queue()
 		 * @note	Thread safe
 		 */
-		void queueCommand(std::function<void()> commandCallback, CoreThreadQueueFlags flags = CTQF_Default);
+		template<class Fn>
+		void queueCommand(Fn&& commandCallback, CoreThreadQueueFlags flags = CTQF_Default)
+		{
+			assert(BS_THREAD_CURRENT_ID != getCoreThreadId() && "Cannot queue commands on the core thread for the core thread");
+
+			if (!flags.isSet(CTQF_InternalQueue))
+				getQueue()->queueCommand(std::forward<Fn>(commandCallback));
+			else
+				queueInternalCommand(std::forward<Fn>(commandCallback), flags.isSet(CTQF_BlockUntilComplete));
+		}
 
 		/**
 		 * Called once every frame.
@@ -183,6 +201,12 @@ namespace bs
 		/** Creates or retrieves a queue for the calling thread. */
 		SPtr<TCoreThreadQueue<CommandQueueNoSync>> getQueue();
 
+		/** Queues a command that returns a value on the internal queue. See CTQF_InternalQueue. */
+		AsyncOp queueInternalReturnCommand(std::function<void(AsyncOp&)> commandCallback, bool blockUntilComplete);
+
+		/** Queues a command on the internal queue. See CTQF_InternalQueue. */
+		void queueInternalCommand(std::function<void()> commandCallback, bool blockUntilComplete);
+
 		/**
 		 * Blocks the calling thread until the command with the specified ID completes. Make sure that the specified ID 
 		 * actually exists, otherwise this will block forever.
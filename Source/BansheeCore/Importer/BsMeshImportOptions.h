@@ -162,6 +162,35 @@ namespace bs
 		 */
 		bool getImportRootMotion() const { return mImportRootMotion; }
 
+		/**
+		 * Enables or disables animation compression. When enabled the bone curves of imported animation clips will be
+		 * resampled at the animation sample rate and quantized, greatly reducing their size and the cost of evaluating
+		 * them, at the cost of some precision. See AnimationClip::compress.
+		 */
+		void setCompressAnimation(bool enabled) { mCompressAnimation = enabled; }
+
+		/**
+		 * Checks is animation compression enabled.
+		 *
+		 * @see	setCompressAnimation
+		 */
+		bool getCompressAnimation() const { return mCompressAnimation; }
+
+		/**
+		 * Enables or disables vertex order optimization. When enabled, triangles of each sub-mesh are reordered to make
+		 * better use of the post-transform vertex cache and to reduce overdraw, and vertices are reordered to match the
+		 * order in which triangles reference them. See MeshUtility::optimizeVertexCache, 
+		 * MeshUtility::optimizeOverdraw and MeshUtility::optimizeVertexFetch.
+		 */
+		void setOptimizeVertexOrder(bool enabled) { mOptimizeVertexOrder = enabled; }
+
+		/**
+		 * Checks is vertex order optimization enabled.
+		 *
+		 * @see	setOptimizeVertexOrder
+		 */
+		bool getOptimizeVertexOrder() const { return mOptimizeVertexOrder; }
+
 		/** Creates a new import options object that allows you to customize how are meshes imported. */
 		static SPtr<MeshImportOptions> create();
 
@@ -174,6 +203,8 @@ namespace bs
 		bool mImportAnimation;
 		bool mReduceKeyFrames;
 		bool mImportRootMotion;
+		bool mCompressAnimation;
+		bool mOptimizeVertexOrder;
 		float mImportScale;
 		CollisionMeshType mCollisionMeshType;
 		Vector<AnimationSplitInfo> mAnimationSplits;
@@ -724,6 +724,81 @@ namespace bs
 		bs_frame_clear();
 	}
 
+	/** Reads a single index from an index buffer with indices of @p indexSize bytes. */
+	static UINT32 readIndex(const UINT8* indices, UINT32 idx, UINT32 indexSize)
+	{
+		UINT32 value = 0;
+		memcpy(&value, indices + idx * indexSize, indexSize);
+
+		return value;
+	}
+
+	/** Writes a single index into an index buffer with indices of @p indexSize bytes. */
+	static void writeIndex(UINT8* indices, UINT32 idx, UINT32 value, UINT32 indexSize)
+	{
+		memcpy(indices + idx * indexSize, &value, indexSize);
+	}
+
+	/** Simulates a FIFO post-transform vertex cache. */
+	class VertexCacheSimulator
+	{
+	public:
+		VertexCacheSimulator(UINT32 numVertices, UINT32 cacheSize)
+			:mTimestamps(numVertices, 0), mCacheSize(cacheSize), mTime(cacheSize + 1)
+		{ }
+
+		/** Transforms the vertex with the provided index. Returns true if the vertex wasn't found in the cache. */
+		bool transform(UINT32 vertexIdx)
+		{
+			// Vertex is in the cache if it was one of the last mCacheSize vertices inserted
+			if (mTime - mTimestamps[vertexIdx] <= mCacheSize)
+				return false;
+
+			mTimestamps[vertexIdx] = mTime++;
+			return true;
+		}
+
+		/** Evicts all vertices from the cache. */
+		void clear()
+		{
+			mTime += mCacheSize + 1;
+		}
+
+	private:
+		Vector<UINT32> mTimestamps;
+		UINT32 mCacheSize;
+		UINT32 mTime;
+	};
+
+	/**
+	 * Returns the score of a vertex used for determining which triangle to output next during vertex cache
+	 * optimization. Higher score means the vertex is more likely to be in the cache, or has fewer triangles left to
+	 * output.
+	 */
+	static float getVertexCacheScore(INT32 cachePosition, UINT32 numRemainingFaces, UINT32 cacheSize)
+	{
+		if (numRemainingFaces == 0)
+			return -1.0f;
+
+		float score = 0.0f;
+		if (cachePosition >= 0)
+		{
+			// Vertices used by the last triangle get a fixed score, so the next triangle doesn't prefer any of its edges
+			if (cachePosition < 3)
+				score = 0.75f;
+			else
+			{
+				float scale = 1.0f / (cacheSize - 3);
+				score = std::pow(1.0f - (cachePosition - 3) * scale, 1.5f);
+			}
+		}
+
+		// Boost vertices with few triangles left, so lone triangles aren't left behind
+		score += 2.0f * std::pow((float)numRemainingFaces, -0.5f);
+
+		return score;
+	}
+
 	void MeshUtility::calculateNormals(Vector3* vertices, UINT8* indices, UINT32 numVertices,
 		UINT32 numIndices, Vector3* normals, UINT32 indexSize)
 	{
@@ -945,4 +1020,367 @@ namespace bs
 			ptr += stride;
 		}
 	}
-}
\ No newline at end of file
+
+	void MeshUtility::optimizeVertexCache(UINT8* indices, UINT32 numVertices, UINT32 numIndices, UINT32 indexSize,
+		UINT32 cacheSize)
+	{
+		UINT32 numFaces = numIndices / 3;
+		if (numFaces == 0)
+			return;
+
+		cacheSize = std::max(cacheSize, 4U);
+
+		Vector<UINT32> faces(numFaces * 3);
+		for (UINT32 i = 0; i < numFaces * 3; i++)
+		{
+			faces[i] = readIndex(indices, i, indexSize);
+			assert(faces[i] < numVertices);
+		}
+
+		// Find triangles referencing each vertex. Triangles are removed from the list once they're output.
+		Vector<UINT32> numRemainingFaces(numVertices, 0);
+		for (auto& vertexIdx : faces)
+			numRemainingFaces[vertexIdx]++;
+
+		Vector<UINT32> vertexFaceOffsets(numVertices);
+		UINT32 offset = 0;
+		for (UINT32 i = 0; i < numVertices; i++)
+		{
+			vertexFaceOffsets[i] = offset;
+			offset += numRemainingFaces[i];
+		}
+
+		Vector<UINT32> vertexFaces(numFaces * 3);
+		Vector<UINT32> vertexFaceCounts(numVertices, 0);
+		for (UINT32 i = 0; i < numFaces * 3; i++)
+		{
+			UINT32 vertexIdx = faces[i];
+			vertexFaces[vertexFaceOffsets[vertexIdx] + vertexFaceCounts[vertexIdx]++] = i / 3;
+		}
+
+		Vector<INT32> cachePositions(numVertices, -1);
+		Vector<float> vertexScores(numVertices);
+		for (UINT32 i = 0; i < numVertices; i++)
+			vertexScores[i] = getVertexCacheScore(-1, numRemainingFaces[i], cacheSize);
+
+		Vector<float> faceScores(numFaces);
+		Vector<bool> faceOutput(numFaces, false);
+		for (UINT32 i = 0; i < numFaces; i++)
+		{
+			UINT32* face = &faces[i * 3];
+			faceScores[i] = vertexScores[face[0]] + vertexScores[face[1]] + vertexScores[face[2]];
+		}
+
+		// Cache contains the vertices of the last output triangle at the front, and can temporarily grow past the
+		// cache size by three vertices
+		Vector<UINT32> cache;
+		Vector<UINT32> newCache;
+		cache.reserve(cacheSize + 3);
+		newCache.reserve(cacheSize + 3);
+
+		UINT32 bestFace = 0;
+		UINT32 nextUnusedFace = 0;
+		for (UINT32 i = 0; i < numFaces; i++)
+		{
+			// None of the triangles in the cache are left, continue with the next triangle in the original order
+			if (bestFace == (UINT32)-1)
+			{
+				while (faceOutput[nextUnusedFace])
+					nextUnusedFace++;
+
+				bestFace = nextUnusedFace;
+			}
+
+			UINT32* face = &faces[bestFace * 3];
+			writeIndex(indices, i * 3 + 0, face[0], indexSize);
+			writeIndex(indices, i * 3 + 1, face[1], indexSize);
+			writeIndex(indices, i * 3 + 2, face[2], indexSize);
+
+			faceOutput[bestFace] = true;
+
+			newCache.clear();
+			for (UINT32 j = 0; j < 3; j++)
+			{
+				UINT32 vertexIdx = face[j];
+				newCache.push_back(vertexIdx);
+
+				// Remove the triangle from the vertex's list of remaining triangles
+				UINT32* remainingFaces = &vertexFaces[vertexFaceOffsets[vertexIdx]];
+				UINT32& numRemaining = numRemainingFaces[vertexIdx];
+				for (UINT32 k = 0; k < numRemaining; k++)
+				{
+					if (remainingFaces[k] == bestFace)
+					{
+						std::swap(remainingFaces[k], remainingFaces[numRemaining - 1]);
+						numRemaining--;
+						break;
+					}
+				}
+			}
+
+			for (auto& vertexIdx : cache)
+			{
+				if (vertexIdx != face[0] && vertexIdx != face[1] && vertexIdx != face[2])
+					newCache.push_back(vertexIdx);
+			}
+
+			// Update scores of all vertices whose cache position changed, and of their remaining triangles
+			for (UINT32 j = 0; j < (UINT32)newCache.size(); j++)
+			{
+				UINT32 vertexIdx = newCache[j];
+				cachePositions[vertexIdx] = j < cacheSize ? (INT32)j : -1;
+
+				float score = getVertexCacheScore(cachePositions[vertexIdx], numRemainingFaces[vertexIdx], cacheSize);
+				float scoreDelta = score - vertexScores[vertexIdx];
+				vertexScores[vertexIdx] = score;
+
+				UINT32* remainingFaces = &vertexFaces[vertexFaceOffsets[vertexIdx]];
+				for (UINT32 k = 0; k < numRemainingFaces[vertexIdx]; k++)
+					faceScores[remainingFaces[k]] += scoreDelta;
+			}
+
+			if (newCache.size() > cacheSize)
+				newCache.resize(cacheSize);
+
+			std::swap(cache, newCache);
+
+			// Pick the best triangle using the vertices in the cache
+			bestFace = (UINT32)-1;
+			float bestScore = -1.0f;
+			for (auto& vertexIdx : cache)
+			{
+				UINT32* remainingFaces = &vertexFaces[vertexFaceOffsets[vertexIdx]];
+				for (UINT32 k = 0; k < numRemainingFaces[vertexIdx]; k++)
+				{
+					UINT32 faceIdx = remainingFaces[k];
+					if (faceScores[faceIdx] > bestScore)
+					{
+						bestScore = faceScores[faceIdx];
+						bestFace = faceIdx;
+					}
+				}
+			}
+		}
+	}
+
+	void MeshUtility::optimizeOverdraw(Vector3* vertices, UINT8* indices, UINT32 numVertices, UINT32 numIndices,
+		UINT32 indexSize, UINT32 vertexStride, float threshold, UINT32 cacheSize)
+	{
+		UINT32 numFaces = numIndices / 3;
+		if (numFaces == 0)
+			return;
+
+		UINT32 stride = vertexStride == 0 ? sizeof(Vector3) : vertexStride;
+		auto getVertex = [&](UINT32 idx) -> const Vector3& { return *(Vector3*)((UINT8*)vertices + idx * stride); };
+
+		Vector<UINT32> faces(numFaces * 3);
+		for (UINT32 i = 0; i < numFaces * 3; i++)
+			faces[i] = readIndex(indices, i, indexSize);
+
+		VertexCacheStats stats = calculateVertexCacheStats(indices, numVertices, numIndices, indexSize, cacheSize);
+		float targetACMR = stats.acmr * threshold;
+
+		// Split the triangles into clusters. A new cluster starts whenever the cache was flushed by the current order
+		// anyway, or when the current cluster is efficient enough that starting with an empty cache costs little.
+		Vector<UINT32> clusterStarts;
+		clusterStarts.push_back(0);
+
+		VertexCacheSimulator cache(numVertices, cacheSize);
+		UINT32 clusterStart = 0;
+		UINT32 clusterMisses = 0;
+		for (UINT32 i = 0; i < numFaces; i++)
+		{
+			UINT32 misses = 0;
+			for (UINT32 j = 0; j < 3; j++)
+				misses += cache.transform(faces[i * 3 + j]) ? 1 : 0;
+
+			if (misses == 3 && i > clusterStart)
+			{
+				clusterStarts.push_back(i);
+				clusterStart = i;
+				clusterMisses = 0;
+			}
+
+			clusterMisses += misses;
+
+			UINT32 clusterSize = i + 1 - clusterStart;
+			if (clusterMisses <= targetACMR * clusterSize && (i + 1) < numFaces)
+			{
+				clusterStarts.push_back(i + 1);
+				clusterStart = i + 1;
+				clusterMisses = 0;
+
+				cache.clear();
+			}
+		}
+
+		// Sort clusters so ones on the outside of the mesh, facing away from the center, are rendered first
+		UINT32 numClusters = (UINT32)clusterStarts.size();
+		clusterStarts.push_back(numFaces);
+
+		Vector<Vector3> clusterCentroids(numClusters, Vector3::ZERO);
+		Vector<Vector3> clusterNormals(numClusters, Vector3::ZERO);
+		Vector3 meshCentroid = Vector3::ZERO;
+		float meshArea = 0.0f;
+
+		for (UINT32 i = 0; i < numClusters; i++)
+		{
+			float clusterArea = 0.0f;
+			for (UINT32 j = clusterStarts[i]; j < clusterStarts[i + 1]; j++)
+			{
+				const Vector3& a = getVertex(faces[j * 3 + 0]);
+				const Vector3& b = getVertex(faces[j * 3 + 1]);
+				const Vector3& c = getVertex(faces[j * 3 + 2]);
+
+				// Cross product length is twice the triangle area, and its direction the triangle normal
+				Vector3 normal = Vector3::cross(b - a, c - a);
+				float area = normal.length();
+
+				clusterCentroids[i] += (a + b + c) * (area / 3.0f);
+				clusterNormals[i] += normal;
+				clusterArea += area;
+			}
+
+			meshCentroid += clusterCentroids[i];
+			meshArea += clusterArea;
+
+			if (clusterArea > 0.0f)
+				clusterCentroids[i] /= clusterArea;
+		}
+
+		if (meshArea > 0.0f)
+			meshCentroid /= meshArea;
+
+		Vector<std::pair<float, UINT32>> sortKeys(numClusters);
+		for (UINT32 i = 0; i < numClusters; i++)
+		{
+			Vector3 normal = Vector3::normalize(clusterNormals[i]);
+			sortKeys[i] = std::make_pair(-(clusterCentroids[i] - meshCentroid).dot(normal), i);
+		}
+
+		std::stable_sort(sortKeys.begin(), sortKeys.end(),
+			[](const std::pair<float, UINT32>& lhs, const std::pair<float, UINT32>& rhs)
+		{
+			return lhs.first < rhs.first;
+		});
+
+		UINT32 outputIdx = 0;
+		for (auto& entry : sortKeys)
+		{
+			UINT32 clusterIdx = entry.second;
+			for (UINT32 i = clusterStarts[clusterIdx] * 3; i < clusterStarts[clusterIdx + 1] * 3; i++)
+				writeIndex(indices, outputIdx++, faces[i], indexSize);
+		}
+	}
+
+	UINT32 MeshUtility::optimizeVertexFetch(UINT8* indices, UINT32 numVertices, UINT32 numIndices, UINT32* remap,
+		UINT32 indexSize)
+	{
+		for (UINT32 i = 0; i < numVertices; i++)
+			remap[i] = (UINT32)-1;
+
+		UINT32 numUsedVertices = 0;
+		for (UINT32 i = 0; i < numIndices; i++)
+		{
+			UINT32 vertexIdx = readIndex(indices, i, indexSize);
+			assert(vertexIdx < numVertices);
+
+			if (remap[vertexIdx] == (UINT32)-1)
+				remap[vertexIdx] = numUsedVertices++;
+
+			writeIndex(indices, i, remap[vertexIdx], indexSize);
+		}
+
+		UINT32 nextIdx = numUsedVertices;
+		for (UINT32 i = 0; i < numVertices; i++)
+		{
+			if (remap[i] == (UINT32)-1)
+				remap[i] = nextIdx++;
+		}
+
+		return numUsedVertices;
+	}
+
+	void MeshUtility::remapVertices(UINT8* vertices, UINT32 numVertices, UINT32 vertexSize, const UINT32* remap)
+	{
+		UINT32 bufferSize = numVertices * vertexSize;
+		UINT8* source = (UINT8*)bs_stack_alloc(bufferSize);
+		memcpy(source, vertices, bufferSize);
+
+		for (UINT32 i = 0; i < numVertices; i++)
+			memcpy(vertices + remap[i] * vertexSize, source + i * vertexSize, vertexSize);
+
+		bs_stack_free(source);
+	}
+
+	UINT32 MeshUtility::optimizeVertexOrder(Vector3* vertices, UINT32* indices, UINT32* subMeshIndices, 
+		UINT32 numVertices, UINT32 numIndices, UINT32* remap)
+	{
+		// Group indices by sub-mesh, keeping the relative triangle order within each sub-mesh
+		Vector<Vector<UINT32>> indicesPerSubMesh;
+		for (UINT32 i = 0; i < numIndices; i++)
+		{
+			UINT32 subMeshIdx = subMeshIndices[i];
+			if (subMeshIdx >= (UINT32)indicesPerSubMesh.size())
+				indicesPerSubMesh.resize(subMeshIdx + 1);
+
+			indicesPerSubMesh[subMeshIdx].push_back(indices[i]);
+		}
+
+		// Reorder triangles within each sub-mesh, and store them grouped by sub-mesh
+		UINT32 currentIndex = 0;
+		for (UINT32 i = 0; i < (UINT32)indicesPerSubMesh.size(); i++)
+		{
+			Vector<UINT32>& subMeshIndexData = indicesPerSubMesh[i];
+			UINT32 indexCount = (UINT32)subMeshIndexData.size();
+
+			if (indexCount == 0)
+				continue;
+
+			UINT8* subMeshIndexPtr = (UINT8*)subMeshIndexData.data();
+			optimizeVertexCache(subMeshIndexPtr, numVertices, indexCount);
+			optimizeOverdraw(vertices, subMeshIndexPtr, numVertices, indexCount);
+
+			memcpy(indices + currentIndex, subMeshIndexData.data(), indexCount * sizeof(UINT32));
+			std::fill(subMeshIndices + currentIndex, subMeshIndices + currentIndex + indexCount, i);
+
+			currentIndex += indexCount;
+		}
+
+		// Store vertices in the order they're first referenced by the triangles
+		return optimizeVertexFetch((UINT8*)indices, numVertices, numIndices, remap);
+	}
+
+	VertexCacheStats MeshUtility::calculateVertexCacheStats(UINT8* indices, UINT32 numVertices, UINT32 numIndices,
+		UINT32 indexSize, UINT32 cacheSize)
+	{
+		VertexCacheStats stats;
+
+		UINT32 numFaces = numIndices / 3;
+		if (numFaces == 0)
+			return stats;
+
+		VertexCacheSimulator cache(numVertices, cacheSize);
+		Vector<bool> referenced(numVertices, false);
+
+		UINT32 numMisses = 0;
+		UINT32 numReferenced = 0;
+		for (UINT32 i = 0; i < numFaces * 3; i++)
+		{
+			UINT32 vertexIdx = readIndex(indices, i, indexSize);
+			if (cache.transform(vertexIdx))
+				numMisses++;
+
+			if (!referenced[vertexIdx])
+			{
+				referenced[vertexIdx] = true;
+				numReferenced++;
+			}
+		}
+
+		stats.acmr = numMisses / (float)numFaces;
+		stats.atvr = numMisses / (float)numReferenced;
+
+		return stats;
+	}
+}
@@ -24,6 +24,19 @@ namespace bs
 		UINT32 packed;
 	};
 
+	/** Describes how efficiently an index buffer uses the post-transform vertex cache. */
+	struct VertexCacheStats
+	{
+		/** Average number of vertices transformed per triangle (average cache miss ratio). Ranges from 0.5 to 3. */
+		float acmr = 0.0f;
+
+		/** 
+		 * Average number of times each referenced vertex is transformed (average transform to vertex ratio). 1 is
+		 * optimal.
+		 */
+		float atvr = 0.0f;
+	};
+
 	/** Performs various operations on mesh geometry. */
 	class BS_CORE_EXPORT MeshUtility
 	{
@@ -177,6 +190,103 @@ namespace bs
 		 * @param[in]	stride			Distance between two entries in the @p source buffer, in bytes.
 		 */
 		static void unpackNormals(UINT8* source, Vector4* destination, UINT32 count, UINT32 stride);
+
+		/**
+		 * Reorders triangles so that vertices shared between them are more likely to be found in the post-transform
+		 * vertex cache, reducing the number of times each vertex needs to be transformed. Uses the linear-speed vertex
+		 * cache optimization by Tom Forsyth.
+		 *
+		 * @param[in, out]	indices		Set of indices containing indexes into vertex array for each triangle. Triangles
+		 *								will be reordered in place.
+		 * @param[in]		numVertices	Number of vertices referenced by the @p indices array.
+		 * @param[in]		numIndices	Number of indices in the @p indices array. Must be a multiple of three.
+		 * @param[in]		indexSize	Size of a single index in the indices array, in bytes.
+		 * @param[in]		cacheSize	Number of vertices in the cache the triangle order is optimized for.
+		 */
+		static void optimizeVertexCache(UINT8* indices, UINT32 numVertices, UINT32 numIndices, UINT32 indexSize = 4,
+			UINT32 cacheSize = 16);
+
+		/**
+		 * Reorders triangles so that triangles that are likely to occlude other triangles are rendered first, reducing
+		 * overdraw. Triangles are split into clusters that are efficient on their own for the post-transform vertex
+		 * cache, and clusters are then ordered by how much they face away from the center of the mesh. Should be called
+		 * after optimizeVertexCache().
+		 *
+		 * @param[in]		vertices		Set of vertices containing vertex positions.
+		 * @param[in, out]	indices			Set of indices containing indexes into vertex array for each triangle.
+		 *									Triangles will be reordered in place.
+		 * @param[in]		numVertices		Number of vertices in the @p vertices array.
+		 * @param[in]		numIndices		Number of indices in the @p indices array. Must be a multiple of three.
+		 * @param[in]		indexSize		Size of a single index in the indices array, in bytes.
+		 * @param[in]		vertexStride	Number of bytes to advance the @p vertices array with each vertex. If set to
+		 *									zero the array is advanced according to the size of Vector3.
+		 * @param[in]		threshold		Determines how much worse than the current triangle order a cluster is
+		 *									allowed to be for the post-transform vertex cache. Higher values result in
+		 *									smaller clusters and less overdraw, at the cost of more vertex transforms.
+		 * @param[in]		cacheSize		Number of vertices in the cache used for evaluating cluster efficiency.
+		 */
+		static void optimizeOverdraw(Vector3* vertices, UINT8* indices, UINT32 numVertices, UINT32 numIndices, 
+			UINT32 indexSize = 4, UINT32 vertexStride = 0, float threshold = 1.05f, UINT32 cacheSize = 16);
+
+		/**
+		 * Generates a new vertex order in which vertices are stored in the order they are first referenced by the
+		 * triangles, improving memory locality of vertex fetches. Indices are updated to reference the new order, while
+		 * vertex data must be reordered by calling remapVertices() with the generated @p remap table.
+		 *
+		 * @param[in, out]	indices		Set of indices containing indexes into vertex array for each triangle.
+		 * @param[in]		numVertices	Number of vertices referenced by the @p indices array.
+		 * @param[in]		numIndices	Number of indices in the @p indices array.
+		 * @param[out]		remap		Pre-allocated buffer that will contain the new index of each vertex. Must be the
+		 *								same size as the vertex array. Vertices not referenced by any triangle are placed
+		 *								after all the referenced vertices.
+		 * @param[in]		indexSize	Size of a single index in the indices array, in bytes.
+		 * @return						Number of vertices referenced by the triangles.
+		 */
+		static UINT32 optimizeVertexFetch(UINT8* indices, UINT32 numVertices, UINT32 numIndices, UINT32* remap,
+			UINT32 indexSize = 4);
+
+		/**
+		 * Reorders vertex data according to a remap table, as generated by optimizeVertexFetch().
+		 *
+		 * @param[in, out]	vertices	Buffer containing data for each vertex. Will be reordered in place.
+		 * @param[in]		numVertices	Number of vertices in the @p vertices array.
+		 * @param[in]		vertexSize	Size of the data of a single vertex, in bytes.
+		 * @param[in]		remap		New index of each vertex. Must be the same size as the vertex array.
+		 */
+		static void remapVertices(UINT8* vertices, UINT32 numVertices, UINT32 vertexSize, const UINT32* remap);
+
+		/**
+		 * Optimizes the triangle and vertex order of a mesh consisting of multiple sub-meshes. Triangles are grouped by
+		 * sub-mesh in increasing sub-mesh order, and triangles of each sub-mesh are reordered using optimizeVertexCache()
+		 * and optimizeOverdraw(). Vertices are then reordered using optimizeVertexFetch(). Vertex data (including the 
+		 * positions) must be reordered by calling remapVertices() with the generated @p remap table.
+		 *
+		 * @param[in]		vertices		Set of vertices containing vertex positions.
+		 * @param[in, out]	indices			Set of 32-bit indices containing indexes into vertex array for each triangle.
+		 * @param[in, out]	subMeshIndices	Index of the sub-mesh each entry in @p indices belongs to. All three indices
+		 *									of a triangle must belong to the same sub-mesh. Reordered along with the
+		 *									indices.
+		 * @param[in]		numVertices		Number of vertices in the @p vertices array.
+		 * @param[in]		numIndices		Number of indices in the @p indices array. Must be a multiple of three.
+		 * @param[out]		remap			Pre-allocated buffer that will contain the new index of each vertex. Must be
+		 *									the same size as the vertex array.
+		 * @return							Number of vertices referenced by the triangles.
+		 */
+		static UINT32 optimizeVertexOrder(Vector3* vertices, UINT32* indices, UINT32* subMeshIndices, UINT32 numVertices,
+			UINT32 numIndices, UINT32* remap);
+
+		/**
+		 * Simulates rendering of the provided triangles using a FIFO post-transform vertex cache, and returns statistics
+		 * about how efficiently the cache was used.
+		 *
+		 * @param[in]	indices		Set of indices containing indexes into vertex array for each triangle.
+		 * @param[in]	numVertices	Number of vertices referenced by the @p indices array.
+		 * @param[in]	numIndices	Number of indices in the @p indices array. Must be a multiple of three.
+		 * @param[in]	indexSize	Size of a single index in the indices array, in bytes.
+		 * @param[in]	cacheSize	Number of vertices in the simulated cache.
+		 */
+		static VertexCacheStats calculateVertexCacheStats(UINT8* indices, UINT32 numVertices, UINT32 numIndices, 
+			UINT32 indexSize = 4, UINT32 cacheSize = 16);
 	};
 
 	/** @} */
@@ -29,7 +29,7 @@ namespace bs
 		RenderStatsData()
 		: numDrawCalls(0), numComputeCalls(0), numRenderTargetChanges(0), numPresents(0), numClears(0)
 		, numVertices(0), numPrimitives(0), numPipelineStateChanges(0), numGpuParamBinds(0), numVertexBufferBinds(0)
-		, numIndexBufferBinds(0)
+		, numIndexBufferBinds(0), numOcclusionCulled(0), numOcclusionVisible(0)
 		{ }
 
 		UINT64 numDrawCalls;
@@ -52,6 +52,9 @@ namespace bs
 
 		UINT64 numObjectsCreated; 
 		UINT64 numObjectsDestroyed;
+
+		UINT64 numOcclusionCulled;
+		UINT64 numOcclusionVisible;
 	};
 
 	/**
@@ -98,6 +101,12 @@ namespace bs
 		/** Increments index buffer change counter indicating how many times was a index buffer bound to the pipeline. */
 		void incNumIndexBufferBinds() { mData.numIndexBufferBinds++; }
 
+		/** Increments the counter of objects that were hidden behind occluders and culled by the renderer. */
+		void addNumOcclusionCulled(UINT32 count) { mData.numOcclusionCulled += count; }
+
+		/** Increments the counter of objects that were tested for occlusion by the renderer and found visible. */
+		void addNumOcclusionVisible(UINT32 count) { mData.numOcclusionVisible += count; }
+
 		/**
 		 * Increments created GPU resource counter. 
 		 *
@@ -41,7 +41,14 @@ namespace bs
 
 		void setData(AudioClip* obj, const SPtr<DataStream>& val, UINT32 size)
 		{
-			obj->mStreamData = val->clone(); // Making sure that the AudioClip cannot modify the source stream, which is still used by the deserializer
+			// Re-open mapped resource files as regular file streams, so streaming clips read the file as needed instead of
+			// keeping a copy of the whole file in memory
+			SPtr<MappedFileDataStream> mappedStream = std::dynamic_pointer_cast<MappedFileDataStream>(val);
+			if (mappedStream != nullptr)
+				obj->mStreamData = bs_shared_ptr_new<FileDataStream>(mappedStream->getPath(), DataStream::READ, true);
+			else
+				obj->mStreamData = val->clone(); // Making sure that the AudioClip cannot modify the source stream, which is still used by the deserializer
+
 			obj->mStreamSize = size;
 			obj->mStreamOffset = (UINT32)val->tell();
 		}
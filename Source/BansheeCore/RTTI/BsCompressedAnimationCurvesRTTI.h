@@ -0,0 +1,68 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Reflection/BsRTTIType.h"
+#include "Animation/BsCompressedAnimationCurves.h"
+
+namespace bs
+{
+	/** @cond RTTI */
+	/** @addtogroup RTTI-Impl-Core
+	 *  @{
+	 */
+
+	class BS_CORE_EXPORT CompressedAnimationCurvesRTTI : 
+		public RTTIType <CompressedAnimationCurves, IReflectable, CompressedAnimationCurvesRTTI>
+	{
+	private:
+		BS_BEGIN_RTTI_MEMBERS
+			BS_RTTI_MEMBER_PLAIN(mSampleRate, 0)
+			BS_RTTI_MEMBER_PLAIN(mLength, 1)
+			BS_RTTI_MEMBER_PLAIN(mNumFrames, 2)
+			BS_RTTI_MEMBER_PLAIN(mFrameStride, 3)
+			BS_RTTI_MEMBER_PLAIN(mNumAnimatedPositions, 4)
+			BS_RTTI_MEMBER_PLAIN(mNumAnimatedRotations, 5)
+			BS_RTTI_MEMBER_PLAIN(mNumAnimatedScales, 6)
+			BS_RTTI_MEMBER_PLAIN_ARRAY(mPositionSlots, 7)
+			BS_RTTI_MEMBER_PLAIN_ARRAY(mRotationSlots, 8)
+			BS_RTTI_MEMBER_PLAIN_ARRAY(mScaleSlots, 9)
+			BS_RTTI_MEMBER_PLAIN_ARRAY(mPositionMin, 10)
+			BS_RTTI_MEMBER_PLAIN_ARRAY(mPositionExtent, 11)
+			BS_RTTI_MEMBER_PLAIN_ARRAY(mScaleMin, 12)
+			BS_RTTI_MEMBER_PLAIN_ARRAY(mScaleExtent, 13)
+			BS_RTTI_MEMBER_PLAIN_ARRAY(mRotationConstants, 14)
+			BS_RTTI_MEMBER_PLAIN_ARRAY(mFrameData, 15)
+			BS_RTTI_MEMBER_PLAIN_NAMED(uncompressedSize, mStats.uncompressedSize, 16)
+			BS_RTTI_MEMBER_PLAIN_NAMED(compressedSize, mStats.compressedSize, 17)
+			BS_RTTI_MEMBER_PLAIN_NAMED(maxPositionError, mStats.maxPositionError, 18)
+			BS_RTTI_MEMBER_PLAIN_NAMED(maxRotationError, mStats.maxRotationError, 19)
+			BS_RTTI_MEMBER_PLAIN_NAMED(maxScaleError, mStats.maxScaleError, 20)
+		BS_END_RTTI_MEMBERS
+
+	public:
+		CompressedAnimationCurvesRTTI()
+			:mInitMembers(this)
+		{ }
+
+		const String& getRTTIName() override
+		{
+			static String name = "CompressedAnimationCurves";
+			return name;
+		}
+
+		UINT32 getRTTIId() override
+		{
+			return TID_CompressedAnimationCurves;
+		}
+
+		SPtr<IReflectable> newRTTIObject() override
+		{
+			return CompressedAnimationCurves::createEmpty();
+		}
+	};
+
+	/** @} */
+	/** @endcond */
+}
@@ -23,6 +23,8 @@ namespace bs
 			BS_RTTI_MEMBER_REFL(mMesh, 3)
 			BS_RTTI_MEMBER_PLAIN(mLayer, 4)
 			BS_RTTI_MEMBER_REFL_ARRAY(mMaterials, 5)
+			BS_RTTI_MEMBER_PLAIN(mUseAsOccluder, 6)
+			BS_RTTI_MEMBER_PLAIN(mOccluderBounds, 7)
 		BS_END_RTTI_MEMBERS
 
 	public:
@@ -5,6 +5,7 @@
 #include "BsCorePrerequisites.h"
 #include "Reflection/BsRTTIType.h"
 #include "Scene/BsSceneObject.h"
+#include "Scene/BsTransformHierarchy.h"
 #include "Scene/BsGameObjectHandle.h"
 #include "Scene/BsGameObjectManager.h"
 #include "Scene/BsComponent.h"
@@ -28,11 +29,15 @@ namespace bs
 	class BS_CORE_EXPORT SceneObjectRTTI : public RTTIType<SceneObject, GameObject, SceneObjectRTTI>
 	{
 	private:
-		Transform& getTransform(SceneObject* obj) { return obj->mWorldTfrm; }
-		void setTransform(SceneObject* obj, Transform& value) { obj->mWorldTfrm = value; }
+		Transform& getTransform(SceneObject* obj) { return const_cast<Transform&>(obj->getTransform()); }
+		void setTransform(SceneObject* obj, Transform& value) { /* World transform is derived from the local one */ }
 
-		Transform& getLocalTransform(SceneObject* obj) { return obj->mLocalTfrm; }
-		void setLocalTransform(SceneObject* obj, Transform& value) { obj->mLocalTfrm = value; }
+		Transform& getLocalTransform(SceneObject* obj) { return obj->getLocalTfrmInternal(); }
+		void setLocalTransform(SceneObject* obj, Transform& value)
+		{
+			obj->getLocalTfrmInternal() = value;
+			TransformHierarchy::instance().markDirty(obj->mTransformId);
+		}
 
 		bool& getActive(SceneObject* obj) { return obj->mActiveSelf; }
 		void setActive(SceneObject* obj, bool& value) { obj->mActiveSelf = value; }
@@ -86,7 +91,11 @@ namespace bs
 		void setPrefabHash(SceneObject* obj, UINT32& value) { obj->mPrefabHash = value; }
 
 		ObjectMobility& getMobility(SceneObject* obj) { return obj->mMobility; }
-		void setMobility(SceneObject* obj, ObjectMobility& value) { obj->mMobility = value; }
+		void setMobility(SceneObject* obj, ObjectMobility& value)
+		{
+			obj->mMobility = value;
+			TransformHierarchy::instance().setMovable(obj->mTransformId, value == ObjectMobility::Movable);
+		}
 	public:
 		SceneObjectRTTI()
 		{
@@ -48,6 +48,12 @@ namespace bs
 				&SkeletonRTTI::setBoneInfo, &SkeletonRTTI::setNumBoneInfos);
 		}
 
+		void onDeserializationEnded(IReflectable* obj, const UnorderedMap<String, UINT64>& params) override
+		{
+			Skeleton* skeleton = static_cast<Skeleton*>(obj);
+			skeleton->initialize();
+		}
+
 		const String& getRTTIName() override
 		{
 			static String name = "Skeleton";
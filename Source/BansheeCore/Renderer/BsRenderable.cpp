@@ -27,8 +27,8 @@ namespace bs
 
 	template<bool Core>
 	TRenderable<Core>::TRenderable()
-		: mLayer(1), mUseOverrideBounds(false), mTfrmMatrix(BsIdentity), mTfrmMatrixNoScale(BsIdentity)
-		, mAnimType(RenderableAnimType::None)
+		: mLayer(1), mUseOverrideBounds(false), mUseAsOccluder(false), mTfrmMatrix(BsIdentity)
+		, mTfrmMatrixNoScale(BsIdentity), mAnimType(RenderableAnimType::None)
 	{
 		mMaterials.resize(1);
 	}
@@ -140,6 +140,25 @@ namespace bs
 		_markCoreDirty();
 	}
 
+	template<bool Core>
+	void TRenderable<Core>::setOccluderBounds(const AABox& bounds)
+	{
+		mOccluderBounds = bounds;
+
+		if(mUseAsOccluder)
+			_markCoreDirty();
+	}
+
+	template<bool Core>
+	void TRenderable<Core>::setUseAsOccluder(bool enable)
+	{
+		if (mUseAsOccluder == enable)
+			return;
+
+		mUseAsOccluder = enable;
+		_markCoreDirty();
+	}
+
 	template class TRenderable < false >;
 	template class TRenderable < true >;
 
@@ -308,6 +327,8 @@ namespace bs
 			rttiGetElemSize(mLayer) + 
 			rttiGetElemSize(mOverrideBounds) + 
 			rttiGetElemSize(mUseOverrideBounds) +
+			rttiGetElemSize(mOccluderBounds) + 
+			rttiGetElemSize(mUseAsOccluder) +
 			rttiGetElemSize(numMaterials) + 
 			rttiGetElemSize(mTfrmMatrix) +
 			rttiGetElemSize(mTfrmMatrixNoScale) +
@@ -323,6 +344,8 @@ namespace bs
 		dataPtr = rttiWriteElem(mLayer, dataPtr);
 		dataPtr = rttiWriteElem(mOverrideBounds, dataPtr);
 		dataPtr = rttiWriteElem(mUseOverrideBounds, dataPtr);
+		dataPtr = rttiWriteElem(mOccluderBounds, dataPtr);
+		dataPtr = rttiWriteElem(mUseAsOccluder, dataPtr);
 		dataPtr = rttiWriteElem(numMaterials, dataPtr);
 		dataPtr = rttiWriteElem(mTfrmMatrix, dataPtr);
 		dataPtr = rttiWriteElem(mTfrmMatrixNoScale, dataPtr);
@@ -594,6 +617,8 @@ namespace bs
 		dataPtr = rttiReadElem(mLayer, dataPtr);
 		dataPtr = rttiReadElem(mOverrideBounds, dataPtr);
 		dataPtr = rttiReadElem(mUseOverrideBounds, dataPtr);
+		dataPtr = rttiReadElem(mOccluderBounds, dataPtr);
+		dataPtr = rttiReadElem(mUseAsOccluder, dataPtr);
 		dataPtr = rttiReadElem(numMaterials, dataPtr);
 		dataPtr = rttiReadElem(mTfrmMatrix, dataPtr);
 		dataPtr = rttiReadElem(mTfrmMatrixNoScale, dataPtr);
@@ -95,6 +95,26 @@ namespace bs
 		 */
 		void setUseOverrideBounds(bool enable);
 
+		/**
+		 * Sets a box, in local space, used for hiding other objects during occlusion culling. The box must be fully 
+		 * contained within the rendered geometry (e.g. the inside of a wall or a building), otherwise objects that are
+		 * actually visible might get culled. Only relevant if setUseAsOccluder() is set to true.
+		 */
+		void setOccluderBounds(const AABox& bounds);
+
+		/** @copydoc setOccluderBounds() */
+		const AABox& getOccluderBounds() const { return mOccluderBounds; }
+
+		/**
+		 * Determines if the renderable is used for hiding other objects during occlusion culling. Good occluders are large
+		 * opaque objects such as walls, terrain or buildings. Occluder shape is provided through setOccluderBounds(). 
+		 * Disabled by default.
+		 */
+		void setUseAsOccluder(bool enable);
+
+		/** @copydoc setUseAsOccluder() */
+		bool getUseAsOccluder() const { return mUseAsOccluder; }
+
 		/** @copydoc setLayer() */
 		UINT64 getLayer() const { return mLayer; }
 
@@ -132,6 +152,8 @@ namespace bs
 		UINT64 mLayer;
 		AABox mOverrideBounds;
 		bool mUseOverrideBounds;
+		AABox mOccluderBounds;
+		bool mUseAsOccluder;
 		Matrix4 mTfrmMatrix;
 		Matrix4 mTfrmMatrixNoScale;
 		RenderableAnimType mAnimType;
@@ -0,0 +1,306 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "Resources/BsAsyncResourceLoader.h"
+#include "Resources/BsResource.h"
+#include "Resources/BsSavedResourceData.h"
+#include "Threading/BsTaskScheduler.h"
+#include "FileSystem/BsFileSystem.h"
+#include "FileSystem/BsDataStream.h"
+#include "Serialization/BsBinarySerializer.h"
+#include "Utility/BsCompression.h"
+#include "BsCoreApplication.h"
+
+namespace bs
+{
+	/** Returns the parameters passed to the serializer when decoding resource files. */
+	static UnorderedMap<String, UINT64> getDecodeParams(bool keepSourceData)
+	{
+		UnorderedMap<String, UINT64> params;
+		if (keepSourceData)
+			params["keepSourceData"] = 1;
+
+		return params;
+	}
+
+	AsyncResourceLoader::AsyncResourceLoader(UINT64 memoryBudget)
+		:mMemoryBudget(memoryBudget)
+	{ }
+
+	AsyncResourceLoader::~AsyncResourceLoader()
+	{
+		stop();
+	}
+
+	void AsyncResourceLoader::load(const Path& filePath, bool keepSourceData, const LoadedCallback& callback)
+	{
+		SPtr<LoadRequest> request = bs_shared_ptr_new<LoadRequest>();
+		request->filePath = filePath;
+		request->keepSourceData = keepSourceData;
+		request->callback = callback;
+		request->size = 0;
+
+		{
+			Lock lock(mMutex);
+			mQueuedRequests.push_back(request);
+
+			if (!mIOThreadRunning)
+			{
+				mIOThreadRunning = true;
+				mIOThread = ThreadPool::instance().run("ResourceIO", std::bind(&AsyncResourceLoader::runIOThread, this));
+			}
+		}
+
+		mRequestQueuedCond.notify_one();
+	}
+
+	void AsyncResourceLoader::setMemoryBudget(UINT64 memoryBudget)
+	{
+		{
+			Lock lock(mMutex);
+			mMemoryBudget = memoryBudget;
+		}
+
+		mRequestFinishedCond.notify_all();
+	}
+
+	void AsyncResourceLoader::stop()
+	{
+		{
+			Lock lock(mMutex);
+			if (!mIOThreadRunning)
+				return;
+
+			mShutdown = true;
+		}
+
+		// I/O thread exits once it reads all the queued files
+		mRequestQueuedCond.notify_all();
+		mIOThread.blockUntilComplete();
+
+		Lock lock(mMutex);
+		while (mNumInFlight > 0)
+			mRequestFinishedCond.wait(lock);
+
+		mIOThreadRunning = false;
+		mShutdown = false;
+	}
+
+	void AsyncResourceLoader::runIOThread()
+	{
+		while (true)
+		{
+			Vector<SPtr<LoadRequest>> requests;
+			{
+				Lock lock(mMutex);
+				while (mQueuedRequests.empty() && !mShutdown)
+					mRequestQueuedCond.wait(lock);
+
+				if (mQueuedRequests.empty())
+					break;
+
+				std::swap(requests, mQueuedRequests);
+			}
+
+			// Read in path order, so files from the same folder (likely close together on disk) are read together
+			std::sort(requests.begin(), requests.end(),
+				[](const SPtr<LoadRequest>& a, const SPtr<LoadRequest>& b)
+			{
+				return a->filePath.toString() < b->filePath.toString();
+			});
+
+			for (auto& request : requests)
+			{
+				// Map the file without paging it in, so its header can be checked before any of the budget is used
+				SPtr<DataStream> fileData = readFile(request->filePath, false);
+				request->size = fileData != nullptr ? getMemoryUsage(fileData) : 0;
+
+				// Wait until loads in progress free up enough of the budget
+				{
+					Lock lock(mMutex);
+					while (mNumInFlight > 0 && mInFlightBytes + request->size > mMemoryBudget)
+						mRequestFinishedCond.wait(lock);
+
+					mNumInFlight++;
+					mInFlightBytes += request->size;
+				}
+
+				RequestGuard guard(this, request);
+				if (fileData == nullptr)
+					continue;
+
+				std::static_pointer_cast<MappedFileDataStream>(fileData)->prefetch();
+
+				String taskName = "Resource decompress: " + request->filePath.getFilename();
+				SPtr<Task> task = Task::create(taskName,
+					std::bind(&AsyncResourceLoader::decompressStage, this, request, fileData));
+
+				TaskScheduler::instance().addTask(task);
+				guard.release();
+			}
+		}
+	}
+
+	void AsyncResourceLoader::decompressStage(const SPtr<LoadRequest>& request, const SPtr<DataStream>& fileData)
+	{
+		RequestGuard guard(this, request);
+
+		SPtr<ResourceFileData> resourceData = bs_shared_ptr_new<ResourceFileData>();
+		if (!decompress(fileData, request->keepSourceData, *resourceData))
+			return;
+
+		String taskName = "Resource deserialize: " + request->filePath.getFilename();
+		SPtr<Task> task = Task::create(taskName,
+			std::bind(&AsyncResourceLoader::deserializeStage, this, request, resourceData));
+
+		TaskScheduler::instance().addTask(task);
+		guard.release();
+	}
+
+	void AsyncResourceLoader::deserializeStage(const SPtr<LoadRequest>& request,
+		const SPtr<ResourceFileData>& fileData)
+	{
+		RequestGuard guard(this, request);
+		SPtr<Resource> resource = deserialize(*fileData, request->keepSourceData);
+
+		// Release the file data before the budget it uses is released
+		fileData->resourceStream = nullptr;
+
+		guard.release();
+		finishRequest(request, resource);
+	}
+
+	void AsyncResourceLoader::finishRequest(const SPtr<LoadRequest>& request, const SPtr<Resource>& resource)
+	{
+		request->callback(resource);
+
+		{
+			Lock lock(mMutex);
+			mNumInFlight--;
+			mInFlightBytes -= request->size;
+		}
+
+		mRequestFinishedCond.notify_all();
+	}
+
+	SPtr<DataStream> AsyncResourceLoader::readFile(const Path& filePath, bool prefetch)
+	{
+		SPtr<MappedFileDataStream> stream = bs_shared_ptr_new<MappedFileDataStream>(filePath);
+		if (stream->size() == 0)
+			return nullptr;
+
+		if (stream->size() > std::numeric_limits<UINT32>::max())
+		{
+			LOGERR("Cannot load resource \"" + filePath.toString() + "\". File size is larger that UINT32 can hold.");
+			return nullptr;
+		}
+
+		// Page the whole file in now, so the following stages don't stall on I/O
+		if (prefetch)
+			stream->prefetch();
+
+		return stream;
+	}
+
+	UINT64 AsyncResourceLoader::getMemoryUsage(const SPtr<DataStream>& fileData)
+	{
+		UINT64 memoryUsage = fileData->size();
+
+		// Decompressed data is held in memory alongside the mapped file
+		ResourceFileData header;
+		if (readHeader(fileData, false, header) &&
+			(CompressionMethod)header.metaData->getCompressionMethod() != CompressionMethod::None)
+		{
+			memoryUsage += header.resourceSize;
+		}
+
+		fileData->seek(0);
+		return memoryUsage;
+	}
+
+	bool AsyncResourceLoader::readHeader(const SPtr<DataStream>& fileData, bool keepSourceData,
+		ResourceFileData& output)
+	{
+		UnorderedMap<String, UINT64> params = getDecodeParams(keepSourceData);
+
+		// Read meta-data
+		if (fileData->eof())
+			return false;
+
+		UINT32 metaDataSize = 0;
+		fileData->read(&metaDataSize, sizeof(metaDataSize));
+
+		BinarySerializer bs;
+		output.metaData = std::static_pointer_cast<SavedResourceData>(bs.decode(fileData, metaDataSize, params));
+
+		// Read resource data size
+		if (output.metaData == nullptr || fileData->eof())
+			return false;
+
+		fileData->read(&output.resourceSize, sizeof(output.resourceSize));
+		return true;
+	}
+
+	bool AsyncResourceLoader::decompress(const SPtr<DataStream>& fileData, bool keepSourceData,
+		ResourceFileData& output)
+	{
+		if (!readHeader(fileData, keepSourceData, output))
+			return false;
+
+		SPtr<DataStream> stream = fileData;
+		switch ((CompressionMethod)output.metaData->getCompressionMethod())
+		{
+		case CompressionMethod::None:
+			break;
+		case CompressionMethod::Snappy:
+			stream = Compression::decompress(stream);
+			break;
+		case CompressionMethod::SnappyChunked:
+			stream = Compression::decompressChunked(stream);
+			break;
+		default:
+			LOGERR("Unsupported compression method: " + toString(output.metaData->getCompressionMethod()));
+			return false;
+		}
+
+		if (stream == nullptr)
+			return false;
+
+		output.resourceStream = stream;
+		return true;
+	}
+
+	SPtr<Resource> AsyncResourceLoader::deserialize(const ResourceFileData& fileData, bool keepSourceData)
+	{
+		if (fileData.resourceStream == nullptr)
+			return nullptr;
+
+		UnorderedMap<String, UINT64> params = getDecodeParams(keepSourceData);
+
+		// Data referencing the mapping keeps the file mapped, and the editor may re-save the resource while the data is 
+		// still alive. Mapped pages go missing once the file is truncated, and on some platforms a mapped file can't be
+		// written at all. In such cases decode through a regular file stream instead, which always copies the data out
+		// of the file. The file was already paged in by readFile(), so the reads don't need to wait on the disk.
+		SPtr<DataStream> stream = fileData.resourceStream;
+		bool isEditor = CoreApplication::isStarted() && gCoreApplication().isEditor();
+		if (stream->isMapped() && (keepSourceData || isEditor))
+		{
+			SPtr<MappedFileDataStream> mappedStream = std::static_pointer_cast<MappedFileDataStream>(stream);
+
+			stream = bs_shared_ptr_new<FileDataStream>(mappedStream->getPath(), DataStream::READ, true);
+			stream->seek(mappedStream->tell());
+		}
+
+		BinarySerializer bs;
+		SPtr<IReflectable> loadedData = bs.decode(stream, fileData.resourceSize, params);
+		if (loadedData == nullptr)
+			return nullptr;
+
+		if (!loadedData->isDerivedFrom(Resource::getRTTIStatic()))
+		{
+			LOGERR("Loaded class doesn't derive from Resource.");
+			return nullptr;
+		}
+
+		return std::static_pointer_cast<Resource>(loadedData);
+	}
+}
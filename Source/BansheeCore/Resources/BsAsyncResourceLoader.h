@@ -0,0 +1,161 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Threading/BsThreadPool.h"
+
+namespace bs
+{
+	class SavedResourceData;
+
+	/** @addtogroup Resources-Internal
+	 *  @{
+	 */
+
+	/** Contents of a resource file split into its parts, with the resource data decompressed and ready to deserialize. */
+	struct ResourceFileData
+	{
+		SPtr<SavedResourceData> metaData;
+		SPtr<DataStream> resourceStream;
+		UINT32 resourceSize = 0;
+	};
+
+	/**
+	 * Loads resource files asynchronously, in a pipeline of three stages:
+	 *  - Files are read into memory on a single dedicated I/O thread, as storage devices perform best when reading one
+	 *    file at a time in order.
+	 *  - Read data is decompressed in parallel on the TaskScheduler workers.
+	 *  - Decompressed data is deserialized in parallel on the TaskScheduler workers.
+	 *
+	 * The amount of memory held by loads in progress, counting both the file data and its decompressed contents, is
+	 * limited by a memory budget. The I/O thread stops reading new files until enough in-flight loads complete.
+	 */
+	class BS_CORE_EXPORT AsyncResourceLoader
+	{
+	public:
+		/**
+		 * Callback triggered when a load completes, receiving the deserialized resource or null if the load failed.
+		 * Triggered from an arbitrary thread.
+		 */
+		typedef std::function<void(const SPtr<Resource>&)> LoadedCallback;
+
+		/**
+		 * @param[in]	memoryBudget	Maximum amount of memory, in bytes, held by loads in progress (see 
+		 *								getMemoryUsage()). A file requiring more than the budget is still loaded, but
+		 *								only once no other loads are in progress.
+		 */
+		AsyncResourceLoader(UINT64 memoryBudget = 256 * 1024 * 1024);
+		~AsyncResourceLoader();
+
+		/**
+		 * Queues a resource file for loading.
+		 *
+		 * @param[in]	filePath		Path of the resource file to load.
+		 * @param[in]	keepSourceData	If true the resource will keep its source data after it's initialized. See
+		 *								ResourceLoadFlag::KeepSourceData.
+		 * @param[in]	callback		Callback to trigger once the load completes.
+		 */
+		void load(const Path& filePath, bool keepSourceData, const LoadedCallback& callback);
+
+		/** @copydoc AsyncResourceLoader::AsyncResourceLoader */
+		void setMemoryBudget(UINT64 memoryBudget);
+
+		/** Blocks until all queued loads complete, and stops the I/O thread. The loader can still be used afterwards. */
+		void stop();
+
+		/**
+		 * Maps the file at the specified path into memory and optionally pages it in. Returns null if the file cannot be
+		 * opened, is empty or is too large. Uncompressed data blocks of resources deserialized from the mapping reference
+		 * it without copying, unless the resource is loaded with source data or in the editor (see deserialize()).
+		 */
+		static SPtr<DataStream> readFile(const Path& filePath, bool prefetch = true);
+
+		/**
+		 * Returns the amount of memory, in bytes, held while loading the file read by readFile(). This is the size of the
+		 * file, plus the size of the decompressed resource data if the file is compressed.
+		 */
+		static UINT64 getMemoryUsage(const SPtr<DataStream>& fileData);
+
+		/**
+		 * Parses the contents of a resource file read by readFile(), deserializing the meta-data and decompressing the
+		 * resource data if required. Returns false if the data is invalid.
+		 */
+		static bool decompress(const SPtr<DataStream>& fileData, bool keepSourceData, ResourceFileData& output);
+
+		/**
+		 * Deserializes the resource data parsed by decompress(). Returns null if the data is invalid. Data blocks are
+		 * copied out of the file instead of referencing its mapping if @p keepSourceData is enabled or if running in the
+		 * editor, as the file may then be re-saved while the data is still alive.
+		 */
+		static SPtr<Resource> deserialize(const ResourceFileData& fileData, bool keepSourceData);
+
+	private:
+		/** Information about a single load operation. */
+		struct LoadRequest
+		{
+			Path filePath;
+			bool keepSourceData;
+			LoadedCallback callback;
+			UINT64 size;
+		};
+
+		/** Main loop of the I/O thread. */
+		void runIOThread();
+
+		/** Executes the decompression stage for the provided data, and queues the deserialization stage. */
+		void decompressStage(const SPtr<LoadRequest>& request, const SPtr<DataStream>& fileData);
+
+		/** Executes the deserialization stage and triggers the load callback. */
+		void deserializeStage(const SPtr<LoadRequest>& request, const SPtr<ResourceFileData>& fileData);
+
+		/** Releases the memory budget used by a request, and triggers its callback. */
+		void finishRequest(const SPtr<LoadRequest>& request, const SPtr<Resource>& resource);
+
+		/**
+		 * Reads the meta-data and the size of the resource data from the start of a resource file. Returns false if the
+		 * data is invalid.
+		 */
+		static bool readHeader(const SPtr<DataStream>& fileData, bool keepSourceData, ResourceFileData& output);
+
+		/**
+		 * Fails the guarded request once it goes out of scope, unless release() was called. Ensures a stage always 
+		 * releases the memory budget of its request, whichever way it exits.
+		 */
+		class RequestGuard
+		{
+		public:
+			RequestGuard(AsyncResourceLoader* loader, const SPtr<LoadRequest>& request)
+				:mLoader(loader), mRequest(request)
+			{ }
+
+			~RequestGuard()
+			{
+				if (mRequest != nullptr)
+					mLoader->finishRequest(mRequest, nullptr);
+			}
+
+			/** Signals that the request was passed on to the next stage, or finished. */
+			void release() { mRequest = nullptr; }
+
+		private:
+			AsyncResourceLoader* mLoader;
+			SPtr<LoadRequest> mRequest;
+		};
+
+		Vector<SPtr<LoadRequest>> mQueuedRequests;
+		UINT32 mNumInFlight = 0;
+		UINT64 mInFlightBytes = 0;
+		UINT64 mMemoryBudget;
+
+		bool mIOThreadRunning = false;
+		bool mShutdown = false;
+		HThread mIOThread;
+
+		Mutex mMutex;
+		Signal mRequestQueuedCond;
+		Signal mRequestFinishedCond;
+	};
+
+	/** @} */
+}
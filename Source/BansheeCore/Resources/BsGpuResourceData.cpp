@@ -4,6 +4,7 @@
 #include "RTTI/BsGpuResourceDataRTTI.h"
 #include "CoreThread/BsCoreThread.h"
 #include "Error/BsException.h"
+#include "FileSystem/BsDataStream.h"
 
 namespace bs
 {
@@ -18,6 +19,7 @@ namespace bs
 		mData = copy.mData;
 		mLocked = copy.mLocked; // TODO - This should be shared by all copies pointing to the same data?
 		mOwnsData = false;
+		mMappedSource = copy.mMappedSource;
 	}
 
 	GpuResourceData::~GpuResourceData()
@@ -30,6 +32,7 @@ namespace bs
 		mData = rhs.mData;
 		mLocked = rhs.mLocked; // TODO - This should be shared by all copies pointing to the same data?
 		mOwnsData = false;
+		mMappedSource = rhs.mMappedSource;
 
 		return *this;
 	}
@@ -70,6 +73,13 @@ namespace bs
 
 	void GpuResourceData::freeInternalBuffer()
 	{
+		if(mMappedSource != nullptr)
+		{
+			mData = nullptr;
+			mMappedSource = nullptr;
+			return;
+		}
+
 		if(mData == nullptr || !mOwnsData)
 			return;
 
@@ -101,6 +111,23 @@ namespace bs
 		mOwnsData = false;
 	}
 
+	void GpuResourceData::readBuffer(const SPtr<DataStream>& stream, UINT32 size)
+	{
+		if(stream->isMapped() && (stream->size() - stream->tell()) >= size)
+		{
+			SPtr<MemoryDataStream> memStream = std::static_pointer_cast<MemoryDataStream>(stream);
+			setExternalBuffer(memStream->getCurrentPtr());
+			mMappedSource = stream;
+
+			stream->skip(size);
+		}
+		else
+		{
+			allocateInternalBuffer(size);
+			stream->read(mData, size);
+		}
+	}
+
 	void GpuResourceData::_lock() const
 	{
 		mLocked = true;
@@ -66,6 +66,13 @@ namespace bs
 		 */
 		void setExternalBuffer(UINT8* data);
 
+		/**
+		 * Fills the internal buffer with @p size bytes read from the provided stream. If the stream is a memory mapped 
+		 * file the data is not copied, instead the buffer references the mapped memory directly and keeps the stream 
+		 * alive for as long as it is used.
+		 */
+		void readBuffer(const SPtr<DataStream>& stream, UINT32 size);
+
 		/** Checks if the internal buffer is locked due to some other thread using it. */
 		bool isLocked() const { return mLocked; }
 
@@ -86,6 +93,7 @@ namespace bs
 		UINT8* mData;
 		bool mOwnsData;
 		mutable bool mLocked;
+		SPtr<DataStream> mMappedSource;
 
 		/************************************************************************/
 		/* 								SERIALIZATION                      		*/
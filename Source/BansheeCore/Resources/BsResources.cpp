@@ -27,6 +27,9 @@ namespace bs
 
 	Resources::~Resources()
 	{
+		// Let any asynchronous loads finish before tearing down
+		mAsyncLoader.stop();
+
 		// Unload and invalidate all resources
 		UnorderedMap<UUID, LoadedResourceData> loadedResourcesCopy;
 		
@@ -325,15 +328,14 @@ namespace bs
 			{
 				loadCallback(filePath, outputResource, loadFlags.isSet(ResourceLoadFlag::KeepSourceData));
 			}
-			else // Asynchronous, read the file on a worker thread
+			else // Asynchronous, read the file on the I/O thread and decode it on the worker threads
 			{
-				String fileName = filePath.getFilename();
-				String taskName = "Resource load: " + fileName;
-
 				bool keepSourceData = loadFlags.isSet(ResourceLoadFlag::KeepSourceData);
-				SPtr<Task> task = Task::create(taskName, 
-					std::bind(&Resources::loadCallback, this, filePath, outputResource, keepSourceData));
-				TaskScheduler::instance().addTask(task);
+				mAsyncLoader.load(filePath, keepSourceData, 
+					[this, filePath, outputResource](const SPtr<Resource>& rawResource) mutable
+				{
+					finishLoad(filePath, outputResource, rawResource);
+				});
 			}
 		}
 		else // File already loaded or in progress
@@ -359,65 +361,15 @@ namespace bs
 
 	SPtr<Resource> Resources::loadFromDiskAndDeserialize(const Path& filePath, bool loadWithSaveData)
 	{
-		// Note: Called asynchronously over multiple resources this will cause performance issues on hard drives as they
-		// work best when they are reading one thing at a time, and it won't have benefits on an SSD either. Think about
-		// executing all file reads on a single thread, while decompression and similar operations can execute on multiple.
-
-		SPtr<DataStream> stream = FileSystem::openFile(filePath, true);
-		if (stream == nullptr)
+		SPtr<DataStream> fileData = AsyncResourceLoader::readFile(filePath);
+		if (fileData == nullptr)
 			return nullptr;
 
-		if (stream->size() > std::numeric_limits<UINT32>::max())
-		{
-			BS_EXCEPT(InternalErrorException,
-				"File size is larger that UINT32 can hold. Ask a programmer to use a bigger data type.");
-		}
-
-		UnorderedMap<String, UINT64> params;
-		if(loadWithSaveData)
-			params["keepSourceData"] = 1;
-
-		// Read meta-data
-		SPtr<SavedResourceData> metaData;
-		{
-			if (!stream->eof())
-			{
-				UINT32 objectSize = 0;
-				stream->read(&objectSize, sizeof(objectSize));
-
-				BinarySerializer bs;
-				metaData = std::static_pointer_cast<SavedResourceData>(bs.decode(stream, objectSize, params));
-			}
-		}
-
-		// Read resource data
-		SPtr<IReflectable> loadedData;
-		{
-			if(metaData && !stream->eof())
-			{
-				UINT32 objectSize = 0;
-				stream->read(&objectSize, sizeof(objectSize));
-
-				if (metaData->getCompressionMethod() != 0)
-					stream = Compression::decompress(stream);
-
-				BinarySerializer bs;
-				loadedData = std::static_pointer_cast<SavedResourceData>(bs.decode(stream, objectSize, params));
-			}
-		}
-
-		if (loadedData == nullptr)
-		{
-			LOGERR("Unable to load resource at path \"" + filePath.toString() + "\"");
-		}
-		else
-		{
-			if (!loadedData->isDerivedFrom(Resource::getRTTIStatic()))
-				BS_EXCEPT(InternalErrorException, "Loaded class doesn't derive from Resource.");
-		}
+		ResourceFileData resourceData;
+		if (!AsyncResourceLoader::decompress(fileData, loadWithSaveData, resourceData))
+			return nullptr;
 
-		SPtr<Resource> resource = std::static_pointer_cast<Resource>(loadedData);
-		return resource;
+		return AsyncResourceLoader::deserialize(resourceData, loadWithSaveData);
 	}
 
 	void Resources::release(ResourceHandleBase& resource)
@@ -576,9 +528,12 @@ namespace bs
 		for (UINT32 i = 0; i < (UINT32)dependencyList.size(); i++)
 			dependencyUUIDs[i] = dependencyList[i].resource.getUUID();
 
-		UINT32 compressionMethod = (compress && resource->isCompressible()) ? 1 : 0;
+		CompressionMethod compressionMethod = CompressionMethod::None;
+		if (compress && resource->isCompressible())
+			compressionMethod = CompressionMethod::SnappyChunked;
+
 		SPtr<SavedResourceData> resourceData = bs_shared_ptr_new<SavedResourceData>(dependencyUUIDs, 
-			resource->allowAsyncLoading(), compressionMethod);
+			resource->allowAsyncLoading(), (UINT32)compressionMethod);
 
 		Path parentDir = filePath.getDirectory();
 		if (!FileSystem::exists(parentDir))
@@ -608,11 +563,8 @@ namespace bs
 			UINT8* bytes = ms.encode(resource.get(), numBytes);
 
 			SPtr<MemoryDataStream> objStream = bs_shared_ptr_new<MemoryDataStream>(bytes, numBytes);
-			if (compressionMethod != 0)
-			{
-				SPtr<DataStream> srcStream = std::static_pointer_cast<DataStream>(objStream);
-				objStream = Compression::compress(srcStream);
-			}
+			if (compressionMethod != CompressionMethod::None)
+				objStream = Compression::compressChunked(objStream);
 
 			stream.write((char*)&numBytes, sizeof(numBytes));
 			stream.write((char*)objStream->getPtr(), objStream->size());
@@ -848,6 +800,13 @@ namespace bs
 	void Resources::loadCallback(const Path& filePath, HResource& resource, bool loadWithSaveData)
 	{
 		SPtr<Resource> rawResource = loadFromDiskAndDeserialize(filePath, loadWithSaveData);
+		finishLoad(filePath, resource, rawResource);
+	}
+
+	void Resources::finishLoad(const Path& filePath, HResource& resource, const SPtr<Resource>& rawResource)
+	{
+		if (rawResource == nullptr)
+			LOGERR("Unable to load resource at path \"" + filePath.toString() + "\"");
 
 		{
 			Lock lock(mInProgressResourcesMutex);
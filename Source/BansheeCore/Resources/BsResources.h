@@ -4,6 +4,7 @@
 
 #include "BsCorePrerequisites.h"
 #include "Utility/BsModule.h"
+#include "Resources/BsAsyncResourceLoader.h"
 
 namespace bs
 {
@@ -246,6 +247,12 @@ namespace bs
 		 */
 		SPtr<ResourceManifest> getResourceManifest(const String& name) const;
 
+		/**
+		 * Determines the maximum amount of file data, in bytes, that asynchronous loads in progress may hold in memory.
+		 * Once reached, no new files are read until some of the loads in progress complete. 
+		 */
+		void setAsyncLoadMemoryBudget(UINT64 bytes) { mAsyncLoader.setMemoryBudget(bytes); }
+
 		/** Attempts to retrieve file path from the provided UUID. Returns true if successful, false otherwise. */
 		bool getFilePathFromUUID(const UUID& uuid, Path& filePath) const;
 
@@ -308,15 +315,18 @@ namespace bs
 		 */
 		HResource loadInternal(const UUID& UUID, const Path& filePath, bool synchronous, ResourceLoadFlags loadFlags);
 
-		/** Performs actually reading and deserializing of the resource file. Called from various worker threads. */
+		/** Reads and deserializes the resource file on the calling thread. */
 		SPtr<Resource> loadFromDiskAndDeserialize(const Path& filePath, bool loadWithSaveData);
 
 		/**	Triggered when individual resource has finished loading. */
 		void loadComplete(HResource& resource);
 
-		/**	Callback triggered when the task manager is ready to process the loading task. */
+		/**	Loads the resource file synchronously and completes the load. */
 		void loadCallback(const Path& filePath, HResource& resource, bool loadWithSaveData);
 
+		/** Assigns the deserialized resource data to the resource and completes the load. */
+		void finishLoad(const Path& filePath, HResource& resource, const SPtr<Resource>& rawResource);
+
 		/**	Destroys a resource, freeing its memory. */
 		void destroy(ResourceHandleBase& resource);
 
@@ -331,6 +341,8 @@ namespace bs
 		UnorderedMap<UUID, LoadedResourceData> mLoadedResources;
 		UnorderedMap<UUID, ResourceLoadData*> mInProgressResources; // Resources that are being asynchronously loaded
 		UnorderedMap<UUID, Vector<ResourceLoadData*>> mDependantLoads; // Allows dependency to be notified when a dependant is loaded
+
+		AsyncResourceLoader mAsyncLoader;
 	};
 
 	/** Provides easier access to Resources manager. */
@@ -28,7 +28,7 @@ namespace bs
 		/**	Returns true if this resource is allow to be asynchronously loaded. */
 		bool allowAsyncLoading() const { return mAllowAsync; }
 
-		/** Returns the method used for compressing the resource. 0 if none. */
+		/** Returns the method used for compressing the resource, as a value of CompressionMethod. */
 		UINT32 getCompressionMethod() const { return mCompressionMethod; }
 
 	private:
@@ -7,11 +7,12 @@
 namespace bs
 {
 	Component::Component()
-		:mNotifyFlags(TCF_None), mSceneManagerId(-1)
+		:mNotifyFlags(TCF_None), mSceneManagerId(-1), mUpdatePriority(0), mUpdateBucketIdx(-1), mUpdateIdx(-1)
 	{ }
 
 	Component::Component(const HSceneObject& parent)
-		:mNotifyFlags(TCF_None), mSceneManagerId(-1), mParent(parent)
+		:mNotifyFlags(TCF_None), mSceneManagerId(-1), mUpdatePriority(0), mUpdateBucketIdx(-1), mUpdateIdx(-1)
+		, mParent(parent)
 	{
 		setName("Component");
 	}
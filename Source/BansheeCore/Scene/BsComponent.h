@@ -20,7 +20,14 @@ namespace bs
 		 * Note that this flag must be specified on component creation, in its constructor and any later changes
 		 * to the flag will be ignored.
 		 */
-		AlwaysRun = 1 
+		AlwaysRun = 1,
+		/**
+		 * Signals that update() only modifies state owned by the component itself, allowing the scene manager to update
+		 * components of the same type in parallel on worker threads. update() of such components must not create or
+		 * destroy game objects, nor access other components. Off by default. Must be specified on component creation,
+		 * in its constructor.
+		 */
+		ThreadSafeUpdate = 2
 	};
 
 	typedef Flags<ComponentFlag> ComponentFlags;
@@ -151,6 +158,16 @@ namespace bs
 		/** Checks if the component has a certain flag enabled. */
 		bool hasFlag(ComponentFlag flag) const { return mFlags.isSet(flag); }
 
+		/** 
+		 * Determines the order in which update() is called for this component relative to components of other types.
+		 * Components with a lower priority are updated first. All components of the same type should use the same
+		 * priority. Must be specified on component creation, in its constructor. 
+		 */
+		void setUpdatePriority(INT32 priority) { mUpdatePriority = priority; }
+
+		/** @copydoc setUpdatePriority */
+		INT32 getUpdatePriority() const { return mUpdatePriority; }
+
 		/** Sets an index that uniquely identifies a component with the SceneManager. */
 		void setSceneManagerId(UINT32 id) { mSceneManagerId = id; }
 
@@ -175,6 +192,9 @@ namespace bs
 		TransformChangedFlags mNotifyFlags;
 		ComponentFlags mFlags;
 		UINT32 mSceneManagerId;
+		INT32 mUpdatePriority;
+		UINT32 mUpdateBucketIdx;
+		UINT32 mUpdateIdx;
 
 	private:
 		HSceneObject mParent;
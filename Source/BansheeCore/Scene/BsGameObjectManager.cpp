@@ -6,7 +6,8 @@
 namespace bs
 {
 	GameObjectManager::GameObjectManager()
-		:mNextAvailableID(1), mIsDeserializationActive(false), mGODeserializationMode(GODM_UseNewIds | GODM_BreakExternal)
+		:mActiveDeserializedObject(nullptr), mIsDeserializationActive(false)
+		, mGODeserializationMode(GODM_UseNewIds | GODM_BreakExternal)
 	{
 
 	}
@@ -18,21 +19,19 @@ namespace bs
 
 	GameObjectHandleBase GameObjectManager::getObject(UINT64 id) const
 	{
-		auto iterFind = mObjects.find(id);
-
-		if (iterFind != mObjects.end())
-			return iterFind->second;
+		UINT32 slotIdx = findSlot(id);
+		if (slotIdx != (UINT32)-1)
+			return GameObjectHandleBase(mSlots[slotIdx].handleData);
 
 		return nullptr;
 	}
 
 	bool GameObjectManager::tryGetObject(UINT64 id, GameObjectHandleBase& object) const
 	{
-		auto iterFind = mObjects.find(id);
-
-		if (iterFind != mObjects.end())
+		UINT32 slotIdx = findSlot(id);
+		if (slotIdx != (UINT32)-1)
 		{
-			object = iterFind->second;
+			object = GameObjectHandleBase(mSlots[slotIdx].handleData);
 			return true;
 		}
 
@@ -41,7 +40,7 @@ namespace bs
 
 	bool GameObjectManager::objectExists(UINT64 id) const
 	{
-		return mObjects.find(id) != mObjects.end();
+		return findSlot(id) != (UINT32)-1;
 	}
 
 	void GameObjectManager::remapId(UINT64 oldId, UINT64 newId)
@@ -49,8 +48,17 @@ namespace bs
 		if (oldId == newId)
 			return;
 
-		mObjects[newId] = mObjects[oldId];
-		mObjects.erase(oldId);
+		UINT32 slotIdx = findSlot(oldId);
+		if (slotIdx == (UINT32)-1)
+			return;
+
+		ObjectSlot& slot = mSlots[slotIdx];
+		if (slot.instanceId != getSlotId(slotIdx))
+			mRemappedIds.erase(slot.instanceId);
+
+		slot.instanceId = newId;
+		if (newId != getSlotId(slotIdx))
+			mRemappedIds[newId] = slotIdx;
 	}
 
 	void GameObjectManager::queueForDestroy(const GameObjectHandleBase& object)
@@ -58,69 +66,123 @@ namespace bs
 		if (object.isDestroyed())
 			return;
 
-		UINT64 instanceId = object->getInstanceId();
-		mQueuedForDestroy[instanceId] = object;
+		mQueuedForDestroy.push_back(object);
 	}
 
 	void GameObjectManager::destroyQueuedObjects()
 	{
-		for (auto& objPair : mQueuedForDestroy)
-			objPair.second->destroyInternal(objPair.second, true);
+		// Objects destroyed here can trigger callbacks that queue more objects, so keep going until the queue is empty
+		while (!mQueuedForDestroy.empty())
+		{
+			Vector<GameObjectHandleBase> queued;
+			std::swap(queued, mQueuedForDestroy);
+
+			// Destroy in instance ID order, and only once even if an object was queued multiple times
+			std::sort(queued.begin(), queued.end(),
+				[](const GameObjectHandleBase& a, const GameObjectHandleBase& b)
+			{
+				return a.getInstanceId() < b.getInstanceId();
+			});
+
+			UINT64 lastId = 0;
+			for (auto& entry : queued)
+			{
+				UINT64 instanceId = entry.getInstanceId();
+				if (instanceId == lastId)
+					continue;
 
-		mQueuedForDestroy.clear();
+				lastId = instanceId;
+
+				// Might have been destroyed along with its parent
+				if (entry.isDestroyed())
+					continue;
+
+				entry->destroyInternal(entry, true);
+			}
+		}
 	}
 
 	GameObjectHandleBase GameObjectManager::registerObject(const SPtr<GameObject>& object, UINT64 originalId)
 	{
-		object->initialize(object, mNextAvailableID);
+		UINT32 slotIdx = allocateSlot();
+		UINT64 instanceId = getSlotId(slotIdx);
+
+		object->initialize(object, instanceId);
 
 		// If deserialization is active we must ensure all handles pointing to the same object share GameObjectHandleData,
 		// so check if any handles referencing this object have been created. See ::registerUnresolvedHandle for
 		// further explanation.
+		SPtr<GameObjectHandleData>* handleData = nullptr;
 		if (mIsDeserializationActive)
 		{
 			assert(originalId != 0 && "You must provide an original ID when registering a deserialized game object.");
 
-			auto iterFind = mUnresolvedHandleData.find(originalId);
-			if (iterFind != mUnresolvedHandleData.end())
-			{
-				GameObjectHandleBase handle;
-				handle.mData = iterFind->second;
-				handle._setHandleData(object);
-
-				mObjects[mNextAvailableID] = handle;
-				mIdMapping[originalId] = mNextAvailableID;
-				mNextAvailableID++;
-
-				return handle;
-			}
-			else
-			{
-				GameObjectHandleBase handle(object);
+			handleData = mUnresolvedHandleData.find(originalId);
+			mIdMapping[originalId] = instanceId;
+		}
 
-				mObjects[mNextAvailableID] = handle;
-				mIdMapping[originalId] = mNextAvailableID;
-				mNextAvailableID++;
+		GameObjectHandleBase handle = handleData != nullptr ? GameObjectHandleBase(*handleData) 
+			: GameObjectHandleBase(object);
 
-				return handle;
-			}
-		}
+		if (handleData != nullptr)
+			handle._setHandleData(object);
 
-		GameObjectHandleBase handle(object);
-		mObjects[mNextAvailableID] = handle;
-		mNextAvailableID++;
+		ObjectSlot& slot = mSlots[slotIdx];
+		slot.handleData = handle.mData;
+		slot.instanceId = instanceId;
 
 		return handle;
 	}
 
 	void GameObjectManager::unregisterObject(GameObjectHandleBase& object)
 	{
-		mObjects.erase(object->getInstanceId());
+		UINT32 slotIdx = findSlot(object->getInstanceId());
+		if (slotIdx != (UINT32)-1)
+		{
+			ObjectSlot& slot = mSlots[slotIdx];
+			if (slot.instanceId != getSlotId(slotIdx))
+				mRemappedIds.erase(slot.instanceId);
+
+			// Bump the generation so IDs referencing the old object don't resolve to the slot's next occupant
+			slot.handleData = nullptr;
+			slot.instanceId = 0;
+			slot.generation = slot.generation == (UINT32)-1 ? 1 : slot.generation + 1;
+
+			mFreeSlots.push_back(slotIdx);
+		}
 
 		onDestroyed(object);
 		object.destroy();
 	}
 
+	UINT32 GameObjectManager::findSlot(UINT64 id) const
+	{
+		// IDs assigned by the manager encode the slot index directly
+		UINT32 slotIdx = (UINT32)id;
+		if (slotIdx < (UINT32)mSlots.size() && mSlots[slotIdx].handleData != nullptr && mSlots[slotIdx].instanceId == id)
+			return slotIdx;
+
+		const UINT32* remappedIdx = mRemappedIds.find(id);
+		if (remappedIdx != nullptr)
+			return *remappedIdx;
+
+		return (UINT32)-1;
+	}
+
+	UINT32 GameObjectManager::allocateSlot()
+	{
+		if (!mFreeSlots.empty())
+		{
+			UINT32 slotIdx = mFreeSlots.back();
+			mFreeSlots.pop_back();
+
+			return slotIdx;
+		}
+
+		mSlots.push_back(ObjectSlot());
+		return (UINT32)mSlots.size() - 1;
+	}
+
 	void GameObjectManager::startDeserialization()
 	{
 		assert(!mIsDeserializationActive);
@@ -156,21 +218,21 @@ namespace bs
 
 		bool isInternalReference = false;
 
-		auto findIter = mIdMapping.find(instanceId);
-		if (findIter != mIdMapping.end())
+		const UINT64* newId = mIdMapping.find(instanceId);
+		if (newId != nullptr)
 		{
 			if ((flags & GODM_UseNewIds) != 0)
-				instanceId = findIter->second;
+				instanceId = *newId;
 
 			isInternalReference = true;
 		}
 
 		if (isInternalReference || (!isInternalReference && (flags & GODM_RestoreExternal) != 0))
 		{
-			auto findIterObj = mObjects.find(instanceId);
+			UINT32 slotIdx = findSlot(instanceId);
 
-			if (findIterObj != mObjects.end())
-				data.handle._resolve(findIterObj->second);
+			if (slotIdx != (UINT32)-1)
+				data.handle._resolve(GameObjectHandleBase(mSlots[slotIdx].handleData));
 			else
 			{
 				if ((flags & GODM_KeepMissing) == 0)
@@ -202,13 +264,13 @@ namespace bs
 		bool foundHandleData = false;
 
 		// Search object that are currently being deserialized
-		auto iterFind = mIdMapping.find(originalId);
-		if (iterFind != mIdMapping.end())
+		const UINT64* newId = mIdMapping.find(originalId);
+		if (newId != nullptr)
 		{
-			auto iterFind2 = mObjects.find(iterFind->second);
-			if (iterFind2 != mObjects.end())
+			UINT32 slotIdx = findSlot(*newId);
+			if (slotIdx != (UINT32)-1)
 			{
-				object.mData = iterFind2->second.mData;
+				object.mData = mSlots[slotIdx].handleData;
 				foundHandleData = true;
 			}
 		}
@@ -216,10 +278,10 @@ namespace bs
 		// Search previously deserialized handles
 		if (!foundHandleData)
 		{
-			auto iterFind = mUnresolvedHandleData.find(originalId);
-			if (iterFind != mUnresolvedHandleData.end())
+			SPtr<GameObjectHandleData>* handleData = mUnresolvedHandleData.find(originalId);
+			if (handleData != nullptr)
 			{
-				object.mData = iterFind->second;
+				object.mData = *handleData;
 				foundHandleData = true;
 			}
 		}
@@ -4,6 +4,7 @@
 
 #include "BsCorePrerequisites.h"
 #include "Utility/BsModule.h"
+#include "Utility/BsIdHashMap.h"
 #include "Scene/BsGameObject.h"
 
 namespace bs
@@ -32,6 +33,11 @@ namespace bs
 	/**
 	 * Tracks GameObject creation and destructions. Also resolves GameObject references from GameObject handles.
 	 *
+	 * Live objects are stored in a generational slot map. Instance IDs assigned by the manager encode the slot index in
+	 * their low 32 bits and the slot generation in their high 32 bits, so an ID can be resolved to its object in constant
+	 * time, and IDs of destroyed objects are never confused with objects later placed in the same slot. Objects whose
+	 * IDs were remapped (see remapId()) are found through a separate hash table instead.
+	 *
 	 * @note	Sim thread only.
 	 */
 	class BS_CORE_EXPORT GameObjectManager : public Module<GameObjectManager>
@@ -43,6 +49,14 @@ namespace bs
 			GameObjectHandleBase handle;
 		};
 
+		/**	Entry in the slot map of live objects. */
+		struct ObjectSlot
+		{
+			SPtr<GameObjectHandleData> handleData; // Null if the slot is free
+			UINT64 instanceId = 0;
+			UINT32 generation = 1;
+		};
+
 	public:
 		GameObjectManager();
 		~GameObjectManager();
@@ -65,7 +79,8 @@ namespace bs
 
 		/**
 		 * Attempts to find a GameObject handle based on the GameObject instance ID. Returns empty handle if ID cannot be 
-		 * found.
+		 * found. IDs assigned by the manager are resolved in constant time using the slot index and generation they
+		 * encode.
 		 */
 		GameObjectHandleBase getObject(UINT64 id) const;
 
@@ -137,14 +152,24 @@ namespace bs
 		UINT32 getDeserializationFlags() const { return mGODeserializationMode; }
 
 	private:
-		UINT64 mNextAvailableID; // 0 is not a valid ID
-		Map<UINT64, GameObjectHandleBase> mObjects;
-		Map<UINT64, GameObjectHandleBase> mQueuedForDestroy;
+		/** Returns the index of the slot containing the object with the specified instance ID, or -1 if not found. */
+		UINT32 findSlot(UINT64 id) const;
+
+		/** Returns the instance ID that the manager assigns to an object stored in the specified slot. */
+		UINT64 getSlotId(UINT32 slotIdx) const { return ((UINT64)mSlots[slotIdx].generation << 32) | slotIdx; }
+
+		/** Reserves a free slot, growing the slot map if needed, and returns its index. */
+		UINT32 allocateSlot();
+
+		Vector<ObjectSlot> mSlots;
+		Vector<UINT32> mFreeSlots;
+		IdHashMap<UINT32> mRemappedIds;
+		Vector<GameObjectHandleBase> mQueuedForDestroy;
 
 		GameObject* mActiveDeserializedObject;
 		bool mIsDeserializationActive;
-		Map<UINT64, UINT64> mIdMapping;
-		Map<UINT64, SPtr<GameObjectHandleData>> mUnresolvedHandleData;
+		IdHashMap<UINT64> mIdMapping;
+		IdHashMap<SPtr<GameObjectHandleData>> mUnresolvedHandleData;
 		Vector<UnresolvedHandle> mUnresolvedHandles;
 		Vector<std::function<void()>> mEndCallbacks;
 		UINT32 mGODeserializationMode;
@@ -73,7 +73,7 @@ namespace bs
 
 		// Clone the hierarchy for internal storage
 		mRoot = sceneObject->clone(false);
-		mRoot->mParent = nullptr;
+		mRoot->_setParent(HSceneObject(), false);
 		mRoot->mLinkId = -1;
 
 		// Remove objects with "dont save" flag
@@ -4,6 +4,7 @@
 #include "Scene/BsPrefabDiff.h"
 #include "Scene/BsPrefab.h"
 #include "Scene/BsSceneObject.h"
+#include "Scene/BsTransformHierarchy.h"
 #include "Resources/BsResources.h"
 
 namespace bs
@@ -33,7 +34,16 @@ namespace bs
 		newInstance->mParent->removeChild(newInstance);
 		newInstance->mParent = parent;
 
+		// Parent's child list still references the original object, whose handle the new instance takes over below, so
+		// only the transform hierarchy link needs to be updated
+		UINT32 parentTransformId = TransformHierarchy::INVALID_ID;
+		if (parent != nullptr)
+			parentTransformId = parent->mTransformId;
+
+		TransformHierarchy::instance().setParent(newInstance->mTransformId, parentTransformId);
+
 		restoreLinkedInstanceData(newInstance, soProxy, linkedInstanceData);
+		newInstance->notifyTransformChanged((TransformChangedFlags)(TCF_Parent | TCF_Transform));
 	}
 
 	void PrefabUtility::updateFromPrefab(const HSceneObject& so)
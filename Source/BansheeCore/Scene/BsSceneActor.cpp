@@ -6,7 +6,7 @@
 namespace bs
 {
 	SceneActor::SceneActor()
-		:mMobility(ObjectMobility::Movable), mActive(true), mHash(0)
+		:mMobility(ObjectMobility::Movable), mActive(true), mHash(0), mBoundIdx((UINT32)-1), mDirtyIdx((UINT32)-1)
 	{
 		
 	}
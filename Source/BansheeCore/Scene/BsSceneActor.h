@@ -106,6 +106,9 @@ namespace bs
 		ObjectMobility mMobility;
 		bool mActive;
 		UINT32 mHash;
+
+		UINT32 mBoundIdx; // Index in the scene manager's list of bound actors, or -1 if not bound
+		UINT32 mDirtyIdx; // Index in the scene manager's list of dirty actors, or -1 if not queued for update
 	};
 
 	/** @} */
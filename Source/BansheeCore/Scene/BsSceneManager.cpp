@@ -11,6 +11,9 @@
 #include "RenderAPI/BsRenderTarget.h"
 #include "Renderer/BsLightProbeVolume.h"
 #include "Scene/BsSceneActor.h"
+#include "Scene/BsTransformHierarchy.h"
+#include "Threading/BsParallel.h"
+#include "Profiling/BsProfilerCPU.h"
 
 namespace bs
 {
@@ -30,6 +33,9 @@ namespace bs
 	{
 		if (mRootNode != nullptr && !mRootNode.isDestroyed())
 			mRootNode->destroy(true);
+
+		for (auto& entry : mUpdateBuckets)
+			bs_delete(entry);
 	}
 
 	void SceneManager::clearScene(bool forceAll)
@@ -87,19 +93,66 @@ namespace bs
 
 	void SceneManager::_bindActor(const SPtr<SceneActor>& actor, const HSceneObject& so)
 	{
-		mBoundActors[actor.get()] = BoundActorData(actor, so);
+		if (actor->mBoundIdx != (UINT32)-1)
+			_unbindActor(actor);
+
+		actor->mBoundIdx = (UINT32)mBoundActors.size();
+		mBoundActors.push_back(BoundActorData(actor, so));
+
+		so->mBoundActors.push_back(actor.get());
+		_markActorDirty(actor.get());
 	}
 
 	void SceneManager::_unbindActor(const SPtr<SceneActor>& actor)
 	{
-		mBoundActors.erase(actor.get());
+		UINT32 idx = actor->mBoundIdx;
+		if (idx == (UINT32)-1)
+			return;
+
+		const HSceneObject& so = mBoundActors[idx].so;
+		if (!so.isDestroyed())
+		{
+			auto iterFind = std::find(so->mBoundActors.begin(), so->mBoundActors.end(), actor.get());
+			if (iterFind != so->mBoundActors.end())
+				so->mBoundActors.erase(iterFind);
+		}
+
+		if (actor->mDirtyIdx != (UINT32)-1)
+		{
+			mDirtyActors[actor->mDirtyIdx] = (UINT32)-1;
+			actor->mDirtyIdx = (UINT32)-1;
+		}
+
+		// Move the last entry into the freed slot, and patch its index in the dirty list if it's queued
+		UINT32 lastIdx = (UINT32)mBoundActors.size() - 1;
+		if (idx != lastIdx)
+		{
+			std::swap(mBoundActors[idx], mBoundActors[lastIdx]);
+
+			SceneActor* movedActor = mBoundActors[idx].actor.get();
+			movedActor->mBoundIdx = idx;
+
+			if (movedActor->mDirtyIdx != (UINT32)-1)
+				mDirtyActors[movedActor->mDirtyIdx] = idx;
+		}
+
+		mBoundActors.erase(mBoundActors.end() - 1);
+		actor->mBoundIdx = (UINT32)-1;
+	}
+
+	void SceneManager::_markActorDirty(SceneActor* actor)
+	{
+		if (actor->mDirtyIdx != (UINT32)-1 || actor->mBoundIdx == (UINT32)-1)
+			return;
+
+		actor->mDirtyIdx = (UINT32)mDirtyActors.size();
+		mDirtyActors.push_back(actor->mBoundIdx);
 	}
 
 	HSceneObject SceneManager::_getActorSO(const SPtr<SceneActor>& actor) const
 	{
-		auto iterFind = mBoundActors.find(actor.get());
-		if (iterFind != mBoundActors.end())
-			return iterFind->second.so;
+		if (actor->mBoundIdx != (UINT32)-1)
+			return mBoundActors[actor->mBoundIdx].so;
 
 		return HSceneObject();		
 	}
@@ -151,8 +204,30 @@ namespace bs
 
 	void SceneManager::_updateCoreObjectTransforms()
 	{
-		for (auto& entry : mBoundActors)
-			entry.second.actor->_updateState(*entry.second.so);
+		// Evaluate all dirty world transforms up front, so the actor updates below only read scene object state
+		TransformHierarchy::instance().update();
+
+		auto updateActor = [this](UINT32 i)
+		{
+			UINT32 idx = mDirtyActors[i];
+			if (idx == (UINT32)-1)
+				return;
+
+			BoundActorData& entry = mBoundActors[idx];
+			entry.actor->_updateState(*entry.so);
+			entry.actor->mDirtyIdx = (UINT32)-1;
+		};
+
+		UINT32 numDirty = (UINT32)mDirtyActors.size();
+		if (numDirty >= PARALLEL_ACTOR_UPDATE_THRESHOLD)
+			parallelFor(0, numDirty, 256, updateActor);
+		else
+		{
+			for (UINT32 i = 0; i < numDirty; i++)
+				updateActor(i);
+		}
+
+		mDirtyActors.clear();
 	}
 
 	SPtr<Camera> SceneManager::getMainCamera() const
@@ -215,11 +290,7 @@ namespace bs
 					if (entry->sceneObject()->getActive())
 					{
 						entry->onEnabled();
-
-						UINT32 idx = (UINT32)mActiveComponents.size();
-						mActiveComponents.push_back(entry);
-
-						entry->setSceneManagerId(encodeComponentId(idx, ActiveList));
+						addToActiveList(entry);
 					}
 					else
 					{
@@ -247,10 +318,7 @@ namespace bs
 				removeFromInactiveList(component);
 				i--; // Keep the same index next iteration to process the component we just swapped
 
-				UINT32 activeIdx = (UINT32)mActiveComponents.size();
-				mActiveComponents.push_back(component);
-
-				component->setSceneManagerId(encodeComponentId(activeIdx, ActiveList));
+				addToActiveList(component);
 			}
 		}
 		// Stop updates on all active components
@@ -305,11 +373,7 @@ namespace bs
 			if (parentActive)
 			{
 				component->onEnabled();
-
-				UINT32 idx = (UINT32)mActiveComponents.size();
-				mActiveComponents.push_back(component);
-
-				component->setSceneManagerId(encodeComponentId(idx, ActiveList));
+				addToActiveList(component);
 			}
 			else
 			{
@@ -338,11 +402,7 @@ namespace bs
 				component->onEnabled();
 
 			removeFromInactiveList(component);
-
-			UINT32 activeIdx = (UINT32)mActiveComponents.size();
-			mActiveComponents.push_back(component);
-
-			component->setSceneManagerId(encodeComponentId(activeIdx, ActiveList));
+			addToActiveList(component);
 		}
 	}
 
@@ -413,6 +473,70 @@ namespace bs
 		}
 
 		mActiveComponents.erase(mActiveComponents.end() - 1);
+
+		// Remove from the update bucket, moving the last component in its place
+		Component* componentPtr = component.get();
+		Vector<Component*>& bucketComponents = mUpdateBuckets[componentPtr->mUpdateBucketIdx]->components;
+
+		UINT32 updateIdx = componentPtr->mUpdateIdx;
+		UINT32 lastUpdateIdx = (UINT32)bucketComponents.size() - 1;
+
+		assert(bucketComponents[updateIdx] == componentPtr);
+
+		if (updateIdx != lastUpdateIdx)
+		{
+			bucketComponents[updateIdx] = bucketComponents[lastUpdateIdx];
+			bucketComponents[updateIdx]->mUpdateIdx = updateIdx;
+		}
+
+		bucketComponents.erase(bucketComponents.end() - 1);
+		componentPtr->mUpdateBucketIdx = (UINT32)-1;
+		componentPtr->mUpdateIdx = (UINT32)-1;
+	}
+
+	void SceneManager::addToActiveList(const HComponent& component)
+	{
+		UINT32 idx = (UINT32)mActiveComponents.size();
+		mActiveComponents.push_back(component);
+
+		component->setSceneManagerId(encodeComponentId(idx, ActiveList));
+
+		Component* componentPtr = component.get();
+		UINT32 bucketIdx = getUpdateBucketIdx(*componentPtr);
+		Vector<Component*>& bucketComponents = mUpdateBuckets[bucketIdx]->components;
+
+		componentPtr->mUpdateBucketIdx = bucketIdx;
+		componentPtr->mUpdateIdx = (UINT32)bucketComponents.size();
+		bucketComponents.push_back(componentPtr);
+	}
+
+	UINT32 SceneManager::getUpdateBucketIdx(const Component& component)
+	{
+		RTTITypeBase* rtti = component.getRTTI();
+
+		INT32 priority = component.getUpdatePriority();
+		UINT32 rttiId = rtti->getRTTIId();
+		bool threadSafe = component.hasFlag(ComponentFlag::ThreadSafeUpdate);
+
+		UINT64 key = ((UINT64)(UINT32)priority << 32) | ((UINT64)rttiId << 1) | (threadSafe ? 1 : 0);
+
+		auto iterFind = mUpdateBucketLookup.find(key);
+		if (iterFind != mUpdateBucketLookup.end())
+			return iterFind->second;
+
+		UpdateBucket* bucket = bs_new<UpdateBucket>();
+		bucket->priority = priority;
+		bucket->rttiId = rttiId;
+		bucket->threadSafe = threadSafe;
+		bucket->profilerName = "Update: " + rtti->getRTTIName();
+
+		UINT32 bucketIdx = (UINT32)mUpdateBuckets.size();
+		mUpdateBuckets.push_back(bucket);
+		mUpdateBucketLookup[key] = bucketIdx;
+
+		// Order is only modified at the start of the next update, as this may be called during the update loop
+		mUpdateOrderDirty = true;
+		return bucketIdx;
 	}
 
 	void SceneManager::removeFromInactiveList(const HComponent& component)
@@ -475,15 +599,66 @@ namespace bs
 
 	void SceneManager::_update()
 	{
-		// Note: Eventually perform updates based on component types and/or on component priority. Right now we just
-		// iterate in an undefined order, but it wouldn't be hard to change it.
+		if (mUpdateOrderDirty)
+		{
+			mUpdateOrder.resize(mUpdateBuckets.size());
+			for (UINT32 i = 0; i < (UINT32)mUpdateOrder.size(); i++)
+				mUpdateOrder[i] = i;
+
+			std::sort(mUpdateOrder.begin(), mUpdateOrder.end(), 
+				[this](UINT32 a, UINT32 b)
+			{
+				const UpdateBucket& lhs = *mUpdateBuckets[a];
+				const UpdateBucket& rhs = *mUpdateBuckets[b];
 
-		for (auto& entry : mActiveComponents)
-			entry->update();
+				if (lhs.priority != rhs.priority)
+					return lhs.priority < rhs.priority;
+
+				return lhs.rttiId < rhs.rttiId;
+			});
+
+			mUpdateOrderDirty = false;
+		}
+
+		// Note: Components may be added or removed by the update calls, so buckets are accessed by index. Buckets 
+		// created during the loop are first updated next frame.
+		for (UINT32 i = 0; i < (UINT32)mUpdateOrder.size(); i++)
+		{
+			UpdateBucket* bucket = mUpdateBuckets[mUpdateOrder[i]];
+
+			UINT32 numComponents = (UINT32)bucket->components.size();
+			if (numComponents == 0)
+				continue;
+
+			gProfilerCPU().beginSample(bucket->profilerName.c_str());
+
+			if (bucket->threadSafe && numComponents >= PARALLEL_COMPONENT_UPDATE_THRESHOLD)
+			{
+				// Evaluate any transforms modified by earlier updates, so reading them from worker threads is safe
+				TransformHierarchy::instance().update();
+
+				parallelFor(0, numComponents, 64, [bucket](UINT32 idx)
+				{
+					bucket->components[idx]->update();
+				});
+			}
+			else
+			{
+				for (UINT32 j = 0; j < (UINT32)bucket->components.size(); j++)
+					bucket->components[j]->update();
+			}
+
+			gProfilerCPU().endSample(bucket->profilerName.c_str());
+		}
 
 		GameObjectManager::instance().destroyQueuedObjects();
 	}
 
+	void SceneManager::_notifyChildrenModified(const HSceneObject& parent)
+	{
+		onChildrenModified(parent);
+	}
+
 	void SceneManager::registerNewSO(const HSceneObject& node)
 	{ 
 		if(mRootNode)
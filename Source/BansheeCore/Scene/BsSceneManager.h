@@ -90,6 +90,12 @@ namespace bs
 		 */
 		void setMainRenderTarget(const SPtr<RenderTarget>& rt);
 
+		/** 
+		 * Triggered whenever a child is added to or removed from an instantiated scene object, including when a child is
+		 * re-parented or destroyed. Provides the scene object whose list of children changed.
+		 */
+		Event<void(const HSceneObject&)> onChildrenModified;
+
 		/** 
 		 * Binds a scene actor with a scene object. Every frame the scene object's transform will be monitored for
 		 * changes and those changes will be automatically transfered to the actor. 
@@ -117,9 +123,18 @@ namespace bs
 		/** Called every frame. Calls update methods on all scene objects and their components. */
 		void _update();
 
-		/** Updates dirty transforms on any core objects that may be tied with scene objects. */
+		/** 
+		 * Updates dirty transforms on any core objects that may be tied with scene objects. Only actors whose scene
+		 * objects were modified since the last call are updated.
+		 */
 		void _updateCoreObjectTransforms();
 
+		/** 
+		 * Queues a bound actor for an update during the next call to _updateCoreObjectTransforms(). Called by the scene
+		 * object the actor is bound to whenever its transform, active state or mobility changes.
+		 */
+		void _markActorDirty(SceneActor* actor);
+
 		/** Notifies the manager that a new component has just been created. The manager triggers necessary callbacks. */
 		void _notifyComponentCreated(const HComponent& component, bool parentActive);
 
@@ -138,6 +153,9 @@ namespace bs
 		/** Notifies the manager that a component is about to be destroyed. The manager triggers necessary callbacks. */
 		void _notifyComponentDestroyed(const HComponent& component);
 
+		/** Notifies the manager that a child was added to or removed from the provided scene object. */
+		void _notifyChildrenModified(const HSceneObject& parent);
+
 	protected:
 		friend class SceneObject;
 
@@ -178,14 +196,41 @@ namespace bs
 		/** Checks does the specified component type match the provided RTTI id. */
 		static bool isComponentOfType(const HComponent& component, UINT32 rttiId);
 
+		/** Adds a component to the active component list, and to the update bucket for its type. */
+		void addToActiveList(const HComponent& component);
+
+		/** Returns the index of the update bucket for the component's type and priority, creating it if needed. */
+		UINT32 getUpdateBucketIdx(const Component& component);
+
+		/** Active components of a single type and update priority. Their update() is called together. */
+		struct UpdateBucket
+		{
+			INT32 priority;
+			UINT32 rttiId;
+			bool threadSafe;
+			String profilerName;
+			Vector<Component*> components;
+		};
+
+		/** Minimum number of components in a thread-safe bucket before their updates are distributed across threads. */
+		static const UINT32 PARALLEL_COMPONENT_UPDATE_THRESHOLD = 256;
+
+		/** Minimum number of dirty actors required before their updates are distributed across worker threads. */
+		static const UINT32 PARALLEL_ACTOR_UPDATE_THRESHOLD = 2048;
+
 	protected:
 		HSceneObject mRootNode;
 
-		UnorderedMap<SceneActor*, BoundActorData> mBoundActors;
+		Vector<BoundActorData> mBoundActors;
+		Vector<UINT32> mDirtyActors;
 		UnorderedMap<Camera*, SPtr<Camera>> mCameras;
 		Vector<SPtr<Camera>> mMainCameras;
 
 		Vector<HComponent> mActiveComponents;
+		Vector<UpdateBucket*> mUpdateBuckets;
+		UnorderedMap<UINT64, UINT32> mUpdateBucketLookup;
+		Vector<UINT32> mUpdateOrder;
+		bool mUpdateOrderDirty = false;
 		Vector<HComponent> mInactiveComponents;
 		Vector<HComponent> mUninitializedComponents;
 
@@ -3,6 +3,7 @@
 #include "Scene/BsSceneObject.h"
 #include "Scene/BsComponent.h"
 #include "Scene/BsSceneManager.h"
+#include "Scene/BsTransformHierarchy.h"
 #include "Error/BsException.h"
 #include "Debug/BsDebug.h"
 #include "RTTI/BsSceneObjectRTTI.h"
@@ -15,11 +16,12 @@
 namespace bs
 {
 	SceneObject::SceneObject(const String& name, UINT32 flags)
-		: GameObject(), mPrefabHash(0), mFlags(flags), mCachedLocalTfrm(Matrix4::IDENTITY)
-		, mCachedWorldTfrm(Matrix4::IDENTITY), mDirtyFlags(0xFFFFFFFF), mDirtyHash(0), mActiveSelf(true)
-		, mActiveHierarchy(true), mMobility(ObjectMobility::Movable)
+		: GameObject(), mPrefabHash(0), mFlags(flags), mDirtyHash(0), mActiveSelf(true), mActiveHierarchy(true)
+		, mMobility(ObjectMobility::Movable)
 	{
 		setName(name);
+
+		mTransformId = TransformHierarchy::instance().createNode();
 	}
 
 	SceneObject::~SceneObject()
@@ -29,6 +31,9 @@ namespace bs
 			LOGWRN("Object is being deleted without being destroyed first? " + mName);
 			destroyInternal(mThisHandle, true);
 		}
+
+		if (TransformHierarchy::isStarted())
+			TransformHierarchy::instance().destroyNode(mTransformId);
 	}
 
 	HSceneObject SceneObject::create(const String& name, UINT32 flags)
@@ -236,7 +241,7 @@ namespace bs
 	{
 		if (mMobility == ObjectMobility::Movable)
 		{
-			mLocalTfrm.setPosition(position);
+			getLocalTfrmInternal().setPosition(position);
 			notifyTransformChanged(TCF_Transform);
 		}
 	}
@@ -245,7 +250,7 @@ namespace bs
 	{
 		if (mMobility == ObjectMobility::Movable)
 		{
-			mLocalTfrm.setRotation(rotation);
+			getLocalTfrmInternal().setRotation(rotation);
 			notifyTransformChanged(TCF_Transform);
 		}
 	}
@@ -254,7 +259,7 @@ namespace bs
 	{
 		if (mMobility == ObjectMobility::Movable)
 		{
-			mLocalTfrm.setScale(scale);
+			getLocalTfrmInternal().setScale(scale);
 			notifyTransformChanged(TCF_Transform);
 		}
 	}
@@ -265,9 +270,9 @@ namespace bs
 			return;
 
 		if (mParent != nullptr)
-			mLocalTfrm.setWorldPosition(position, mParent->getTransform());
+			getLocalTfrmInternal().setWorldPosition(position, mParent->getTransform());
 		else
-			mLocalTfrm.setPosition(position);
+			getLocalTfrmInternal().setPosition(position);
 
 		notifyTransformChanged(TCF_Transform);
 	}
@@ -278,9 +283,9 @@ namespace bs
 			return;
 
 		if (mParent != nullptr)
-			mLocalTfrm.setWorldRotation(rotation, mParent->getTransform());
+			getLocalTfrmInternal().setWorldRotation(rotation, mParent->getTransform());
 		else
-			mLocalTfrm.setRotation(rotation);
+			getLocalTfrmInternal().setRotation(rotation);
 
 		notifyTransformChanged(TCF_Transform);
 	}
@@ -291,19 +296,26 @@ namespace bs
 			return;
 
 		if (mParent != nullptr)
-			mLocalTfrm.setWorldScale(scale, mParent->getTransform());
+			getLocalTfrmInternal().setWorldScale(scale, mParent->getTransform());
 		else
-			mLocalTfrm.setScale(scale);
+			getLocalTfrmInternal().setScale(scale);
 
 		notifyTransformChanged(TCF_Transform);
 	}
 
 	const Transform& SceneObject::getTransform() const
 	{ 
-		if (!isCachedWorldTfrmUpToDate())
-			updateWorldTfrm();
+		return TransformHierarchy::instance().getWorld(mTransformId);
+	}
 
-		return mWorldTfrm; 
+	const Transform& SceneObject::getLocalTransform() const
+	{
+		return getLocalTfrmInternal();
+	}
+
+	Transform& SceneObject::getLocalTfrmInternal() const
+	{
+		return TransformHierarchy::instance().getLocal(mTransformId);
 	}
 
 	void SceneObject::lookAt(const Vector3& location, const Vector3& up)
@@ -319,34 +331,25 @@ namespace bs
 
 	const Matrix4& SceneObject::getWorldMatrix() const
 	{
-		if (!isCachedWorldTfrmUpToDate())
-			updateWorldTfrm();
-
-		return mCachedWorldTfrm;
+		return TransformHierarchy::instance().getWorldMatrix(mTransformId);
 	}
 
 	Matrix4 SceneObject::getInvWorldMatrix() const
 	{
-		if (!isCachedWorldTfrmUpToDate())
-			updateWorldTfrm();
-
-		Matrix4 worldToLocal = mWorldTfrm.getInvMatrix();
+		Matrix4 worldToLocal = getTransform().getInvMatrix();
 		return worldToLocal;
 	}
 
 	const Matrix4& SceneObject::getLocalMatrix() const
 	{
-		if (!isCachedLocalTfrmUpToDate())
-			updateLocalTfrm();
-
-		return mCachedLocalTfrm;
+		return TransformHierarchy::instance().getLocalMatrix(mTransformId);
 	}
 
 	void SceneObject::move(const Vector3& vec)
 	{
 		if (mMobility == ObjectMobility::Movable)
 		{
-			mLocalTfrm.move(vec);
+			getLocalTfrmInternal().move(vec);
 			notifyTransformChanged(TCF_Transform);
 		}
 	}
@@ -355,7 +358,7 @@ namespace bs
 	{
 		if (mMobility == ObjectMobility::Movable)
 		{
-			mLocalTfrm.moveRelative(vec);
+			getLocalTfrmInternal().moveRelative(vec);
 			notifyTransformChanged(TCF_Transform);
 		}
 	}
@@ -364,7 +367,7 @@ namespace bs
 	{
 		if (mMobility == ObjectMobility::Movable)
 		{
-			mLocalTfrm.rotate(axis, angle);
+			getLocalTfrmInternal().rotate(axis, angle);
 			notifyTransformChanged(TCF_Transform);
 		}
 	}
@@ -373,7 +376,7 @@ namespace bs
 	{
 		if (mMobility == ObjectMobility::Movable)
 		{
-			mLocalTfrm.rotate(q);
+			getLocalTfrmInternal().rotate(q);
 			notifyTransformChanged(TCF_Transform);
 		}
 	}
@@ -382,7 +385,7 @@ namespace bs
 	{
 		if (mMobility == ObjectMobility::Movable)
 		{
-			mLocalTfrm.roll(angle);
+			getLocalTfrmInternal().roll(angle);
 			notifyTransformChanged(TCF_Transform);
 		}
 	}
@@ -391,7 +394,7 @@ namespace bs
 	{
 		if (mMobility == ObjectMobility::Movable)
 		{
-			mLocalTfrm.yaw(angle);
+			getLocalTfrmInternal().yaw(angle);
 			notifyTransformChanged(TCF_Transform);
 		}
 	}
@@ -400,7 +403,7 @@ namespace bs
 	{
 		if (mMobility == ObjectMobility::Movable)
 		{
-			mLocalTfrm.pitch(angle);
+			getLocalTfrmInternal().pitch(angle);
 			notifyTransformChanged(TCF_Transform);
 		}
 	}
@@ -416,11 +419,7 @@ namespace bs
 
 	void SceneObject::updateTransformsIfDirty()
 	{
-		if (!isCachedLocalTfrmUpToDate())
-			updateLocalTfrm();
-
-		if (!isCachedWorldTfrmUpToDate())
-			updateWorldTfrm();
+		TransformHierarchy::instance().evaluate(mTransformId);
 	}
 
 	void SceneObject::notifyTransformChanged(TransformChangedFlags flags) const
@@ -431,7 +430,7 @@ namespace bs
 			componentFlags = (TransformChangedFlags)(componentFlags & ~TCF_Transform);
 		else
 		{
-			mDirtyFlags |= DirtyFlags::LocalTfrmDirty | DirtyFlags::WorldTfrmDirty;
+			TransformHierarchy::instance().markDirty(mTransformId);
 			mDirtyHash++;
 		}
 
@@ -449,6 +448,8 @@ namespace bs
 			}
 		}
 
+		markBoundActorsDirty();
+
 		// Mobility flag is only relevant for this scene object
 		flags = (TransformChangedFlags)(flags & ~TCF_Mobility);
 		if (flags != 0)
@@ -458,29 +459,10 @@ namespace bs
 		}
 	}
 
-	void SceneObject::updateWorldTfrm() const
-	{
-		mWorldTfrm = mLocalTfrm;
-
-		// Don't allow movement from parent when not movable
-		if (mParent != nullptr && mMobility == ObjectMobility::Movable)
-		{
-			mWorldTfrm.makeWorld(mParent->getTransform());
-
-			mCachedWorldTfrm = mWorldTfrm.getMatrix();
-		}
-		else
-		{
-			mCachedWorldTfrm = getLocalMatrix();
-		}
-
-		mDirtyFlags &= ~DirtyFlags::WorldTfrmDirty;
-	}
-
-	void SceneObject::updateLocalTfrm() const
+	void SceneObject::markBoundActorsDirty() const
 	{
-		mCachedLocalTfrm = mLocalTfrm.getMatrix();
-		mDirtyFlags &= ~DirtyFlags::LocalTfrmDirty;
+		for (auto& entry : mBoundActors)
+			gSceneManager()._markActorDirty(entry);
 	}
 
 	/************************************************************************/
@@ -532,12 +514,19 @@ namespace bs
 
 			mParent = parent;
 
+			UINT32 parentTransformId = TransformHierarchy::INVALID_ID;
+			if (parent != nullptr)
+				parentTransformId = parent->mTransformId;
+
+			TransformHierarchy::instance().setParent(mTransformId, parentTransformId);
+
 			if (keepWorldTransform)
 			{
-				mLocalTfrm = worldTfrm;
+				Transform& localTfrm = getLocalTfrmInternal();
+				localTfrm = worldTfrm;
 
 				if (mParent != nullptr)
-					mLocalTfrm.makeLocal(mParent->getTransform());
+					localTfrm.makeLocal(mParent->getTransform());
 			}
 
 			notifyTransformChanged((TransformChangedFlags)(TCF_Parent | TCF_Transform));
@@ -570,6 +559,9 @@ namespace bs
 		mChildren.push_back(object); 
 
 		object->_setFlags(mFlags);
+
+		if (isInstantiated() && SceneManager::isStarted())
+			gSceneManager()._notifyChildrenModified(mThisHandle);
 	}
 
 	void SceneObject::removeChild(const HSceneObject& object)
@@ -583,6 +575,9 @@ namespace bs
 			BS_EXCEPT(InternalErrorException, 
 				"Trying to remove a child but it's not a child of the transform.");
 		}
+
+		if (isInstantiated() && SceneManager::isStarted())
+			gSceneManager()._notifyChildrenModified(mThisHandle);
 	}
 
 	HSceneObject SceneObject::findPath(const String& path) const
@@ -679,6 +674,7 @@ namespace bs
 		if (mActiveHierarchy != activeHierarchy)
 		{
 			mActiveHierarchy = activeHierarchy;
+			markBoundActorsDirty();
 
 			if (triggerEvents)
 			{
@@ -714,6 +710,7 @@ namespace bs
 		if(mMobility != mobility)
 		{
 			mMobility = mobility;
+			TransformHierarchy::instance().setMovable(mTransformId, mobility == ObjectMobility::Movable);
 
 			// If mobility changed to movable, update both the mobility flag and transform, otherwise just mobility
 			if (mMobility == ObjectMobility::Movable)
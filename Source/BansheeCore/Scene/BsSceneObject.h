@@ -40,13 +40,6 @@ namespace bs
 	 */
 	class BS_CORE_EXPORT SceneObject : public GameObject
 	{
-		/**	Flags that signify which part of the SceneObject needs updating. */
-		enum DirtyFlags
-		{
-			LocalTfrmDirty = 0x01,
-			WorldTfrmDirty = 0x02
-		};
-
 		friend class SceneManager;
 		friend class Prefab;
 		friend class PrefabDiff;
@@ -195,11 +188,14 @@ namespace bs
 		/* 								Transform	                     		*/
 		/************************************************************************/
 	public:
-		/** Gets the transform object representing object's position/rotation/scale in world space. */
+		/** 
+		 * Gets the transform object representing object's position/rotation/scale in world space. The returned reference
+		 * should not be kept past the end of the frame, as transforms can be relocated during the scene update.
+		 */
 		const Transform& getTransform() const;
 
 		/** Gets the transform object representing object's position/rotation/scale relative to its parent. */
-		const Transform& getLocalTransform() const { return mLocalTfrm; }
+		const Transform& getLocalTransform() const;
 
 		/**	Sets the local position of the object. */
 		void setPosition(const Vector3& position);
@@ -304,15 +300,12 @@ namespace bs
 		UINT32 getTransformHash() const { return mDirtyHash; }
 
 	private:
-		Transform mLocalTfrm;
-		mutable Transform mWorldTfrm;
-
-		mutable Matrix4 mCachedLocalTfrm;
-		mutable Matrix4 mCachedWorldTfrm;
-
-		mutable UINT32 mDirtyFlags;
+		UINT32 mTransformId;
 		mutable UINT32 mDirtyHash;
 
+		/** Returns the local transform for modification. Call notifyTransformChanged() after modifying it. */
+		Transform& getLocalTfrmInternal() const;
+
 		/** 
 		 * Notifies components and child scene object that a transform has been changed.  
 		 * 
@@ -320,21 +313,8 @@ namespace bs
 		 */
 		void notifyTransformChanged(TransformChangedFlags flags) const;
 
-		/** Updates the local transform. Normally just reconstructs the transform matrix from the position/rotation/scale. */
-		void updateLocalTfrm() const;
-
-		/**
-		 * Updates the world transform. Reconstructs the local transform matrix and multiplies it with any parent transforms.
-		 *
-		 * @note	If parent transforms are dirty they will be updated.
-		 */
-		void updateWorldTfrm() const;
-
-		/**	Checks if cached local transform needs updating. */
-		bool isCachedLocalTfrmUpToDate() const { return (mDirtyFlags & DirtyFlags::LocalTfrmDirty) == 0; }
-
-		/**	Checks if cached world transform needs updating. */
-		bool isCachedWorldTfrmUpToDate() const { return (mDirtyFlags & DirtyFlags::WorldTfrmDirty) == 0; }
+		/** Queues any scene actors bound to this object for an update by the scene manager. */
+		void markBoundActorsDirty() const;
 
 		/************************************************************************/
 		/* 								Hierarchy	                     		*/
@@ -445,6 +425,7 @@ namespace bs
 		bool mActiveSelf;
 		bool mActiveHierarchy;
 		ObjectMobility mMobility;
+		Vector<SceneActor*> mBoundActors;
 
 		/**
 		 * Internal version of setParent() that allows you to set a null parent.
@@ -0,0 +1,346 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "Scene/BsTransformHierarchy.h"
+#include "Threading/BsParallel.h"
+
+namespace bs
+{
+	TransformHierarchy::~TransformHierarchy()
+	{
+		for (auto& entry : mPages)
+			bs_delete(entry);
+	}
+
+	UINT32 TransformHierarchy::createNode()
+	{
+		UINT32 nodeIdx = mNumNodes++;
+		if (nodeIdx / PAGE_SIZE >= (UINT32)mPages.size())
+			mPages.push_back(bs_new<Page>());
+
+		UINT32 id;
+		if (!mFreeIds.empty())
+		{
+			id = mFreeIds.back();
+			mFreeIds.pop_back();
+
+			mNodeIndices[id] = nodeIdx;
+		}
+		else
+		{
+			id = (UINT32)mNodeIndices.size();
+			mNodeIndices.push_back(nodeIdx);
+		}
+
+		Page& page = getPage(nodeIdx);
+		UINT32 slot = nodeIdx % PAGE_SIZE;
+
+		page.local[slot] = Transform();
+		page.world[slot] = Transform();
+		page.localMatrix[slot] = Matrix4::IDENTITY;
+		page.worldMatrix[slot] = Matrix4::IDENTITY;
+		page.parent[slot] = INVALID_ID;
+		page.id[slot] = id;
+		page.flags[slot] = LocalDirty | WorldDirty | Movable;
+
+		mNumDirtied++;
+		return id;
+	}
+
+	void TransformHierarchy::destroyNode(UINT32 id)
+	{
+		UINT32 nodeIdx = mNodeIndices[id];
+
+		Page& page = getPage(nodeIdx);
+		UINT32 slot = nodeIdx % PAGE_SIZE;
+
+		// Entry stays in place until the next reorder, to keep the indices of other entries unchanged
+		page.parent[slot] = INVALID_ID;
+		page.id[slot] = INVALID_ID;
+		page.flags[slot] = Free;
+
+		mNodeIndices[id] = INVALID_ID;
+		mFreeIds.push_back(id);
+		mNumFreeNodes++;
+	}
+
+	void TransformHierarchy::setParent(UINT32 id, UINT32 parentId)
+	{
+		UINT32 nodeIdx = mNodeIndices[id];
+		UINT32 parentIdx = INVALID_ID;
+		if (parentId != INVALID_ID)
+			parentIdx = mNodeIndices[parentId];
+
+		getPage(nodeIdx).parent[nodeIdx % PAGE_SIZE] = parentIdx;
+
+		// World transform depends on the parent
+		markDirty(id);
+
+		mNumParentChanges++;
+		mIsOrderValid = false;
+	}
+
+	void TransformHierarchy::setMovable(UINT32 id, bool movable)
+	{
+		UINT32 nodeIdx = mNodeIndices[id];
+		UINT8& flags = getPage(nodeIdx).flags[nodeIdx % PAGE_SIZE];
+
+		if (movable)
+			flags |= Movable;
+		else
+			flags &= ~Movable;
+	}
+
+	void TransformHierarchy::markDirty(UINT32 id)
+	{
+		UINT32 nodeIdx = mNodeIndices[id];
+		UINT8& flags = getPage(nodeIdx).flags[nodeIdx % PAGE_SIZE];
+
+		if ((flags & WorldDirty) == 0)
+			mNumDirtied++;
+
+		flags |= LocalDirty | WorldDirty;
+	}
+
+	const Transform& TransformHierarchy::getWorld(UINT32 id)
+	{
+		UINT32 nodeIdx = mNodeIndices[id];
+		Page& page = getPage(nodeIdx);
+		UINT32 slot = nodeIdx % PAGE_SIZE;
+
+		if ((page.flags[slot] & WorldDirty) != 0)
+			evaluateNode(nodeIdx);
+
+		return page.world[slot];
+	}
+
+	const Matrix4& TransformHierarchy::getLocalMatrix(UINT32 id)
+	{
+		UINT32 nodeIdx = mNodeIndices[id];
+		Page& page = getPage(nodeIdx);
+		UINT32 slot = nodeIdx % PAGE_SIZE;
+
+		if ((page.flags[slot] & LocalDirty) != 0)
+			evaluateNode(nodeIdx);
+
+		return page.localMatrix[slot];
+	}
+
+	const Matrix4& TransformHierarchy::getWorldMatrix(UINT32 id)
+	{
+		UINT32 nodeIdx = mNodeIndices[id];
+		Page& page = getPage(nodeIdx);
+		UINT32 slot = nodeIdx % PAGE_SIZE;
+
+		if ((page.flags[slot] & WorldDirty) != 0)
+			evaluateNode(nodeIdx);
+
+		return page.worldMatrix[slot];
+	}
+
+	void TransformHierarchy::evaluate(UINT32 id)
+	{
+		UINT32 nodeIdx = mNodeIndices[id];
+		if ((getPage(nodeIdx).flags[nodeIdx % PAGE_SIZE] & (LocalDirty | WorldDirty)) != 0)
+			evaluateNode(nodeIdx);
+	}
+
+	void TransformHierarchy::evaluateNode(UINT32 nodeIdx)
+	{
+		Page& page = getPage(nodeIdx);
+		UINT32 slot = nodeIdx % PAGE_SIZE;
+		UINT8& flags = page.flags[slot];
+
+		if ((flags & LocalDirty) != 0)
+		{
+			page.localMatrix[slot] = page.local[slot].getMatrix();
+			flags &= ~LocalDirty;
+		}
+
+		if ((flags & WorldDirty) != 0)
+		{
+			page.world[slot] = page.local[slot];
+
+			// Don't allow movement from parent when not movable
+			UINT32 parentIdx = page.parent[slot];
+			if (parentIdx != INVALID_ID && (flags & Movable) != 0)
+			{
+				Page& parentPage = getPage(parentIdx);
+				UINT32 parentSlot = parentIdx % PAGE_SIZE;
+
+				if ((parentPage.flags[parentSlot] & WorldDirty) != 0)
+					evaluateNode(parentIdx);
+
+				page.world[slot].makeWorld(parentPage.world[parentSlot]);
+				page.worldMatrix[slot] = page.world[slot].getMatrix();
+			}
+			else
+				page.worldMatrix[slot] = page.localMatrix[slot];
+
+			flags &= ~WorldDirty;
+		}
+	}
+
+	void TransformHierarchy::evaluateRange(UINT32 begin, UINT32 end)
+	{
+		for (UINT32 i = begin; i < end; i++)
+		{
+			if ((getPage(i).flags[i % PAGE_SIZE] & (LocalDirty | WorldDirty)) != 0)
+				evaluateNode(i);
+		}
+	}
+
+	void TransformHierarchy::update()
+	{
+		if (mNumDirtied == 0)
+			return;
+
+		UINT32 numLiveNodes = mNumNodes - mNumFreeNodes;
+		UINT32 maxFragmentation = numLiveNodes / 4 > PAGE_SIZE ? numLiveNodes / 4 : PAGE_SIZE;
+
+		bool parallel = mNumDirtied >= PARALLEL_UPDATE_THRESHOLD;
+		bool fragmented = mNumFreeNodes + mNumParentChanges > maxFragmentation;
+
+		if (fragmented || (parallel && !mIsOrderValid))
+			reorder();
+
+		if (parallel && mIsOrderValid)
+		{
+			// Roots first, after which sub-trees of their children only read entries within their own range
+			for (auto& entry : mRootNodes)
+				evaluateRange(entry, entry + 1);
+
+			parallelFor(0, (UINT32)mSubtreeRanges.size(), 16, [this](UINT32 i)
+			{
+				evaluateRange(mSubtreeRanges[i].first, mSubtreeRanges[i].second);
+			});
+
+			// Entries created since the last reorder, which can only be parentless while the order is valid
+			evaluateRange(mNumOrderedNodes, mNumNodes);
+		}
+		else
+			evaluateRange(0, mNumNodes);
+
+		mNumDirtied = 0;
+	}
+
+	void TransformHierarchy::reorder()
+	{
+		UINT32 numNodes = mNumNodes;
+
+		auto isFree = [this](UINT32 nodeIdx)
+		{
+			return (getPage(nodeIdx).flags[nodeIdx % PAGE_SIZE] & Free) != 0;
+		};
+
+		auto getParent = [this, &isFree](UINT32 nodeIdx)
+		{
+			UINT32 parentIdx = getPage(nodeIdx).parent[nodeIdx % PAGE_SIZE];
+			if (parentIdx == INVALID_ID || isFree(parentIdx))
+				return INVALID_ID;
+
+			return parentIdx;
+		};
+
+		// Build a list of children for each entry, keeping siblings in their current order
+		Vector<UINT32> childOffsets(numNodes + 1, 0);
+		for (UINT32 i = 0; i < numNodes; i++)
+		{
+			UINT32 parentIdx = isFree(i) ? INVALID_ID : getParent(i);
+			if (parentIdx != INVALID_ID)
+				childOffsets[parentIdx + 1]++;
+		}
+
+		for (UINT32 i = 0; i < numNodes; i++)
+			childOffsets[i + 1] += childOffsets[i];
+
+		Vector<UINT32> children(childOffsets[numNodes]);
+		{
+			Vector<UINT32> writeOffsets(childOffsets.begin(), childOffsets.end() - 1);
+			for (UINT32 i = 0; i < numNodes; i++)
+			{
+				UINT32 parentIdx = isFree(i) ? INVALID_ID : getParent(i);
+				if (parentIdx != INVALID_ID)
+					children[writeOffsets[parentIdx]++] = i;
+			}
+		}
+
+		// Walk all the trees in depth-first order
+		Vector<UINT32> order;
+		order.reserve(numNodes - mNumFreeNodes);
+
+		Vector<UINT32> stack;
+		mRootNodes.clear();
+		mSubtreeRanges.clear();
+
+		for (UINT32 i = 0; i < numNodes; i++)
+		{
+			if (isFree(i) || getParent(i) != INVALID_ID)
+				continue;
+
+			mRootNodes.push_back((UINT32)order.size());
+			order.push_back(i);
+
+			for (UINT32 j = childOffsets[i]; j < childOffsets[i + 1]; j++)
+			{
+				UINT32 subtreeBegin = (UINT32)order.size();
+
+				stack.push_back(children[j]);
+				while (!stack.empty())
+				{
+					UINT32 nodeIdx = stack.back();
+					stack.pop_back();
+
+					order.push_back(nodeIdx);
+
+					// Push in reverse so the first child is visited first
+					for (UINT32 k = childOffsets[nodeIdx + 1]; k > childOffsets[nodeIdx]; k--)
+						stack.push_back(children[k - 1]);
+				}
+
+				mSubtreeRanges.push_back(std::make_pair(subtreeBegin, (UINT32)order.size()));
+			}
+		}
+
+		// Move the entries to new pages in the new order
+		UINT32 numOrderedNodes = (UINT32)order.size();
+		Vector<UINT32> newIndices(numNodes, (UINT32)INVALID_ID);
+		for (UINT32 i = 0; i < numOrderedNodes; i++)
+			newIndices[order[i]] = i;
+
+		Vector<Page*> newPages((numOrderedNodes + PAGE_SIZE - 1) / PAGE_SIZE);
+		for (auto& entry : newPages)
+			entry = bs_new<Page>();
+
+		for (UINT32 i = 0; i < numOrderedNodes; i++)
+		{
+			UINT32 oldIdx = order[i];
+			Page& src = getPage(oldIdx);
+			UINT32 srcSlot = oldIdx % PAGE_SIZE;
+
+			Page& dst = *newPages[i / PAGE_SIZE];
+			UINT32 dstSlot = i % PAGE_SIZE;
+
+			UINT32 parentIdx = getParent(oldIdx);
+
+			dst.local[dstSlot] = src.local[srcSlot];
+			dst.world[dstSlot] = src.world[srcSlot];
+			dst.localMatrix[dstSlot] = src.localMatrix[srcSlot];
+			dst.worldMatrix[dstSlot] = src.worldMatrix[srcSlot];
+			dst.parent[dstSlot] = parentIdx != INVALID_ID ? newIndices[parentIdx] : INVALID_ID;
+			dst.id[dstSlot] = src.id[srcSlot];
+			dst.flags[dstSlot] = src.flags[srcSlot];
+
+			mNodeIndices[src.id[srcSlot]] = i;
+		}
+
+		for (auto& entry : mPages)
+			bs_delete(entry);
+
+		mPages = std::move(newPages);
+		mNumNodes = numOrderedNodes;
+		mNumOrderedNodes = numOrderedNodes;
+		mNumFreeNodes = 0;
+		mNumParentChanges = 0;
+		mIsOrderValid = true;
+	}
+}
@@ -0,0 +1,153 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Utility/BsModule.h"
+#include "Scene/BsTransform.h"
+#include "Math/BsMatrix4.h"
+
+namespace bs
+{
+	/** @addtogroup Scene-Internal
+	 *  @{
+	 */
+
+	/**
+	 * Stores local and world transforms of all scene objects in packed arrays, along with their cached matrices and
+	 * parent links. Each scene object references its entry through a stable ID that remains valid for the lifetime of the
+	 * object, while the entries themselves are periodically reordered so that parents precede their children in
+	 * depth-first order.
+	 *
+	 * World transforms are evaluated lazily when queried, same as before, but update() evaluates all dirty entries in a
+	 * single linear pass each frame, after which world transform queries are simple array lookups.
+	 *
+	 * @note	Sim thread only.
+	 */
+	class BS_CORE_EXPORT TransformHierarchy : public Module<TransformHierarchy>
+	{
+		/** Flags describing the state of a single entry. */
+		enum NodeFlags
+		{
+			LocalDirty = 1 << 0,
+			WorldDirty = 1 << 1,
+			Movable = 1 << 2,
+			Free = 1 << 3
+		};
+
+		/** Number of entries in a single page. */
+		static const UINT32 PAGE_SIZE = 1024;
+
+		/**
+		 * Fixed size block of entries, with each property stored in a separate array. Entries never move between pages
+		 * except during reordering, so references to them stay valid as new entries are added.
+		 */
+		struct Page
+		{
+			Transform local[PAGE_SIZE];
+			Transform world[PAGE_SIZE];
+			Matrix4 localMatrix[PAGE_SIZE];
+			Matrix4 worldMatrix[PAGE_SIZE];
+			UINT32 parent[PAGE_SIZE];
+			UINT32 id[PAGE_SIZE];
+			UINT8 flags[PAGE_SIZE];
+		};
+
+	public:
+		/** ID representing no entry. */
+		static const UINT32 INVALID_ID = (UINT32)-1;
+
+		TransformHierarchy() = default;
+		~TransformHierarchy();
+
+		/** Creates a new entry with an identity transform and no parent, and returns its ID. */
+		UINT32 createNode();
+
+		/** Destroys an entry previously created with createNode(). */
+		void destroyNode(UINT32 id);
+
+		/**
+		 * Changes the parent of the entry. Provide INVALID_ID to remove the parent. Marks the entry dirty, but not its
+		 * children, which must be marked dirty separately.
+		 */
+		void setParent(UINT32 id, UINT32 parentId);
+
+		/**
+		 * Determines if the entry inherits the transform of its parent. If false the world transform of the entry is equal
+		 * to its local transform.
+		 */
+		void setMovable(UINT32 id, bool movable);
+
+		/**
+		 * Notifies the system that the local transform of the entry was modified, or that the world transform of its
+		 * parent changed. Children must be marked dirty separately.
+		 */
+		void markDirty(UINT32 id);
+
+		/** Returns the transform of the entry relative to its parent. Call markDirty() after modifying it. */
+		Transform& getLocal(UINT32 id) { return getPage(mNodeIndices[id]).local[mNodeIndices[id] % PAGE_SIZE]; }
+
+		/**
+		 * Returns the world transform of the entry, evaluating it if dirty. The reference remains valid until the next
+		 * call to update().
+		 */
+		const Transform& getWorld(UINT32 id);
+
+		/** Returns the local transform matrix of the entry, evaluating it if dirty. */
+		const Matrix4& getLocalMatrix(UINT32 id);
+
+		/** Returns the world transform matrix of the entry, evaluating it if dirty. */
+		const Matrix4& getWorldMatrix(UINT32 id);
+
+		/** Evaluates the local and world transforms of the entry, if dirty. */
+		void evaluate(UINT32 id);
+
+		/**
+		 * Evaluates world transforms of all dirty entries. Reorders the entries in depth-first order if the hierarchy
+		 * changed enough to make the current order inefficient. If enough entries are dirty and the order is up to date,
+		 * independent sub-trees are evaluated in parallel.
+		 */
+		void update();
+
+	private:
+		/** Returns the page containing the entry at the specified index. */
+		Page& getPage(UINT32 nodeIdx) { return *mPages[nodeIdx / PAGE_SIZE]; }
+
+		/** Evaluates the world transform, and the local transform if required, of the entry at the specified index. */
+		void evaluateNode(UINT32 nodeIdx);
+
+		/** Evaluates all dirty entries in the range [@p begin, @p end). */
+		void evaluateRange(UINT32 begin, UINT32 end);
+
+		/**
+		 * Removes free entries and reorders the remaining entries so that each sub-tree occupies a contiguous range, with
+		 * parents preceding their children.
+		 */
+		void reorder();
+
+		Vector<Page*> mPages;
+		UINT32 mNumNodes = 0;
+		UINT32 mNumFreeNodes = 0;
+
+		Vector<UINT32> mNodeIndices;
+		Vector<UINT32> mFreeIds;
+
+		// Entries marked dirty since the last update, an upper bound on the number of entries update() must evaluate
+		UINT32 mNumDirtied = 0;
+
+		// Number of parent changes since the entries were last reordered
+		UINT32 mNumParentChanges = 0;
+
+		// Sub-tree layout from the last reorder, valid while mIsOrderValid is true. Root entries are stored in
+		// mRootNodes, and each of their direct children owns a range of [begin, end) indices in mSubtreeRanges.
+		bool mIsOrderValid = false;
+		Vector<UINT32> mRootNodes;
+		Vector<std::pair<UINT32, UINT32>> mSubtreeRanges;
+		UINT32 mNumOrderedNodes = 0;
+
+		/** Minimum number of dirtied entries before update() evaluates sub-trees in parallel. */
+		static const UINT32 PARALLEL_UPDATE_THRESHOLD = 4096;
+	};
+
+	/** @} */
+}
@@ -179,6 +179,8 @@ set(BS_BANSHEEEDITOR_INC_UTILITY
 
 set(BS_BANSHEEEDITOR_SRC_TESTING
 	"Testing/BsEditorTestSuite.cpp"
+	"Testing/BsTransformHierarchyTestSuite.cpp"
+	"Testing/BsCommandBufferTestSuite.cpp"
 )
 
 set(BS_BANSHEEEDITOR_SRC_SETTINGS
@@ -223,6 +225,8 @@ set(BS_BANSHEEEDITOR_SRC_HANDLES
 
 set(BS_BANSHEEEDITOR_INC_TESTING
 	"Testing/BsEditorTestSuite.h"
+	"Testing/BsTransformHierarchyTestSuite.h"
+	"Testing/BsCommandBufferTestSuite.h"
 )
 
 set(BS_BANSHEEEDITOR_INC_CODEEDITOR
@@ -8,6 +8,8 @@
 #include "GUI/BsGUIPanel.h"
 #include "GUI/BsGUIStatusBar.h"
 #include "Testing/BsEditorTestSuite.h"
+#include "Testing/BsCommandBufferTestSuite.h"
+#include "Testing/BsTransformHierarchyTestSuite.h"
 #include "Testing/BsTestOutput.h"
 #include "RenderAPI/BsRenderWindow.h"
 #include "CoreThread/BsCoreThread.h"
@@ -37,6 +39,8 @@ namespace bs
 		mMenuBar->addMenuItem(L"File/Exit", nullptr, 10000);
 
 		SPtr<TestSuite> testSuite = TestSuite::create<EditorTestSuite>();
+		testSuite->add(TestSuite::create<TransformHierarchyTestSuite>());
+		testSuite->add(TestSuite::create<CommandBufferTestSuite>());
 		ExceptionTestOutput testOutput;
 		testSuite->run(testOutput);
 
@@ -50,10 +50,14 @@ namespace bs
 		contextMenu->addMenuItem(L"Paste", std::bind(&GUISceneTreeView::paste, this), 36, ShortcutKey(ButtonModifier::Ctrl, BC_V));
 
 		setContextMenu(contextMenu);
+
+		mChildrenModifiedConn = gSceneManager().onChildrenModified.connect(
+			std::bind(&GUISceneTreeView::onChildrenModified, this, std::placeholders::_1));
 	}
 
 	GUISceneTreeView::~GUISceneTreeView()
 	{
+		mChildrenModifiedConn.disconnect();
 		SceneTreeViewLocator::_remove(this);
 	}
 
@@ -76,9 +80,24 @@ namespace bs
 
 	void GUISceneTreeView::updateTreeElement(SceneTreeElement* element)
 	{
-		HSceneObject currentSO = element->mSceneObject;
+		bool needsUpdate = updateTreeElementChildren(element, false);
+		needsUpdate |= updateTreeElementProperties(element);
+
+		if(needsUpdate)
+			updateElementGUI(element);
 
-		// Check if SceneObject has changed in any way and update the tree element
+		for(UINT32 i = 0; i < (UINT32)element->mChildren.size(); i++)
+		{
+			SceneTreeElement* sceneElement = static_cast<SceneTreeElement*>(element->mChildren[i]);
+			updateTreeElement(sceneElement);
+		}
+
+		sortTreeElementChildren(element);
+	}
+
+	bool GUISceneTreeView::updateTreeElementChildren(SceneTreeElement* element, bool buildNewChildren)
+	{
+		HSceneObject currentSO = element->mSceneObject;
 
 		// Early exit case - Most commonly there will be no changes between active and cached data so 
 		// we first do a quick check in order to avoid expensive comparison later
@@ -112,82 +131,73 @@ namespace bs
 
 		completeMatch &= visibleChildCount == element->mChildren.size();
 
-		// Not a complete match, compare everything and insert/delete elements as needed
-		bool needsUpdate = false;
-		if(!completeMatch)
-		{
-			Vector<TreeElement*> newChildren;
+		if(completeMatch)
+			return false;
 
-			bool* tempToDelete = (bool*)bs_stack_alloc(sizeof(bool) * (UINT32)element->mChildren.size());
-			for(UINT32 i = 0; i < (UINT32)element->mChildren.size(); i++)
-				tempToDelete[i] = true;
+		// Not a complete match, compare everything and insert/delete elements as needed
+		Vector<TreeElement*> newChildren;
 
-			for(UINT32 i = 0; i < currentSO->getNumChildren(); i++)
-			{
-				HSceneObject currentSOChild = currentSO->getChild(i);
-				bool isInternal = currentSOChild->hasFlag(SOF_Internal);
+		bool* tempToDelete = (bool*)bs_stack_alloc(sizeof(bool) * (UINT32)element->mChildren.size());
+		for(UINT32 i = 0; i < (UINT32)element->mChildren.size(); i++)
+			tempToDelete[i] = true;
 
-				HSceneObject prefabParent = currentSOChild->getPrefabParent();
+		// Look up existing children by ID, instead of searching through all of them for every scene object
+		UnorderedMap<UINT64, UINT32> childIndices;
+		for(UINT32 i = 0; i < (UINT32)element->mChildren.size(); i++)
+			childIndices[static_cast<SceneTreeElement*>(element->mChildren[i])->mId] = i;
 
-				// Only count it as a prefab instance if its not scene root (otherwise every object would be colored as a prefab)
-				bool isPrefabInstance = prefabParent != nullptr && prefabParent->getParent() != nullptr;
+		for(UINT32 i = 0; i < currentSO->getNumChildren(); i++)
+		{
+			HSceneObject currentSOChild = currentSO->getChild(i);
 
 #if BS_DEBUG_MODE == 0
-				if (isInternal)
-					continue;
+			if (currentSOChild->hasFlag(SOF_Internal))
+				continue;
 #endif
 
-				UINT64 curId = currentSOChild->getInstanceId();
-				bool found = false;
-
-				for(UINT32 j = 0; j < element->mChildren.size(); j++)
-				{
-					SceneTreeElement* currentChild = static_cast<SceneTreeElement*>(element->mChildren[j]);
-
-					if(curId == currentChild->mId)
-					{
-						tempToDelete[j] = false;
-						currentChild->mSortedIdx = (UINT32)newChildren.size();
-						newChildren.push_back(currentChild);
+			UINT64 curId = currentSOChild->getInstanceId();
 
-						found = true;
-						break;
-					}
-				}
+			auto iterFind = childIndices.find(curId);
+			if(iterFind != childIndices.end())
+			{
+				TreeElement* currentChild = element->mChildren[iterFind->second];
 
-				if(!found)
-				{
-					SceneTreeElement* newChild = bs_new<SceneTreeElement>();
-					newChild->mParent = element;
-					newChild->mSceneObject = currentSOChild;
-					newChild->mId = currentSOChild->getInstanceId();
-					newChild->mName = currentSOChild->getName();
-					newChild->mSortedIdx = (UINT32)newChildren.size();
-					newChild->mIsVisible = element->mIsVisible && element->mIsExpanded;
-					newChild->mIsDisabled = !currentSOChild->getActive();
-					newChild->mTint = isInternal ? Color::Red : (isPrefabInstance ? PREFAB_TINT : Color::White);
-					newChild->mIsPrefabInstance = isPrefabInstance;
-
-					newChildren.push_back(newChild);
-
-					updateElementGUI(newChild);
-				}
+				tempToDelete[iterFind->second] = false;
+				currentChild->mSortedIdx = (UINT32)newChildren.size();
+				newChildren.push_back(currentChild);
 			}
-
-			for(UINT32 i = 0; i < element->mChildren.size(); i++)
+			else
 			{
-				if(!tempToDelete[i])
-					continue;
+				SceneTreeElement* newChild = createTreeElement(element, currentSOChild);
+				newChild->mSortedIdx = (UINT32)newChildren.size();
+
+				newChildren.push_back(newChild);
+
+				updateElementGUI(newChild);
 
-				deleteTreeElementInternal(element->mChildren[i]);
+				if(buildNewChildren)
+					updateTreeElement(newChild);
 			}
+		}
 
-			bs_stack_free(tempToDelete);
+		for(UINT32 i = 0; i < element->mChildren.size(); i++)
+		{
+			if(!tempToDelete[i])
+				continue;
 
-			element->mChildren = newChildren;
-			needsUpdate = true;
+			deleteTreeElementInternal(element->mChildren[i]);
 		}
 
+		bs_stack_free(tempToDelete);
+
+		element->mChildren = newChildren;
+		return true;
+	}
+
+	bool GUISceneTreeView::updateTreeElementProperties(SceneTreeElement* element)
+	{
+		bool needsUpdate = false;
+
 		// Check if name needs updating
 		const String& name = element->mSceneObject->getName();
 		if(element->mName != name)
@@ -219,15 +229,11 @@ namespace bs
 			needsUpdate = true;
 		}
 
-		if(needsUpdate)
-			updateElementGUI(element);
-
-		for(UINT32 i = 0; i < (UINT32)element->mChildren.size(); i++)
-		{
-			SceneTreeElement* sceneElement = static_cast<SceneTreeElement*>(element->mChildren[i]);
-			updateTreeElement(sceneElement);
-		}
+		return needsUpdate;
+	}
 
+	void GUISceneTreeView::sortTreeElementChildren(TreeElement* element)
+	{
 		// Calculate the sorted index of the elements based on their name
 		bs_frame_mark();
 		FrameVector<SceneTreeElement*> sortVector;
@@ -253,12 +259,92 @@ namespace bs
 	void GUISceneTreeView::updateTreeElementHierarchy()
 	{
 		HSceneObject root = gSceneManager().getRootNode();
-		mRootElement.mSceneObject = root;
-		mRootElement.mId = root->getInstanceId();
-		mRootElement.mSortedIdx = 0;
-		mRootElement.mIsExpanded = true;
 
-		updateTreeElement(&mRootElement);
+		// Scene root changed, or first update, rebuild everything
+		if(mRootElement.mSceneObject != root)
+		{
+			mElementsById.erase(mRootElement.mId);
+
+			mRootElement.mSceneObject = root;
+			mRootElement.mId = root->getInstanceId();
+			mRootElement.mSortedIdx = 0;
+			mRootElement.mIsExpanded = true;
+
+			mElementsById[mRootElement.mId] = &mRootElement;
+			mModifiedParents.clear();
+
+			updateTreeElement(&mRootElement);
+			return;
+		}
+
+		updateModifiedTreeElements();
+	}
+
+	void GUISceneTreeView::updateModifiedTreeElements()
+	{
+		for(auto& entry : mModifiedParents)
+		{
+			auto iterFind = mElementsById.find(entry);
+			if(iterFind == mElementsById.end())
+				continue;
+
+			SceneTreeElement* element = iterFind->second;
+			if(element->mSceneObject.isDestroyed())
+				continue;
+
+			if(updateTreeElementChildren(element, true))
+			{
+				updateElementGUI(element);
+				sortTreeElementChildren(element);
+			}
+		}
+
+		mModifiedParents.clear();
+
+		// Properties only affect how elements are displayed, so only check the elements that are currently represented
+		// by GUI elements. Others are checked once they scroll into view.
+		bs_frame_mark();
+		{
+			FrameStack<SceneTreeElement*> todo;
+			todo.push(&mRootElement);
+
+			while(!todo.empty())
+			{
+				SceneTreeElement* current = todo.top();
+				todo.pop();
+
+				bool resortChildren = false;
+				for(auto& child : current->mChildren)
+				{
+					SceneTreeElement* sceneChild = static_cast<SceneTreeElement*>(child);
+					if(!sceneChild->mIsVisible)
+						continue;
+
+					if(sceneChild->mElement != nullptr && !sceneChild->mSceneObject.isDestroyed())
+					{
+						String oldName = sceneChild->mName;
+
+						if(updateTreeElementProperties(sceneChild))
+						{
+							updateElementGUI(sceneChild);
+							resortChildren |= sceneChild->mName != oldName;
+						}
+					}
+
+					if(sceneChild->mIsExpanded)
+						todo.push(sceneChild);
+				}
+
+				if(resortChildren)
+					sortTreeElementChildren(current);
+			}
+		}
+		bs_frame_clear();
+	}
+
+	void GUISceneTreeView::onChildrenModified(const HSceneObject& parent)
+	{
+		mModifiedParents.insert(parent->getInstanceId());
 	}
 
 	void GUISceneTreeView::renameTreeElement(GUITreeView::TreeElement* element, const WString& name)
@@ -292,7 +378,51 @@ namespace bs
 		if(element->mIsSelected)
 			unselectElement(element);
 
+		// Children are deleted along with the element, so remove the whole sub-tree from the lookup
+		Stack<TreeElement*> todo;
+		todo.push(element);
+
+		while (!todo.empty())
+		{
+			SceneTreeElement* current = static_cast<SceneTreeElement*>(todo.top());
+			todo.pop();
+
+			// Element might have already been replaced by a new one, if its scene object moved to a different parent
+			auto iterFind = mElementsById.find(current->mId);
+			if (iterFind != mElementsById.end() && iterFind->second == current)
+				mElementsById.erase(iterFind);
+
+			if (current->mIsSelected)
+				unselectElement(current);
+
+			for (auto& child : current->mChildren)
+				todo.push(child);
+		}
+
 		bs_delete(element);
+		_markLayoutAsDirty();
+	}
+
+	GUISceneTreeView::SceneTreeElement* GUISceneTreeView::createTreeElement(SceneTreeElement* parent, const HSceneObject& so)
+	{
+		bool isInternal = so->hasFlag(SOF_Internal);
+		HSceneObject prefabParent = so->getPrefabParent();
+
+		// Only count it as a prefab instance if its not scene root (otherwise every object would be colored as a prefab)
+		bool isPrefabInstance = prefabParent != nullptr && prefabParent->getParent() != nullptr;
+
+		SceneTreeElement* newChild = bs_new<SceneTreeElement>();
+		newChild->mParent = parent;
+		newChild->mSceneObject = so;
+		newChild->mId = so->getInstanceId();
+		newChild->mName = so->getName();
+		newChild->mIsVisible = parent->mIsVisible && parent->mIsExpanded;
+		newChild->mIsDisabled = !so->getActive();
+		newChild->mTint = isInternal ? Color::Red : (isPrefabInstance ? PREFAB_TINT : Color::White);
+		newChild->mIsPrefabInstance = isPrefabInstance;
+
+		mElementsById[newChild->mId] = newChild;
+		return newChild;
 	}
 
 	bool GUISceneTreeView::acceptDragAndDrop() const
@@ -401,72 +531,32 @@ namespace bs
 		// for better performance.
 		updateTreeElementHierarchy();
 
-		Stack<SceneTreeElement*> todo;
-		todo.push(&mRootElement);
-
-		while (!todo.empty())
+		for (auto& so : objects)
 		{
-			SceneTreeElement* currentElem = todo.top();
-			todo.pop();
-
-			auto iterFind = std::find(objects.begin(), objects.end(), currentElem->mSceneObject);
-			if (iterFind != objects.end())
-			{
-				expandToElement(currentElem);
-				selectElement(currentElem);
-			}
+			SceneTreeElement* element = findTreeElement(so);
+			if (element == nullptr)
+				continue;
 
-			for (auto& child : currentElem->mChildren)
-			{
-				SceneTreeElement* sceneChild = static_cast<SceneTreeElement*>(child);
-				todo.push(sceneChild);
-			}
+			expandToElement(element);
+			selectElement(element);
 		}
 	}
 
 	void GUISceneTreeView::ping(const HSceneObject& object)
 	{
-		Stack<SceneTreeElement*> todo;
-		todo.push(&mRootElement);
-
-		while (!todo.empty())
-		{
-			SceneTreeElement* currentElem = todo.top();
-			todo.pop();
-
-			if (currentElem->mSceneObject == object)
-			{
-				GUITreeView::ping(currentElem);
-				break;
-			}
-
-			for (auto& child : currentElem->mChildren)
-			{
-				SceneTreeElement* sceneChild = static_cast<SceneTreeElement*>(child);
-				todo.push(sceneChild);
-			}
-		}
+		SceneTreeElement* element = findTreeElement(object);
+		if (element != nullptr)
+			GUITreeView::ping(element);
 	}
 
 	GUISceneTreeView::SceneTreeElement* GUISceneTreeView::findTreeElement(const HSceneObject& so)
 	{
-		Stack<SceneTreeElement*> todo;
-		todo.push(&mRootElement);
-
-		while (!todo.empty())
-		{
-			SceneTreeElement* currentElem = todo.top();
-			todo.pop();
+		if (so.isDestroyed())
+			return nullptr;
 
-			if (so == currentElem->mSceneObject)
-				return currentElem;
-
-			for (auto& child : currentElem->mChildren)
-			{
-				SceneTreeElement* sceneChild = static_cast<SceneTreeElement*>(child);
-				todo.push(sceneChild);
-			}
-		}
+		auto iterFind = mElementsById.find(so->getInstanceId());
+		if (iterFind != mElementsById.end())
+			return iterFind->second;
 
 		return nullptr;
 	}
@@ -136,6 +136,34 @@ namespace bs
 		 */
 		void updateTreeElement(SceneTreeElement* element);
 
+		/**
+		 * Creates and deletes child tree elements so they match the children of the SceneObject referenced by the
+		 * provided tree element. Returns true if any children were added or removed.
+		 *
+		 * @param[in]	element				Element whose children to update.
+		 * @param[in]	buildNewChildren	If true, the hierarchies of newly added children are created as well. Otherwise
+		 *									the caller is expected to call updateTreeElement() on all children.
+		 */
+		bool updateTreeElementChildren(SceneTreeElement* element, bool buildNewChildren);
+
+		/**
+		 * Updates the name, active and prefab state of the tree element from its SceneObject. Returns true if anything
+		 * changed.
+		 */
+		bool updateTreeElementProperties(SceneTreeElement* element);
+
+		/** Calculates the sorted index of all child elements of the provided tree element, based on their names. */
+		void sortTreeElementChildren(TreeElement* element);
+
+		/**
+		 * Updates the tree elements whose SceneObject%s had children added or removed since the last call, and the
+		 * properties of all tree elements currently represented by GUI elements.
+		 */
+		void updateModifiedTreeElements();
+
+		/** Triggered by the scene manager when a SceneObject gains or loses a child. */
+		void onChildrenModified(const HSceneObject& parent);
+
 		/**
 		 * Triggered when a drag and drop operation that was started by the tree view ends, regardless if it was processed
 		 * or not.
@@ -175,6 +203,9 @@ namespace bs
 		/** Deletes the internal TreeElement representation without actually deleting the referenced SceneObject. */
 		void deleteTreeElementInternal(TreeElement* element);
 
+		/** Creates a new tree element representing the provided SceneObject. */
+		SceneTreeElement* createTreeElement(SceneTreeElement* parent, const HSceneObject& so);
+
 		/**	Attempts to find a tree element referencing the specified scene object. */
 		SceneTreeElement* findTreeElement(const HSceneObject& so);
 
@@ -193,6 +224,10 @@ namespace bs
 		Vector<HSceneObject> mCopyList;
 		bool mCutFlag;
 
+		UnorderedMap<UINT64, SceneTreeElement*> mElementsById;
+		UnorderedSet<UINT64> mModifiedParents;
+		HEvent mChildrenModifiedConn;
+
 		static const Color PREFAB_TINT;
 	};
 
@@ -14,6 +14,7 @@
 #include "GUI/BsGUICommandEvent.h"
 #include "GUI/BsGUIVirtualButtonEvent.h"
 #include "GUI/BsGUIScrollArea.h"
+#include "GUI/BsGUIHelper.h"
 #include "GUI/BsDragAndDropManager.h"
 #include "Utility/BsTime.h"
 
@@ -33,7 +34,7 @@ namespace bs
 
 	GUITreeView::TreeElement::TreeElement()
 		: mParent(nullptr), mFoldoutBtn(nullptr), mElement(nullptr), mSortedIdx(0), mIsExpanded(false), mIsSelected(false)
-		, mIsHighlighted(false), mIsVisible(true), mIsCut(false), mIsDisabled(false)
+		, mIsHighlighted(false), mIsVisible(true), mIsCut(false), mIsDisabled(false), mOptimalSizeStyle(nullptr)
 	{ }
 
 	GUITreeView::TreeElement::~TreeElement()
@@ -64,22 +65,6 @@ namespace bs
 		return false;
 	}
 
-	GUITreeView::TreeElement* GUITreeView::InteractableElement::getTreeElement() const
-	{
-		if(!isTreeElement())
-			return nullptr;
-
-		UINT32 sortedIdx = (index - 1) / 2;
-
-		auto findIter = std::find_if(parent->mChildren.begin(), parent->mChildren.end(),
-			[&](const TreeElement* x) { return x->mSortedIdx == sortedIdx; });
-
-		if(findIter != parent->mChildren.end())
-			return *findIter;
-
-		return nullptr;
-	}
-
 	GUITreeView::GUITreeView(const String& backgroundStyle, const String& elementBtnStyle, 
 		const String& foldoutBtnStyle, const String& selectionBackgroundStyle, const String& highlightBackgroundStyle, 
 		const String& editBoxStyle, const String& dragHighlightStyle, const String& dragSepHighlightStyle, const GUIDimensions& dimensions)
@@ -132,6 +117,10 @@ namespace bs
 		mDragHighlight->_setElementDepth(2);
 		mDragSepHighlight->_setElementDepth(2);
 
+		mMeasureLabel = GUILabel::create(HString(L""), mElementBtnStyle);
+		mMeasureLabel->setVisible(false);
+
+		_registerChildElement(mMeasureLabel);
 		_registerChildElement(mBackgroundImage);
 		_registerChildElement(mNameEditBox);
 		_registerChildElement(mDragHighlight);
@@ -750,75 +739,141 @@ namespace bs
 		if(element == &getRootElement())
 			return;
 
+		// Name might have changed, size will be recalculated when next requested
+		element->mOptimalSizeStyle = nullptr;
+
 		if(element->mIsVisible)
+			refreshElementGUI(element);
+		else
 		{
-			HString name(toWString(element->mName));
-			if(element->mElement == nullptr)
+			releaseElementGUI(element);
+
+			if(element->mIsSelected && element->mIsExpanded)
+				unselectElement(element);
+		}
+
+		// GUI elements are assigned during layout, as only then it is known which elements are in the visible area
+		_markLayoutAsDirty();
+	}
+
+	void GUITreeView::createElementGUI(TreeElement* element)
+	{
+		if(element->mElement == nullptr)
+		{
+			if(!mFreeLabels.empty())
 			{
-				element->mElement = GUILabel::create(name, mElementBtnStyle);
+				element->mElement = mFreeLabels.back();
+				mFreeLabels.pop_back();
+			}
+			else
+			{
+				element->mElement = GUILabel::create(HString(L""), mElementBtnStyle);
 				_registerChildElement(element->mElement);
 			}
 
-			if (element->mIsCut)
-			{
-				Color cutTint = element->mTint;
-				cutTint.a = CUT_COLOR.a;
+			// Element being renamed is represented by the edit box instead
+			element->mElement->setVisible(element != mEditElement);
+		}
 
-				element->mElement->setTint(cutTint);
-			}
-			else if(element->mIsDisabled)
-			{
-				Color disabledTint = element->mTint;
-				disabledTint.a = DISABLED_COLOR.a;
+		refreshElementGUI(element);
+	}
 
-				element->mElement->setTint(disabledTint);
-			}
-			else
-				element->mElement->setTint(element->mTint);
+	void GUITreeView::releaseElementGUI(TreeElement* element)
+	{
+		if(element->mElement != nullptr)
+		{
+			element->mElement->setVisible(false);
+
+			mFreeLabels.push_back(element->mElement);
+			element->mElement = nullptr;
+		}
+
+		if(element->mFoldoutBtn != nullptr)
+		{
+			element->mFoldoutToggledConn.disconnect();
+			element->mFoldoutBtn->setVisible(false);
+
+			mFreeFoldoutBtns.push_back(element->mFoldoutBtn);
+			element->mFoldoutBtn = nullptr;
+		}
+	}
+
+	void GUITreeView::refreshElementGUI(TreeElement* element)
+	{
+		if(element->mElement == nullptr)
+			return;
+
+		if (element->mIsCut)
+		{
+			Color cutTint = element->mTint;
+			cutTint.a = CUT_COLOR.a;
+
+			element->mElement->setTint(cutTint);
+		}
+		else if(element->mIsDisabled)
+		{
+			Color disabledTint = element->mTint;
+			disabledTint.a = DISABLED_COLOR.a;
 
-			if(element->mChildren.size() > 0)
+			element->mElement->setTint(disabledTint);
+		}
+		else
+			element->mElement->setTint(element->mTint);
+
+		if(element->mChildren.size() > 0)
+		{
+			if(element->mFoldoutBtn == nullptr)
 			{
-				if(element->mFoldoutBtn == nullptr)
+				if(!mFreeFoldoutBtns.empty())
 				{
-					element->mFoldoutBtn = GUIToggle::create(GUIContent(HString(L"")), mFoldoutBtnStyle);
-					_registerChildElement(element->mFoldoutBtn);
+					element->mFoldoutBtn = mFreeFoldoutBtns.back();
+					mFreeFoldoutBtns.pop_back();
 
-					element->mFoldoutBtn->onToggled.connect(std::bind(&GUITreeView::elementToggled, this, element, _1));
-
-					if(element->mIsExpanded)
-						element->mFoldoutBtn->toggleOn();
+					element->mFoldoutBtn->setVisible(true);
 				}
-			}
-			else
-			{
-				if(element->mFoldoutBtn != nullptr)
+				else
 				{
-					GUIElement::destroy(element->mFoldoutBtn);
-					element->mFoldoutBtn = nullptr;
+					element->mFoldoutBtn = GUIToggle::create(GUIContent(HString(L"")), mFoldoutBtnStyle);
+					_registerChildElement(element->mFoldoutBtn);
 				}
-			}
 
-			element->mElement->setContent(GUIContent(name));
+				// Set the state before connecting, so a reused button doesn't report a toggle
+				if(element->mIsExpanded)
+					element->mFoldoutBtn->toggleOn();
+				else
+					element->mFoldoutBtn->toggleOff();
+
+				element->mFoldoutToggledConn = element->mFoldoutBtn->onToggled.connect(
+					std::bind(&GUITreeView::elementToggled, this, element, _1));
+			}
 		}
 		else
 		{
-			if(element->mElement != nullptr)
-			{
-				GUIElement::destroy(element->mElement);
-				element->mElement = nullptr;
-			}
-
 			if(element->mFoldoutBtn != nullptr)
 			{
-				GUIElement::destroy(element->mFoldoutBtn);
+				element->mFoldoutToggledConn.disconnect();
+				element->mFoldoutBtn->setVisible(false);
+
+				mFreeFoldoutBtns.push_back(element->mFoldoutBtn);
 				element->mFoldoutBtn = nullptr;
 			}
+		}
 
-			if(element->mIsSelected && element->mIsExpanded)
-				unselectElement(element);
+		element->mElement->setContent(GUIContent(HString(toWString(element->mName))));
+	}
+
+	Vector2I GUITreeView::getElementOptimalSize(const TreeElement* element) const
+	{
+		// Sizes are cached per element, and recalculated when the name or the style changes
+		const GUIElementStyle* style = mMeasureLabel->_getStyle();
+		if(element->mOptimalSizeStyle != style)
+		{
+			element->mOptimalSize = GUIHelper::calcOptimalContentsSize(toWString(element->mName), *style, 
+				mMeasureLabel->_getDimensions());
+			element->mOptimalSizeStyle = style;
 		}
 
-		_markLayoutAsDirty();
+		return element->mOptimalSize;
 	}
 
 	void GUITreeView::elementToggled(TreeElement* element, bool toggled)
@@ -916,9 +971,9 @@ namespace bs
 				todo.pop();
 
 				INT32 yOffset = 0;
-				if(current->mElement != nullptr)
+				if(current != &getRootElementConst())
 				{
-					Vector2I curOptimalSize = current->mElement->_getOptimalSize();
+					Vector2I curOptimalSize = getElementOptimalSize(current);
 					optimalSize.x = std::max(optimalSize.x, 
 						(INT32)(INITIAL_INDENT_OFFSET + curOptimalSize.x + currentUpdateElement.indent * INDENT_SIZE));
 					yOffset = curOptimalSize.y + ELEMENT_EXTRA_SPACING;
@@ -981,16 +1036,19 @@ namespace bs
 
 		mVisibleElements.clear();
 
-		Stack<UpdateTreeElement> todo;
-		todo.push(UpdateTreeElement(&getRootElement(), 0));
+		TreeElement* rootElement = &getRootElement();
 
-		// NOTE - Instead of iterating through all elements, try to find those within the clip rect
-		// and only iterate through those. Others should somehow be marked in-active (similar to GUIElement::isDisabled()?)
+		Stack<UpdateTreeElement> todo;
+		todo.push(UpdateTreeElement(rootElement, 0));
 
 		Vector<TreeElement*> tempOrderedElements;
 
 		Vector2I offset(data.area.x, data.area.y);
 
+		// Only elements overlapping the clip rect are represented by GUI elements, the rest only have their area updated
+		INT32 clipTop = data.clipRect.y;
+		INT32 clipBottom = data.clipRect.y + (INT32)data.clipRect.height;
+
 		while(!todo.empty())
 		{
 			UpdateTreeElement currentUpdateElement = todo.top();
@@ -1000,24 +1058,32 @@ namespace bs
 
 			INT32 btnHeight = 0;
 			INT32 yOffset = 0;
-			if(current->mElement != nullptr)
+			if(current != rootElement)
 			{
-				Vector2I elementSize = current->mElement->_getOptimalSize();
+				Vector2I elementSize = getElementOptimalSize(current);
 				btnHeight = elementSize.y;
 
 				mVisibleElements.push_back(InteractableElement(current->mParent, current->mSortedIdx * 2 + 0, Rect2I(data.area.x, offset.y, data.area.width, ELEMENT_EXTRA_SPACING)));
-				mVisibleElements.push_back(InteractableElement(current->mParent, current->mSortedIdx * 2 + 1, Rect2I(data.area.x, offset.y + ELEMENT_EXTRA_SPACING, data.area.width, btnHeight)));
+				mVisibleElements.push_back(InteractableElement(current->mParent, current->mSortedIdx * 2 + 1, Rect2I(data.area.x, offset.y + ELEMENT_EXTRA_SPACING, data.area.width, btnHeight), current));
 
 				offset.x = data.area.x + INITIAL_INDENT_OFFSET + indent * INDENT_SIZE;
 				offset.y += ELEMENT_EXTRA_SPACING;
 
-				GUILayoutData childData = data;
-				childData.area.x = offset.x;
-				childData.area.y = offset.y;
-				childData.area.width = elementSize.x;
-				childData.area.height = elementSize.y;
+				current->mArea = Rect2I(offset.x, offset.y, elementSize.x, elementSize.y);
 
-				current->mElement->_setLayoutData(childData);
+				bool inClipRect = offset.y < clipBottom && (offset.y + btnHeight) > clipTop;
+				if(inClipRect)
+				{
+					if(current->mElement == nullptr)
+						createElementGUI(current);
+
+					GUILayoutData childData = data;
+					childData.area = current->mArea;
+
+					current->mElement->_setLayoutData(childData);
+				}
+				else if(current->mElement != nullptr)
+					releaseElementGUI(current);
 
 				yOffset = btnHeight;
 			}
@@ -1073,25 +1139,25 @@ namespace bs
 
 		for(auto selectedElem : mSelectedElements)
 		{
-			GUILabel* targetElement = selectedElem.element->mElement;
-			if (targetElement == nullptr)
+			TreeElement* targetElement = selectedElem.element;
+			if (!targetElement->mIsVisible)
 				continue;
 
 			GUILayoutData childData = data;
-			childData.area.y = targetElement->_getLayoutData().area.y;
-			childData.area.height = targetElement->_getLayoutData().area.height;
+			childData.area.y = targetElement->mArea.y;
+			childData.area.height = targetElement->mArea.height;
 
 			selectedElem.background->_setLayoutData(childData);
 		}
 
 		if (mIsElementHighlighted)
 		{
-			GUILabel* targetElement = mHighlightedElement.element->mElement;
-			if (targetElement != nullptr)
+			TreeElement* targetElement = mHighlightedElement.element;
+			if (targetElement->mIsVisible)
 			{
 				GUILayoutData childData = data;
-				childData.area.y = targetElement->_getLayoutData().area.y;
-				childData.area.height = targetElement->_getLayoutData().area.height;
+				childData.area.y = targetElement->mArea.y;
+				childData.area.height = targetElement->mArea.height;
 
 				mHighlightedElement.background->_setLayoutData(childData);
 			}
@@ -1099,13 +1165,12 @@ namespace bs
 
 		if(mEditElement != nullptr)
 		{
-			GUILabel* targetElement = mEditElement->mElement;
-			if (targetElement != nullptr)
+			if (mEditElement->mIsVisible)
 			{
 				UINT32 remainingWidth = (UINT32)std::max(0, (((INT32)data.area.width) - (offset.x - data.area.x)));
 
 				GUILayoutData childData = data;
-				childData.area = targetElement->_getLayoutData().area;
+				childData.area = mEditElement->mArea;
 				childData.area.width = remainingWidth;
 
 				mNameEditBox->_setLayoutData(childData);
@@ -1293,7 +1358,7 @@ namespace bs
 
 	void GUITreeView::scrollToElement(TreeElement* element, bool center)
 	{
-		if(element->mElement == nullptr)
+		if(!element->mIsVisible || element == &getRootElement())
 			return;
 
 		GUIScrollArea* scrollArea = findParentScrollArea();
@@ -1304,7 +1369,7 @@ namespace bs
 		{
 			Rect2I myBounds = _getClippedBounds();
 			INT32 clipVertCenter = myBounds.y + (INT32)Math::roundToInt(myBounds.height * 0.5f);
-			INT32 elemVertCenter = element->mElement->_getLayoutData().area.y + (INT32)Math::roundToInt(element->mElement->_getLayoutData().area.height * 0.5f);
+			INT32 elemVertCenter = element->mArea.y + (INT32)Math::roundToInt(element->mArea.height * 0.5f);
 
 			if(elemVertCenter > clipVertCenter)
 				scrollArea->scrollDownPx(elemVertCenter - clipVertCenter);
@@ -1314,8 +1379,8 @@ namespace bs
 		else
 		{
 			Rect2I myBounds = _getClippedBounds();
-			INT32 elemVertTop = element->mElement->_getLayoutData().area.y;
-			INT32 elemVertBottom = element->mElement->_getLayoutData().area.y + element->mElement->_getLayoutData().area.height;
+			INT32 elemVertTop = element->mArea.y;
+			INT32 elemVertBottom = element->mArea.y + element->mArea.height;
 
 			INT32 top = myBounds.y;
 			INT32 bottom = myBounds.y + myBounds.height;
@@ -36,8 +36,9 @@ namespace bs
 		};
 
 		/**
-		 * Contains data about a single piece of content and all its children. This element may be visible and represented
-		 * by a GUI element, but might not (for example its parent is collapsed).
+		 * Contains data about a single piece of content and all its children. This element may be visible, but might not
+		 * (for example its parent is collapsed). Visible elements are only represented by GUI elements while they are
+		 * within the visible area of the tree view.
 		 */
 		struct TreeElement
 		{
@@ -49,8 +50,10 @@ namespace bs
 
 			GUIToggle* mFoldoutBtn;
 			GUILabel* mElement;
+			HEvent mFoldoutToggledConn;
 
 			String mName;
+			Rect2I mArea;
 
 			UINT32 mSortedIdx;
 			bool mIsExpanded;
@@ -61,6 +64,9 @@ namespace bs
 			bool mIsDisabled;
 			Color mTint;
 
+			mutable Vector2I mOptimalSize;
+			mutable const GUIElementStyle* mOptimalSizeStyle;
+
 			bool isParentRec(TreeElement* element) const;
 		};
 
@@ -70,16 +76,17 @@ namespace bs
 		 */
 		struct InteractableElement
 		{
-			InteractableElement(TreeElement* parent, UINT32 index, const Rect2I& bounds)
-				:parent(parent), index(index), bounds(bounds)
+			InteractableElement(TreeElement* parent, UINT32 index, const Rect2I& bounds, TreeElement* element = nullptr)
+				:parent(parent), index(index), bounds(bounds), element(element)
 			{ }
 
 			bool isTreeElement() const { return index % 2 == 1; }
-			TreeElement* getTreeElement() const;
+			TreeElement* getTreeElement() const { return isTreeElement() ? element : nullptr; }
 
 			TreeElement* parent;
 			UINT32 index;
 			Rect2I bounds;
+			TreeElement* element;
 		};
 
 		/**	Contains data about one of the currently selected tree elements. */
@@ -234,9 +241,30 @@ namespace bs
 		/**	Collapses the provided TreeElement making its children hidden and not interactable. */
 		void collapseElement(TreeElement* element);
 
-		/**	Rebuilds the needed GUI elements for the provided TreeElement. */
+		/**
+		 * Refreshes the GUI elements of the provided TreeElement after its contents or visibility changed. Must be called
+		 * whenever element name, tint, visibility or number of children changes.
+		 */
 		void updateElementGUI(TreeElement* element);
 
+		/**
+		 * Assigns GUI elements to the provided TreeElement, reusing previously released ones if possible. Called when the
+		 * element enters the visible area of the tree view.
+		 */
+		void createElementGUI(TreeElement* element);
+
+		/**
+		 * Releases the GUI elements of the provided TreeElement so they can be reused by other elements. Called when the
+		 * element leaves the visible area of the tree view, or is hidden.
+		 */
+		void releaseElementGUI(TreeElement* element);
+
+		/** Updates the contents of the GUI elements assigned to the provided TreeElement, if any. */
+		void refreshElementGUI(TreeElement* element);
+
+		/** Returns the optimal size of the label representing the provided TreeElement. */
+		Vector2I getElementOptimalSize(const TreeElement* element) const;
+
 		/**	Close any elements that were temporarily expanded due to a drag operation hovering over them. */
 		void closeTemporarilyExpandedElements();
 
@@ -285,6 +313,13 @@ namespace bs
 
 		Vector<InteractableElement> mVisibleElements;
 
+		// GUI elements not currently assigned to any TreeElement, hidden until reused
+		Vector<GUILabel*> mFreeLabels;
+		Vector<GUIToggle*> mFreeFoldoutBtns;
+
+		// Hidden label used for calculating the size of tree elements that have no GUI elements assigned
+		GUILabel* mMeasureLabel;
+
 		bool mIsElementSelected;
 		Vector<SelectedElement> mSelectedElements;
 
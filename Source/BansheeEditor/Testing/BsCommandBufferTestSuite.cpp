@@ -0,0 +1,345 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "Testing/BsCommandBufferTestSuite.h"
+#include "CoreThread/BsCommandBuffer.h"
+#include <array>
+
+namespace bs
+{
+	/** Keeps track of the number of its live copies, so tests can check command captures are destroyed. */
+	struct LiveCounter
+	{
+		LiveCounter(std::atomic<INT32>* numLive)
+			:numLive(numLive)
+		{
+			(*numLive)++;
+		}
+
+		LiveCounter(const LiveCounter& other)
+			:numLive(other.numLive)
+		{
+			(*numLive)++;
+		}
+
+		~LiveCounter()
+		{
+			(*numLive)--;
+		}
+
+		LiveCounter& operator=(const LiveCounter&) = delete;
+
+		std::atomic<INT32>* numLive;
+	};
+
+	/** Adds a command to the buffer and fills out its header. */
+	template<class Fn>
+	QueuedCommand* queueCommand(CommandBuffer& buffer, Fn&& callback, UINT32 callbackId = 0, bool notify = false)
+	{
+		QueuedCommand* command = buffer.push(std::forward<Fn>(callback));
+		command->callbackId = callbackId;
+		command->notifyWhenComplete = notify;
+
+		return command;
+	}
+
+	/**
+	 * Adds a command capturing a payload of the specified size. When executed the command checks the payload contents
+	 * and records its index.
+	 */
+	template<UINT32 SIZE>
+	QueuedCommand* queuePayload(CommandBuffer& buffer, UINT32 index, const LiveCounter& counter,
+		Vector<UINT32>& executed, bool& valid)
+	{
+		std::array<UINT8, SIZE> payload;
+		for (UINT32 i = 0; i < SIZE; i++)
+			payload[i] = (UINT8)(index + i);
+
+		return queueCommand(buffer, [payload, index, counter, &executed, &valid]()
+		{
+			for (UINT32 i = 0; i < SIZE; i++)
+				valid &= payload[i] == (UINT8)(index + i);
+
+			executed.push_back(index);
+		});
+	}
+
+	/** Checks that the entries are a sequence of increasing indices starting at zero. */
+	bool isSequence(const Vector<UINT32>& entries)
+	{
+		for (UINT32 i = 0; i < (UINT32)entries.size(); i++)
+		{
+			if (entries[i] != i)
+				return false;
+		}
+
+		return true;
+	}
+
+	CommandBufferTestSuite::CommandBufferTestSuite()
+	{
+		BS_ADD_TEST(CommandBufferTestSuite::testCaptures);
+		BS_ADD_TEST(CommandBufferTestSuite::testBlockBoundaries);
+		BS_ADD_TEST(CommandBufferTestSuite::testOrderAndDestruction);
+		BS_ADD_TEST(CommandBufferTestSuite::testThreadedPlayback);
+	}
+
+	void CommandBufferTestSuite::testCaptures()
+	{
+		static const UINT32 NUM_COMMANDS = 16;
+
+		CommandBuffer buffer;
+		SPtr<Vector<String>> output = bs_shared_ptr_new<Vector<String>>();
+
+		// Long enough to not fit into small string storage
+		String longString(1000, 'x');
+		String shortString = "short";
+
+		for (UINT32 i = 0; i < NUM_COMMANDS; i++)
+		{
+			queueCommand(buffer, [output, shortString, longString, i]()
+			{
+				output->push_back(shortString + toString(i));
+				output->push_back(longString);
+			}, i, true);
+		}
+
+		BS_TEST_ASSERT(output.use_count() == NUM_COMMANDS + 1);
+
+		AsyncOp asyncOp;
+		QueuedCommand* command = buffer.pushReturn([output](AsyncOp& op)
+		{
+			op._completeOperation((UINT32)output->size());
+		}, asyncOp);
+
+		command->callbackId = 0;
+		command->notifyWhenComplete = false;
+
+		// Return value not set by the callback
+		AsyncOp incompleteAsyncOp;
+		command = buffer.pushReturn([](AsyncOp& op) { }, incompleteAsyncOp);
+		command->callbackId = 0;
+		command->notifyWhenComplete = false;
+
+		BS_TEST_ASSERT(buffer.getNumCommands() == NUM_COMMANDS + 2);
+
+		CommandBuffer::CommandList commands = buffer.flush();
+		BS_TEST_ASSERT(commands.numCommands == NUM_COMMANDS + 2);
+		BS_TEST_ASSERT(buffer.getNumCommands() == 0);
+
+		Vector<UINT32> notified;
+		buffer.playback(commands, [&notified](UINT32 callbackId) { notified.push_back(callbackId); });
+
+		BS_TEST_ASSERT(output->size() == NUM_COMMANDS * 2);
+		for (UINT32 i = 0; i < NUM_COMMANDS; i++)
+		{
+			BS_TEST_ASSERT((*output)[i * 2] == shortString + toString(i));
+			BS_TEST_ASSERT((*output)[i * 2 + 1] == longString);
+		}
+
+		BS_TEST_ASSERT(output.use_count() == 1);
+		BS_TEST_ASSERT(notified.size() == NUM_COMMANDS && isSequence(notified));
+
+		BS_TEST_ASSERT(asyncOp.hasCompleted());
+		BS_TEST_ASSERT(asyncOp.getReturnValue<UINT32>() == NUM_COMMANDS * 2);
+		BS_TEST_ASSERT(incompleteAsyncOp.hasCompleted());
+	}
+
+	void CommandBufferTestSuite::testBlockBoundaries()
+	{
+		static const UINT32 NUM_COMMANDS = 500;
+		static const UINT32 NUM_ROUNDS = 3;
+
+		std::atomic<INT32> numLive(0);
+		LiveCounter counter(&numLive);
+
+		CommandBuffer buffer;
+		for (UINT32 round = 0; round < NUM_ROUNDS; round++)
+		{
+			Vector<UINT32> executed;
+			bool valid = true;
+
+			for (UINT32 i = 0; i < NUM_COMMANDS; i++)
+			{
+				// Mix of sizes, so commands end at different offsets within a block. Every so often queue a command
+				// larger than a block.
+				if ((i % 100) == 99)
+					queuePayload<CommandBuffer::BLOCK_SIZE + 1000>(buffer, i, counter, executed, valid);
+				else
+				{
+					switch (i % 5)
+					{
+					case 0: queuePayload<1>(buffer, i, counter, executed, valid); break;
+					case 1: queuePayload<24>(buffer, i, counter, executed, valid); break;
+					case 2: queuePayload<200>(buffer, i, counter, executed, valid); break;
+					case 3: queuePayload<1000>(buffer, i, counter, executed, valid); break;
+					case 4: queuePayload<20000>(buffer, i, counter, executed, valid); break;
+					}
+				}
+			}
+
+			BS_TEST_ASSERT(buffer.getNumCommands() == NUM_COMMANDS);
+			BS_TEST_ASSERT(numLive == (INT32)NUM_COMMANDS + 1);
+
+			buffer.playback(buffer.flush());
+
+			BS_TEST_ASSERT(executed.size() == NUM_COMMANDS && isSequence(executed));
+			BS_TEST_ASSERT(valid);
+			BS_TEST_ASSERT(numLive == 1);
+		}
+	}
+
+	void CommandBufferTestSuite::testOrderAndDestruction()
+	{
+		static const UINT32 NUM_COMMANDS = 1000;
+
+		std::atomic<INT32> numLive(0);
+		Vector<UINT32> executed;
+		Vector<INT32> liveOnExecute;
+
+		{
+			CommandBuffer buffer;
+			for (UINT32 i = 0; i < NUM_COMMANDS; i++)
+			{
+				LiveCounter counter(&numLive);
+				queueCommand(buffer, [counter, i, &numLive, &executed, &liveOnExecute]()
+				{
+					executed.push_back(i);
+					liveOnExecute.push_back(numLive);
+				});
+			}
+
+			BS_TEST_ASSERT(numLive == (INT32)NUM_COMMANDS);
+			buffer.playback(buffer.flush());
+
+			BS_TEST_ASSERT(executed.size() == NUM_COMMANDS && isSequence(executed));
+			BS_TEST_ASSERT(numLive == 0);
+
+			// Each command is destroyed right after it executes
+			bool destroyedInOrder = true;
+			for (UINT32 i = 0; i < (UINT32)liveOnExecute.size(); i++)
+				destroyedInOrder &= liveOnExecute[i] == (INT32)(NUM_COMMANDS - i);
+
+			BS_TEST_ASSERT(destroyedInOrder);
+
+			// Cancelled commands are destroyed without executing
+			for (UINT32 i = 0; i < NUM_COMMANDS; i++)
+			{
+				LiveCounter counter(&numLive);
+				queueCommand(buffer, [counter, &executed]() { executed.push_back(0); });
+			}
+
+			BS_TEST_ASSERT(numLive == (INT32)NUM_COMMANDS);
+			buffer.cancel(buffer.flush());
+
+			BS_TEST_ASSERT(numLive == 0);
+			BS_TEST_ASSERT(executed.size() == NUM_COMMANDS);
+
+			// Commands still in the buffer when it is destroyed are destroyed without executing
+			for (UINT32 i = 0; i < NUM_COMMANDS; i++)
+			{
+				LiveCounter counter(&numLive);
+				queueCommand(buffer, [counter, &executed]() { executed.push_back(0); });
+			}
+
+			BS_TEST_ASSERT(numLive == (INT32)NUM_COMMANDS);
+		}
+
+		BS_TEST_ASSERT(numLive == 0);
+		BS_TEST_ASSERT(executed.size() == NUM_COMMANDS);
+	}
+
+	void CommandBufferTestSuite::testThreadedPlayback()
+	{
+		static const UINT32 NUM_FLUSHES = 1000;
+		static const UINT32 MAX_COMMANDS_PER_FLUSH = 500;
+		static const UINT32 MAX_QUEUED_LISTS = 4;
+
+		std::atomic<INT32> numLive(0);
+		LiveCounter counter(&numLive);
+
+		CommandBuffer buffer;
+		Mutex mutex;
+		Signal signal;
+		Queue<CommandBuffer::CommandList> queuedLists;
+		bool done = false;
+
+		// Only accessed by the consumer, until it is joined
+		Vector<UINT32> executed;
+		bool valid = true;
+
+		Thread consumer([&]()
+		{
+			while (true)
+			{
+				CommandBuffer::CommandList commands;
+				{
+					Lock lock(mutex);
+
+					while (queuedLists.empty() && !done)
+						signal.wait(lock);
+
+					if (queuedLists.empty())
+						break;
+
+					commands = queuedLists.front();
+					queuedLists.pop();
+				}
+
+				signal.notify_all();
+				buffer.playback(commands);
+			}
+		});
+
+		// A new block is allocated only when none were returned by the consumer, and the first command after a flush is
+		// always at the start of a block. So the number of different addresses of the first commands is an upper bound
+		// on the number of blocks allocated.
+		UnorderedSet<QueuedCommand*> firstCommands;
+
+		UINT32 index = 0;
+		UINT32 seed = 1;
+		for (UINT32 i = 0; i < NUM_FLUSHES; i++)
+		{
+			seed = seed * 1103515245 + 12345;
+			UINT32 numCommands = 1 + (seed >> 8) % MAX_COMMANDS_PER_FLUSH;
+
+			for (UINT32 j = 0; j < numCommands; j++)
+			{
+				QueuedCommand* command;
+				if ((index % 3) == 0)
+					command = queuePayload<256>(buffer, index, counter, executed, valid);
+				else
+					command = queuePayload<8>(buffer, index, counter, executed, valid);
+
+				if (j == 0)
+					firstCommands.insert(command);
+
+				index++;
+			}
+
+			CommandBuffer::CommandList commands = buffer.flush();
+			{
+				Lock lock(mutex);
+
+				while (queuedLists.size() >= MAX_QUEUED_LISTS)
+					signal.wait(lock);
+
+				queuedLists.push(commands);
+			}
+
+			signal.notify_all();
+		}
+
+		{
+			Lock lock(mutex);
+			done = true;
+		}
+
+		signal.notify_all();
+		consumer.join();
+
+		BS_TEST_ASSERT(executed.size() == index && isSequence(executed));
+		BS_TEST_ASSERT(valid);
+		BS_TEST_ASSERT(numLive == 1);
+		BS_TEST_ASSERT(firstCommands.size() < NUM_FLUSHES / 10);
+	}
+}
@@ -0,0 +1,38 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsEditorPrerequisites.h"
+#include "Testing/BsTestSuite.h"
+
+namespace bs
+{
+	/** @addtogroup Testing-Editor
+	 *  @{
+	 */
+
+	/** Contains a set of unit tests for CommandBuffer. */
+	class CommandBufferTestSuite : public TestSuite
+	{
+	public:
+		CommandBufferTestSuite();
+
+	private:
+		/** Queues commands capturing shared pointers and strings, and commands returning values. */
+		void testCaptures();
+
+		/** Queues commands with payloads of varied sizes so they cross block boundaries, including oversized ones. */
+		void testBlockBoundaries();
+
+		/** Checks commands execute in order, and that their captures are destroyed when executed or cancelled. */
+		void testOrderAndDestruction();
+
+		/**
+		 * Queues commands on one thread and plays them back on another, across many flushes, checking their memory
+		 * blocks get reused.
+		 */
+		void testThreadedPlayback();
+	};
+
+	/** @} */
+}
@@ -16,6 +16,17 @@
 #include "Allocators/BsFrameAlloc.h"
 #include "FileSystem/BsFileSystem.h"
 #include "Scene/BsSceneManager.h"
+#include "Scene/BsGameObjectManager.h"
+#include "Utility/BsTimer.h"
+#include "Animation/BsAnimation.h"
+#include "Animation/BsAnimationClip.h"
+#include "Animation/BsAnimationManager.h"
+#include "Animation/BsBakedAnimationPoses.h"
+#include "Animation/BsSkeleton.h"
+#include "Animation/BsSkeletonMask.h"
+#include "Mesh/BsMeshUtility.h"
+#include "Mesh/BsMeshData.h"
+#include "Math/BsVector2.h"
 
 namespace bs
 {
@@ -414,6 +425,13 @@ namespace bs
 		BS_ADD_TEST(EditorTestSuite::TestPrefabComplex);
 		BS_ADD_TEST(EditorTestSuite::TestPrefabDiff);
 		BS_ADD_TEST(EditorTestSuite::TestFrameAlloc);
+		BS_ADD_TEST(EditorTestSuite::TestGameObjectHandles);
+		BS_ADD_TEST(EditorTestSuite::TestGameObjectHandlesBenchmark);
+		BS_ADD_TEST(EditorTestSuite::TestAnimationCompression);
+		BS_ADD_TEST(EditorTestSuite::TestBakedPoses);
+		BS_ADD_TEST(EditorTestSuite::TestSkeletonBlending);
+		BS_ADD_TEST(EditorTestSuite::TestAnimationLOD);
+		BS_ADD_TEST(EditorTestSuite::TestMeshOptimization);
 	}
 
 	void EditorTestSuite::SceneObjectRecord_UndoRedo()
@@ -808,4 +826,1032 @@ namespace bs
 		alloc.dealloc(a13);
 		alloc.clear();
 	}
+
+	void EditorTestSuite::TestGameObjectHandles()
+	{
+		static const UINT32 NUM_PARENTS = 1000;
+		static const UINT32 NUM_CHILDREN = 99;
+
+		GameObjectManager& gom = GameObjectManager::instance();
+
+		HSceneObject root = SceneObject::create("root");
+		Vector<HSceneObject> objects;
+		objects.reserve(NUM_PARENTS * (NUM_CHILDREN + 1));
+
+		for (UINT32 i = 0; i < NUM_PARENTS; i++)
+		{
+			HSceneObject parent = SceneObject::create("parent");
+			parent->setParent(root);
+			objects.push_back(parent);
+
+			for (UINT32 j = 0; j < NUM_CHILDREN; j++)
+			{
+				HSceneObject child = SceneObject::create("child");
+				child->setParent(parent);
+				objects.push_back(child);
+			}
+		}
+
+		bool allFound = true;
+		Vector<UINT64> instanceIds;
+		instanceIds.reserve(objects.size());
+		for (auto& entry : objects)
+		{
+			UINT64 instanceId = entry.getInstanceId();
+			instanceIds.push_back(instanceId);
+
+			GameObjectHandleBase handle = gom.getObject(instanceId);
+			allFound &= !handle.isDestroyed() && handle.get() == entry.get();
+		}
+
+		BS_TEST_ASSERT(allFound);
+
+		// Destroy half the parents individually so their slots get reused, and the rest along with the root
+		UINT64 destroyedId = instanceIds[0];
+		for (UINT32 i = 0; i < NUM_PARENTS; i += 2)
+			objects[i * (NUM_CHILDREN + 1)]->destroy();
+
+		gom.destroyQueuedObjects();
+		root->destroy(true);
+
+		// Handles of destroyed objects report an instance ID of zero, so check the IDs recorded before destruction
+		bool allDestroyed = true;
+		for (UINT32 i = 0; i < (UINT32)objects.size(); i++)
+			allDestroyed &= objects[i].isDestroyed() && !gom.objectExists(instanceIds[i]);
+
+		BS_TEST_ASSERT(allDestroyed);
+
+		// IDs of destroyed objects must not resolve to new objects placed in the same slots
+		HSceneObject newObject = SceneObject::create("new");
+		BS_TEST_ASSERT(newObject.getInstanceId() != destroyedId);
+		BS_TEST_ASSERT(!gom.objectExists(destroyedId));
+		BS_TEST_ASSERT(gom.getObject(newObject.getInstanceId()).get() == newObject.get());
+		newObject->destroy(true);
+	}
+
+	void EditorTestSuite::TestGameObjectHandlesBenchmark()
+	{
+		static const UINT32 NUM_OBJECTS = 100000;
+
+		GameObjectManager& gom = GameObjectManager::instance();
+
+		Timer timer;
+		HSceneObject root = SceneObject::create("root");
+		Vector<HSceneObject> objects;
+		objects.reserve(NUM_OBJECTS);
+
+		for (UINT32 i = 0; i < NUM_OBJECTS; i++)
+		{
+			HSceneObject so = SceneObject::create("object");
+			so->setParent(root);
+			objects.push_back(so);
+		}
+
+		UINT64 createTime = timer.getMicroseconds();
+
+		Vector<UINT64> instanceIds;
+		instanceIds.reserve(NUM_OBJECTS);
+		for (auto& entry : objects)
+			instanceIds.push_back(entry.getInstanceId());
+
+		// Look up in random order, so neither container benefits from IDs being allocated sequentially
+		Vector<UINT64> lookupIds = instanceIds;
+		UINT32 seed = 1;
+		for (UINT32 i = NUM_OBJECTS - 1; i > 0; i--)
+		{
+			seed = seed * 1103515245 + 12345;
+			std::swap(lookupIds[i], lookupIds[(seed >> 8) % (i + 1)]);
+		}
+
+		timer.reset();
+		bool allFound = true;
+		for (auto& entry : lookupIds)
+			allFound &= gom.getObject(entry).getInstanceId() == entry;
+
+		UINT64 lookupTime = timer.getMicroseconds();
+		BS_TEST_ASSERT(allFound);
+
+		// Same operations on an ordered map, for comparison
+		Map<UINT64, GameObjectHandleBase> objectMap;
+
+		timer.reset();
+		for (UINT32 i = 0; i < NUM_OBJECTS; i++)
+			objectMap[instanceIds[i]] = objects[i];
+
+		UINT64 mapInsertTime = timer.getMicroseconds();
+
+		timer.reset();
+		bool allFoundInMap = true;
+		for (auto& entry : lookupIds)
+		{
+			auto iterFind = objectMap.find(entry);
+			allFoundInMap &= iterFind != objectMap.end() && iterFind->second.getInstanceId() == entry;
+		}
+
+		UINT64 mapLookupTime = timer.getMicroseconds();
+		BS_TEST_ASSERT(allFoundInMap);
+
+		timer.reset();
+		for (auto& entry : instanceIds)
+			objectMap.erase(entry);
+
+		UINT64 mapEraseTime = timer.getMicroseconds();
+
+		timer.reset();
+		root->destroy(true);
+
+		UINT64 destroyTime = timer.getMicroseconds();
+
+		bool allDestroyed = true;
+		for (auto& entry : instanceIds)
+			allDestroyed &= !gom.objectExists(entry);
+
+		BS_TEST_ASSERT(allDestroyed);
+
+		LOGDBG("Game object handles (" + toString(NUM_OBJECTS) + " objects): create " + toString(createTime) +
+			"us, lookup " + toString(lookupTime) + "us, destroy " + toString(destroyTime) + "us. Ordered map: insert " +
+			toString(mapInsertTime) + "us, lookup " + toString(mapLookupTime) + "us, erase " + toString(mapEraseTime) +
+			"us");
+	}
+
+	void EditorTestSuite::TestAnimationCompression()
+	{
+		static const UINT32 NUM_BONES = 50;
+		static const UINT32 SAMPLE_RATE = 30;
+		static const UINT32 NUM_KEYS = 61;
+
+		// Keyframes sampled from smooth motion, similar to imported mocap data, with constant scale
+		SPtr<AnimationCurves> curves = bs_shared_ptr_new<AnimationCurves>();
+		for (UINT32 i = 0; i < NUM_BONES; i++)
+		{
+			Vector<TKeyframe<Vector3>> positionKeys(NUM_KEYS);
+			Vector<TKeyframe<Quaternion>> rotationKeys(NUM_KEYS);
+			Vector<TKeyframe<Vector3>> scaleKeys(NUM_KEYS);
+
+			for (UINT32 j = 0; j < NUM_KEYS; j++)
+			{
+				float time = j / (float)SAMPLE_RATE;
+				float phase = time * Math::TWO_PI * 0.5f + i;
+
+				positionKeys[j] = { Vector3(std::sin(phase), std::cos(phase) * 2.0f, (float)i), Vector3::ZERO,
+					Vector3::ZERO, time };
+				rotationKeys[j] = { Quaternion(Vector3::UNIT_Y, Radian(phase)), Quaternion::ZERO, Quaternion::ZERO, time };
+				scaleKeys[j] = { Vector3::ONE, Vector3::ZERO, Vector3::ZERO, time };
+			}
+
+			String name = "bone" + toString(i);
+			curves->addPositionCurve(name, TAnimationCurve<Vector3>(positionKeys));
+			curves->addRotationCurve(name, TAnimationCurve<Quaternion>(rotationKeys));
+			curves->addScaleCurve(name, TAnimationCurve<Vector3>(scaleKeys));
+		}
+
+		SPtr<AnimationClip> clip = AnimationClip::_createPtr(curves, false, SAMPLE_RATE);
+		float length = clip->getLength();
+
+		clip->compress();
+		BS_TEST_ASSERT(clip->isCompressed());
+		BS_TEST_ASSERT(Math::approxEquals(clip->getLength(), length));
+
+		AnimationCompressionStats stats = clip->getCompressionStats();
+		BS_TEST_ASSERT(stats.compressedSize > 0 && stats.compressedSize * 4 < stats.uncompressedSize);
+		BS_TEST_ASSERT(stats.maxPositionError < 0.01f);
+		BS_TEST_ASSERT(stats.maxRotationError < 0.01f);
+		BS_TEST_ASSERT(stats.maxScaleError < 0.0001f);
+
+		// Evaluate all curves at once and compare against the source curves, at and in between the keyframes, including
+		// past the end of the clip
+		SPtr<CompressedAnimationCurves> compressed = clip->_getCompressedCurves();
+		Vector<Vector3> positions(NUM_BONES);
+		Vector<Quaternion> rotations(NUM_BONES);
+		Vector<Vector3> scales(NUM_BONES);
+
+		bool allMatch = true;
+		for (UINT32 i = 0; i < NUM_KEYS * 3; i++)
+		{
+			float time = i / (SAMPLE_RATE * 2.0f);
+			compressed->evaluate(time, true, positions.data(), rotations.data(), scales.data());
+
+			for (UINT32 j = 0; j < NUM_BONES; j++)
+			{
+				Vector3 position = curves->position[j].curve.evaluate(time, true);
+				Quaternion rotation = curves->rotation[j].curve.evaluate(time, true);
+				rotation.normalize();
+
+				allMatch &= position.distance(positions[j]) <= stats.maxPositionError + 0.001f;
+				allMatch &= std::abs(rotation.dot(rotations[j])) > 0.999f;
+				allMatch &= scales[j] == Vector3::ONE;
+			}
+		}
+
+		BS_TEST_ASSERT(allMatch);
+	}
+
+	void EditorTestSuite::TestBakedPoses()
+	{
+		static const UINT32 SAMPLE_RATE = 30;
+
+		BONE_DESC bone;
+		bone.name = "bone";
+		bone.parent = (UINT32)-1;
+		bone.invBindPose = Matrix4::IDENTITY;
+
+		SPtr<Skeleton> skeleton = Skeleton::create(&bone, 1);
+
+		// Moves the bone from the origin to the provided position over one second
+		auto createCurves = [](const Vector3& position)
+		{
+			Vector<TKeyframe<Vector3>> keys =
+			{
+				{ Vector3::ZERO, Vector3::ZERO, Vector3::ZERO, 0.0f },
+				{ position, Vector3::ZERO, Vector3::ZERO, 1.0f }
+			};
+
+			AnimationCurves curves;
+			curves.addPositionCurve("bone", TAnimationCurve<Vector3>(keys));
+
+			return curves;
+		};
+
+		SPtr<AnimationClip> clip = AnimationClip::_createPtr(
+			bs_shared_ptr_new<AnimationCurves>(createCurves(Vector3(1.0f, 0.0f, 0.0f))));
+
+		AnimationManager& animManager = AnimationManager::instance();
+		SPtr<BakedAnimationPoses> poses = animManager.getBakedPoses(skeleton, *clip, SAMPLE_RATE);
+		BS_TEST_ASSERT(poses->getNumBones() == 1);
+		BS_TEST_ASSERT(poses->getNumPoses() == SAMPLE_RATE + 1);
+
+		Vector3 endPosition = poses->getPose(1.0f, false)[0].getTranslation();
+		BS_TEST_ASSERT(endPosition.distance(Vector3(1.0f, 0.0f, 0.0f)) < 0.001f);
+
+		// Requests for the same skeleton, clip and sample rate share the poses
+		BS_TEST_ASSERT(animManager.getBakedPoses(skeleton, *clip, SAMPLE_RATE) == poses);
+		BS_TEST_ASSERT(animManager.getBakedPoses(skeleton, *clip, SAMPLE_RATE * 2) != poses);
+
+		// Curves are modified in place, so only the clip version changes
+		SPtr<AnimationCurves> originalCurves = clip->getCurves();
+		clip->setCurves(createCurves(Vector3(0.0f, 2.0f, 0.0f)));
+		BS_TEST_ASSERT(clip->getCurves() == originalCurves);
+
+		SPtr<BakedAnimationPoses> editedPoses = animManager.getBakedPoses(skeleton, *clip, SAMPLE_RATE);
+		BS_TEST_ASSERT(editedPoses != poses);
+
+		endPosition = editedPoses->getPose(1.0f, false)[0].getTranslation();
+		BS_TEST_ASSERT(endPosition.distance(Vector3(0.0f, 2.0f, 0.0f)) < 0.001f);
+
+		Vector3 halfPosition = editedPoses->getPose(0.5f, false)[0].getTranslation();
+		BS_TEST_ASSERT(halfPosition.distance(Vector3(0.0f, 1.0f, 0.0f)) < 0.05f);
+	}
+
+	void EditorTestSuite::TestSkeletonBlending()
+	{
+		// Curves used by a single animation state, along with the data the state references
+		struct TestState
+		{
+			SPtr<AnimationClip> clip;
+			Vector<AnimationCurveMapping> boneToCurveMapping;
+			Vector<TCurveCache<Vector3>> positionCaches;
+			Vector<TCurveCache<Quaternion>> rotationCaches;
+			Vector<TCurveCache<Vector3>> scaleCaches;
+			AnimationState state;
+		};
+
+		// Sizes chosen so the rotations blended by each state don't fill all groups of four
+		UINT32 boneCounts[] = { 1, 3, 6, 11, 17, 8 };
+		for (auto& numBones : boneCounts)
+		{
+			// Binary tree, parents always precede their children
+			Vector<BONE_DESC> bones(numBones);
+			for (UINT32 i = 0; i < numBones; i++)
+			{
+				bones[i].name = "bone" + toString(i);
+				bones[i].parent = i == 0 ? (UINT32)-1 : (i - 1) / 2;
+				bones[i].invBindPose = Matrix4::TRS(Vector3(0.0f, -(float)i, 0.0f),
+					Quaternion(Vector3::UNIT_Z, Degree(i * 10.0f)), Vector3::ONE).inverseAffine();
+			}
+
+			SPtr<Skeleton> skeleton = Skeleton::create(bones.data(), numBones);
+
+			// Creates a clip animating a subset of bones. Rotations of every other animated bone can be flipped to the
+			// opposite hemisphere, to exercise the shortest path check when blending.
+			auto createClip = [numBones](UINT32 seed, UINT32 rotationStep, UINT32 positionStep, bool hasScale,
+				bool flipRotations)
+			{
+				SPtr<AnimationCurves> curves = bs_shared_ptr_new<AnimationCurves>();
+				for (UINT32 i = 0; i < numBones; i++)
+				{
+					String name = "bone" + toString(i);
+					float offset = (float)(seed + i);
+
+					if ((i % rotationStep) == 0)
+					{
+						Vector3 axis = Vector3::normalize(Vector3(1.0f, offset, (float)seed));
+						Quaternion start(axis, Degree(offset * 13.0f));
+						Quaternion end(axis, Degree(offset * 13.0f + 90.0f));
+
+						if (flipRotations && ((i / rotationStep) % 2) == 1)
+						{
+							start = -start;
+							end = -end;
+						}
+
+						Vector<TKeyframe<Quaternion>> keys =
+						{
+							{ start, Quaternion::ZERO, Quaternion::ZERO, 0.0f },
+							{ end, Quaternion::ZERO, Quaternion::ZERO, 1.0f }
+						};
+
+						curves->addRotationCurve(name, TAnimationCurve<Quaternion>(keys));
+					}
+
+					if ((i % positionStep) == 0)
+					{
+						Vector<TKeyframe<Vector3>> keys =
+						{
+							{ Vector3(offset, 1.0f, 0.0f), Vector3::ZERO, Vector3::ZERO, 0.0f },
+							{ Vector3(0.0f, offset, 2.0f), Vector3::ZERO, Vector3::ZERO, 1.0f }
+						};
+
+						curves->addPositionCurve(name, TAnimationCurve<Vector3>(keys));
+					}
+
+					if (hasScale)
+					{
+						Vector<TKeyframe<Vector3>> keys =
+						{
+							{ Vector3::ONE, Vector3::ZERO, Vector3::ZERO, 0.0f },
+							{ Vector3(2.0f, 1.0f + offset * 0.1f, 0.5f), Vector3::ZERO, Vector3::ZERO, 1.0f }
+						};
+
+						curves->addScaleCurve(name, TAnimationCurve<Vector3>(keys));
+					}
+				}
+
+				return AnimationClip::_createPtr(curves);
+			};
+
+			auto initState = [&skeleton, numBones](TestState& data, const SPtr<AnimationClip>& clip, float weight)
+			{
+				SPtr<AnimationCurves> curves = clip->getCurves();
+
+				data.clip = clip;
+				data.boneToCurveMapping.resize(numBones);
+				data.positionCaches.resize(curves->position.size());
+				data.rotationCaches.resize(curves->rotation.size());
+				data.scaleCaches.resize(curves->scale.size());
+
+				clip->getBoneMapping(*skeleton, data.boneToCurveMapping.data());
+
+				AnimationState& state = data.state;
+				state.curves = curves;
+				state.compressedCurves = nullptr;
+				state.boneToCurveMapping = data.boneToCurveMapping.data();
+				state.soToCurveMapping = nullptr;
+				state.positionCaches = data.positionCaches.data();
+				state.rotationCaches = data.rotationCaches.data();
+				state.scaleCaches = data.scaleCaches.data();
+				state.genericCaches = nullptr;
+				state.time = 0.37f;
+				state.weight = weight;
+				state.loop = false;
+				state.disabled = false;
+			};
+
+			// Two states blended normally, and two states added on top
+			TestState states[4];
+			initState(states[0], createClip(1, 1, 1, true, false), 0.7f);
+			initState(states[1], createClip(2, 2, 3, false, true), 0.3f);
+			initState(states[2], createClip(3, 2, 2, false, false), 0.5f);
+			initState(states[3], createClip(4, 3, 5, true, true), 0.25f);
+
+			AnimationState normalStates[] = { states[0].state, states[1].state };
+			AnimationState additiveStates[] = { states[2].state, states[3].state };
+
+			AnimationStateLayer normalLayer;
+			normalLayer.states = normalStates;
+			normalLayer.numStates = 2;
+			normalLayer.index = 0;
+			normalLayer.additive = false;
+
+			AnimationStateLayer additiveLayer;
+			additiveLayer.states = additiveStates;
+			additiveLayer.numStates = 2;
+			additiveLayer.index = 1;
+			additiveLayer.additive = true;
+
+			SkeletonMaskBuilder maskBuilder(skeleton);
+			if (numBones > 2)
+				maskBuilder.setBoneState("bone2", false);
+
+			SkeletonMask mask = maskBuilder.getMask();
+
+			// Scalar evaluation of the same pose, a bone at a time
+			auto getReferencePose = [&](const AnimationStateLayer* layers, UINT32 numLayers, Vector<Vector3>& positions,
+				Vector<Quaternion>& rotations, Vector<Vector3>& scales, Vector<Matrix4>& pose)
+			{
+				positions.assign(numBones, Vector3::ZERO);
+				rotations.assign(numBones, Quaternion::ZERO);
+				scales.assign(numBones, Vector3::ONE);
+
+				for (UINT32 i = 0; i < numLayers; i++)
+				{
+					const AnimationStateLayer& layer = layers[i];
+
+					float invLayerWeight = 1.0f;
+					if (layer.additive)
+					{
+						float weightSum = 0.0f;
+						for (UINT32 j = 0; j < layer.numStates; j++)
+							weightSum += layer.states[j].weight;
+
+						invLayerWeight = 1.0f / weightSum;
+					}
+
+					for (UINT32 j = 0; j < layer.numStates; j++)
+					{
+						const AnimationState& state = layer.states[j];
+						float weight = state.weight * invLayerWeight;
+
+						for (UINT32 k = 0; k < numBones; k++)
+						{
+							if (!mask.isEnabled(k))
+								continue;
+
+							const AnimationCurveMapping& mapping = state.boneToCurveMapping[k];
+							if (mapping.position != (UINT32)-1)
+							{
+								const TAnimationCurve<Vector3>& curve = state.curves->position[mapping.position].curve;
+								positions[k] += curve.evaluate(state.time, state.loop) * weight;
+							}
+
+							if (mapping.scale != (UINT32)-1)
+							{
+								const TAnimationCurve<Vector3>& curve = state.curves->scale[mapping.scale].curve;
+								scales[k] *= curve.evaluate(state.time, state.loop) * weight;
+							}
+
+							if (mapping.rotation != (UINT32)-1)
+							{
+								const TAnimationCurve<Quaternion>& curve = state.curves->rotation[mapping.rotation].curve;
+								Quaternion value = curve.evaluate(state.time, state.loop);
+
+								if (layer.additive)
+								{
+									if (rotations[k].w == 0.0f)
+										rotations[k] = Quaternion::IDENTITY;
+
+									rotations[k] *= Quaternion::lerp(weight, Quaternion::IDENTITY, value);
+								}
+								else
+								{
+									value = value * weight;
+									if (value.dot(rotations[k]) < 0.0f)
+										value = -value;
+
+									rotations[k] += value;
+								}
+							}
+						}
+					}
+				}
+
+				pose.resize(numBones);
+				for (UINT32 i = 0; i < numBones; i++)
+				{
+					if (rotations[i].w == 0.0f)
+						rotations[i] = Quaternion::IDENTITY;
+					else
+						rotations[i].normalize();
+
+					pose[i] = Matrix4::TRS(positions[i], rotations[i], scales[i]);
+				}
+
+				for (UINT32 i = 0; i < numBones; i++)
+				{
+					if (bones[i].parent != (UINT32)-1)
+						pose[i] = pose[bones[i].parent] * pose[i];
+				}
+
+				for (UINT32 i = 0; i < numBones; i++)
+					pose[i] = pose[i] * bones[i].invBindPose;
+			};
+
+			AnimationStateLayer bothLayers[] = { normalLayer, additiveLayer };
+			std::pair<const AnimationStateLayer*, UINT32> layerSets[] =
+			{
+				{ &normalLayer, 1 },
+				{ &additiveLayer, 1 },
+				{ bothLayers, 2 }
+			};
+
+			for (auto& entry : layerSets)
+			{
+				LocalSkeletonPose localPose(numBones);
+				for (UINT32 i = 0; i < numBones; i++)
+					localPose.hasOverride[i] = false;
+
+				Vector<Matrix4> pose(numBones);
+				skeleton->getPose(pose.data(), localPose, mask, entry.first, entry.second);
+
+				Vector<Vector3> refPositions;
+				Vector<Quaternion> refRotations;
+				Vector<Vector3> refScales;
+				Vector<Matrix4> refPose;
+				getReferencePose(entry.first, entry.second, refPositions, refRotations, refScales, refPose);
+
+				bool allMatch = true;
+				for (UINT32 i = 0; i < numBones; i++)
+				{
+					allMatch &= localPose.positions[i].distance(refPositions[i]) < 0.0001f;
+					allMatch &= localPose.scales[i].distance(refScales[i]) < 0.0001f;
+					allMatch &= localPose.rotations[i].dot(refRotations[i]) > 0.9999f;
+
+					for (UINT32 row = 0; row < 3; row++)
+					{
+						for (UINT32 col = 0; col < 4; col++)
+							allMatch &= Math::abs(pose[i][row][col] - refPose[i][row][col]) < 0.001f;
+					}
+				}
+
+				BS_TEST_ASSERT(allMatch);
+			}
+		}
+	}
+
+	void EditorTestSuite::TestAnimationLOD()
+	{
+		static const UINT32 NUM_BONES = 7;
+		static const UINT32 NUM_UPDATES = 48;
+		static const UINT32 FIRST_UPDATE = 5;
+		static const float UPDATE_STEP = 1.0f / 64.0f;
+
+		// Binary tree, parents always precede their children
+		BONE_DESC bones[NUM_BONES];
+		for (UINT32 i = 0; i < NUM_BONES; i++)
+		{
+			bones[i].name = "bone" + toString(i);
+			bones[i].parent = i == 0 ? (UINT32)-1 : (i - 1) / 2;
+			bones[i].invBindPose = Matrix4::TRS(Vector3(0.0f, -(float)i, 0.0f),
+				Quaternion(Vector3::UNIT_Z, Degree(i * 10.0f)), Vector3::ONE).inverseAffine();
+		}
+
+		SPtr<Skeleton> skeleton = Skeleton::create(bones, NUM_BONES);
+		const LocalSkeletonPose& bindPose = skeleton->getLocalBindPose();
+
+		// Moves and rotates every bone over the length of the clip
+		SPtr<AnimationCurves> curves = bs_shared_ptr_new<AnimationCurves>();
+		for (UINT32 i = 0; i < NUM_BONES; i++)
+		{
+			String name = "bone" + toString(i);
+
+			Vector<TKeyframe<Vector3>> positionKeys =
+			{
+				{ Vector3((float)i, 0.0f, 0.0f), Vector3::ZERO, Vector3::ZERO, 0.0f },
+				{ Vector3((float)i, 4.0f, 1.0f), Vector3::ZERO, Vector3::ZERO, 1.0f }
+			};
+
+			Vector<TKeyframe<Quaternion>> rotationKeys =
+			{
+				{ Quaternion(Vector3::UNIT_X, Degree(i * 5.0f)), Quaternion::ZERO, Quaternion::ZERO, 0.0f },
+				{ Quaternion(Vector3::UNIT_X, Degree(i * 5.0f + 90.0f)), Quaternion::ZERO, Quaternion::ZERO, 1.0f }
+			};
+
+			curves->addPositionCurve(name, TAnimationCurve<Vector3>(positionKeys));
+			curves->addRotationCurve(name, TAnimationCurve<Quaternion>(rotationKeys));
+		}
+
+		Vector<AnimationClipInfo> clipInfos = { AnimationClipInfo(AnimationClip::create(curves)) };
+		clipInfos[0].state.wrapMode = AnimWrapMode::Clamp;
+
+		// Each level updates less often and evaluates a subset of the bones of the previous level
+		SkeletonMaskBuilder maskBuilder(skeleton);
+		Vector<AnimationLOD> lods(3);
+		lods[0].threshold = 10.0f;
+
+		maskBuilder.setBoneState("bone5", false);
+		maskBuilder.setBoneState("bone6", false);
+		lods[1].threshold = 50.0f;
+		lods[1].updateInterval = 3;
+		lods[1].mask = maskBuilder.getMask();
+
+		maskBuilder.setBoneState("bone3", false);
+		maskBuilder.setBoneState("bone4", false);
+		lods[2].threshold = 200.0f;
+		lods[2].updateInterval = 4;
+		lods[2].mask = maskBuilder.getMask();
+		lods[2].interpolate = false;
+
+		auto createProxy = [&](UINT64 id, const Vector<AnimationLOD>& proxyLODs, AnimLODMetric metric)
+		{
+			SPtr<AnimationProxy> proxy = bs_shared_ptr_new<AnimationProxy>(id);
+			proxy->rebuild(skeleton, SkeletonMask(NUM_BONES), clipInfos, Vector<AnimatedSceneObject>(), nullptr);
+			proxy->updateLODs(proxyLODs, metric);
+			proxy->mBounds = AABox(Vector3(-1.0f, -1.0f, -1.0f), Vector3(1.0f, 1.0f, 1.0f));
+
+			return proxy;
+		};
+
+		auto createView = [](float distance, bool perspective)
+		{
+			AnimationManager::LODView view;
+			view.position = Vector3(0.0f, 0.0f, distance);
+			view.sizeScale = 1.0f;
+			view.perspective = perspective;
+
+			return view;
+		};
+
+		// Levels are picked by the closest view, falling back to the last level when past all thresholds
+		{
+			SPtr<AnimationProxy> proxy = createProxy(0, lods, AnimLODMetric::Distance);
+
+			BS_TEST_ASSERT(AnimationManager::_getLOD(*proxy, {}) == 0);
+			BS_TEST_ASSERT(AnimationManager::_getLOD(*proxy, { createView(5.0f, true) }) == 0);
+			BS_TEST_ASSERT(AnimationManager::_getLOD(*proxy, { createView(30.0f, true) }) == 1);
+			BS_TEST_ASSERT(AnimationManager::_getLOD(*proxy, { createView(100.0f, true) }) == 2);
+			BS_TEST_ASSERT(AnimationManager::_getLOD(*proxy, { createView(1000.0f, true) }) == 2);
+			BS_TEST_ASSERT(AnimationManager::_getLOD(*proxy, { createView(30.0f, true), createView(100.0f, true) }) == 1);
+		}
+
+		// Levels are picked by the largest size on screen
+		{
+			Vector<AnimationLOD> screenSizeLODs = lods;
+			screenSizeLODs[0].threshold = 0.5f;
+			screenSizeLODs[1].threshold = 0.1f;
+			screenSizeLODs[2].threshold = 0.01f;
+
+			SPtr<AnimationProxy> proxy = createProxy(0, screenSizeLODs, AnimLODMetric::ScreenSize);
+
+			BS_TEST_ASSERT(AnimationManager::_getLOD(*proxy, { createView(1000.0f, false) }) == 0);
+			BS_TEST_ASSERT(AnimationManager::_getLOD(*proxy, { createView(10.0f, true) }) == 1);
+			BS_TEST_ASSERT(AnimationManager::_getLOD(*proxy, { createView(100.0f, true) }) == 2);
+			BS_TEST_ASSERT(AnimationManager::_getLOD(*proxy, { createView(1000.0f, true) }) == 2);
+			BS_TEST_ASSERT(AnimationManager::_getLOD(*proxy, { createView(10.0f, true), createView(100.0f, true) }) == 1);
+		}
+
+		// Evaluate a pose with every bone enabled on each update, to compare the levels of detail against
+		SPtr<AnimationProxy> refProxy = createProxy(0, {}, AnimLODMetric::Distance);
+		Vector<Vector3> refPositions(NUM_UPDATES * NUM_BONES);
+		Vector<Quaternion> refRotations(NUM_UPDATES * NUM_BONES);
+
+		LocalSkeletonPose refPose(NUM_BONES);
+		for (UINT32 i = 0; i < NUM_UPDATES; i++)
+		{
+			clipInfos[0].state.time = i * UPDATE_STEP;
+			refProxy->updateTime(clipInfos);
+
+			for (UINT32 j = 0; j < NUM_BONES; j++)
+				refPose.hasOverride[j] = false;
+
+			skeleton->getLocalPose(refPose, SkeletonMask(NUM_BONES), refProxy->layers, refProxy->numLayers);
+			for (UINT32 j = 0; j < NUM_BONES; j++)
+			{
+				refPositions[i * NUM_BONES + j] = refPose.positions[j];
+				refRotations[i * NUM_BONES + j] = refPose.rotations[j];
+			}
+		}
+
+		auto matchesReference = [&](const LocalSkeletonPose& pose, UINT32 boneIdx, UINT32 updateIdx)
+		{
+			UINT32 refIdx = updateIdx * NUM_BONES + boneIdx;
+
+			return pose.positions[boneIdx].distance(refPositions[refIdx]) < 0.0001f &&
+				Math::abs(pose.rotations[boneIdx].dot(refRotations[refIdx])) > 0.9999f;
+		};
+
+		auto isBetweenReferences = [&](const LocalSkeletonPose& pose, UINT32 boneIdx, UINT32 updateA, UINT32 updateB)
+		{
+			const Vector3& positionA = refPositions[updateA * NUM_BONES + boneIdx];
+			const Vector3& positionB = refPositions[updateB * NUM_BONES + boneIdx];
+			const Quaternion& rotationA = refRotations[updateA * NUM_BONES + boneIdx];
+			const Quaternion& rotationB = refRotations[updateB * NUM_BONES + boneIdx];
+
+			const Vector3& position = pose.positions[boneIdx];
+			const Quaternion& rotation = pose.rotations[boneIdx];
+
+			// Rotations are interpolated along the shorter arc between the two rotations, so the result is at least as
+			// close to either of them as they are to each other
+			float arcCos = rotationA.dot(rotationB);
+
+			return Math::abs(positionA.distance(position) + position.distance(positionB) -
+				positionA.distance(positionB)) < 0.0001f &&
+				rotation.dot(rotationA) > arcCos - 0.0001f && rotation.dot(rotationB) > arcCos - 0.0001f;
+		};
+
+		Vector<Matrix4> pose(NUM_BONES);
+		for (UINT32 lodIdx = 0; lodIdx < (UINT32)lods.size(); lodIdx++)
+		{
+			const AnimationLOD& lod = lods[lodIdx];
+
+			// One proxy for each offset within the update interval
+			UINT32 numProxies = lod.updateInterval;
+			Vector<SPtr<AnimationProxy>> proxies(numProxies);
+			Vector<Vector<UINT32>> evaluatedUpdates(numProxies);
+			for (UINT32 i = 0; i < numProxies; i++)
+				proxies[i] = createProxy(10 + i, lods, AnimLODMetric::Distance);
+
+			bool evaluatedOnePerUpdate = true;
+			bool matchesSchedule = true;
+			bool matchesPoses = true;
+			bool matchesBindPose = true;
+			for (UINT32 i = 0; i < NUM_UPDATES; i++)
+			{
+				clipInfos[0].state.time = i * UPDATE_STEP;
+
+				UINT32 numEvaluated = 0;
+				for (UINT32 j = 0; j < numProxies; j++)
+				{
+					AnimationProxy& proxy = *proxies[j];
+					proxy.updateTime(clipInfos);
+					memset(proxy.skeletonPose.hasOverride, 0, sizeof(bool) * NUM_BONES);
+
+					bool interpolated = AnimationManager::_evaluateSkeleton(&proxy, lodIdx, FIRST_UPDATE + i, pose.data());
+					if (!interpolated)
+					{
+						evaluatedUpdates[j].push_back(i);
+						numEvaluated++;
+					}
+
+					// The first update always evaluates, after which evaluations are offset by the proxy ID
+					bool scheduled = ((FIRST_UPDATE + i + (UINT32)proxy.id) % lod.updateInterval) == 0;
+					matchesSchedule &= (i == 0 || scheduled) == !interpolated;
+
+					UINT32 lastEvaluation = evaluatedUpdates[j].back();
+					UINT32 prevEvaluation = lastEvaluation;
+					if (evaluatedUpdates[j].size() > 1)
+						prevEvaluation = evaluatedUpdates[j][evaluatedUpdates[j].size() - 2];
+
+					for (UINT32 k = 0; k < NUM_BONES; k++)
+					{
+						// Bones disabled by the level keep their bind pose
+						if (!lod.mask.isEnabled(k))
+						{
+							const LocalSkeletonPose& skeletonPose = proxy.skeletonPose;
+							matchesBindPose &= skeletonPose.positions[k].distance(bindPose.positions[k]) < 0.0001f;
+							matchesBindPose &= Math::abs(skeletonPose.rotations[k].dot(bindPose.rotations[k])) > 0.9999f;
+							continue;
+						}
+
+						if (lod.updateInterval > 1 && lod.interpolate)
+						{
+							matchesPoses &= matchesReference(proxy.mLODPoses[0], k, prevEvaluation);
+							matchesPoses &= matchesReference(proxy.mLODPoses[1], k, lastEvaluation);
+							matchesPoses &= isBetweenReferences(proxy.skeletonPose, k, prevEvaluation, lastEvaluation);
+						}
+						else
+							matchesPoses &= matchesReference(proxy.skeletonPose, k, lastEvaluation);
+					}
+				}
+
+				// Proxies with consecutive IDs take turns, so exactly one of them is evaluated per update
+				if (i > 0)
+					evaluatedOnePerUpdate &= numEvaluated == 1;
+			}
+
+			// After the first evaluation each proxy is evaluated once every update interval
+			bool evaluatedOncePerInterval = true;
+			for (auto& entry : evaluatedUpdates)
+			{
+				evaluatedOncePerInterval &= entry.size() > 2;
+				for (UINT32 i = 2; i < (UINT32)entry.size(); i++)
+					evaluatedOncePerInterval &= (entry[i] - entry[i - 1]) == lod.updateInterval;
+			}
+
+			BS_TEST_ASSERT(evaluatedOnePerUpdate);
+			BS_TEST_ASSERT(evaluatedOncePerInterval);
+			BS_TEST_ASSERT(matchesSchedule);
+			BS_TEST_ASSERT(matchesPoses);
+			BS_TEST_ASSERT(matchesBindPose);
+		}
+	}
+
+	void EditorTestSuite::TestMeshOptimization()
+	{
+		struct TestMesh
+		{
+			Vector<Vector3> positions;
+			Vector<UINT32> indices;
+		};
+
+		// Regular grid in authoring order, and a grid and a sphere with triangles in random order, similar to meshes
+		// exported by tools that don't care about the triangle order
+		Vector<TestMesh> meshes(3);
+
+		static const UINT32 GRID_SIZE = 64;
+		for (UINT32 i = 0; i < 2; i++)
+		{
+			for (UINT32 y = 0; y <= GRID_SIZE; y++)
+			{
+				for (UINT32 x = 0; x <= GRID_SIZE; x++)
+					meshes[i].positions.push_back(Vector3((float)x, 0.0f, (float)y));
+			}
+
+			for (UINT32 y = 0; y < GRID_SIZE; y++)
+			{
+				for (UINT32 x = 0; x < GRID_SIZE; x++)
+				{
+					UINT32 a = y * (GRID_SIZE + 1) + x;
+					UINT32 b = a + GRID_SIZE + 1;
+
+					meshes[i].indices.insert(meshes[i].indices.end(), { a, b, a + 1, a + 1, b, b + 1 });
+				}
+			}
+		}
+
+		static const UINT32 NUM_RINGS = 48;
+		static const UINT32 NUM_SEGMENTS = 96;
+		for (UINT32 ring = 0; ring <= NUM_RINGS; ring++)
+		{
+			for (UINT32 segment = 0; segment <= NUM_SEGMENTS; segment++)
+			{
+				Radian theta(Math::PI * ring / NUM_RINGS);
+				Radian phi(Math::TWO_PI * segment / NUM_SEGMENTS);
+
+				meshes[2].positions.push_back(Vector3(Math::sin(theta) * Math::cos(phi), Math::cos(theta), 
+					Math::sin(theta) * Math::sin(phi)));
+			}
+		}
+
+		for (UINT32 ring = 0; ring < NUM_RINGS; ring++)
+		{
+			for (UINT32 segment = 0; segment < NUM_SEGMENTS; segment++)
+			{
+				UINT32 a = ring * (NUM_SEGMENTS + 1) + segment;
+				UINT32 b = a + NUM_SEGMENTS + 1;
+
+				meshes[2].indices.insert(meshes[2].indices.end(), { a, a + 1, b, a + 1, b + 1, b });
+			}
+		}
+
+		for (UINT32 i = 1; i < 3; i++)
+		{
+			UINT32 seed = 12345;
+			UINT32 numFaces = (UINT32)meshes[i].indices.size() / 3;
+			for (UINT32 j = numFaces - 1; j > 0; j--)
+			{
+				seed = seed * 1664525 + 1013904223;
+				UINT32 other = seed % (j + 1);
+
+				for (UINT32 k = 0; k < 3; k++)
+					std::swap(meshes[i].indices[j * 3 + k], meshes[i].indices[other * 3 + k]);
+			}
+		}
+
+		// Returns all triangles of a mesh in a canonical order, in order to check the optimizations preserve them
+		auto getSortedTriangles = [](const Vector<UINT32>& indices)
+		{
+			Vector<std::tuple<UINT32, UINT32, UINT32>> output;
+			for (UINT32 i = 0; i < (UINT32)indices.size(); i += 3)
+			{
+				UINT32 a = indices[i + 0], b = indices[i + 1], c = indices[i + 2];
+
+				// Rotate so the smallest index comes first, keeping the winding order
+				if (b < a && b < c)
+					output.push_back(std::make_tuple(b, c, a));
+				else if (c < a && c < b)
+					output.push_back(std::make_tuple(c, a, b));
+				else
+					output.push_back(std::make_tuple(a, b, c));
+			}
+
+			std::sort(output.begin(), output.end());
+			return output;
+		};
+
+		// Meshes below are optimized in place, keep a copy of the shuffled grid for the sub-mesh test
+		const TestMesh subMeshSource = meshes[1];
+
+		for (auto& mesh : meshes)
+		{
+			UINT32 numVertices = (UINT32)mesh.positions.size();
+			UINT32 numIndices = (UINT32)mesh.indices.size();
+			UINT8* indices = (UINT8*)mesh.indices.data();
+
+			auto triangles = getSortedTriangles(mesh.indices);
+			VertexCacheStats before = MeshUtility::calculateVertexCacheStats(indices, numVertices, numIndices);
+
+			MeshUtility::optimizeVertexCache(indices, numVertices, numIndices);
+			VertexCacheStats afterCache = MeshUtility::calculateVertexCacheStats(indices, numVertices, numIndices);
+
+			MeshUtility::optimizeOverdraw(mesh.positions.data(), indices, numVertices, numIndices);
+			VertexCacheStats afterOverdraw = MeshUtility::calculateVertexCacheStats(indices, numVertices, numIndices);
+
+			BS_TEST_ASSERT(getSortedTriangles(mesh.indices) == triangles);
+			BS_TEST_ASSERT(afterCache.acmr <= before.acmr);
+			BS_TEST_ASSERT(afterCache.acmr < 0.8f);
+			BS_TEST_ASSERT(afterOverdraw.acmr <= afterCache.acmr * 1.1f);
+
+			// Vertices must be referenced in increasing order, and remapped data must match the old data
+			Vector<UINT32> remap(numVertices);
+			Vector<UINT32> oldIndices = mesh.indices;
+			UINT32 numUsedVertices = MeshUtility::optimizeVertexFetch(indices, numVertices, numIndices, remap.data());
+
+			Vector<Vector3> positions = mesh.positions;
+			MeshUtility::remapVertices((UINT8*)positions.data(), numVertices, sizeof(Vector3), remap.data());
+
+			BS_TEST_ASSERT(numUsedVertices == numVertices);
+
+			UINT32 maxVertexIdx = 0;
+			bool allMatch = true;
+			for (UINT32 i = 0; i < numIndices; i++)
+			{
+				UINT32 vertexIdx = mesh.indices[i];
+				allMatch &= vertexIdx <= maxVertexIdx + 1;
+				allMatch &= positions[vertexIdx] == mesh.positions[oldIndices[i]];
+
+				maxVertexIdx = std::max(maxVertexIdx, vertexIdx);
+			}
+
+			BS_TEST_ASSERT(allMatch);
+		}
+
+		// Shuffled grid with triangles interleaved between three sub-meshes, along with the per-vertex data the mesh
+		// importer remaps: UV coordinates, bone influences and blend shape frames
+		static const UINT32 NUM_SUB_MESHES = 3;
+
+		UINT32 numVertices = (UINT32)subMeshSource.positions.size();
+		UINT32 numIndices = (UINT32)subMeshSource.indices.size();
+
+		Vector<Vector3> positions = subMeshSource.positions;
+		Vector<UINT32> indices = subMeshSource.indices;
+		Vector<UINT32> subMeshIndices(numIndices);
+		Vector<Vector2> uvs(numVertices);
+		Vector<BoneWeight> boneWeights(numVertices);
+		Vector<Vector3> blendShapePositions(numVertices);
+
+		for (UINT32 i = 0; i < numIndices; i++)
+			subMeshIndices[i] = (i / 3) % NUM_SUB_MESHES;
+
+		for (UINT32 i = 0; i < numVertices; i++)
+		{
+			uvs[i] = Vector2(positions[i].x / GRID_SIZE, positions[i].z / GRID_SIZE);
+			boneWeights[i] = { (int)i, (int)(i % 4), 0, 0, 0.75f, 0.25f, 0.0f, 0.0f };
+			blendShapePositions[i] = positions[i] + Vector3(0.0f, (float)i, 0.0f);
+		}
+
+		const Vector<Vector3> oldPositions = positions;
+		const Vector<UINT32> oldIndices = indices;
+		const Vector<UINT32> oldSubMeshIndices = subMeshIndices;
+		const Vector<Vector2> oldUVs = uvs;
+		const Vector<BoneWeight> oldBoneWeights = boneWeights;
+		const Vector<Vector3> oldBlendShapePositions = blendShapePositions;
+
+		Vector<UINT32> remap(numVertices);
+		UINT32 numUsedVertices = MeshUtility::optimizeVertexOrder(positions.data(), indices.data(), 
+			subMeshIndices.data(), numVertices, numIndices, remap.data());
+		BS_TEST_ASSERT(numUsedVertices == numVertices);
+
+		MeshUtility::remapVertices((UINT8*)positions.data(), numVertices, sizeof(Vector3), remap.data());
+		MeshUtility::remapVertices((UINT8*)uvs.data(), numVertices, sizeof(Vector2), remap.data());
+		MeshUtility::remapVertices((UINT8*)boneWeights.data(), numVertices, sizeof(BoneWeight), remap.data());
+		MeshUtility::remapVertices((UINT8*)blendShapePositions.data(), numVertices, sizeof(Vector3), remap.data());
+
+		// Each sub-mesh must occupy a single contiguous index range, in sub-mesh order, containing the same triangles
+		Vector<UINT32> newToOldVertex(numVertices);
+		for (UINT32 i = 0; i < numVertices; i++)
+			newToOldVertex[remap[i]] = i;
+
+		UINT32 rangeStart = 0;
+		for (UINT32 i = 0; i < NUM_SUB_MESHES; i++)
+		{
+			Vector<UINT32> oldSubMesh;
+			for (UINT32 j = 0; j < numIndices; j++)
+			{
+				if (oldSubMeshIndices[j] == i)
+					oldSubMesh.push_back(oldIndices[j]);
+			}
+
+			UINT32 rangeEnd = rangeStart + (UINT32)oldSubMesh.size();
+
+			bool rangeValid = true;
+			Vector<UINT32> newSubMesh;
+			for (UINT32 j = rangeStart; j < rangeEnd; j++)
+			{
+				rangeValid &= subMeshIndices[j] == i;
+				newSubMesh.push_back(newToOldVertex[indices[j]]);
+			}
+
+			BS_TEST_ASSERT(rangeValid);
+			BS_TEST_ASSERT(getSortedTriangles(newSubMesh) == getSortedTriangles(oldSubMesh));
+
+			rangeStart = rangeEnd;
+		}
+
+		BS_TEST_ASSERT(rangeStart == numIndices);
+
+		// Per-vertex data must follow the vertices to their new location
+		bool allMatch = true;
+		for (UINT32 i = 0; i < numIndices; i++)
+		{
+			UINT32 newIdx = indices[i];
+			UINT32 oldIdx = newToOldVertex[newIdx];
+
+			allMatch &= positions[newIdx] == oldPositions[oldIdx];
+			allMatch &= uvs[newIdx] == oldUVs[oldIdx];
+			allMatch &= boneWeights[newIdx].index0 == oldBoneWeights[oldIdx].index0;
+			allMatch &= boneWeights[newIdx].index1 == oldBoneWeights[oldIdx].index1;
+			allMatch &= blendShapePositions[newIdx] == oldBlendShapePositions[oldIdx];
+		}
+
+		BS_TEST_ASSERT(allMatch);
+	}
 }
\ No newline at end of file
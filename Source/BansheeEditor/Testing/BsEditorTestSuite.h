@@ -93,6 +93,39 @@ namespace bs
 
 		/**	Tests the frame allocator. */
 		void TestFrameAlloc();
+
+		/** Creates and destroys a large number of scene objects, checking their handles and instance IDs. */
+		void TestGameObjectHandles();
+
+		/**
+		 * Times creation, lookup and destruction of a large number of scene objects, and the same operations on an ordered
+		 * map, which is how the game object manager used to store live objects.
+		 */
+		void TestGameObjectHandlesBenchmark();
+
+		/** Compresses an animation clip and checks the compressed curves against the source curves. */
+		void TestAnimationCompression();
+
+		/** Bakes poses of an animation clip, and checks they are shared and rebaked when the clip curves change. */
+		void TestBakedPoses();
+
+		/**
+		 * Evaluates skeleton poses from normal and additive animation layers, and compares them against a scalar
+		 * evaluation of the same poses.
+		 */
+		void TestSkeletonBlending();
+
+		/**
+		 * Evaluates skeleton poses at multiple levels of detail, checking how often they are evaluated, that skipped
+		 * updates interpolate between the evaluated poses, and that bones disabled by a level keep their bind pose.
+		 */
+		void TestAnimationLOD();
+
+		/** 
+		 * Optimizes the vertex order of generated meshes, checking the triangles and per-vertex data are preserved, and
+		 * that vertex cache efficiency improves.
+		 */
+		void TestMeshOptimization();
 	};
 
 	/** @} */
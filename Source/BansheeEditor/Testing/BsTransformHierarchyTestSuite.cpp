@@ -0,0 +1,506 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "Testing/BsTransformHierarchyTestSuite.h"
+#include "Scene/BsTransformHierarchy.h"
+#include "Math/BsMath.h"
+
+namespace bs
+{
+	/**
+	 * Performs operations on a TransformHierarchy, while keeping a copy of the scene that is evaluated through naive
+	 * recursion. Entries are referenced through their index in the reference scene.
+	 */
+	class ReferenceTransformHierarchy
+	{
+		struct Node
+		{
+			UINT32 id;
+			INT32 parent;
+			Vector<UINT32> children;
+			Transform local;
+			bool movable;
+			bool alive;
+		};
+
+	public:
+		/** Creates a new entry with the provided local transform, and returns its index. */
+		UINT32 create(const Transform& local, INT32 parent = -1)
+		{
+			Node node;
+			node.id = mHierarchy.createNode();
+			node.parent = -1;
+			node.local = local;
+			node.movable = true;
+			node.alive = true;
+
+			UINT32 idx = (UINT32)mNodes.size();
+			mNodes.push_back(node);
+			mNumAlive++;
+
+			mHierarchy.getLocal(node.id) = local;
+			mHierarchy.markDirty(node.id);
+
+			if (parent != -1)
+				setParent(idx, parent);
+
+			return idx;
+		}
+
+		/** Changes the local transform of the entry, and marks it and its children dirty. */
+		void move(UINT32 idx, const Transform& local)
+		{
+			mNodes[idx].local = local;
+			mHierarchy.getLocal(mNodes[idx].id) = local;
+
+			markDirty(idx);
+		}
+
+		/** Changes the parent of the entry, and marks its children dirty. Provide -1 to remove the parent. */
+		void setParent(UINT32 idx, INT32 parent)
+		{
+			Node& node = mNodes[idx];
+			if (node.parent != -1)
+			{
+				Vector<UINT32>& siblings = mNodes[node.parent].children;
+				siblings.erase(std::find(siblings.begin(), siblings.end(), idx));
+			}
+
+			node.parent = parent;
+			if (parent != -1)
+				mNodes[parent].children.push_back(idx);
+
+			UINT32 parentId = parent != -1 ? mNodes[parent].id : TransformHierarchy::INVALID_ID;
+			mHierarchy.setParent(node.id, parentId);
+
+			for (auto& entry : node.children)
+				markDirty(entry);
+		}
+
+		/** Determines if the entry inherits its parent's transform, and marks it and its children dirty. */
+		void setMovable(UINT32 idx, bool movable)
+		{
+			mNodes[idx].movable = movable;
+			mHierarchy.setMovable(mNodes[idx].id, movable);
+
+			markDirty(idx);
+		}
+
+		/** Destroys the entry along with all of its children. */
+		void destroy(UINT32 idx)
+		{
+			Node& node = mNodes[idx];
+			if (node.parent != -1)
+			{
+				Vector<UINT32>& siblings = mNodes[node.parent].children;
+				siblings.erase(std::find(siblings.begin(), siblings.end(), idx));
+				node.parent = -1;
+			}
+
+			destroySubtree(idx);
+		}
+
+		/** Returns true if the provided entry is a child of the other entry, or the same entry. */
+		bool isDescendant(UINT32 idx, UINT32 ancestorIdx) const
+		{
+			INT32 current = (INT32)idx;
+			while (current != -1)
+			{
+				if (current == (INT32)ancestorIdx)
+					return true;
+
+				current = mNodes[current].parent;
+			}
+
+			return false;
+		}
+
+		/** Checks that the world and local transforms of the entry match the reference. */
+		bool isValid(UINT32 idx)
+		{
+			const Node& node = mNodes[idx];
+			Transform world = getReferenceWorld(idx);
+
+			const Transform& stored = mHierarchy.getWorld(node.id);
+			if (!Math::approxEquals(stored.getPosition(), world.getPosition(), 1e-3f) ||
+				!Math::approxEquals(stored.getRotation(), world.getRotation(), 1e-3f) ||
+				!Math::approxEquals(stored.getScale(), world.getScale(), 1e-3f))
+			{
+				return false;
+			}
+
+			return matricesEqual(mHierarchy.getWorldMatrix(node.id), world.getMatrix()) &&
+				matricesEqual(mHierarchy.getLocalMatrix(node.id), node.local.getMatrix());
+		}
+
+		/** Checks that all live entries match the reference. */
+		bool areAllValid()
+		{
+			bool valid = true;
+			for (UINT32 i = 0; i < (UINT32)mNodes.size(); i++)
+			{
+				if (mNodes[i].alive)
+					valid &= isValid(i);
+			}
+
+			return valid;
+		}
+
+		/** Returns the index of a random live entry, or -1 if there are none. */
+		INT32 getRandomAlive(UINT32 random) const
+		{
+			if (mNumAlive == 0)
+				return -1;
+
+			UINT32 idx = random % (UINT32)mNodes.size();
+			while (!mNodes[idx].alive)
+				idx = (idx + 1) % (UINT32)mNodes.size();
+
+			return (INT32)idx;
+		}
+
+		/** Returns the hierarchy ID of the entry. */
+		UINT32 getId(UINT32 idx) const { return mNodes[idx].id; }
+
+		/** Returns the number of live entries. */
+		UINT32 getNumAlive() const { return mNumAlive; }
+
+		/** Returns the hierarchy being tested. */
+		TransformHierarchy& getHierarchy() { return mHierarchy; }
+
+	private:
+		/** Marks the entry and all of its children dirty. */
+		void markDirty(UINT32 idx)
+		{
+			mHierarchy.markDirty(mNodes[idx].id);
+
+			for (auto& entry : mNodes[idx].children)
+				markDirty(entry);
+		}
+
+		/** Destroys the entry and all of its children, without updating the parent. */
+		void destroySubtree(UINT32 idx)
+		{
+			Node& node = mNodes[idx];
+			for (auto& entry : node.children)
+				destroySubtree(entry);
+
+			mHierarchy.destroyNode(node.id);
+			node.children.clear();
+			node.alive = false;
+			mNumAlive--;
+		}
+
+		/** Evaluates the world transform of the entry by recursively walking its parents. */
+		Transform getReferenceWorld(UINT32 idx) const
+		{
+			const Node& node = mNodes[idx];
+
+			Transform world = node.local;
+			if (node.parent != -1 && node.movable)
+				world.makeWorld(getReferenceWorld(node.parent));
+
+			return world;
+		}
+
+		/** Compares two matrices, allowing for a larger error for larger values. */
+		static bool matricesEqual(const Matrix4& a, const Matrix4& b)
+		{
+			for (UINT32 row = 0; row < 4; row++)
+			{
+				for (UINT32 col = 0; col < 4; col++)
+				{
+					float tolerance = 1e-3f * std::max(1.0f, Math::abs(b[row][col]));
+					if (Math::abs(a[row][col] - b[row][col]) > tolerance)
+						return false;
+				}
+			}
+
+			return true;
+		}
+
+		TransformHierarchy mHierarchy;
+		Vector<Node> mNodes;
+		UINT32 mNumAlive = 0;
+	};
+
+	/** Simple deterministic random number generator. */
+	class TestRandom
+	{
+	public:
+		TestRandom(UINT32 seed) :mSeed(seed) {}
+
+		UINT32 get()
+		{
+			mSeed = mSeed * 1103515245 + 12345;
+			return mSeed >> 8;
+		}
+
+		float getRange(float min, float max)
+		{
+			return min + (get() % 10000) / 10000.0f * (max - min);
+		}
+
+		Transform getTransform()
+		{
+			Transform output;
+			output.setPosition(Vector3(getRange(-10.0f, 10.0f), getRange(-10.0f, 10.0f), getRange(-10.0f, 10.0f)));
+			output.setRotation(Quaternion(Degree(getRange(-180.0f, 180.0f)), Degree(getRange(-180.0f, 180.0f)),
+				Degree(getRange(-180.0f, 180.0f))));
+			output.setScale(Vector3(getRange(0.8f, 1.2f), getRange(0.8f, 1.2f), getRange(0.8f, 1.2f)));
+
+			return output;
+		}
+
+	private:
+		UINT32 mSeed;
+	};
+
+	TransformHierarchyTestSuite::TransformHierarchyTestSuite()
+	{
+		BS_ADD_TEST(TransformHierarchyTestSuite::testCreate);
+		BS_ADD_TEST(TransformHierarchyTestSuite::testMove);
+		BS_ADD_TEST(TransformHierarchyTestSuite::testReparent);
+		BS_ADD_TEST(TransformHierarchyTestSuite::testDestroy);
+		BS_ADD_TEST(TransformHierarchyTestSuite::testRandomOperations);
+	}
+
+	void TransformHierarchyTestSuite::testCreate()
+	{
+		ReferenceTransformHierarchy reference;
+		TestRandom random(1);
+
+		// New entry has an identity transform
+		UINT32 root = reference.create(Transform());
+
+		TransformHierarchy& hierarchy = reference.getHierarchy();
+		BS_TEST_ASSERT(hierarchy.getWorldMatrix(reference.getId(root)) == Matrix4::IDENTITY);
+
+		// Lazily evaluated, before update
+		INT32 parent = (INT32)root;
+		for (UINT32 i = 0; i < 16; i++)
+			parent = (INT32)reference.create(random.getTransform(), parent);
+
+		BS_TEST_ASSERT(reference.areAllValid());
+
+		// Evaluated by update
+		for (UINT32 i = 0; i < 16; i++)
+			parent = (INT32)reference.create(random.getTransform(), parent);
+
+		hierarchy.update();
+		BS_TEST_ASSERT(reference.areAllValid());
+	}
+
+	void TransformHierarchyTestSuite::testMove()
+	{
+		ReferenceTransformHierarchy reference;
+		TestRandom random(2);
+
+		UINT32 root = reference.create(random.getTransform());
+		UINT32 child = reference.create(random.getTransform(), root);
+		UINT32 grandChild = reference.create(random.getTransform(), child);
+		UINT32 sibling = reference.create(random.getTransform(), root);
+
+		TransformHierarchy& hierarchy = reference.getHierarchy();
+		hierarchy.update();
+		BS_TEST_ASSERT(reference.areAllValid());
+
+		// Moving the root moves everything
+		reference.move(root, random.getTransform());
+		BS_TEST_ASSERT(reference.isValid(grandChild));
+
+		hierarchy.update();
+		BS_TEST_ASSERT(reference.areAllValid());
+
+		// Moving an entry in the middle only moves its sub-tree
+		Matrix4 siblingMatrix = hierarchy.getWorldMatrix(reference.getId(sibling));
+
+		reference.move(child, random.getTransform());
+		hierarchy.update();
+
+		BS_TEST_ASSERT(reference.areAllValid());
+		BS_TEST_ASSERT(hierarchy.getWorldMatrix(reference.getId(sibling)) == siblingMatrix);
+
+		// Multiple moves between updates
+		for (UINT32 i = 0; i < 8; i++)
+		{
+			reference.move(root, random.getTransform());
+			reference.move(grandChild, random.getTransform());
+		}
+
+		hierarchy.update();
+		BS_TEST_ASSERT(reference.areAllValid());
+	}
+
+	void TransformHierarchyTestSuite::testReparent()
+	{
+		ReferenceTransformHierarchy reference;
+		TestRandom random(3);
+
+		UINT32 rootA = reference.create(random.getTransform());
+		UINT32 rootB = reference.create(random.getTransform());
+		UINT32 child = reference.create(random.getTransform(), rootA);
+		UINT32 grandChild = reference.create(random.getTransform(), child);
+
+		TransformHierarchy& hierarchy = reference.getHierarchy();
+		hierarchy.update();
+
+		// Move a sub-tree to another parent
+		reference.setParent(child, rootB);
+		BS_TEST_ASSERT(reference.isValid(grandChild));
+
+		hierarchy.update();
+		BS_TEST_ASSERT(reference.areAllValid());
+
+		// Move to the root
+		reference.setParent(child, -1);
+		hierarchy.update();
+		BS_TEST_ASSERT(reference.areAllValid());
+
+		// Parent created after the child, so the child precedes its parent until a reorder
+		UINT32 newParent = reference.create(random.getTransform());
+
+		reference.setParent(rootA, newParent);
+		reference.move(newParent, random.getTransform());
+		hierarchy.update();
+		BS_TEST_ASSERT(reference.areAllValid());
+
+		// Immovable entries ignore the parent transform
+		reference.setParent(child, rootA);
+		reference.setMovable(child, false);
+		hierarchy.update();
+		BS_TEST_ASSERT(reference.areAllValid());
+
+		reference.move(newParent, random.getTransform());
+		hierarchy.update();
+		BS_TEST_ASSERT(reference.areAllValid());
+
+		reference.setMovable(child, true);
+		hierarchy.update();
+		BS_TEST_ASSERT(reference.areAllValid());
+	}
+
+	void TransformHierarchyTestSuite::testDestroy()
+	{
+		ReferenceTransformHierarchy reference;
+		TestRandom random(4);
+
+		UINT32 root = reference.create(random.getTransform());
+		UINT32 child = reference.create(random.getTransform(), root);
+		UINT32 grandChild = reference.create(random.getTransform(), child);
+		UINT32 sibling = reference.create(random.getTransform(), root);
+
+		TransformHierarchy& hierarchy = reference.getHierarchy();
+		hierarchy.update();
+
+		UINT32 childId = reference.getId(child);
+		UINT32 grandChildId = reference.getId(grandChild);
+
+		reference.destroy(child);
+		BS_TEST_ASSERT(reference.getNumAlive() == 2);
+
+		hierarchy.update();
+		BS_TEST_ASSERT(reference.areAllValid());
+
+		// IDs of destroyed entries are reused, and the new entries don't inherit any of the old state
+		UINT32 newChild = reference.create(random.getTransform(), sibling);
+		UINT32 newRoot = reference.create(random.getTransform());
+
+		UINT32 newChildId = reference.getId(newChild);
+		UINT32 newRootId = reference.getId(newRoot);
+		BS_TEST_ASSERT(newChildId == childId || newChildId == grandChildId);
+		BS_TEST_ASSERT(newRootId == childId || newRootId == grandChildId);
+
+		BS_TEST_ASSERT(reference.areAllValid());
+
+		hierarchy.update();
+		BS_TEST_ASSERT(reference.areAllValid());
+
+		// Destroy everything
+		reference.destroy(root);
+		reference.destroy(newRoot);
+		BS_TEST_ASSERT(reference.getNumAlive() == 0);
+
+		hierarchy.update();
+
+		UINT32 last = reference.create(random.getTransform());
+
+		hierarchy.update();
+		BS_TEST_ASSERT(reference.isValid(last));
+	}
+
+	void TransformHierarchyTestSuite::testRandomOperations()
+	{
+		static const UINT32 NUM_INITIAL = 6000;
+		static const UINT32 NUM_FRAMES = 12;
+		static const UINT32 NUM_OPERATIONS = 1500;
+
+		ReferenceTransformHierarchy reference;
+		TestRandom random(5);
+
+		// Mix of roots and deep chains, spanning multiple pages. Enough entries are dirty for a parallel update.
+		for (UINT32 i = 0; i < NUM_INITIAL; i++)
+		{
+			INT32 parent = (random.get() % 8) != 0 ? reference.getRandomAlive(random.get()) : -1;
+			reference.create(random.getTransform(), parent);
+		}
+
+		TransformHierarchy& hierarchy = reference.getHierarchy();
+		hierarchy.update();
+		BS_TEST_ASSERT(reference.areAllValid());
+
+		bool allValid = true;
+		for (UINT32 frame = 0; frame < NUM_FRAMES; frame++)
+		{
+			for (UINT32 i = 0; i < NUM_OPERATIONS; i++)
+			{
+				INT32 target = reference.getRandomAlive(random.get());
+				UINT32 operation = random.get() % 10;
+
+				if (target == -1 || operation < 2)
+				{
+					INT32 parent = (random.get() % 4) != 0 ? target : -1;
+					reference.create(random.getTransform(), parent);
+				}
+				else if (operation < 5)
+					reference.move((UINT32)target, random.getTransform());
+				else if (operation < 8)
+				{
+					INT32 parent = (random.get() % 8) != 0 ? reference.getRandomAlive(random.get()) : -1;
+					if (parent == -1 || !reference.isDescendant((UINT32)parent, (UINT32)target))
+						reference.setParent((UINT32)target, parent);
+				}
+				else if (operation < 9)
+				{
+					// Keep the hierarchy from shrinking away
+					if (reference.getNumAlive() > NUM_INITIAL / 2)
+						reference.destroy((UINT32)target);
+				}
+				else
+					reference.setMovable((UINT32)target, (random.get() % 2) != 0);
+
+				// Occasionally query in the middle of modifications, before update
+				if ((i % 100) == 0)
+				{
+					INT32 queried = reference.getRandomAlive(random.get());
+					if (queried != -1)
+						allValid &= reference.isValid((UINT32)queried);
+				}
+			}
+
+			// Every few frames, move everything so the parallel update path runs on an up to date order
+			if ((frame % 4) == 3)
+			{
+				for (UINT32 i = 0; i < NUM_INITIAL; i++)
+				{
+					INT32 target = reference.getRandomAlive(random.get());
+					reference.move((UINT32)target, random.getTransform());
+				}
+			}
+
+			hierarchy.update();
+			allValid &= reference.areAllValid();
+		}
+
+		BS_TEST_ASSERT(allValid);
+	}
+}
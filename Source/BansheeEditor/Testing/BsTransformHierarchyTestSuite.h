@@ -0,0 +1,44 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsEditorPrerequisites.h"
+#include "Testing/BsTestSuite.h"
+
+namespace bs
+{
+	/** @addtogroup Testing-Editor
+	 *  @{
+	 */
+
+	/**
+	 * Contains a set of unit tests for TransformHierarchy. Each test compares the transforms stored in the hierarchy
+	 * against a naive recursive evaluation of the same scene.
+	 */
+	class TransformHierarchyTestSuite : public TestSuite
+	{
+	public:
+		TransformHierarchyTestSuite();
+
+	private:
+		/** Creates entries in a chain, checking their world transforms before and after update. */
+		void testCreate();
+
+		/** Moves parent entries, checking the movement propagates to the children. */
+		void testMove();
+
+		/** Moves entries between parents and to the root, including immovable entries. */
+		void testReparent();
+
+		/** Destroys sub-trees and checks the IDs are reused for new entries. */
+		void testDestroy();
+
+		/**
+		 * Performs random operations on a hierarchy spanning multiple pages, over multiple calls to update(). Includes
+		 * enough parent changes to trigger reorders, and enough dirty entries to trigger the parallel update.
+		 */
+		void testRandomOperations();
+	};
+
+	/** @} */
+}
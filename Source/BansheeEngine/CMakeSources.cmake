@@ -70,6 +70,7 @@ set(BS_BANSHEEENGINE_SRC_GUI
 	"GUI/BsGUITooltipManager.cpp"
 	"GUI/BsGUITooltip.cpp"
 	"GUI/BsGUIWidget.cpp"
+	"GUI/BsGUIHitTestGrid.cpp"
 	"GUI/BsShortcutKey.cpp"
 	"GUI/BsShortcutManager.cpp"
 	"GUI/BsCGUIWidget.cpp"
@@ -247,6 +248,7 @@ set(BS_BANSHEEENGINE_INC_GUI
 	"GUI/BsGUITooltipManager.h"
 	"GUI/BsGUITooltip.h"
 	"GUI/BsGUIWidget.h"
+	"GUI/BsGUIHitTestGrid.h"
 	"GUI/BsCGUIWidget.h"
 	"GUI/BsShortcutManager.h"
 	"GUI/BsShortcutKey.h"
@@ -38,6 +38,7 @@ namespace bs
 		mBounds.push_back(bounds);
 
 		updateClippedBounds();
+		_markContentAsDirty();
 	}
 
 	void GUIDropDownHitBox::setBounds(const Vector<Rect2I>& bounds)
@@ -45,6 +46,7 @@ namespace bs
 		mBounds = bounds;
 
 		updateClippedBounds();
+		_markContentAsDirty();
 	}
 
 	void GUIDropDownHitBox::updateClippedBounds()
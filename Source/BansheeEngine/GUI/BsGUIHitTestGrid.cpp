@@ -0,0 +1,126 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "GUI/BsGUIHitTestGrid.h"
+#include "GUI/BsGUIElement.h"
+#include "Math/BsMath.h"
+
+namespace bs
+{
+	GUIHitTestGrid::GUIHitTestGrid()
+		: mCellWidth(MIN_CELL_SIZE), mCellHeight(MIN_CELL_SIZE), mNumCellsX(1), mNumCellsY(1), mCells(1)
+	{ }
+
+	void GUIHitTestGrid::build(const Rect2I& area, const Vector<GUIElement*>& elements)
+	{
+		mArea = area;
+
+		mCellWidth = std::max(MIN_CELL_SIZE, (area.width + MAX_CELLS_PER_AXIS - 1) / MAX_CELLS_PER_AXIS);
+		mCellHeight = std::max(MIN_CELL_SIZE, (area.height + MAX_CELLS_PER_AXIS - 1) / MAX_CELLS_PER_AXIS);
+		mNumCellsX = std::max(1U, (area.width + mCellWidth - 1) / mCellWidth);
+		mNumCellsY = std::max(1U, (area.height + mCellHeight - 1) / mCellHeight);
+
+		for (auto& entry : mCells)
+			entry.clear();
+
+		mCells.resize(mNumCellsX * mNumCellsY);
+		mElements.clear();
+
+		for (auto& element : elements)
+			update(element);
+	}
+
+	void GUIHitTestGrid::update(GUIElement* element)
+	{
+		CellRange range;
+		if (!getCellRange(element->_getClippedBounds(), range))
+			range = { 0, 0, -1, -1 };
+
+		auto iterFind = mElements.find(element);
+		if (iterFind != mElements.end())
+		{
+			const CellRange& oldRange = iterFind->second;
+			if (oldRange.minX == range.minX && oldRange.minY == range.minY &&
+				oldRange.maxX == range.maxX && oldRange.maxY == range.maxY)
+				return;
+
+			erase(element, oldRange);
+			iterFind->second = range;
+		}
+		else
+			mElements[element] = range;
+
+		insert(element, range);
+	}
+
+	void GUIHitTestGrid::remove(GUIElement* element)
+	{
+		auto iterFind = mElements.find(element);
+		if (iterFind == mElements.end())
+			return;
+
+		erase(element, iterFind->second);
+		mElements.erase(iterFind);
+	}
+
+	void GUIHitTestGrid::clear()
+	{
+		for (auto& entry : mCells)
+			entry.clear();
+
+		mElements.clear();
+	}
+
+	void GUIHitTestGrid::findCandidates(const Vector2I& position, Vector<GUIElement*>& output) const
+	{
+		INT32 cellX = Math::clamp((position.x - mArea.x) / (INT32)mCellWidth, 0, (INT32)mNumCellsX - 1);
+		INT32 cellY = Math::clamp((position.y - mArea.y) / (INT32)mCellHeight, 0, (INT32)mNumCellsY - 1);
+
+		const Vector<GUIElement*>& cell = mCells[cellY * mNumCellsX + cellX];
+		output.insert(output.end(), cell.begin(), cell.end());
+	}
+
+	bool GUIHitTestGrid::getCellRange(const Rect2I& bounds, CellRange& range) const
+	{
+		if (bounds.width == 0 || bounds.height == 0)
+			return false;
+
+		// Positions are clamped to the grid both here and when querying, so elements outside of the grid area end up in
+		// the same edge cells as the positions that can hit them
+		INT32 maxCellX = (INT32)mNumCellsX - 1;
+		INT32 maxCellY = (INT32)mNumCellsY - 1;
+
+		range.minX = Math::clamp((bounds.x - mArea.x) / (INT32)mCellWidth, 0, maxCellX);
+		range.minY = Math::clamp((bounds.y - mArea.y) / (INT32)mCellHeight, 0, maxCellY);
+		range.maxX = Math::clamp((bounds.x + (INT32)bounds.width - 1 - mArea.x) / (INT32)mCellWidth, 0, maxCellX);
+		range.maxY = Math::clamp((bounds.y + (INT32)bounds.height - 1 - mArea.y) / (INT32)mCellHeight, 0, maxCellY);
+
+		return true;
+	}
+
+	void GUIHitTestGrid::insert(GUIElement* element, const CellRange& range)
+	{
+		for (INT32 y = range.minY; y <= range.maxY; y++)
+		{
+			for (INT32 x = range.minX; x <= range.maxX; x++)
+				mCells[y * mNumCellsX + x].push_back(element);
+		}
+	}
+
+	void GUIHitTestGrid::erase(GUIElement* element, const CellRange& range)
+	{
+		for (INT32 y = range.minY; y <= range.maxY; y++)
+		{
+			for (INT32 x = range.minX; x <= range.maxX; x++)
+			{
+				Vector<GUIElement*>& cell = mCells[y * mNumCellsX + x];
+
+				auto iterFind = std::find(cell.begin(), cell.end(), element);
+				if (iterFind != cell.end())
+				{
+					std::swap(*iterFind, cell.back());
+					cell.pop_back();
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,81 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsPrerequisites.h"
+#include "Math/BsRect2I.h"
+#include "Math/BsVector2I.h"
+
+namespace bs
+{
+	/** @addtogroup GUI-Internal
+	 *  @{
+	 */
+
+	/**
+	 * Uniform grid over the clipped bounds of GUI elements belonging to a single widget, used for quickly finding elements
+	 * under a point. Each cell stores all the elements whose bounds overlap it. Elements extending past the grid area are
+	 * clamped to the edge cells, so the grid stays correct if element bounds move outside of it, and only needs to be
+	 * rebuilt to keep queries fast.
+	 */
+	class BS_EXPORT GUIHitTestGrid
+	{
+		/** Range of cells, inclusive on both ends, occupied by a single element. */
+		struct CellRange
+		{
+			INT32 minX, minY;
+			INT32 maxX, maxY;
+		};
+
+	public:
+		GUIHitTestGrid();
+
+		/** Clears the grid and rebuilds it so it covers @p area, and inserts all the provided elements. */
+		void build(const Rect2I& area, const Vector<GUIElement*>& elements);
+
+		/** Inserts the element into the grid, or moves it if its clipped bounds changed since it was last inserted. */
+		void update(GUIElement* element);
+
+		/** Removes the element from the grid, if present. */
+		void remove(GUIElement* element);
+
+		/** Removes all elements from the grid. */
+		void clear();
+
+		/** Returns the area covered by the grid, relative to the parent widget. */
+		const Rect2I& getArea() const { return mArea; }
+
+		/**
+		 * Appends all elements whose bounds might contain the provided position to the output list. Elements are not
+		 * tested against the position, and might not contain it.
+		 */
+		void findCandidates(const Vector2I& position, Vector<GUIElement*>& output) const;
+
+	private:
+		/** Calculates the range of cells overlapped by the provided bounds. Returns false if the bounds are empty. */
+		bool getCellRange(const Rect2I& bounds, CellRange& range) const;
+
+		/** Adds the element to all cells in the provided range. */
+		void insert(GUIElement* element, const CellRange& range);
+
+		/** Removes the element from all cells in the provided range. */
+		void erase(GUIElement* element, const CellRange& range);
+
+		Rect2I mArea;
+		UINT32 mCellWidth;
+		UINT32 mCellHeight;
+		UINT32 mNumCellsX;
+		UINT32 mNumCellsY;
+
+		Vector<Vector<GUIElement*>> mCells;
+		UnorderedMap<GUIElement*, CellRange> mElements;
+
+		/** Smallest allowed size of a cell, in pixels. */
+		static const UINT32 MIN_CELL_SIZE = 32;
+
+		/** Maximum number of cells along one axis. Cells grow beyond the minimum size to respect this limit. */
+		static const UINT32 MAX_CELLS_PER_AXIS = 32;
+	};
+
+	/** @} */
+}
@@ -42,20 +42,8 @@ using namespace std::placeholders;
 
 namespace bs
 {
-	struct GUIGroupElement
-	{
-		GUIGroupElement()
-		{ }
-
-		GUIGroupElement(GUIElement* _element, UINT32 _renderElement)
-			:element(_element), renderElement(_renderElement)
-		{ }
-
-		GUIElement* element;
-		UINT32 renderElement;
-	};
-
-	struct GUIMaterialGroup
+	/** Group of render elements that share a material and can be rendered using a single mesh. */
+	struct GUIManager::GUIMaterialGroup
 	{
 		SpriteMaterial* material;
 		SpriteMaterialInfo matInfo;
@@ -220,15 +208,7 @@ namespace bs
 		if(renderData.widgets.size() == 0)
 		{
 			for (auto& entry : renderData.cachedMeshes)
-			{
-				if (entry.mesh == nullptr)
-					continue;
-
-				if(!entry.isLine)
-					mTriangleMeshHeap->dealloc(entry.mesh);
-				else
-					mLineMeshHeap->dealloc(entry.mesh);
-			}
+				freeMesh(entry);
 
 			mCachedGUIData.erase(renderTarget);
 			mCoreDirty = true;
@@ -429,268 +409,466 @@ namespace bs
 		{
 			GUIRenderData& renderData = cachedMeshData.second;
 
-			// Check if anything is dirty. If nothing is we can skip the update
-			bool isDirty = renderData.isDirty;
+			// Update dirty elements, and check if anything changed in a way that requires the elements to be regrouped.
+			// If nothing is dirty we can skip the update.
+			bool needsRegroup = renderData.isDirty;
 			renderData.isDirty = false;
 
+			mDirtyElements.clear();
 			for(auto& widget : renderData.widgets)
 			{
-				if (widget->isDirty(true))
-				{
-					isDirty = true;
-				}
+				if (widget->_updateDirtyElements(mDirtyElements))
+					needsRegroup = true;
 			}
 
-			if(!isDirty)
+			if(!needsRegroup && mDirtyElements.empty())
 				continue;
 
 			mCoreDirty = true;
 
-			bs_frame_mark();
+			// If only contents of some elements changed, only their meshes need to be rebuilt
+			if(!needsRegroup && updateDirtyMeshes(renderData, mDirtyElements))
+				continue;
+
+			groupMeshes(renderData, mDirtyElements);
+		}
+
+		mDirtyElements.clear();
+	}
+
+	void GUIManager::groupMeshes(GUIRenderData& renderData, const Vector<GUIElement*>& dirtyElements)
+	{
+		bs_frame_mark();
+		{
+			// Make a list of all GUI elements, sorted from farthest to nearest (highest depth to lowest)
+			auto elemComp = [](const GUIGroupElement& a, const GUIGroupElement& b)
+			{
+				UINT32 aDepth = a.element->_getRenderElementDepth(a.renderElement);
+				UINT32 bDepth = b.element->_getRenderElementDepth(b.renderElement);
+
+				// Compare pointers just to differentiate between two elements with the same depth, their order doesn't really matter, but std::set
+				// requires all elements to be unique
+				return (aDepth > bDepth) || 
+					(aDepth == bDepth && a.element > b.element) || 
+					(aDepth == bDepth && a.element == b.element && a.renderElement > b.renderElement); 
+			};
+
+			FrameSet<GUIGroupElement, std::function<bool(const GUIGroupElement&, const GUIGroupElement&)>> allElements(elemComp);
+
+			renderData.elementMeshInfos.clear();
+			renderData.renderElementInfos.clear();
+
+			for (auto& widget : renderData.widgets)
 			{
-				// Make a list of all GUI elements, sorted from farthest to nearest (highest depth to lowest)
-				auto elemComp = [](const GUIGroupElement& a, const GUIGroupElement& b)
+				const Vector<GUIElement*>& elements = widget->getElements();
+
+				for (auto& element : elements)
 				{
-					UINT32 aDepth = a.element->_getRenderElementDepth(a.renderElement);
-					UINT32 bDepth = b.element->_getRenderElementDepth(b.renderElement);
+					if (!element->_isVisible())
+						continue;
 
-					// Compare pointers just to differentiate between two elements with the same depth, their order doesn't really matter, but std::set
-					// requires all elements to be unique
-					return (aDepth > bDepth) || 
-						(aDepth == bDepth && a.element > b.element) || 
-						(aDepth == bDepth && a.element == b.element && a.renderElement > b.renderElement); 
-				};
+					UINT32 numRenderElems = element->_getNumRenderElements();
 
-				FrameSet<GUIGroupElement, std::function<bool(const GUIGroupElement&, const GUIGroupElement&)>> allElements(elemComp);
+					GUIElementMeshInfo& meshInfo = renderData.elementMeshInfos[element];
+					meshInfo.bounds = element->_getClippedBounds();
+					meshInfo.firstRenderElement = (UINT32)renderData.renderElementInfos.size();
+					meshInfo.numRenderElements = numRenderElems;
 
-				for (auto& widget : renderData.widgets)
-				{
-					const Vector<GUIElement*>& elements = widget->getElements();
+					renderData.renderElementInfos.resize(meshInfo.firstRenderElement + numRenderElems);
 
-					for (auto& element : elements)
+					for (UINT32 i = 0; i < numRenderElems; i++)
 					{
-						if (!element->_isVisible())
-							continue;
-
-						UINT32 numRenderElems = element->_getNumRenderElements();
-						for (UINT32 i = 0; i < numRenderElems; i++)
-						{
-							allElements.insert(GUIGroupElement(element, i));
-						}
+						allElements.insert(GUIGroupElement(element, i));
 					}
 				}
+			}
 
-				// Group the elements in such a way so that we end up with a smallest amount of
-				// meshes, without breaking back to front rendering order
-				FrameUnorderedMap<UINT64, FrameVector<GUIMaterialGroup>> materialGroups;
-				for (auto& elem : allElements)
+			// Group the elements in such a way so that we end up with a smallest amount of
+			// meshes, without breaking back to front rendering order
+			FrameUnorderedMap<UINT64, FrameVector<GUIMaterialGroup>> materialGroups;
+			for (auto& elem : allElements)
+			{
+				GUIElement* guiElem = elem.element;
+				UINT32 renderElemIdx = elem.renderElement;
+				UINT32 elemDepth = guiElem->_getRenderElementDepth(renderElemIdx);
+
+				Rect2I tfrmedBounds = guiElem->_getClippedBounds();
+				tfrmedBounds.transform(guiElem->_getParentWidget()->getWorldTfrm());
+
+				SpriteMaterial* spriteMaterial = nullptr;
+				const SpriteMaterialInfo& matInfo = guiElem->_getMaterial(renderElemIdx, &spriteMaterial);
+				assert(spriteMaterial != nullptr);
+
+				UINT64 hash = spriteMaterial->getMergeHash(matInfo);
+				FrameVector<GUIMaterialGroup>& groupsPerMaterial = materialGroups[hash];
+
+				UINT32 numVertices;
+				UINT32 numIndices;
+				GUIMeshType meshType;
+				guiElem->_getMeshInfo(renderElemIdx, numVertices, numIndices, meshType);
+
+				GUIRenderElementInfo& renderElemInfo = renderData.renderElementInfos[
+					renderData.elementMeshInfos[guiElem].firstRenderElement + renderElemIdx];
+				renderElemInfo.mergeHash = hash;
+				renderElemInfo.depth = elemDepth;
+				renderElemInfo.numVertices = numVertices;
+				renderElemInfo.numIndices = numIndices;
+				renderElemInfo.meshType = meshType;
+				
+				// Try to find a group this material will fit in:
+				//  - Group that has a depth value same or one below elements depth will always be a match
+				//  - Otherwise, we search higher depth values as well, but we only use them if no elements in between those depth values
+				//    overlap the current elements bounds.
+				GUIMaterialGroup* foundGroup = nullptr;
+
+				for (auto groupIter = groupsPerMaterial.rbegin(); groupIter != groupsPerMaterial.rend(); ++groupIter)
 				{
-					GUIElement* guiElem = elem.element;
-					UINT32 renderElemIdx = elem.renderElement;
-					UINT32 elemDepth = guiElem->_getRenderElementDepth(renderElemIdx);
+					// If we separate meshes by widget, ignore any groups with widget parents other than mine
+					if (mSeparateMeshesByWidget)
+					{
+						if (groupIter->elements.size() > 0)
+						{
+							GUIElement* otherElem = groupIter->elements.begin()->element; // We only need to check the first element
+							if (otherElem->_getParentWidget() != guiElem->_getParentWidget())
+								continue;
+						}
+					}
 
-					Rect2I tfrmedBounds = guiElem->_getClippedBounds();
-					tfrmedBounds.transform(guiElem->_getParentWidget()->getWorldTfrm());
+					GUIMaterialGroup& group = *groupIter;
 
-					SpriteMaterial* spriteMaterial = nullptr;
-					const SpriteMaterialInfo& matInfo = guiElem->_getMaterial(renderElemIdx, &spriteMaterial);
-					assert(spriteMaterial != nullptr);
+					if (group.depth == elemDepth)
+					{
+						foundGroup = &group;
+						break;
+					}
+					else
+					{
+						UINT32 startDepth = elemDepth;
+						UINT32 endDepth = group.depth;
 
-					UINT64 hash = spriteMaterial->getMergeHash(matInfo);
-					FrameVector<GUIMaterialGroup>& groupsPerMaterial = materialGroups[hash];
-					
-					// Try to find a group this material will fit in:
-					//  - Group that has a depth value same or one below elements depth will always be a match
-					//  - Otherwise, we search higher depth values as well, but we only use them if no elements in between those depth values
-					//    overlap the current elements bounds.
-					GUIMaterialGroup* foundGroup = nullptr;
+						Rect2I potentialGroupBounds = group.bounds;
+						potentialGroupBounds.encapsulate(tfrmedBounds);
 
-					for (auto groupIter = groupsPerMaterial.rbegin(); groupIter != groupsPerMaterial.rend(); ++groupIter)
-					{
-						// If we separate meshes by widget, ignore any groups with widget parents other than mine
-						if (mSeparateMeshesByWidget)
+						bool foundOverlap = false;
+						for (auto& material : materialGroups)
 						{
-							if (groupIter->elements.size() > 0)
+							for (auto& matGroup : material.second)
 							{
-								GUIElement* otherElem = groupIter->elements.begin()->element; // We only need to check the first element
-								if (otherElem->_getParentWidget() != guiElem->_getParentWidget())
+								if (&matGroup == &group)
 									continue;
+
+								if ((matGroup.minDepth >= startDepth && matGroup.minDepth <= endDepth)
+									|| (matGroup.depth >= startDepth && matGroup.depth <= endDepth))
+								{
+									if (matGroup.bounds.overlaps(potentialGroupBounds))
+									{
+										foundOverlap = true;
+										break;
+									}
+								}
 							}
 						}
 
-						GUIMaterialGroup& group = *groupIter;
-
-						if (group.depth == elemDepth)
+						if (!foundOverlap)
 						{
 							foundGroup = &group;
 							break;
 						}
-						else
-						{
-							UINT32 startDepth = elemDepth;
-							UINT32 endDepth = group.depth;
+					}
+				}
 
-							Rect2I potentialGroupBounds = group.bounds;
-							potentialGroupBounds.encapsulate(tfrmedBounds);
+				if (foundGroup == nullptr)
+				{
+					groupsPerMaterial.push_back(GUIMaterialGroup());
+					foundGroup = &groupsPerMaterial[groupsPerMaterial.size() - 1];
+
+					foundGroup->depth = elemDepth;
+					foundGroup->minDepth = elemDepth;
+					foundGroup->bounds = tfrmedBounds;
+					foundGroup->elements.push_back(GUIGroupElement(guiElem, renderElemIdx));
+					foundGroup->matInfo = matInfo.clone();
+					foundGroup->material = spriteMaterial;
+					foundGroup->meshType = meshType;
+					foundGroup->numVertices = numVertices;
+					foundGroup->numIndices = numIndices;
+				}
+				else
+				{
+					foundGroup->bounds.encapsulate(tfrmedBounds);
+					foundGroup->elements.push_back(GUIGroupElement(guiElem, renderElemIdx));
+					foundGroup->minDepth = std::min(foundGroup->minDepth, elemDepth);
+					
+					assert(meshType == foundGroup->meshType); // It's expected that GUI element doesn't use same material for different mesh types so this should always be true
 
-							bool foundOverlap = false;
-							for (auto& material : materialGroups)
-							{
-								for (auto& matGroup : material.second)
-								{
-									if (&matGroup == &group)
-										continue;
+					foundGroup->numVertices += numVertices;
+					foundGroup->numIndices += numIndices;
 
-									if ((matGroup.minDepth >= startDepth && matGroup.minDepth <= endDepth)
-										|| (matGroup.depth >= startDepth && matGroup.depth <= endDepth))
-									{
-										if (matGroup.bounds.overlaps(potentialGroupBounds))
-										{
-											foundOverlap = true;
-											break;
-										}
-									}
-								}
-							}
+					spriteMaterial->merge(foundGroup->matInfo, matInfo);
+				}
+			}
 
-							if (!foundOverlap)
-							{
-								foundGroup = &group;
-								break;
-							}
-						}
-					}
+			// Make a list of all GUI elements, sorted from farthest to nearest (highest depth to lowest)
+			auto groupComp = [](GUIMaterialGroup* a, GUIMaterialGroup* b)
+			{
+				return (a->depth > b->depth) || (a->depth == b->depth && a > b);
+				// Compare pointers just to differentiate between two elements with the same depth, their order doesn't really matter, but std::set
+				// requires all elements to be unique
+			};
+
+			UINT32 numMeshes = 0;
+			FrameSet<GUIMaterialGroup*, std::function<bool(GUIMaterialGroup*, GUIMaterialGroup*)>> sortedGroups(groupComp);
+			for(auto& material : materialGroups)
+			{
+				for(auto& group : material.second)
+				{
+					sortedGroups.insert(&group);
+					numMeshes++;
+				}
+			}
 
-					if (foundGroup == nullptr)
-					{
-						groupsPerMaterial.push_back(GUIMaterialGroup());
-						foundGroup = &groupsPerMaterial[groupsPerMaterial.size() - 1];
+			// Existing meshes can be kept if they contain the same render elements in the same order, and none of them 
+			// changed. Each render element belongs to a single mesh, so meshes can be found by their first render element.
+			UINT32 oldNumMeshes = (UINT32)renderData.cachedMeshes.size();
 
-						foundGroup->depth = elemDepth;
-						foundGroup->minDepth = elemDepth;
-						foundGroup->bounds = tfrmedBounds;
-						foundGroup->elements.push_back(GUIGroupElement(guiElem, renderElemIdx));
-						foundGroup->matInfo = matInfo.clone();
-						foundGroup->material = spriteMaterial;
+			FrameMap<std::pair<GUIElement*, UINT32>, UINT32> oldMeshLookup;
+			for (UINT32 i = 0; i < oldNumMeshes; i++)
+			{
+				const GUIMeshData& oldMesh = renderData.cachedMeshes[i];
+				if (oldMesh.elements.empty())
+					continue;
 
-						guiElem->_getMeshInfo(renderElemIdx, foundGroup->numVertices, foundGroup->numIndices, foundGroup->meshType);
-					}
-					else
-					{
-						foundGroup->bounds.encapsulate(tfrmedBounds);
-						foundGroup->elements.push_back(GUIGroupElement(guiElem, renderElemIdx));
-						foundGroup->minDepth = std::min(foundGroup->minDepth, elemDepth);
-						
-						UINT32 numVertices;
-						UINT32 numIndices;
-						GUIMeshType meshType;
-						guiElem->_getMeshInfo(renderElemIdx, numVertices, numIndices, meshType);
-						assert(meshType == foundGroup->meshType); // It's expected that GUI element doesn't use same material for different mesh types so this should always be true
-
-						foundGroup->numVertices += numVertices;
-						foundGroup->numIndices += numIndices;
-
-						spriteMaterial->merge(foundGroup->matInfo, matInfo);
-					}
+				const GUIGroupElement& firstElement = oldMesh.elements[0];
+				oldMeshLookup[std::make_pair(firstElement.element, firstElement.renderElement)] = i;
+			}
+
+			FrameUnorderedSet<GUIElement*> dirtyElementSet(dirtyElements.begin(), dirtyElements.end());
+			FrameVector<bool> oldMeshKept(oldNumMeshes, false);
+
+			Vector<GUIMeshData> newMeshes(numMeshes);
+			
+			// Fill buffers for each group and update their meshes
+			UINT32 meshIdx = 0;
+			for(auto& group : sortedGroups)
+			{
+				GUIWidget* widget;
+
+				if (group->elements.size() == 0)
+					widget = nullptr;
+				else
+				{
+					GUIElement* elem = group->elements.begin()->element;
+					widget = elem->_getParentWidget();
+				}
+
+				GUIMeshData& guiMeshData = newMeshes[meshIdx];
+				guiMeshData.matInfo = group->matInfo;
+				guiMeshData.material = group->material;
+				guiMeshData.widget = widget;
+				guiMeshData.isLine = group->meshType == GUIMeshType::Line;
+				guiMeshData.numVertices = group->numVertices;
+				guiMeshData.numIndices = group->numIndices;
+				guiMeshData.elements = std::move(group->elements);
+
+				for(auto& matElement : guiMeshData.elements)
+				{
+					const GUIElementMeshInfo& meshInfo = renderData.elementMeshInfos[matElement.element];
+					renderData.renderElementInfos[meshInfo.firstRenderElement + matElement.renderElement].meshIdx = meshIdx;
 				}
 
-				// Make a list of all GUI elements, sorted from farthest to nearest (highest depth to lowest)
-				auto groupComp = [](GUIMaterialGroup* a, GUIMaterialGroup* b)
+				INT32 oldMeshIdx = -1;
+				if (!guiMeshData.elements.empty())
 				{
-					return (a->depth > b->depth) || (a->depth == b->depth && a > b);
-					// Compare pointers just to differentiate between two elements with the same depth, their order doesn't really matter, but std::set
-					// requires all elements to be unique
-				};
-
-				UINT32 numMeshes = 0;
-				FrameSet<GUIMaterialGroup*, std::function<bool(GUIMaterialGroup*, GUIMaterialGroup*)>> sortedGroups(groupComp);
-				for(auto& material : materialGroups)
+					const GUIGroupElement& firstElement = guiMeshData.elements[0];
+					auto iterFind = oldMeshLookup.find(std::make_pair(firstElement.element, firstElement.renderElement));
+
+					if (iterFind != oldMeshLookup.end())
+						oldMeshIdx = (INT32)iterFind->second;
+				}
+
+				bool canKeepMesh = false;
+				if (oldMeshIdx != -1)
 				{
-					for(auto& group : material.second)
+					const GUIMeshData& oldMesh = renderData.cachedMeshes[oldMeshIdx];
+
+					canKeepMesh = oldMesh.mesh != nullptr && oldMesh.isLine == guiMeshData.isLine &&
+						oldMesh.elements.size() == guiMeshData.elements.size();
+
+					for (UINT32 i = 0; canKeepMesh && i < (UINT32)guiMeshData.elements.size(); i++)
 					{
-						sortedGroups.insert(&group);
-						numMeshes++;
+						const GUIGroupElement& oldElement = oldMesh.elements[i];
+						const GUIGroupElement& newElement = guiMeshData.elements[i];
+
+						canKeepMesh = oldElement.element == newElement.element && 
+							oldElement.renderElement == newElement.renderElement &&
+							dirtyElementSet.find(newElement.element) == dirtyElementSet.end();
 					}
 				}
 
-				UINT32 oldNumMeshes = (UINT32)renderData.cachedMeshes.size();
-				for (UINT32 i = 0; i < oldNumMeshes; i++)
+				if (canKeepMesh)
 				{
-					if(!renderData.cachedMeshes[i].isLine)
-						mTriangleMeshHeap->dealloc(renderData.cachedMeshes[i].mesh);
-					else
-						mLineMeshHeap->dealloc(renderData.cachedMeshes[i].mesh);
+					guiMeshData.mesh = renderData.cachedMeshes[oldMeshIdx].mesh;
+					oldMeshKept[oldMeshIdx] = true;
 				}
+				else
+					buildMesh(guiMeshData);
 
-				renderData.cachedMeshes.resize(numMeshes);
-				
-				// Fill buffers for each group and update their meshes
-				UINT32 meshIdx = 0;
-				for(auto& group : sortedGroups)
+				meshIdx++;
+			}
+
+			for (UINT32 i = 0; i < oldNumMeshes; i++)
+			{
+				if (!oldMeshKept[i])
+					freeMesh(renderData.cachedMeshes[i]);
+			}
+
+			renderData.cachedMeshes = std::move(newMeshes);
+		}
+
+		bs_frame_clear();
+	}
+
+	bool GUIManager::updateDirtyMeshes(GUIRenderData& renderData, const Vector<GUIElement*>& dirtyElements)
+	{
+		bool canUpdate = true;
+
+		bs_frame_mark();
+		{
+			// Check if the properties the render elements were grouped by are unchanged, and find their meshes
+			FrameVector<UINT32> dirtyMeshes;
+			for (auto& element : dirtyElements)
+			{
+				UINT32 numRenderElems = element->_isVisible() ? element->_getNumRenderElements() : 0;
+
+				auto iterFind = renderData.elementMeshInfos.find(element);
+				if (iterFind == renderData.elementMeshInfos.end())
 				{
-					SPtr<MeshData> meshData;
-					GUIWidget* widget;
+					// Element wasn't rendered before, and still isn't
+					if (numRenderElems == 0)
+						continue;
 
-					if (group->elements.size() == 0)
-						widget = nullptr;
-					else
-					{
-						GUIElement* elem = group->elements.begin()->element;
-						widget = elem->_getParentWidget();
-					}
+					canUpdate = false;
+					break;
+				}
 
-					GUIMeshData& guiMeshData = renderData.cachedMeshes[meshIdx];
-					guiMeshData.matInfo = group->matInfo;
-					guiMeshData.material = group->material;
-					guiMeshData.widget = widget;
+				const GUIElementMeshInfo& meshInfo = iterFind->second;
+				if (meshInfo.numRenderElements != numRenderElems || meshInfo.bounds != element->_getClippedBounds())
+				{
+					canUpdate = false;
+					break;
+				}
 
-					if (group->meshType == GUIMeshType::Triangle)
-					{
-						meshData = bs_shared_ptr_new<MeshData>(group->numVertices, group->numIndices, mTriangleVertexDesc);
-						guiMeshData.isLine = false;
-					}
-					else // Line
+				for (UINT32 i = 0; i < numRenderElems; i++)
+				{
+					const GUIRenderElementInfo& renderElemInfo = renderData.renderElementInfos[meshInfo.firstRenderElement + i];
+
+					SpriteMaterial* spriteMaterial = nullptr;
+					const SpriteMaterialInfo& matInfo = element->_getMaterial(i, &spriteMaterial);
+
+					UINT32 numVertices;
+					UINT32 numIndices;
+					GUIMeshType meshType;
+					element->_getMeshInfo(i, numVertices, numIndices, meshType);
+
+					if (renderElemInfo.depth != element->_getRenderElementDepth(i) ||
+						renderElemInfo.mergeHash != spriteMaterial->getMergeHash(matInfo) ||
+						renderElemInfo.numVertices != numVertices || renderElemInfo.numIndices != numIndices ||
+						renderElemInfo.meshType != meshType)
 					{
-						meshData = bs_shared_ptr_new<MeshData>(group->numVertices, group->numIndices, mLineVertexDesc);
-						guiMeshData.isLine = true;
+						canUpdate = false;
+						break;
 					}
 
-					UINT8* vertices = meshData->getElementData(VES_POSITION);
-					UINT32* indices = meshData->getIndices32();
+					dirtyMeshes.push_back(renderElemInfo.meshIdx);
+				}
 
-					UINT32 indexOffset = 0;
-					UINT32 vertexOffset = 0;
-					for(auto& matElement : group->elements)
-					{
-						matElement.element->_fillBuffer(vertices, indices, vertexOffset, indexOffset, group->numVertices,
-							group->numIndices, matElement.renderElement);
+				if (!canUpdate)
+					break;
+			}
 
-						UINT32 numVertices;
-						UINT32 numIndices;
-						GUIMeshType meshType;
-						matElement.element->_getMeshInfo(matElement.renderElement, numVertices, numIndices, meshType);
+			if (canUpdate)
+			{
+				std::sort(dirtyMeshes.begin(), dirtyMeshes.end());
+				auto dirtyMeshesEnd = std::unique(dirtyMeshes.begin(), dirtyMeshes.end());
 
-						UINT32 indexStart = indexOffset;
-						UINT32 indexEnd = indexStart + numIndices;
+				for (auto iter = dirtyMeshes.begin(); iter != dirtyMeshesEnd; ++iter)
+				{
+					GUIMeshData& meshData = renderData.cachedMeshes[*iter];
 
-						for(UINT32 i = indexStart; i < indexEnd; i++)
-							indices[i] += vertexOffset;
+					// Material data not accounted for by the merge hash could have changed, so merge it again
+					for (UINT32 i = 0; i < (UINT32)meshData.elements.size(); i++)
+					{
+						const GUIGroupElement& matElement = meshData.elements[i];
 
-						indexOffset += numIndices;
-						vertexOffset += numVertices;
-					}
+						SpriteMaterial* spriteMaterial = nullptr;
+						const SpriteMaterialInfo& matInfo = matElement.element->_getMaterial(matElement.renderElement, 
+							&spriteMaterial);
 
-					if (group->meshType == GUIMeshType::Triangle)
-						guiMeshData.mesh = mTriangleMeshHeap->alloc(meshData);
-					else // Line
-						guiMeshData.mesh = mLineMeshHeap->alloc(meshData, DOT_LINE_LIST);
+						if (i == 0)
+							meshData.matInfo = matInfo.clone();
+						else
+							spriteMaterial->merge(meshData.matInfo, matInfo);
+					}
 
-					meshIdx++;
+					freeMesh(meshData);
+					buildMesh(meshData);
 				}
 			}
+		}
+		bs_frame_clear();
+
+		return canUpdate;
+	}
+
+	void GUIManager::buildMesh(GUIMeshData& meshData)
+	{
+		SPtr<MeshData> vertexData;
+		if (!meshData.isLine)
+			vertexData = bs_shared_ptr_new<MeshData>(meshData.numVertices, meshData.numIndices, mTriangleVertexDesc);
+		else
+			vertexData = bs_shared_ptr_new<MeshData>(meshData.numVertices, meshData.numIndices, mLineVertexDesc);
+
+		UINT8* vertices = vertexData->getElementData(VES_POSITION);
+		UINT32* indices = vertexData->getIndices32();
 
-			bs_frame_clear();			
+		UINT32 indexOffset = 0;
+		UINT32 vertexOffset = 0;
+		for(auto& matElement : meshData.elements)
+		{
+			matElement.element->_fillBuffer(vertices, indices, vertexOffset, indexOffset, meshData.numVertices,
+				meshData.numIndices, matElement.renderElement);
+
+			UINT32 numVertices;
+			UINT32 numIndices;
+			GUIMeshType meshType;
+			matElement.element->_getMeshInfo(matElement.renderElement, numVertices, numIndices, meshType);
+
+			UINT32 indexStart = indexOffset;
+			UINT32 indexEnd = indexStart + numIndices;
+
+			for(UINT32 i = indexStart; i < indexEnd; i++)
+				indices[i] += vertexOffset;
+
+			indexOffset += numIndices;
+			vertexOffset += numVertices;
 		}
+
+		if (!meshData.isLine)
+			meshData.mesh = mTriangleMeshHeap->alloc(vertexData);
+		else
+			meshData.mesh = mLineMeshHeap->alloc(vertexData, DOT_LINE_LIST);
+	}
+
+	void GUIManager::freeMesh(GUIMeshData& meshData)
+	{
+		if (meshData.mesh == nullptr)
+			return;
+
+		if (!meshData.isLine)
+			mTriangleMeshHeap->dealloc(meshData.mesh);
+		else
+			mLineMeshHeap->dealloc(meshData.mesh);
+
+		meshData.mesh = nullptr;
 	}
 
 	void GUIManager::updateCaretTexture()
@@ -1284,29 +1462,25 @@ namespace bs
 				if(widgetWindows[widgetIdx] == windowUnderPointer 
 					&& widget->inBounds(windowToBridgedCoords(widget->getTarget()->getTarget(), windowPos)))
 				{
-					const Vector<GUIElement*>& elements = widget->getElements();
 					Vector2I localPos = getWidgetRelativePos(widget, pointerScreenPos);
 
-					// Elements with lowest depth (most to the front) get handled first
-					for(auto iter = elements.begin(); iter != elements.end(); ++iter)
-					{
-						GUIElement* element = *iter;
-
-						if(element->_isVisible() && element->_isInBounds(localPos))
-						{
-							ElementInfoUnderPointer elementInfo(element, widget);
+					mWidgetElementsUnderPointer.clear();
+					widget->findElementsAt(localPos, mWidgetElementsUnderPointer);
 
-							auto iterFind = std::find_if(mElementsUnderPointer.begin(), mElementsUnderPointer.end(),
-								[=](const ElementInfoUnderPointer& x) { return x.element == element; });
+					for(auto& element : mWidgetElementsUnderPointer)
+					{
+						ElementInfoUnderPointer elementInfo(element, widget);
 
-							if (iterFind != mElementsUnderPointer.end())
-							{
-								elementInfo.usesMouseOver = iterFind->usesMouseOver;
-								elementInfo.receivedMouseOver = iterFind->receivedMouseOver;
-							}
+						auto iterFind = std::find_if(mElementsUnderPointer.begin(), mElementsUnderPointer.end(),
+							[=](const ElementInfoUnderPointer& x) { return x.element == element; });
 
-							mNewElementsUnderPointer.push_back(elementInfo);
+						if (iterFind != mElementsUnderPointer.end())
+						{
+							elementInfo.usesMouseOver = iterFind->usesMouseOver;
+							elementInfo.receivedMouseOver = iterFind->receivedMouseOver;
 						}
+
+						mNewElementsUnderPointer.push_back(elementInfo);
 					}
 				}
 
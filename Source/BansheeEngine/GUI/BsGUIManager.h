@@ -48,6 +48,22 @@ namespace bs
 			Dragging
 		};
 
+		/** Render element of a GUI element that is part of a GUI mesh. */
+		struct GUIGroupElement
+		{
+			GUIGroupElement()
+			{ }
+
+			GUIGroupElement(GUIElement* _element, UINT32 _renderElement)
+				:element(_element), renderElement(_renderElement)
+			{ }
+
+			GUIElement* element;
+			UINT32 renderElement;
+		};
+
+		struct GUIMaterialGroup;
+
 		/** Data required for rendering a single GUI mesh. */
 		struct GUIMeshData
 		{
@@ -56,6 +72,31 @@ namespace bs
 			SpriteMaterialInfo matInfo;
 			GUIWidget* widget;
 			bool isLine;
+			UINT32 numVertices;
+			UINT32 numIndices;
+			Vector<GUIGroupElement> elements; // In the order they are written to the mesh
+		};
+
+		/** 
+		 * Properties of a render element that determine which mesh it is grouped in, as they were when the meshes were 
+		 * last grouped.
+		 */
+		struct GUIRenderElementInfo
+		{
+			UINT64 mergeHash;
+			UINT32 depth;
+			UINT32 numVertices;
+			UINT32 numIndices;
+			GUIMeshType meshType;
+			UINT32 meshIdx;
+		};
+
+		/** Render elements of a single GUI element, as they were when the meshes were last grouped. */
+		struct GUIElementMeshInfo
+		{
+			Rect2I bounds;
+			UINT32 firstRenderElement;
+			UINT32 numRenderElements;
 		};
 
 		/**	GUI render data for a single viewport. */
@@ -68,6 +109,11 @@ namespace bs
 			Vector<GUIMeshData> cachedMeshes;
 			Vector<GUIWidget*> widgets;
 			bool isDirty;
+
+			// Grouping state from the last time the meshes were grouped, used for determining if changes to individual
+			// elements can be applied to their existing meshes
+			UnorderedMap<GUIElement*, GUIElementMeshInfo> elementMeshInfos;
+			Vector<GUIRenderElementInfo> renderElementInfos;
 		};
 
 		/**	Render data for a single GUI group used for notifying the core GUI renderer. */
@@ -227,6 +273,27 @@ namespace bs
 		/**	Recreates all dirty GUI meshes and makes them ready for rendering. */
 		void updateMeshes();
 
+		/** 
+		 * Groups render elements of all the widgets in the viewport into as few meshes as possible, and rebuilds the 
+		 * meshes. Meshes whose render elements haven't changed are kept as they are.
+		 *
+		 * @param[in]	renderData		Render data of the viewport to group.
+		 * @param[in]	dirtyElements	Elements whose render elements were updated since the meshes were last built.
+		 */
+		void groupMeshes(GUIRenderData& renderData, const Vector<GUIElement*>& dirtyElements);
+
+		/**
+		 * Checks if the render elements of the provided elements can be updated in their existing meshes without
+		 * regrouping, and updates the meshes if so. Returns false if the elements need to be regrouped instead.
+		 */
+		bool updateDirtyMeshes(GUIRenderData& renderData, const Vector<GUIElement*>& dirtyElements);
+
+		/** Fills the vertex and index data of the mesh from its render elements, and allocates it on the mesh heap. */
+		void buildMesh(GUIMeshData& meshData);
+
+		/** Deallocates the mesh from the mesh heap, if allocated. */
+		void freeMesh(GUIMeshData& meshData);
+
 		/**	Recreates the input caret texture. */
 		void updateCaretTexture();
 
@@ -345,6 +412,7 @@ namespace bs
 		static const UINT32 MESH_HEAP_INITIAL_NUM_INDICES;
 
 		Vector<WidgetInfo> mWidgets;
+		Vector<GUIElement*> mDirtyElements;
 		UnorderedMap<const Viewport*, GUIRenderData> mCachedGUIData;
 		SPtr<MeshHeap> mTriangleMeshHeap;
 		SPtr<MeshHeap> mLineMeshHeap;
@@ -360,6 +428,7 @@ namespace bs
 		// Element and widget pointer is currently over
 		Vector<ElementInfoUnderPointer> mElementsUnderPointer;
 		Vector<ElementInfoUnderPointer> mNewElementsUnderPointer;
+		Vector<GUIElement*> mWidgetElementsUnderPointer; // Scratch list, cleared before every use
 
 		// Element and widget that's being clicked on
 		GUIMouseButton mActiveMouseButton;
@@ -80,6 +80,7 @@ namespace bs
 
 		mElements.clear();
 		mDirtyContents.clear();
+		mHitTestGrid.clear();
 	}
 
 	void GUIWidget::setDepth(UINT8 depth)
@@ -119,7 +120,7 @@ namespace bs
 					mWidgetIsDirty = true;
 				else
 				{
-					if(Math::approxEquals(mScale, scale))
+					if(!Math::approxEquals(mScale, scale, diffEpsilon))
 						mWidgetIsDirty = true;
 				}
 			}
@@ -236,7 +237,12 @@ namespace bs
 				todo.pop();
 
 				if (currentElem->_getType() == GUIElementBase::Type::Element)
-					mDirtyContents.insert(static_cast<GUIElement*>(currentElem));
+				{
+					GUIElement* element = static_cast<GUIElement*>(currentElem);
+
+					mDirtyContents.insert(element);
+					mHitTestGrid.update(element);
+				}
 
 				currentElem->_markAsClean();
 
@@ -255,6 +261,7 @@ namespace bs
 		if (elem->_getType() == GUIElementBase::Type::Element)
 		{
 			mElements.push_back(static_cast<GUIElement*>(elem));
+			mHitTestGrid.update(static_cast<GUIElement*>(elem));
 			mWidgetIsDirty = true;
 		}
 	}
@@ -272,7 +279,10 @@ namespace bs
 		}
 
 		if (elem->_getType() == GUIElementBase::Type::Element)
+		{
 			mDirtyContents.erase(static_cast<GUIElement*>(elem));
+			mHitTestGrid.remove(static_cast<GUIElement*>(elem));
+		}
 	}
 
 	void GUIWidget::_markMeshDirty(GUIElementBase* elem)
@@ -348,13 +358,38 @@ namespace bs
 			for (auto& dirtyElement : mDirtyContents)
 				dirtyElement->_updateRenderElements();
 
-			mDirtyContents.clear();
 			updateBounds();
+			updateHitTestGrid();
+			mDirtyContents.clear();
 		}
 		
 		return dirty;
 	}
 
+	bool GUIWidget::_updateDirtyElements(Vector<GUIElement*>& updatedElements)
+	{
+		if (!mIsActive)
+			return false;
+
+		bool widgetDirty = mWidgetIsDirty;
+		if (!widgetDirty && mDirtyContents.empty())
+			return false;
+
+		mWidgetIsDirty = false;
+
+		for (auto& dirtyElement : mDirtyContents)
+		{
+			dirtyElement->_updateRenderElements();
+			updatedElements.push_back(dirtyElement);
+		}
+
+		updateBounds();
+		updateHitTestGrid();
+		mDirtyContents.clear();
+
+		return widgetDirty;
+	}
+
 	bool GUIWidget::inBounds(const Vector2I& position) const
 	{
 		Viewport* target = getTarget();
@@ -372,6 +407,17 @@ namespace bs
 		return mBounds.contains(localPos);
 	}
 
+	void GUIWidget::findElementsAt(const Vector2I& position, Vector<GUIElement*>& output) const
+	{
+		size_t firstCandidate = output.size();
+		mHitTestGrid.findCandidates(position, output);
+
+		auto iterEnd = std::remove_if(output.begin() + firstCandidate, output.end(), 
+			[&](GUIElement* element) { return !element->_isVisible() || !element->_isInBounds(position); });
+
+		output.erase(iterEnd, output.end());
+	}
+
 	void GUIWidget::updateBounds() const
 	{
 		if(mElements.size() > 0)
@@ -384,6 +430,26 @@ namespace bs
 		}
 	}
 
+	void GUIWidget::updateHitTestGrid()
+	{
+		// Element bounds can also change when their contents update, not just during layout
+		for (auto& dirtyElement : mDirtyContents)
+			mHitTestGrid.update(dirtyElement);
+
+		// The grid stays valid when elements move outside of it, but rebuild it so the cells keep covering the elements
+		// evenly
+		const Rect2I& gridArea = mHitTestGrid.getArea();
+
+		Rect2I coveredArea = gridArea;
+		coveredArea.encapsulate(mBounds);
+
+		UINT64 gridSize = (UINT64)gridArea.width * gridArea.height;
+		UINT64 boundsSize = (UINT64)mBounds.width * mBounds.height;
+
+		if (coveredArea != gridArea || boundsSize * 4 < gridSize)
+			mHitTestGrid.build(mBounds, mElements);
+	}
+
 	void GUIWidget::ownerTargetResized()
 	{
 		updateRootPanel();
@@ -8,6 +8,7 @@
 #include "Math/BsQuaternion.h"
 #include "Math/BsMatrix4.h"
 #include "Utility/BsEvent.h"
+#include "GUI/BsGUIHitTestGrid.h"
 
 namespace bs
 {
@@ -67,6 +68,16 @@ namespace bs
 		 */
 		bool isDirty(bool cleanIfDirty);
 
+		/**
+		 * Updates render elements of all dirty elements and marks the widget as clean.
+		 *
+		 * @param[out]	updatedElements	Elements whose render elements were updated are appended to this list.
+		 * @return						True if the widget itself was dirty (elements were added, removed or changed their
+		 *								depth, or the widget moved), in which case the meshes of its elements need to be
+		 *								regrouped. False if only the contents of individual elements changed, if any.
+		 */
+		bool _updateDirtyElements(Vector<GUIElement*>& updatedElements);
+
 		/**	Returns the viewport that this widget will be rendered on. */
 		Viewport* getTarget() const;
 
@@ -79,6 +90,15 @@ namespace bs
 		/**	Returns a list of all elements parented to this widget. */
 		const Vector<GUIElement*>& getElements() const { return mElements; }
 
+		/**
+		 * Finds all visible elements that contain the provided position. Only elements whose bounds overlap the position
+		 * are tested.
+		 *
+		 * @param[in]	position	Position relative to the widget.
+		 * @param[out]	output		Elements containing the position are appended to this list, in no particular order.
+		 */
+		void findElementsAt(const Vector2I& position, Vector<GUIElement*>& output) const;
+
 		/** Returns the world transform that all GUI elements beloning to this widget will be transformed by. */
 		const Matrix4 getWorldTfrm() const { return mTransform; }
 
@@ -174,6 +194,12 @@ namespace bs
 		/**	Calculates widget bounds using the bounds of all child elements. */
 		void updateBounds() const;
 
+		/** 
+		 * Updates the hit test grid entries of all elements whose contents were just updated, and rebuilds the grid if the
+		 * widget bounds changed.
+		 */
+		void updateHitTestGrid();
+
 		/**	Updates the size of the primary GUI panel based on the viewport. */
 		void updateRootPanel();
 
@@ -191,6 +217,7 @@ namespace bs
 		HEvent mOwnerTargetResizedConn;
 
 		Set<GUIElement*> mDirtyContents;
+		GUIHitTestGrid mHitTestGrid;
 
 		mutable UINT64 mCachedRTId;
 		mutable bool mWidgetIsDirty;
@@ -31,6 +31,7 @@ namespace bs
 		float animSampleRate = 1.0f / 60.0f;
 		bool animResample = false;
 		bool reduceKeyframes = true;
+		bool optimizeVertexOrder = false;
 	};
 
 	/**	Represents a single node in the FBX transform hierarchy. */
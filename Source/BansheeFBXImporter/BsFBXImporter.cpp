@@ -185,6 +185,9 @@ namespace bs
 			{
 				SPtr<AnimationClip> clip = AnimationClip::_createPtr(entry.curves, entry.isAdditive, entry.sampleRate, 
 					entry.rootMotion);
+
+				if (meshImportOptions->getCompressAnimation())
+					clip->compress();
 				
 				for(auto& eventsEntry : events)
 				{
@@ -222,6 +225,7 @@ namespace bs
 		fbxImportOptions.importBlendShapes = meshImportOptions->getImportBlendShapes();
 		fbxImportOptions.importSkin = meshImportOptions->getImportSkin();
 		fbxImportOptions.importScale = meshImportOptions->getImportScale();
+		fbxImportOptions.optimizeVertexOrder = meshImportOptions->getOptimizeVertexOrder();
 
 		FBXImportScene importedScene;
 		bakeTransforms(fbxScene);
@@ -239,6 +243,9 @@ namespace bs
 		splitMeshVertices(importedScene);
 		generateMissingTangentSpace(importedScene, fbxImportOptions);
 
+		if (fbxImportOptions.optimizeVertexOrder)
+			optimizeVertexOrder(importedScene);
+
 		SPtr<RendererMeshData> rendererMeshData = generateMeshData(importedScene, fbxImportOptions, subMeshes);
 
 		skeleton = createSkeleton(importedScene, subMeshes.size() > 1);
@@ -251,7 +258,7 @@ namespace bs
 			convertAnimations(importedScene.clips, splits, skeleton, meshImportOptions->getImportRootMotion(), animation);
 		}
 
-		// TODO - Later: Optimize mesh: Remove bad and degenerate polygons, weld nearby vertices, optimize for vertex cache
+		// TODO - Later: Optimize mesh: Remove bad and degenerate polygons, weld nearby vertices
 
 		shutDownSdk();
 
@@ -1682,6 +1689,53 @@ namespace bs
 		}
 	}
 
+	void FBXImporter::optimizeVertexOrder(FBXImportScene& scene)
+	{
+		for (auto& mesh : scene.meshes)
+		{
+			UINT32 numVertices = (UINT32)mesh->positions.size();
+			UINT32 numIndices = (UINT32)mesh->indices.size();
+
+			if (numIndices == 0)
+				continue;
+
+			// Sub-meshes are output per material, so triangles are grouped by their material index
+			Vector<UINT32> remap(numVertices);
+			MeshUtility::optimizeVertexOrder(mesh->positions.data(), (UINT32*)mesh->indices.data(), 
+				(UINT32*)mesh->materials.data(), numVertices, numIndices, remap.data());
+
+			auto remapVertices = [&](auto& vertices)
+			{
+				if (vertices.size() == numVertices)
+				{
+					MeshUtility::remapVertices((UINT8*)vertices.data(), numVertices, sizeof(vertices[0]), 
+						remap.data());
+				}
+			};
+
+			remapVertices(mesh->positions);
+			remapVertices(mesh->normals);
+			remapVertices(mesh->tangents);
+			remapVertices(mesh->bitangents);
+			remapVertices(mesh->colors);
+			remapVertices(mesh->boneInfluences);
+
+			for (auto& uvLayer : mesh->UV)
+				remapVertices(uvLayer);
+
+			for (auto& shape : mesh->blendShapes)
+			{
+				for (auto& frame : shape.frames)
+				{
+					remapVertices(frame.positions);
+					remapVertices(frame.normals);
+					remapVertices(frame.tangents);
+					remapVertices(frame.bitangents);
+				}
+			}
+		}
+	}
+
 	void FBXImporter::importAnimations(FbxScene* scene, FBXImportOptions& importOptions, FBXImportScene& importScene)
 	{
 		FbxNode* root = scene->GetRootNode();
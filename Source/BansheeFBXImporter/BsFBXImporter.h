@@ -133,6 +133,15 @@ namespace bs
 		 */
 		void generateMissingTangentSpace(FBXImportScene& scene, const FBXImportOptions& options);
 
+		/**
+		 * Reorders triangles of all meshes in the scene for better GPU vertex cache use and less overdraw, and reorders
+		 * vertices in the order they are referenced by the triangles. Triangles are grouped by material, in the same order
+		 * the sub-meshes are output by generateMeshData().
+		 *
+		 * @note	This assumes vertices have already been split and shouldn't be called on pre-split meshes.
+		 */
+		void optimizeVertexOrder(FBXImportScene& scene);
+
 		/** Converts the mesh data from the imported FBX scene into mesh data that can be used for initializing a mesh. */
 		SPtr<RendererMeshData> generateMeshData(const FBXImportScene& scene, const FBXImportOptions& options, 
 			Vector<SubMesh>& outputSubMeshes);
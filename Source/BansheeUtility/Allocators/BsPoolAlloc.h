@@ -0,0 +1,176 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "Prerequisites/BsPrerequisitesUtil.h"
+
+namespace bs
+{
+	/** @addtogroup Internal-Utility
+	 *  @{
+	 */
+
+	/** @addtogroup Memory-Internal
+	 *  @{
+	 */
+
+	/** Locking policy for PoolAlloc. Non-locking version used when the allocator is only accessed from a single thread. */
+	template<bool Lock>
+	class PoolAllocLock
+	{
+	public:
+		void lock() { }
+		void unlock() { }
+	};
+
+	/** Locking policy for PoolAlloc. Locking version used when the allocator is accessed from multiple threads. */
+	template<>
+	class PoolAllocLock<true>
+	{
+	public:
+		void lock() { mLock.lock(); }
+		void unlock() { mLock.unlock(); }
+
+	private:
+		SpinLock mLock;
+	};
+
+	/**
+	 * A memory allocator that allocates elements of the same size. Allows for fairly quick allocations and deallocations
+	 * as freed elements are kept in a free list and reused, while new elements are carved out of large preallocated
+	 * blocks.
+	 *
+	 * @tparam	ElemSize		Size of a single element in the pool, in bytes. This will be the exact allocation size.
+	 * @tparam	ElemsPerBlock	Determines how much space to reserve for elements. This determines the initial size of the
+	 *							pool, and the additional size the pool will be expanded by every time the number of
+	 *							elements goes over the available storage limit.
+	 * @tparam	Alignment		Memory alignment of each stored element. Must be a power of two.
+	 * @tparam	Lock			If true the pool allocator will be made thread safe (at the cost of performance).
+	 */
+	template<int ElemSize, int ElemsPerBlock = 512, int Alignment = 4, bool Lock = false>
+	class PoolAlloc : INonCopyable
+	{
+	private:
+		/** A single block able to hold ElemsPerBlock elements. */
+		struct MemBlock
+		{
+			UINT8* data;
+			UINT32 numUsed;
+			MemBlock* next;
+		};
+
+		/** Header written into freed elements, linking them into the free list. */
+		struct FreeElem
+		{
+			FreeElem* next;
+		};
+
+	public:
+		PoolAlloc()
+			:mFreeBlock(nullptr), mFreeList(nullptr), mTotalNumElems(0)
+		{ }
+
+		~PoolAlloc()
+		{
+			MemBlock* curBlock = mFreeBlock;
+			while (curBlock != nullptr)
+			{
+				MemBlock* nextBlock = curBlock->next;
+				bs_free_aligned(curBlock->data);
+				bs_delete(curBlock);
+
+				curBlock = nextBlock;
+			}
+		}
+
+		/** Allocates enough memory for a single element in the pool. */
+		UINT8* alloc()
+		{
+			mLock.lock();
+
+			UINT8* output;
+			if (mFreeList != nullptr)
+			{
+				output = (UINT8*)mFreeList;
+				mFreeList = mFreeList->next;
+			}
+			else
+			{
+				if (mFreeBlock == nullptr || mFreeBlock->numUsed == ElemsPerBlock)
+					allocBlock();
+
+				output = mFreeBlock->data + mFreeBlock->numUsed * ActualElemSize;
+				mFreeBlock->numUsed++;
+			}
+
+			mTotalNumElems++;
+			mLock.unlock();
+
+			return output;
+		}
+
+		/** Deallocates an element previously allocated with alloc(). */
+		void free(void* data)
+		{
+			if (data == nullptr)
+				return;
+
+			mLock.lock();
+
+			FreeElem* elem = (FreeElem*)data;
+			elem->next = mFreeList;
+			mFreeList = elem;
+
+			mTotalNumElems--;
+			mLock.unlock();
+		}
+
+		/** Allocates and constructs a single pool element. */
+		template<class T, class... Args>
+		T* construct(Args &&...args)
+		{
+			static_assert(sizeof(T) <= ElemSize, "Element doesn't fit in the pool.");
+
+			T* data = (T*)alloc();
+			new ((void*)data) T(std::forward<Args>(args)...);
+
+			return data;
+		}
+
+		/** Destructs and deallocates an element previously allocated with construct(). */
+		template<class T>
+		void destruct(T* data)
+		{
+			data->~T();
+			free(data);
+		}
+
+		/** Returns the number of elements currently allocated from the pool. */
+		UINT32 getNumAllocated() const { return mTotalNumElems; }
+
+	private:
+		/** Allocates a new block of memory and makes it the active block. */
+		void allocBlock()
+		{
+			MemBlock* newBlock = bs_new<MemBlock>();
+			newBlock->data = (UINT8*)bs_alloc_aligned(ActualElemSize * ElemsPerBlock, Alignment);
+			newBlock->numUsed = 0;
+			newBlock->next = mFreeBlock;
+
+			mFreeBlock = newBlock;
+		}
+
+		static constexpr int MinElemSize = ElemSize > (int)sizeof(FreeElem) ? ElemSize : (int)sizeof(FreeElem);
+		static constexpr int ActualElemSize = ((MinElemSize + Alignment - 1) / Alignment) * Alignment;
+
+		static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two.");
+
+		MemBlock* mFreeBlock;
+		FreeElem* mFreeList;
+		UINT32 mTotalNumElems;
+		PoolAllocLock<Lock> mLock;
+	};
+
+	/** @} */
+	/** @} */
+}
@@ -1,6 +1,10 @@
 //********************************** Banshee Engine (www.banshee3d.com) **************************************************//
 //**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
 #include "Testing/BsFileSystemTestSuite.h"
+#include "Testing/BsTaskSchedulerTestSuite.h"
+#include "Testing/BsMathTestSuite.h"
+#include "Testing/BsCompressionTestSuite.h"
+#include "Testing/BsSerializationTestSuite.h"
 #include "Testing/BsConsoleTestOutput.h"
 
 using namespace bs;
@@ -8,6 +12,10 @@ using namespace bs;
 int main()
 {
 	SPtr<TestSuite> tests = FileSystemTestSuite::create<FileSystemTestSuite>();
+	tests->add(TaskSchedulerTestSuite::create<TaskSchedulerTestSuite>());
+	tests->add(MathTestSuite::create<MathTestSuite>());
+	tests->add(CompressionTestSuite::create<CompressionTestSuite>());
+	tests->add(SerializationTestSuite::create<SerializationTestSuite>());
 	ConsoleTestOutput testOutput;
 	tests->run(testOutput);
 
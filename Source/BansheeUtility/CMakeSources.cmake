@@ -4,6 +4,8 @@ set(BS_BANSHEEUTILITY_INC_THREADING
 	"Threading/BsSpinLock.h"
 	"Threading/BsThreadPool.h"
 	"Threading/BsTaskScheduler.h"
+	"Threading/BsWorkStealingQueue.h"
+	"Threading/BsParallel.h"
 )
 
 set(BS_BANSHEEUTILITY_SRC_THIRDPARTY
@@ -60,6 +62,8 @@ set(BS_BANSHEEUTILITY_SRC_UTILITY
 	"Utility/BsUtil.cpp"
 	"Utility/BsCompression.cpp"
 	"Utility/BsTriangulation.cpp"
+	"Utility/BsDynamicBVH.cpp"
+	"Utility/BsOcclusionBuffer.cpp"
 	"Utility/BsUUID.cpp"
 )
 
@@ -85,6 +89,7 @@ set(BS_BANSHEEUTILITY_SRC_THREADING
 	"Threading/BsAsyncOp.cpp"
 	"Threading/BsTaskScheduler.cpp"
 	"Threading/BsThreadPool.cpp"
+	"Threading/BsParallel.cpp"
 )
 
 set(BS_BANSHEEUTILITY_INC_UTILITY
@@ -104,8 +109,11 @@ set(BS_BANSHEEUTILITY_INC_UTILITY
 	"Utility/BsFlags.h"
 	"Utility/BsCompression.h"
 	"Utility/BsTriangulation.h"
+	"Utility/BsDynamicBVH.h"
+	"Utility/BsOcclusionBuffer.h"
 	"Utility/BsNonCopyable.h"
 	"Utility/BsUUID.h"
+	"Utility/BsIdHashMap.h"
 )
 
 set(BS_BANSHEEUTILITY_SRC_ALLOCATORS
@@ -140,6 +148,7 @@ set(BS_BANSHEEUTILITY_INC_ALLOCATORS
 	"Allocators/BsMemStack.h"
 	"Allocators/BsStaticAlloc.h"
 	"Allocators/BsGroupAlloc.h"
+	"Allocators/BsPoolAlloc.h"
 )
 
 set(BS_BANSHEEUTILITY_INC_THIRDPARTY
@@ -184,6 +193,10 @@ set(BS_BANSHEEUTILITY_INC_TESTING
 	"Testing/BsTestSuite.h"
 	"Testing/BsTestOutput.h"
 	"Testing/BsConsoleTestOutput.h"
+	"Testing/BsTaskSchedulerTestSuite.h"
+	"Testing/BsMathTestSuite.h"
+	"Testing/BsCompressionTestSuite.h"
+	"Testing/BsSerializationTestSuite.h"
 )
 
 set(BS_BANSHEEUTILITY_SRC_TESTING
@@ -191,6 +204,10 @@ set(BS_BANSHEEUTILITY_SRC_TESTING
 	"Testing/BsTestSuite.cpp"
 	"Testing/BsTestOutput.cpp"
 	"Testing/BsConsoleTestOutput.cpp"
+	"Testing/BsTaskSchedulerTestSuite.cpp"
+	"Testing/BsMathTestSuite.cpp"
+	"Testing/BsCompressionTestSuite.cpp"
+	"Testing/BsSerializationTestSuite.cpp"
 )
 
 set(BS_BANSHEEUTILITY_SRC_SERIALIZATION
@@ -228,6 +245,7 @@ set(BS_BANSHEEUTILITY_INC_MATH
 	"Math/BsRect2I.h"
 	"Math/BsCapsule.h"
 	"Math/BsMatrixNxM.h"
+	"Math/BsSIMD.h"
 	"Math/BsLine2.h"
 )
 
@@ -4,6 +4,19 @@
 #include "Debug/BsDebug.h"
 #include "String/BsUnicode.h"
 
+#if BS_PLATFORM == BS_PLATFORM_WIN32
+	#define WIN32_LEAN_AND_MEAN
+	#if !defined(NOMINMAX) && defined(_MSC_VER)
+		#define NOMINMAX // required to stop windows.h messing up std::min
+	#endif
+	#include <windows.h>
+#else
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
 namespace bs 
 {
 	const UINT32 DataStream::StreamTempSize = 128;
@@ -417,4 +430,109 @@ namespace bs
 			}
 		}
 	}
+
+	MappedFileDataStream::MappedFileDataStream(const Path& filePath)
+		:MemoryDataStream(nullptr, 0, false), mPath(filePath)
+	{
+		mAccess = READ;
+
+		void* mapping = nullptr;
+		size_t size = 0;
+
+#if BS_PLATFORM == BS_PLATFORM_WIN32
+		HANDLE file = CreateFileW(filePath.toPlatformString().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, 
+			OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			LOGWRN("Cannot open file: " + filePath.toString());
+			return;
+		}
+
+		LARGE_INTEGER fileSize;
+		if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0)
+		{
+			// View keeps the mapping alive after the handles are closed
+			HANDLE mappingHandle = CreateFileMappingW(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+			if (mappingHandle != nullptr)
+			{
+				mapping = MapViewOfFile(mappingHandle, FILE_MAP_COPY, 0, 0, 0);
+				CloseHandle(mappingHandle);
+			}
+
+			if (mapping == nullptr)
+				LOGWRN("Cannot map file: " + filePath.toString());
+			else
+				size = (size_t)fileSize.QuadPart;
+		}
+
+		CloseHandle(file);
+#else
+		int file = open(filePath.toPlatformString().c_str(), O_RDONLY);
+		if (file == -1)
+		{
+			LOGWRN("Cannot open file: " + filePath.toString());
+			return;
+		}
+
+		// Mapping stays valid after the file is closed
+		struct stat fileStat;
+		if (fstat(file, &fileStat) == 0 && fileStat.st_size > 0)
+		{
+			mapping = mmap(nullptr, (size_t)fileStat.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0);
+			if (mapping == MAP_FAILED)
+			{
+				LOGWRN("Cannot map file: " + filePath.toString());
+				mapping = nullptr;
+			}
+			else
+				size = (size_t)fileStat.st_size;
+		}
+
+		::close(file);
+#endif
+
+		mData = mPos = (UINT8*)mapping;
+		mSize = size;
+		mEnd = mData + mSize;
+	}
+
+	MappedFileDataStream::~MappedFileDataStream()
+	{
+		close();
+	}
+
+	void MappedFileDataStream::prefetch() const
+	{
+		static const size_t PREFETCH_STRIDE = 4096;
+
+		volatile UINT8 sink = 0;
+		for (size_t i = 0; i < mSize; i += PREFETCH_STRIDE)
+			sink ^= mData[i];
+	}
+
+	SPtr<DataStream> MappedFileDataStream::clone(bool copyData) const
+	{
+		if (!copyData)
+			return bs_shared_ptr_new<MemoryDataStream>(mData, mSize, false);
+
+		SPtr<MemoryDataStream> copy = bs_shared_ptr_new<MemoryDataStream>(mSize);
+		memcpy(copy->getPtr(), mData, mSize);
+
+		return copy;
+	}
+
+	void MappedFileDataStream::close()
+	{
+		if (mData == nullptr)
+			return;
+
+#if BS_PLATFORM == BS_PLATFORM_WIN32
+		UnmapViewOfFile(mData);
+#else
+		munmap(mData, mSize);
+#endif
+
+		mData = mPos = mEnd = nullptr;
+		mSize = 0;
+	}
 }
@@ -50,6 +50,12 @@ namespace bs
 		virtual bool isWriteable() const { return (mAccess & WRITE) != 0; }
 		virtual bool isFile() const = 0;
 
+		/**
+		 * Checks is the stream a memory mapping of a file. Data of such streams can be referenced directly for as long as
+		 * the stream is kept alive, instead of being copied out of it.
+		 */
+		virtual bool isMapped() const { return false; }
+
 		/** Reads data from the buffer and copies it to the specified value. */
 		template<typename T> DataStream& operator>>(T& val);
 
@@ -282,6 +288,45 @@ namespace bs
 		bool mFreeOnClose;	
 	};
 
+	/**
+	 * Data stream that maps a file into memory instead of reading it. The OS pages the file contents in as they are
+	 * accessed, and they can be referenced directly through getPtr() and getCurrentPtr() without being copied.
+	 *
+	 * @note	Mapping is copy-on-write. Any modifications to the mapped memory are never written back to the file.
+	 * @note	On some platforms the file cannot be modified or deleted while it is mapped.
+	 */
+	class BS_UTILITY_EXPORT MappedFileDataStream : public MemoryDataStream
+	{
+	public:
+		/**
+		 * Maps the file at the provided path into memory. If the file cannot be opened the stream will be empty.
+		 *
+		 * @param[in]	filePath	Path of the file to map.
+		 */
+		MappedFileDataStream(const Path& filePath);
+		~MappedFileDataStream();
+
+		/** @copydoc DataStream::isMapped */
+		bool isMapped() const override { return true; }
+
+		/**
+		 * Touches all the mapped pages in order, so that later accesses to the stream data don't need to wait on file I/O.
+		 */
+		void prefetch() const;
+
+		/** @copydoc DataStream::clone */
+		SPtr<DataStream> clone(bool copyData = true) const override;
+
+		/** @copydoc DataStream::close */
+		void close() override;
+
+		/** Returns the path of the file mapped by the stream. */
+		const Path& getPath() const { return mPath; }
+
+	protected:
+		Path mPath;
+	};
+
 	/** @} */
 }
 
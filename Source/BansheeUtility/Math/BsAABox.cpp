@@ -5,6 +5,7 @@
 #include "Math/BsPlane.h"
 #include "Math/BsSphere.h"
 #include "Math/BsMath.h"
+#include "Math/BsSIMD.h"
 
 namespace bs
 {
@@ -176,13 +177,27 @@ namespace bs
 		Vector3 centre = getCenter();
 		Vector3 halfSize = getHalfSize();
 
-		Vector3 newCentre = m.multiplyAffine(centre);
-		Vector3 newHalfSize(
-			Math::abs(m[0][0]) * halfSize.x + Math::abs(m[0][1]) * halfSize.y + Math::abs(m[0][2]) * halfSize.z, 
-			Math::abs(m[1][0]) * halfSize.x + Math::abs(m[1][1]) * halfSize.y + Math::abs(m[1][2]) * halfSize.z,
-			Math::abs(m[2][0]) * halfSize.x + Math::abs(m[2][1]) * halfSize.y + Math::abs(m[2][2]) * halfSize.z);
+		// Work on matrix columns so that all three output axes are transformed at once
+		SIMDFloat4 col0 = SIMD::load(&m[0].x);
+		SIMDFloat4 col1 = SIMD::load(&m[1].x);
+		SIMDFloat4 col2 = SIMD::load(&m[2].x);
+		SIMDFloat4 col3 = SIMD::set(0.0f, 0.0f, 0.0f, 1.0f);
+		SIMD::transpose(col0, col1, col2, col3);
 
-		setExtents(newCentre - newHalfSize, newCentre + newHalfSize);
+		SIMDFloat4 newCentre = SIMD::madd(col3, col0, SIMD::splat(centre.x));
+		newCentre = SIMD::madd(newCentre, col1, SIMD::splat(centre.y));
+		newCentre = SIMD::madd(newCentre, col2, SIMD::splat(centre.z));
+
+		SIMDFloat4 newHalfSize = SIMD::mul(SIMD::abs(col0), SIMD::splat(halfSize.x));
+		newHalfSize = SIMD::madd(newHalfSize, SIMD::abs(col1), SIMD::splat(halfSize.y));
+		newHalfSize = SIMD::madd(newHalfSize, SIMD::abs(col2), SIMD::splat(halfSize.z));
+
+		float newMin[4];
+		float newMax[4];
+		SIMD::store(newMin, SIMD::sub(newCentre, newHalfSize));
+		SIMD::store(newMax, SIMD::add(newCentre, newHalfSize));
+
+		setExtents(Vector3(newMin[0], newMin[1], newMin[2]), Vector3(newMax[0], newMax[1], newMax[2]));
 	}
 
 	bool AABox::intersects(const AABox& b2) const
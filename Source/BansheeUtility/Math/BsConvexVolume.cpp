@@ -5,12 +5,15 @@
 #include "Math/BsSphere.h"
 #include "Math/BsPlane.h"
 #include "Math/BsMath.h"
+#include "Math/BsSIMD.h"
 
 namespace bs
 {
 	ConvexVolume::ConvexVolume(const Vector<Plane>& planes)
 		:mPlanes(planes)
-	{ }
+	{
+		buildPlaneBatches();
+	}
 
 	ConvexVolume::ConvexVolume(const Matrix4& projectionMatrix, bool useNearPlane)
 	{
@@ -90,23 +93,38 @@ namespace bs
 			float length = mPlanes[i].normal.normalize();
 			mPlanes[i].d /= -length;
 		}
+
+		buildPlaneBatches();
 	}
 
 	bool ConvexVolume::intersects(const AABox& box) const
 	{
 		Vector3 center = box.getCenter();
 		Vector3 extents = box.getHalfSize();
-		Vector3 absExtents(Math::abs(extents.x), Math::abs(extents.y), Math::abs(extents.z));
 
-		for (auto& plane : mPlanes)
+		SIMDFloat4 centerX = SIMD::splat(center.x);
+		SIMDFloat4 centerY = SIMD::splat(center.y);
+		SIMDFloat4 centerZ = SIMD::splat(center.z);
+
+		SIMDFloat4 extentX = SIMD::splat(Math::abs(extents.x));
+		SIMDFloat4 extentY = SIMD::splat(Math::abs(extents.y));
+		SIMDFloat4 extentZ = SIMD::splat(Math::abs(extents.z));
+
+		for (auto& batch : mPlaneBatches)
 		{
-			float dist = center.dot(plane.normal) - plane.d;
+			SIMDFloat4 normalX = SIMD::load(batch.normalX);
+			SIMDFloat4 normalY = SIMD::load(batch.normalY);
+			SIMDFloat4 normalZ = SIMD::load(batch.normalZ);
+
+			SIMDFloat4 dist = SIMD::sub(SIMD::mul(centerX, normalX), SIMD::load(batch.d));
+			dist = SIMD::madd(dist, centerY, normalY);
+			dist = SIMD::madd(dist, centerZ, normalZ);
 
-			float effectiveRadius = absExtents.x * Math::abs(plane.normal.x);
-			effectiveRadius += absExtents.y * Math::abs(plane.normal.y);
-			effectiveRadius += absExtents.z * Math::abs(plane.normal.z);
+			SIMDFloat4 effectiveRadius = SIMD::mul(extentX, SIMD::abs(normalX));
+			effectiveRadius = SIMD::madd(effectiveRadius, extentY, SIMD::abs(normalY));
+			effectiveRadius = SIMD::madd(effectiveRadius, extentZ, SIMD::abs(normalZ));
 
-			if (dist < -effectiveRadius)
+			if (SIMD::lessMask(dist, SIMD::negate(effectiveRadius)) != 0)
 				return false;
 		}
 
@@ -116,13 +134,19 @@ namespace bs
 	bool ConvexVolume::intersects(const Sphere& sphere) const
 	{
 		Vector3 center = sphere.getCenter();
-		float radius = sphere.getRadius();
 
-		for (auto& plane : mPlanes)
+		SIMDFloat4 centerX = SIMD::splat(center.x);
+		SIMDFloat4 centerY = SIMD::splat(center.y);
+		SIMDFloat4 centerZ = SIMD::splat(center.z);
+		SIMDFloat4 negRadius = SIMD::splat(-sphere.getRadius());
+
+		for (auto& batch : mPlaneBatches)
 		{
-			float dist = center.dot(plane.normal) - plane.d;
+			SIMDFloat4 dist = SIMD::sub(SIMD::mul(centerX, SIMD::load(batch.normalX)), SIMD::load(batch.d));
+			dist = SIMD::madd(dist, centerY, SIMD::load(batch.normalY));
+			dist = SIMD::madd(dist, centerZ, SIMD::load(batch.normalZ));
 
-			if (dist < -radius)
+			if (SIMD::lessMask(dist, negRadius) != 0)
 				return false;
 		}
 
@@ -139,4 +163,26 @@ namespace bs
 
 		return true;
 	}
+
+	void ConvexVolume::buildPlaneBatches()
+	{
+		UINT32 numPlanes = (UINT32)mPlanes.size();
+		UINT32 numBatches = (numPlanes + 3) / 4;
+
+		// Unused slots in the last batch are filled with zero planes, which never reject anything
+		mPlaneBatches.clear();
+		mPlaneBatches.resize(numBatches);
+		memset(mPlaneBatches.data(), 0, numBatches * sizeof(PlaneBatch));
+
+		for (UINT32 i = 0; i < numPlanes; i++)
+		{
+			PlaneBatch& batch = mPlaneBatches[i / 4];
+			UINT32 slot = i % 4;
+
+			batch.normalX[slot] = mPlanes[i].normal.x;
+			batch.normalY[slot] = mPlanes[i].normal.y;
+			batch.normalZ[slot] = mPlanes[i].normal.z;
+			batch.d[slot] = mPlanes[i].d;
+		}
+	}
 }
\ No newline at end of file
@@ -57,7 +57,20 @@ namespace bs
 		Vector<Plane> getPlanes() const { return mPlanes; }
 
 	private:
+		/** Four planes stored in structure-of-arrays form, so they can be tested with a single SIMD operation. */
+		struct PlaneBatch
+		{
+			float normalX[4];
+			float normalY[4];
+			float normalZ[4];
+			float d[4];
+		};
+
+		/** Rebuilds the plane batches from the current set of planes. */
+		void buildPlaneBatches();
+
 		Vector<Plane> mPlanes;
+		Vector<PlaneBatch> mPlaneBatches;
 	};
 
 	/** @} */
@@ -178,15 +178,41 @@ namespace bs
 
     void Matrix4::setTRS(const Vector3& translation, const Quaternion& rotation, const Vector3& scale)
     {
-        Matrix3 rot3x3;
-        rotation.toRotationMatrix(rot3x3);
-
-        m[0][0] = scale.x * rot3x3[0][0]; m[0][1] = scale.y * rot3x3[0][1]; m[0][2] = scale.z * rot3x3[0][2]; m[0][3] = translation.x;
-        m[1][0] = scale.x * rot3x3[1][0]; m[1][1] = scale.y * rot3x3[1][1]; m[1][2] = scale.z * rot3x3[1][2]; m[1][3] = translation.y;
-        m[2][0] = scale.x * rot3x3[2][0]; m[2][1] = scale.y * rot3x3[2][1]; m[2][2] = scale.z * rot3x3[2][2]; m[2][3] = translation.z;
+        // Each column of the rotation matrix is a constant plus two products of (shuffled) quaternion components, see
+        // Quaternion::toRotationMatrix() for the scalar version
+        SIMDFloat4 q = SIMD::load(&rotation.x);
+        SIMDFloat4 q2 = SIMD::add(q, q);
+
+        SIMDFloat4 col0 = SIMD::set(1.0f, 0.0f, 0.0f, 0.0f);
+        col0 = SIMD::madd(col0, SIMD::mul(SIMD::shuffle<1, 0, 0, 3>(q), SIMD::shuffle<1, 1, 2, 3>(q2)),
+            SIMD::set(-1.0f, 1.0f, 1.0f, 0.0f));
+        col0 = SIMD::madd(col0, SIMD::mul(SIMD::shuffle<2, 3, 3, 3>(q), SIMD::shuffle<2, 2, 1, 3>(q2)),
+            SIMD::set(-1.0f, 1.0f, -1.0f, 0.0f));
+
+        SIMDFloat4 col1 = SIMD::set(0.0f, 1.0f, 0.0f, 0.0f);
+        col1 = SIMD::madd(col1, SIMD::mul(SIMD::shuffle<0, 0, 1, 3>(q), SIMD::shuffle<1, 0, 2, 3>(q2)),
+            SIMD::set(1.0f, -1.0f, 1.0f, 0.0f));
+        col1 = SIMD::madd(col1, SIMD::mul(SIMD::shuffle<3, 2, 3, 3>(q), SIMD::shuffle<2, 2, 0, 3>(q2)),
+            SIMD::set(-1.0f, -1.0f, 1.0f, 0.0f));
+
+        SIMDFloat4 col2 = SIMD::set(0.0f, 0.0f, 1.0f, 0.0f);
+        col2 = SIMD::madd(col2, SIMD::mul(SIMD::shuffle<0, 1, 0, 3>(q), SIMD::shuffle<2, 2, 0, 3>(q2)),
+            SIMD::set(1.0f, 1.0f, -1.0f, 0.0f));
+        col2 = SIMD::madd(col2, SIMD::mul(SIMD::shuffle<3, 3, 1, 3>(q), SIMD::shuffle<1, 0, 1, 3>(q2)),
+            SIMD::set(1.0f, -1.0f, -1.0f, 0.0f));
+
+        col0 = SIMD::mul(col0, SIMD::splat(scale.x));
+        col1 = SIMD::mul(col1, SIMD::splat(scale.y));
+        col2 = SIMD::mul(col2, SIMD::splat(scale.z));
 
         // No projection term
-        m[3][0] = 0; m[3][1] = 0; m[3][2] = 0; m[3][3] = 1;
+        SIMDFloat4 col3 = SIMD::set(translation.x, translation.y, translation.z, 1.0f);
+
+        SIMD::transpose(col0, col1, col2, col3);
+        SIMD::store(m[0], col0);
+        SIMD::store(m[1], col1);
+        SIMD::store(m[2], col2);
+        SIMD::store(m[3], col3);
     }
 
     void Matrix4::setInverseTRS(const Vector3& translation, const Quaternion& rotation, const Vector3& scale)
@@ -0,0 +1,407 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "Prerequisites/BsPrerequisitesUtil.h"
+
+#if BS_SIMD == BS_SIMD_SSE
+#	include <emmintrin.h>
+#elif BS_SIMD == BS_SIMD_NEON
+#	include <arm_neon.h>
+#endif
+
+namespace bs
+{
+	/** @addtogroup Math
+	 *  @{
+	 */
+
+#if BS_SIMD == BS_SIMD_SSE
+	/** Four single precision floats stored in a SIMD register. */
+	typedef __m128 SIMDFloat4;
+#elif BS_SIMD == BS_SIMD_NEON
+	/** Four single precision floats stored in a SIMD register. */
+	typedef float32x4_t SIMDFloat4;
+#else
+	/** Four single precision floats. Used when no SIMD instruction set is available. */
+	struct alignas(16) SIMDFloat4
+	{
+		float v[4];
+	};
+#endif
+
+	/**
+	 * Thin wrapper around the SIMD instruction set available on the target platform (SSE2 on x86, NEON on ARM), with a
+	 * scalar fallback for other platforms. The instruction set is chosen at compile time, see BS_SIMD.
+	 *
+	 * @note
+	 * SIMDFloat4 values are meant to live in registers or on the stack. Loads and stores from persistent data are
+	 * unaligned, so the data they reference (e.g. Matrix4 rows) doesn't need special alignment.
+	 */
+	class SIMD
+	{
+	public:
+		/** Loads four floats from memory. Memory doesn't need to be aligned. */
+		static SIMDFloat4 load(const float* data)
+		{
+#if BS_SIMD == BS_SIMD_SSE
+			return _mm_loadu_ps(data);
+#elif BS_SIMD == BS_SIMD_NEON
+			return vld1q_f32(data);
+#else
+			SIMDFloat4 r;
+			r.v[0] = data[0]; r.v[1] = data[1]; r.v[2] = data[2]; r.v[3] = data[3];
+			return r;
+#endif
+		}
+
+		/** Stores four floats to memory. Memory doesn't need to be aligned. */
+		static void store(float* data, const SIMDFloat4& a)
+		{
+#if BS_SIMD == BS_SIMD_SSE
+			_mm_storeu_ps(data, a);
+#elif BS_SIMD == BS_SIMD_NEON
+			vst1q_f32(data, a);
+#else
+			data[0] = a.v[0]; data[1] = a.v[1]; data[2] = a.v[2]; data[3] = a.v[3];
+#endif
+		}
+
+		/** Creates a value from four individual floats. */
+		static SIMDFloat4 set(float x, float y, float z, float w)
+		{
+#if BS_SIMD == BS_SIMD_SSE
+			return _mm_setr_ps(x, y, z, w);
+#else
+			alignas(16) float data[4] = { x, y, z, w };
+			return load(data);
+#endif
+		}
+
+		/** Creates a value with all four components set to @p a. */
+		static SIMDFloat4 splat(float a)
+		{
+#if BS_SIMD == BS_SIMD_SSE
+			return _mm_set1_ps(a);
+#elif BS_SIMD == BS_SIMD_NEON
+			return vdupq_n_f32(a);
+#else
+			return set(a, a, a, a);
+#endif
+		}
+
+		/** Creates a value with all four components set to zero. */
+		static SIMDFloat4 zero()
+		{
+#if BS_SIMD == BS_SIMD_SSE
+			return _mm_setzero_ps();
+#else
+			return splat(0.0f);
+#endif
+		}
+
+		/** Returns the first component. */
+		static float getX(const SIMDFloat4& a)
+		{
+#if BS_SIMD == BS_SIMD_SSE
+			return _mm_cvtss_f32(a);
+#elif BS_SIMD == BS_SIMD_NEON
+			return vgetq_lane_f32(a, 0);
+#else
+			return a.v[0];
+#endif
+		}
+
+		/** Component-wise a + b. */
+		static SIMDFloat4 add(const SIMDFloat4& a, const SIMDFloat4& b)
+		{
+#if BS_SIMD == BS_SIMD_SSE
+			return _mm_add_ps(a, b);
+#elif BS_SIMD == BS_SIMD_NEON
+			return vaddq_f32(a, b);
+#else
+			SIMDFloat4 r;
+			for (int i = 0; i < 4; i++) r.v[i] = a.v[i] + b.v[i];
+			return r;
+#endif
+		}
+
+		/** Component-wise a - b. */
+		static SIMDFloat4 sub(const SIMDFloat4& a, const SIMDFloat4& b)
+		{
+#if BS_SIMD == BS_SIMD_SSE
+			return _mm_sub_ps(a, b);
+#elif BS_SIMD == BS_SIMD_NEON
+			return vsubq_f32(a, b);
+#else
+			SIMDFloat4 r;
+			for (int i = 0; i < 4; i++) r.v[i] = a.v[i] - b.v[i];
+			return r;
+#endif
+		}
+
+		/** Component-wise a * b. */
+		static SIMDFloat4 mul(const SIMDFloat4& a, const SIMDFloat4& b)
+		{
+#if BS_SIMD == BS_SIMD_SSE
+			return _mm_mul_ps(a, b);
+#elif BS_SIMD == BS_SIMD_NEON
+			return vmulq_f32(a, b);
+#else
+			SIMDFloat4 r;
+			for (int i = 0; i < 4; i++) r.v[i] = a.v[i] * b.v[i];
+			return r;
+#endif
+		}
+
+		/** Component-wise a / b. */
+		static SIMDFloat4 div(const SIMDFloat4& a, const SIMDFloat4& b)
+		{
+#if BS_SIMD == BS_SIMD_SSE
+			return _mm_div_ps(a, b);
+#elif BS_SIMD == BS_SIMD_NEON
+			// No division on ARMv7, refine the reciprocal estimate using two Newton-Raphson steps instead
+			float32x4_t rcp = vrecpeq_f32(b);
+			rcp = vmulq_f32(vrecpsq_f32(b, rcp), rcp);
+			rcp = vmulq_f32(vrecpsq_f32(b, rcp), rcp);
+
+			return vmulq_f32(a, rcp);
+#else
+			SIMDFloat4 r;
+			for (int i = 0; i < 4; i++) r.v[i] = a.v[i] / b.v[i];
+			return r;
+#endif
+		}
+
+		/** Component-wise a + b * c. */
+		static SIMDFloat4 madd(const SIMDFloat4& a, const SIMDFloat4& b, const SIMDFloat4& c)
+		{
+#if BS_SIMD == BS_SIMD_NEON
+			return vmlaq_f32(a, b, c);
+#else
+			return add(a, mul(b, c));
+#endif
+		}
+
+		/** Component-wise minimum. */
+		static SIMDFloat4 min(const SIMDFloat4& a, const SIMDFloat4& b)
+		{
+#if BS_SIMD == BS_SIMD_SSE
+			return _mm_min_ps(a, b);
+#elif BS_SIMD == BS_SIMD_NEON
+			return vminq_f32(a, b);
+#else
+			SIMDFloat4 r;
+			for (int i = 0; i < 4; i++) r.v[i] = a.v[i] < b.v[i] ? a.v[i] : b.v[i];
+			return r;
+#endif
+		}
+
+		/** Component-wise maximum. */
+		static SIMDFloat4 max(const SIMDFloat4& a, const SIMDFloat4& b)
+		{
+#if BS_SIMD == BS_SIMD_SSE
+			return _mm_max_ps(a, b);
+#elif BS_SIMD == BS_SIMD_NEON
+			return vmaxq_f32(a, b);
+#else
+			SIMDFloat4 r;
+			for (int i = 0; i < 4; i++) r.v[i] = a.v[i] > b.v[i] ? a.v[i] : b.v[i];
+			return r;
+#endif
+		}
+
+		/** Component-wise absolute value. */
+		static SIMDFloat4 abs(const SIMDFloat4& a)
+		{
+#if BS_SIMD == BS_SIMD_SSE
+			return _mm_andnot_ps(_mm_set1_ps(-0.0f), a);
+#elif BS_SIMD == BS_SIMD_NEON
+			return vabsq_f32(a);
+#else
+			SIMDFloat4 r;
+			for (int i = 0; i < 4; i++) r.v[i] = a.v[i] < 0.0f ? -a.v[i] : a.v[i];
+			return r;
+#endif
+		}
+
+		/** Component-wise negation. */
+		static SIMDFloat4 negate(const SIMDFloat4& a)
+		{
+#if BS_SIMD == BS_SIMD_SSE
+			return _mm_xor_ps(_mm_set1_ps(-0.0f), a);
+#elif BS_SIMD == BS_SIMD_NEON
+			return vnegq_f32(a);
+#else
+			SIMDFloat4 r;
+			for (int i = 0; i < 4; i++) r.v[i] = -a.v[i];
+			return r;
+#endif
+		}
+
+		/** Negates the components of @p a where the matching component of @p b is negative. */
+		static SIMDFloat4 flipSign(const SIMDFloat4& a, const SIMDFloat4& b)
+		{
+#if BS_SIMD == BS_SIMD_SSE
+			return _mm_xor_ps(a, _mm_and_ps(_mm_set1_ps(-0.0f), b));
+#elif BS_SIMD == BS_SIMD_NEON
+			uint32x4_t signBits = vandq_u32(vreinterpretq_u32_f32(b), vdupq_n_u32(0x80000000));
+			return vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(a), signBits));
+#else
+			SIMDFloat4 r;
+			for (int i = 0; i < 4; i++) r.v[i] = b.v[i] < 0.0f ? -a.v[i] : a.v[i];
+			return r;
+#endif
+		}
+
+		/** Component-wise square root. */
+		static SIMDFloat4 sqrt(const SIMDFloat4& a)
+		{
+#if BS_SIMD == BS_SIMD_SSE
+			return _mm_sqrt_ps(a);
+#elif BS_SIMD == BS_SIMD_NEON
+			// No square root on ARMv7, refine the reciprocal square root estimate using two Newton-Raphson steps instead
+			float32x4_t rsqrt = vrsqrteq_f32(a);
+			rsqrt = vmulq_f32(vrsqrtsq_f32(vmulq_f32(a, rsqrt), rsqrt), rsqrt);
+			rsqrt = vmulq_f32(vrsqrtsq_f32(vmulq_f32(a, rsqrt), rsqrt), rsqrt);
+
+			// Estimate of zero is infinity, make sure the result for zero is zero
+			uint32x4_t isZero = vceqq_f32(a, vdupq_n_f32(0.0f));
+			float32x4_t r = vmulq_f32(a, rsqrt);
+			return vreinterpretq_f32_u32(vbicq_u32(vreinterpretq_u32_f32(r), isZero));
+#else
+			SIMDFloat4 r;
+			for (int i = 0; i < 4; i++) r.v[i] = std::sqrt(a.v[i]);
+			return r;
+#endif
+		}
+
+		/**
+		 * Compares @p a and @p b component-wise and returns a bitmask where bit N is set if component N of @p a is less
+		 * than component N of @p b.
+		 */
+		static UINT32 lessMask(const SIMDFloat4& a, const SIMDFloat4& b)
+		{
+#if BS_SIMD == BS_SIMD_SSE
+			return (UINT32)_mm_movemask_ps(_mm_cmplt_ps(a, b));
+#elif BS_SIMD == BS_SIMD_NEON
+			static const uint32_t weights[4] = { 1, 2, 4, 8 };
+
+			uint32x4_t bits = vandq_u32(vcltq_f32(a, b), vld1q_u32(weights));
+			uint32x2_t sum = vadd_u32(vget_low_u32(bits), vget_high_u32(bits));
+			return vget_lane_u32(vpadd_u32(sum, sum), 0);
+#else
+			UINT32 r = 0;
+			for (int i = 0; i < 4; i++)
+			{
+				if (a.v[i] < b.v[i])
+					r |= 1 << i;
+			}
+
+			return r;
+#endif
+		}
+
+		/** Rearranges the components of @p a, so that the output component N is equal to input component IN. */
+		template<int I0, int I1, int I2, int I3>
+		static SIMDFloat4 shuffle(const SIMDFloat4& a)
+		{
+#if BS_SIMD == BS_SIMD_SSE
+			return _mm_shuffle_ps(a, a, _MM_SHUFFLE(I3, I2, I1, I0));
+#elif BS_SIMD == BS_SIMD_NEON
+			float32x4_t r = vdupq_n_f32(vgetq_lane_f32(a, I0));
+			r = vsetq_lane_f32(vgetq_lane_f32(a, I1), r, 1);
+			r = vsetq_lane_f32(vgetq_lane_f32(a, I2), r, 2);
+			return vsetq_lane_f32(vgetq_lane_f32(a, I3), r, 3);
+#else
+			return set(a.v[I0], a.v[I1], a.v[I2], a.v[I3]);
+#endif
+		}
+
+		/** Returns a value with all four components set to component N of @p a. */
+		template<int N>
+		static SIMDFloat4 splat(const SIMDFloat4& a)
+		{
+			return shuffle<N, N, N, N>(a);
+		}
+
+		/** Transposes a 4x4 matrix whose rows (or columns) are stored in @p r0 - @p r3. */
+		static void transpose(SIMDFloat4& r0, SIMDFloat4& r1, SIMDFloat4& r2, SIMDFloat4& r3)
+		{
+#if BS_SIMD == BS_SIMD_SSE
+			_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+#elif BS_SIMD == BS_SIMD_NEON
+			float32x4x2_t t01 = vtrnq_f32(r0, r1);
+			float32x4x2_t t23 = vtrnq_f32(r2, r3);
+
+			r0 = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));
+			r1 = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));
+			r2 = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+			r3 = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+#else
+			std::swap(r0.v[1], r1.v[0]);
+			std::swap(r0.v[2], r2.v[0]);
+			std::swap(r0.v[3], r3.v[0]);
+			std::swap(r1.v[2], r2.v[1]);
+			std::swap(r1.v[3], r3.v[1]);
+			std::swap(r2.v[3], r3.v[2]);
+#endif
+		}
+
+		/**
+		 * Multiplies two row-major 4x4 matrices (@p out = @p a * @p b). @p out may point to the same memory as either of
+		 * the inputs.
+		 */
+		static void multiplyMatrix(const float* a, const float* b, float* out)
+		{
+			SIMDFloat4 b0 = load(b);
+			SIMDFloat4 b1 = load(b + 4);
+			SIMDFloat4 b2 = load(b + 8);
+			SIMDFloat4 b3 = load(b + 12);
+
+			SIMDFloat4 rows[4];
+			for (int i = 0; i < 4; i++)
+			{
+				const float* aRow = a + i * 4;
+
+				SIMDFloat4 row = mul(splat(aRow[0]), b0);
+				row = madd(row, splat(aRow[1]), b1);
+				row = madd(row, splat(aRow[2]), b2);
+				rows[i] = madd(row, splat(aRow[3]), b3);
+			}
+
+			for (int i = 0; i < 4; i++)
+				store(out + i * 4, rows[i]);
+		}
+
+		/**
+		 * Multiplies two row-major affine 4x4 matrices (@p out = @p a * @p b). The last row of the output is always
+		 * (0, 0, 0, 1). @p out may point to the same memory as either of the inputs.
+		 */
+		static void multiplyMatrixAffine(const float* a, const float* b, float* out)
+		{
+			SIMDFloat4 b0 = load(b);
+			SIMDFloat4 b1 = load(b + 4);
+			SIMDFloat4 b2 = load(b + 8);
+			SIMDFloat4 b3 = set(0.0f, 0.0f, 0.0f, 1.0f);
+
+			SIMDFloat4 rows[3];
+			for (int i = 0; i < 3; i++)
+			{
+				const float* aRow = a + i * 4;
+
+				SIMDFloat4 row = mul(splat(aRow[0]), b0);
+				row = madd(row, splat(aRow[1]), b1);
+				row = madd(row, splat(aRow[2]), b2);
+				rows[i] = madd(row, splat(aRow[3]), b3);
+			}
+
+			for (int i = 0; i < 3; i++)
+				store(out + i * 4, rows[i]);
+
+			store(out + 12, b3);
+		}
+	};
+
+	/** @} */
+}
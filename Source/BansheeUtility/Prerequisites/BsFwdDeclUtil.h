@@ -55,6 +55,7 @@ namespace bs
 	class Ray;
 	class Capsule;
 	class Sphere;
+	class ConvexVolume;
 	class Vector2;
 	class Vector3;
 	class Vector4;
@@ -119,6 +120,11 @@ namespace bs
 		TID_UnorderedSet = 66,
 		TID_SerializedDataBlock = 67,
 		TID_Flags = 68,
-		TID_IReflectable = 69
+		TID_IReflectable = 69,
+		TID_TestPlainObject = 70,
+		TID_TestLegacyPlainObject = 71,
+		TID_TestBoolArrayObject = 72,
+		TID_TestNode = 73,
+		TID_TestDerivedNode = 74
 	};
 }
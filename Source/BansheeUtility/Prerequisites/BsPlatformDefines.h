@@ -17,6 +17,10 @@
 #define BS_ARCHITECTURE_x86_32 1
 #define BS_ARCHITECTURE_x86_64 2
 
+#define BS_SIMD_SCALAR 0
+#define BS_SIMD_SSE 1
+#define BS_SIMD_NEON 2
+
 #define BS_ENDIAN_LITTLE 1
 #define BS_ENDIAN_BIG 2
 #define BS_ENDIAN BS_ENDIAN_LITTLE
@@ -70,6 +74,17 @@
 #	define BS_ARCH_TYPE BS_ARCHITECTURE_x86_32
 #endif
 
+// Find the available SIMD instruction set. Define BS_SIMD_DISABLED to force the scalar fallback.
+#if defined(BS_SIMD_DISABLED)
+#	define BS_SIMD BS_SIMD_SCALAR
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	define BS_SIMD BS_SIMD_SSE
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#	define BS_SIMD BS_SIMD_NEON
+#else
+#	define BS_SIMD BS_SIMD_SCALAR
+#endif
+
 // DLL export
 #if BS_PLATFORM == BS_PLATFORM_WIN32 // Windows
 #	if BS_COMPILER == BS_COMPILER_MSVC
@@ -46,6 +46,7 @@ namespace bs
 
 		enum { id = 0 /**< Unique id for the serializable type. */ };
 		enum { hasDynamicSize = 0 /**< 0 (Object has static size less than 255 bytes, for example int) or 1 (Dynamic size with no size restriction, for example string) */ };
+		enum { isMemcpy = 1 /**< Optional. 1 if the serialized form is an exact copy of the object's memory. See RTTIPlainMemcpy. */ };
 
 		/** Serializes the provided object into the provided pre-allocated memory buffer. */
 		static void toMemory(const T& data, char* memory)
@@ -70,6 +71,24 @@ namespace bs
 		}
 	};
 
+	/**
+	 * Determines if the serialized form of a plain type is an exact copy of its memory, in which case arrays of the type
+	 * can be serialized with a single memory copy. True for types using the default RTTIPlainType or 
+	 * BS_ALLOW_MEMCPY_SERIALIZATION, and for any RTTIPlainType specialization that sets isMemcpy to 1.
+	 */
+	template<class T, class Enable = void>
+	struct RTTIPlainMemcpy
+	{
+		enum { value = 0 };
+	};
+
+	/** @copydoc RTTIPlainMemcpy */
+	template<class T>
+	struct RTTIPlainMemcpy<T, typename std::enable_if<RTTIPlainType<T>::isMemcpy != 0>::type>
+	{
+		enum { value = 1 };
+	};
+
 	/**
 	 * Helper method when serializing known data types that have valid
 	 * RTTIPlainType specialization.
@@ -165,6 +184,7 @@ namespace bs
 #define BS_ALLOW_MEMCPY_SERIALIZATION(type)					\
 	template<> struct RTTIPlainType<type>					\
 	{	enum { id=0 }; enum { hasDynamicSize = 0 };			\
+	enum { isMemcpy = 1 };									\
 	static void toMemory(const type& data, char* memory)	\
 	{ memcpy(memory, &data, sizeof(type)); }				\
 	static UINT32 fromMemory(type& data, char* memory)		\
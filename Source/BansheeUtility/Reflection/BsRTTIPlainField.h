@@ -94,6 +94,15 @@ namespace bs
 		 * location and contains the proper type.
 		 */
 		virtual void arrayElemFromBuffer(void* object, int index, void* buffer) = 0;
+
+		/**
+		 * Returns a pointer to contiguous storage of all the array elements, if the array can be serialized by copying its
+		 * memory directly. Returns null if elements must be serialized one by one.
+		 */
+		virtual UINT8* getArrayData(void* object)
+		{
+			return nullptr;
+		}
 	};
 
 	/** Represents a plain class field containing a specific type. */
@@ -173,8 +182,8 @@ namespace bs
 
 			ObjectType* castObject = static_cast<ObjectType*>(object);
 
-			std::function<DataType&(ObjectType*)> f = any_cast<std::function<DataType&(ObjectType*)>>(valueGetter);
-			DataType value = f(castObject);
+			const std::function<DataType&(ObjectType*)>& f = any_cast_ref<std::function<DataType&(ObjectType*)>>(valueGetter);
+			const DataType& value = f(castObject);
 
 			return RTTIPlainType<DataType>::getDynamicSize(value);
 		}
@@ -187,8 +196,8 @@ namespace bs
 
 			ObjectType* castObject = static_cast<ObjectType*>(object);
 
-			std::function<DataType&(ObjectType*, UINT32)> f = any_cast<std::function<DataType&(ObjectType*, UINT32)>>(valueGetter);
-			DataType value = f(castObject, index);
+			const std::function<DataType&(ObjectType*, UINT32)>& f = any_cast_ref<std::function<DataType&(ObjectType*, UINT32)>>(valueGetter);
+			const DataType& value = f(castObject, index);
 
 			return RTTIPlainType<DataType>::getDynamicSize(value);
 		}
@@ -198,7 +207,7 @@ namespace bs
 		{
 			checkIsArray(true);
 
-			std::function<UINT32(ObjectType*)> f = any_cast<std::function<UINT32(ObjectType*)>>(arraySizeGetter);
+			const std::function<UINT32(ObjectType*)>& f = any_cast_ref<std::function<UINT32(ObjectType*)>>(arraySizeGetter);
 			ObjectType* castObject = static_cast<ObjectType*>(object);
 			return f(castObject);
 		}
@@ -213,7 +222,7 @@ namespace bs
 				BS_EXCEPT(InternalErrorException, "Specified field (" + mName + ") has no array size setter.");
 			}
 
-			std::function<void(ObjectType*, UINT32)> f = any_cast<std::function<void(ObjectType*, UINT32)>>(arraySizeSetter);
+			const std::function<void(ObjectType*, UINT32)>& f = any_cast_ref<std::function<void(ObjectType*, UINT32)>>(arraySizeSetter);
 			ObjectType* castObject = static_cast<ObjectType*>(object);
 			f(castObject, size);
 		}
@@ -226,8 +235,8 @@ namespace bs
 
 			ObjectType* castObject = static_cast<ObjectType*>(object);
 
-			std::function<DataType&(ObjectType*)> f = any_cast<std::function<DataType&(ObjectType*)>>(valueGetter);
-			DataType value = f(castObject);
+			const std::function<DataType&(ObjectType*)>& f = any_cast_ref<std::function<DataType&(ObjectType*)>>(valueGetter);
+			const DataType& value = f(castObject);
 
 			RTTIPlainType<DataType>::toMemory(value, (char*)buffer);
 		}
@@ -240,8 +249,8 @@ namespace bs
 
 			ObjectType* castObject = static_cast<ObjectType*>(object);
 
-			std::function<DataType&(ObjectType*, UINT32)> f = any_cast<std::function<DataType&(ObjectType*, UINT32)>>(valueGetter);
-			DataType value = f(castObject, index);
+			const std::function<DataType&(ObjectType*, UINT32)>& f = any_cast_ref<std::function<DataType&(ObjectType*, UINT32)>>(valueGetter);
+			const DataType& value = f(castObject, index);
 
 			RTTIPlainType<DataType>::toMemory(value, (char*)buffer);
 		}
@@ -263,7 +272,7 @@ namespace bs
 					"Specified field (" + mName + ") has no setter.");
 			}
 
-			std::function<void(ObjectType*, DataType&)> f = any_cast<std::function<void(ObjectType*, DataType&)>>(valueSetter);
+			const std::function<void(ObjectType*, DataType&)>& f = any_cast_ref<std::function<void(ObjectType*, DataType&)>>(valueSetter);
 			f(castObject, value);
 		}
 
@@ -284,11 +293,223 @@ namespace bs
 					"Specified field (" + mName + ") has no setter.");
 			}
 
-			std::function<void(ObjectType*, UINT32, DataType&)> f = any_cast<std::function<void(ObjectType*, UINT32, DataType&)>>(valueSetter);
+			const std::function<void(ObjectType*, UINT32, DataType&)>& f = any_cast_ref<std::function<void(ObjectType*, UINT32, DataType&)>>(valueSetter);
 			f(castObject, index, value);
 		}
 	};
 
+	/** Provides access to the contiguous element storage of a container, if its elements can be copied in bulk. */
+	template<class Container, class Enable = void>
+	struct RTTIArrayStorage
+	{
+		static UINT8* getData(Container& container) { return nullptr; }
+	};
+
+	/** @copydoc RTTIArrayStorage */
+	template<class T, class Alloc>
+	struct RTTIArrayStorage<std::vector<T, Alloc>, 
+		typename std::enable_if<RTTIPlainMemcpy<T>::value != 0 && !std::is_same<T, bool>::value>::type>
+	{
+		static UINT8* getData(std::vector<T, Alloc>& container) { return (UINT8*)container.data(); }
+	};
+
+	/**
+	 * Plain class field that accesses a member variable through an accessor function resolved at compile time, rather 
+	 * than through type-erased getter/setter callbacks. The accessor returns a reference to the member.
+	 */
+	template <class ObjectType, class DataType, DataType& (*Accessor)(ObjectType*)>
+	struct RTTIPlainMemberField : public RTTIPlainFieldBase
+	{
+		/**
+		 * Initializes the field.
+		 *
+		 * @param[in]	name		Name of the field.
+		 * @param[in]	uniqueId	Unique identifier for this field. See RTTIPlainField::initSingle.
+		 * @param[in]	flags		Various flags you can use to specialize how outside systems handle this field. See "RTTIFieldFlag".
+		 */
+		void init(const String& name, UINT16 uniqueId, UINT64 flags)
+		{
+			static_assert(sizeof(RTTIPlainType<DataType>::id) > 0, "Type has no RTTI ID."); // Just making sure provided type has a type ID
+
+			static_assert((RTTIPlainType<DataType>::hasDynamicSize != 0 || (sizeof(DataType) <= 255)), 
+				"Trying to create a plain RTTI field with size larger than 255. In order to use larger sizes for plain types please specialize " \
+				" RTTIPlainType, set hasDynamicSize to true.");
+
+			initAll(Any(), Any(), Any(), Any(), name, uniqueId, false, SerializableFT_Plain, flags);
+		}
+
+		/** @copydoc RTTIField::getTypeSize */
+		UINT32 getTypeSize() override { return sizeof(DataType); }
+
+		/** @copydoc RTTIPlainFieldBase::getTypeId */
+		UINT32 getTypeId() override { return RTTIPlainType<DataType>::id; }
+
+		/** @copydoc RTTIPlainFieldBase::hasDynamicSize */
+		bool hasDynamicSize() override { return RTTIPlainType<DataType>::hasDynamicSize != 0; }
+
+		/** @copydoc RTTIPlainFieldBase::getDynamicSize */
+		UINT32 getDynamicSize(void* object) override
+		{
+			return RTTIPlainType<DataType>::getDynamicSize(getMember(object));
+		}
+
+		/** @copydoc RTTIPlainFieldBase::getArrayElemDynamicSize */
+		UINT32 getArrayElemDynamicSize(void* object, int index) override
+		{
+			checkIsArray(true);
+			return 0;
+		}
+
+		/** @copydoc RTTIField::getArraySize */
+		UINT32 getArraySize(void* object) override
+		{
+			checkIsArray(true);
+			return 0;
+		}
+
+		/** @copydoc RTTIField::setArraySize */
+		void setArraySize(void* object, UINT32 size) override
+		{
+			checkIsArray(true);
+		}
+
+		/** @copydoc RTTIPlainFieldBase::toBuffer */
+		void toBuffer(void* object, void* buffer) override
+		{
+			RTTIPlainType<DataType>::toMemory(getMember(object), (char*)buffer);
+		}
+
+		/** @copydoc RTTIPlainFieldBase::arrayElemToBuffer */
+		void arrayElemToBuffer(void* object, int index, void* buffer) override
+		{
+			checkIsArray(true);
+		}
+
+		/** @copydoc RTTIPlainFieldBase::fromBuffer */
+		void fromBuffer(void* object, void* buffer) override
+		{
+			// Decode into a new value, as some types (e.g. containers) append to the existing contents
+			DataType value;
+			RTTIPlainType<DataType>::fromMemory(value, (char*)buffer);
+
+			getMember(object) = std::move(value);
+		}
+
+		/** @copydoc RTTIPlainFieldBase::arrayElemFromBuffer */
+		void arrayElemFromBuffer(void* object, int index, void* buffer) override
+		{
+			checkIsArray(true);
+		}
+
+	private:
+		/** Returns the member variable this field references. */
+		static DataType& getMember(void* object)
+		{
+			return Accessor(static_cast<ObjectType*>(object));
+		}
+	};
+
+	/**
+	 * Plain class field containing multiple values in a container, accessing the container member variable through an
+	 * accessor function resolved at compile time. The container must provide size(), resize() and operator[]. If the 
+	 * container is a vector of types serializable with memcpy, the whole array is copied at once.
+	 */
+	template <class ObjectType, class ContainerType, ContainerType& (*Accessor)(ObjectType*)>
+	struct RTTIPlainMemberArrayField : public RTTIPlainFieldBase
+	{
+		typedef typename ContainerType::value_type DataType;
+
+		/**
+		 * Initializes the field.
+		 *
+		 * @param[in]	name		Name of the field.
+		 * @param[in]	uniqueId	Unique identifier for this field. See RTTIPlainField::initArray.
+		 * @param[in]	flags		Various flags you can use to specialize how outside systems handle this field. See "RTTIFieldFlag".
+		 */
+		void init(const String& name, UINT16 uniqueId, UINT64 flags)
+		{
+			static_assert((RTTIPlainType<DataType>::hasDynamicSize != 0 || (sizeof(DataType) <= 255)), 
+				"Trying to create a plain RTTI field with size larger than 255. In order to use larger sizes for plain types please specialize " \
+				" RTTIPlainType, set hasDynamicSize to true.");
+
+			initAll(Any(), Any(), Any(), Any(), name, uniqueId, true, SerializableFT_Plain, flags);
+		}
+
+		/** @copydoc RTTIField::getTypeSize */
+		UINT32 getTypeSize() override { return sizeof(DataType); }
+
+		/** @copydoc RTTIPlainFieldBase::getTypeId */
+		UINT32 getTypeId() override { return RTTIPlainType<DataType>::id; }
+
+		/** @copydoc RTTIPlainFieldBase::hasDynamicSize */
+		bool hasDynamicSize() override { return RTTIPlainType<DataType>::hasDynamicSize != 0; }
+
+		/** @copydoc RTTIPlainFieldBase::getDynamicSize */
+		UINT32 getDynamicSize(void* object) override
+		{
+			checkIsArray(false);
+			return 0;
+		}
+
+		/** @copydoc RTTIPlainFieldBase::getArrayElemDynamicSize */
+		UINT32 getArrayElemDynamicSize(void* object, int index) override
+		{
+			return RTTIPlainType<DataType>::getDynamicSize(getContainer(object)[index]);
+		}
+
+		/** @copydoc RTTIField::getArraySize */
+		UINT32 getArraySize(void* object) override
+		{
+			return (UINT32)getContainer(object).size();
+		}
+
+		/** @copydoc RTTIField::setArraySize */
+		void setArraySize(void* object, UINT32 size) override
+		{
+			getContainer(object).resize(size);
+		}
+
+		/** @copydoc RTTIPlainFieldBase::toBuffer */
+		void toBuffer(void* object, void* buffer) override
+		{
+			checkIsArray(false);
+		}
+
+		/** @copydoc RTTIPlainFieldBase::arrayElemToBuffer */
+		void arrayElemToBuffer(void* object, int index, void* buffer) override
+		{
+			RTTIPlainType<DataType>::toMemory(getContainer(object)[index], (char*)buffer);
+		}
+
+		/** @copydoc RTTIPlainFieldBase::fromBuffer */
+		void fromBuffer(void* object, void* buffer) override
+		{
+			checkIsArray(false);
+		}
+
+		/** @copydoc RTTIPlainFieldBase::arrayElemFromBuffer */
+		void arrayElemFromBuffer(void* object, int index, void* buffer) override
+		{
+			DataType value;
+			RTTIPlainType<DataType>::fromMemory(value, (char*)buffer);
+
+			getContainer(object)[index] = std::move(value);
+		}
+
+		/** @copydoc RTTIPlainFieldBase::getArrayData */
+		UINT8* getArrayData(void* object) override
+		{
+			return RTTIArrayStorage<ContainerType>::getData(getContainer(object));
+		}
+
+	private:
+		/** Returns the container member variable this field references. */
+		static ContainerType& getContainer(void* object)
+		{
+			return Accessor(static_cast<ObjectType*>(object));
+		}
+	};
+
 	/** @} */
 	/** @} */
-}
\ No newline at end of file
+}
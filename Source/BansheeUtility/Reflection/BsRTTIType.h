@@ -38,13 +38,12 @@ namespace bs
 #define BS_RTTI_MEMBER_PLAIN(name, id)															\
 	META_Entry_##name;																			\
 																								\
-	decltype(OwnerType::name)& get##name(OwnerType* obj) { return obj->name; }					\
-	void set##name(OwnerType* obj, decltype(OwnerType::name)& val) { obj->name = val; }			\
+	static decltype(OwnerType::name)& get##name(OwnerType* obj) { return obj->name; }			\
 																								\
 	struct META_NextEntry_##name{};																\
 	void META_InitPrevEntry(META_NextEntry_##name typeId)										\
 	{																							\
-		addPlainField(#name, id, &MyType::get##name, &MyType::set##name);						\
+		addPlainMemberField<decltype(OwnerType::name), &MyType::get##name>(#name, id);			\
 		META_InitPrevEntry(META_Entry_##name());												\
 	}																							\
 																								\
@@ -54,13 +53,12 @@ namespace bs
 #define BS_RTTI_MEMBER_PLAIN_NAMED(name, field, id)												\
 	META_Entry_##name;																			\
 																								\
-	decltype(OwnerType::field)& get##name(OwnerType* obj) { return obj->field; }				\
-	void set##name(OwnerType* obj, decltype(OwnerType::field)& val) { obj->field = val; }		\
+	static std::remove_reference<decltype(OwnerType::field)>::type& get##name(OwnerType* obj) { return obj->field; }	\
 																								\
 	struct META_NextEntry_##name{};																\
 	void META_InitPrevEntry(META_NextEntry_##name typeId)										\
 	{																							\
-		addPlainField(#name, id, &MyType::get##name, &MyType::set##name);						\
+		addPlainMemberField<std::remove_reference<decltype(OwnerType::field)>::type, &MyType::get##name>(#name, id);	\
 		META_InitPrevEntry(META_Entry_##name());												\
 	}																							\
 																								\
@@ -73,15 +71,12 @@ namespace bs
 #define BS_RTTI_MEMBER_PLAIN_ARRAY(name, id)													\
 	META_Entry_##name;																			\
 																								\
-	std::common_type<decltype(OwnerType::name)>::type::value_type& get##name(OwnerType* obj, UINT32 idx) { return obj->name[idx]; }					\
-	void set##name(OwnerType* obj, UINT32 idx, std::common_type<decltype(OwnerType::name)>::type::value_type& val) { obj->name[idx] = val; }		\
-	UINT32 getSize##name(OwnerType* obj) { return (UINT32)obj->name.size(); }																		\
-	void setSize##name(OwnerType* obj, UINT32 val) { obj->name.resize(val); }																		\
+	static decltype(OwnerType::name)& get##name(OwnerType* obj) { return obj->name; }			\
 																								\
 	struct META_NextEntry_##name{};																\
 	void META_InitPrevEntry(META_NextEntry_##name typeId)										\
 	{																							\
-		addPlainArrayField(#name, id, &MyType::get##name, &MyType::getSize##name, &MyType::set##name, &MyType::setSize##name);						\
+		addPlainMemberArrayField<decltype(OwnerType::name), &MyType::get##name>(#name, id);		\
 		META_InitPrevEntry(META_Entry_##name());												\
 	}																							\
 																								\
@@ -93,15 +88,12 @@ namespace bs
 #define BS_RTTI_MEMBER_PLAIN_ARRAY_NAMED(name, field, id)													\
 	META_Entry_##name;																			\
 																								\
-	std::common_type<decltype(OwnerType::field)>::type::value_type& get##name(OwnerType* obj, UINT32 idx) { return obj->field[idx]; }					\
-	void set##name(OwnerType* obj, UINT32 idx, std::common_type<decltype(OwnerType::field)>::type::value_type& val) { obj->field[idx] = val; }		\
-	UINT32 getSize##name(OwnerType* obj) { return (UINT32)obj->field.size(); }																		\
-	void setSize##name(OwnerType* obj, UINT32 val) { obj->field.resize(val); }																		\
+	static std::remove_reference<decltype(OwnerType::field)>::type& get##name(OwnerType* obj) { return obj->field; }	\
 																								\
 	struct META_NextEntry_##name{};																\
 	void META_InitPrevEntry(META_NextEntry_##name typeId)										\
 	{																							\
-		addPlainArrayField(#name, id, &MyType::get##name, &MyType::getSize##name, &MyType::set##name, &MyType::setSize##name);						\
+		addPlainMemberArrayField<std::remove_reference<decltype(OwnerType::field)>::type, &MyType::get##name>(#name, id);	\
 		META_InitPrevEntry(META_Entry_##name());												\
 	}																							\
 																								\
@@ -1121,6 +1113,53 @@ namespace bs
 				std::function<void(ObjectType*, const SPtr<DataStream>&, UINT32)>(std::bind(setter, static_cast<InterfaceType*>(this), _1, _2, _3)), flags);
 		}	
 
+		/**
+		 * Registers a new plain field referencing a member variable of the owner type. The member is accessed through an
+		 * accessor resolved at compile time, rather than through type-erased getter and setter methods.
+		 *
+		 * @tparam		DataType		Type of the member variable.
+		 * @tparam		Accessor		Function returning a reference to the member variable of the provided object.
+		 * @param[in]	name			Name of the field.
+		 * @param[in]	uniqueId		Unique identifier for this field. See addPlainField().
+		 * @param[in]	flags			Various flags you can use to specialize how systems handle this field. See RTTIFieldFlag.
+		 */
+		template<class DataType, DataType& (*Accessor)(Type*)>
+		void addPlainMemberField(const String& name, UINT32 uniqueId, UINT64 flags = 0)
+		{
+			static_assert(!(std::is_base_of<bs::IReflectable, DataType>::value), 
+				"Data type derives from IReflectable but it is being added as a plain field.");
+
+			typedef RTTIPlainMemberField<Type, DataType, Accessor> FieldType;
+
+			FieldType* newField = bs_new<FieldType>();
+			newField->init(name, uniqueId, flags);
+			addNewField(newField);
+		}
+
+		/**
+		 * Registers a new plain array field referencing a container member variable of the owner type. The member is 
+		 * accessed through an accessor resolved at compile time, rather than through type-erased getter and setter 
+		 * methods, and arrays of types serializable with a memcpy are serialized in bulk.
+		 *
+		 * @tparam		ContainerType	Type of the container member variable.
+		 * @tparam		Accessor		Function returning a reference to the member variable of the provided object.
+		 * @param[in]	name			Name of the field.
+		 * @param[in]	uniqueId		Unique identifier for this field. See addPlainField().
+		 * @param[in]	flags			Various flags you can use to specialize how systems handle this field. See RTTIFieldFlag.
+		 */
+		template<class ContainerType, ContainerType& (*Accessor)(Type*)>
+		void addPlainMemberArrayField(const String& name, UINT32 uniqueId, UINT64 flags = 0)
+		{
+			static_assert(!(std::is_base_of<bs::IReflectable, typename ContainerType::value_type>::value), 
+				"Data type derives from IReflectable but it is being added as a plain field.");
+
+			typedef RTTIPlainMemberArrayField<Type, ContainerType, Accessor> FieldType;
+
+			FieldType* newField = bs_new<FieldType>();
+			newField->init(name, uniqueId, flags);
+			addNewField(newField);
+		}
+
 	private:
 		template<class ObjectType, class DataType>
 		void addPlainField(const String& name, UINT32 uniqueId, Any getter, Any setter, UINT64 flags)
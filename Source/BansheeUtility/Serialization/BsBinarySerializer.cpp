@@ -13,6 +13,7 @@
 #include "Reflection/BsRTTIManagedDataBlockField.h"
 #include "Serialization/BsMemorySerializer.h"
 #include "FileSystem/BsDataStream.h"
+#include "Allocators/BsFrameAlloc.h"
 
 #include <unordered_set>
 
@@ -41,7 +42,7 @@ buffer += size;															\
 namespace bs
 {
 	BinarySerializer::BinarySerializer()
-		:mLastUsedObjectId(1)
+		:mLastUsedObjectId(1), mIndexedEnd(0), mDecodeAlloc(nullptr)
 	{
 	}
 
@@ -129,11 +130,88 @@ namespace bs
 		if (dataLength == 0)
 			return nullptr;
 
-		SPtr<SerializedObject> intermediateObject = _decodeToIntermediate(data, dataLength);
-		if (intermediateObject == nullptr)
-			return nullptr;
+		UINT32 dataStart = (UINT32)data->tell();
+		UINT32 dataEnd = dataStart + dataLength;
+
+		mStreamObjects.clear();
+		mStreamObjectIds.clear();
+		mStreamSubObjects.clear();
+		mIndexedEnd = dataStart;
+
+		// Memory stream field data can be referenced directly, otherwise it needs to be read into temporary buffers
+		UPtr<FrameAlloc> decodeAlloc = bs_unique_ptr<FrameAlloc>(nullptr);
+		if (data->isFile())
+			decodeAlloc = bs_unique_ptr_new<FrameAlloc>(DECODE_ALLOC_BLOCK_SIZE);
+
+		mDecodeAlloc = decodeAlloc.get();
+
+		ObjectMetaData objectMetaData;
+		objectMetaData.objectMeta = 0;
+		objectMetaData.typeId = 0;
+
+		if (data->read(&objectMetaData, sizeof(ObjectMetaData)) != sizeof(ObjectMetaData))
+		{
+			BS_EXCEPT(InternalErrorException, "Error decoding data.");
+		}
+
+		data->seek(dataStart);
+
+		UINT32 objectId = 0;
+		UINT32 objectTypeId = 0;
+		bool objectIsBaseClass = false;
+		decodeObjectMetaData(objectMetaData, objectId, objectTypeId, objectIsBaseClass);
+
+		if (objectIsBaseClass)
+		{
+			BS_EXCEPT(InternalErrorException, "Encountered a base-class object while looking for a new object. " \
+				"Base class objects are only supposed to be parts of a larger object.");
+		}
+
+		SPtr<IReflectable> output;
+		RTTITypeBase* type = IReflectable::_getRTTIfromTypeId(objectTypeId);
+		if (type != nullptr)
+		{
+			output = type->newRTTIObject();
 
-		return _decodeFromIntermediate(intermediateObject);
+			INT32 rootIdx = -1;
+			if (objectId > 0)
+			{
+				rootIdx = (INT32)mStreamObjects.size();
+				mStreamObjectIds[objectId] = (UINT32)rootIdx;
+				mStreamObjects.push_back({ dataStart, objectTypeId, output, false, true });
+			}
+
+			decodeObject(data, dataEnd, output);
+
+			if (rootIdx != -1)
+			{
+				mStreamObjects[rootIdx].decodeInProgress = false;
+				mStreamObjects[rootIdx].isDecoded = true;
+			}
+
+			// Go through the remaining objects (should be only ones with weak refs)
+			for (UINT32 i = 0; i < (UINT32)mStreamObjects.size(); i++)
+			{
+				if (mStreamObjects[i].object == nullptr || mStreamObjects[i].isDecoded)
+					continue;
+
+				SPtr<IReflectable> object = mStreamObjects[i].object;
+				mStreamObjects[i].decodeInProgress = true;
+
+				data->seek(mStreamObjects[i].offset);
+				decodeObject(data, dataEnd, object);
+
+				mStreamObjects[i].decodeInProgress = false;
+				mStreamObjects[i].isDecoded = true;
+			}
+		}
+
+		mStreamObjects.clear();
+		mStreamObjectIds.clear();
+		mDecodeAlloc = nullptr;
+
+		data->seek(dataEnd);
+		return output;
 	}
 
 	SPtr<IReflectable> BinarySerializer::_decodeFromIntermediate(const SPtr<SerializedObject>& serializedObject)
@@ -289,6 +367,26 @@ namespace bs
 						{
 							RTTIPlainFieldBase* curField = static_cast<RTTIPlainFieldBase*>(curGenericField);
 
+							// Arrays that can be copied directly are written in one go
+							UINT8* arrayData = nullptr;
+							if (arrayNumElems > 0 && !curField->hasDynamicSize())
+								arrayData = curField->getArrayData(object);
+
+							if (arrayData != nullptr)
+							{
+								UINT32 arraySize = arrayNumElems * curField->getTypeSize();
+								buffer = dataBlockToBuffer(arrayData, arraySize, buffer, bufferLength, bytesWritten, 
+									flushBufferCallback);
+
+								if (buffer == nullptr || bufferLength == 0)
+								{
+									si->onSerializationEnded(object, mParams);
+									return nullptr;
+								}
+
+								break;
+							}
+
 							for(UINT32 arrIdx = 0; arrIdx < arrayNumElems; arrIdx++)
 							{
 								UINT32 typeSize = 0;
@@ -1202,6 +1300,525 @@ namespace bs
 		return ((encodedData & 0x01) != 0);
 	}
 
+	void BinarySerializer::decodeObject(const SPtr<DataStream>& data, UINT32 dataEnd, const SPtr<IReflectable>& object)
+	{
+		// Sub-objects are stored starting with the most derived class, but need to be decoded starting with the base
+		// class, so find where each of them starts first
+		UINT32 firstSubObject = (UINT32)mStreamSubObjects.size();
+		skipObject(data, dataEnd, true);
+
+		UINT32 lastSubObject = (UINT32)mStreamSubObjects.size();
+		UINT32 objectEnd = (UINT32)data->tell();
+
+		RTTITypeBase* rtti = nullptr;
+		for (UINT32 i = firstSubObject; i < lastSubObject; i++)
+		{
+			StreamSubObject& subObject = mStreamSubObjects[i];
+			if (i == firstSubObject)
+				rtti = IReflectable::_getRTTIfromTypeId(subObject.typeId);
+			else
+			{
+				if (rtti != nullptr)
+					rtti = rtti->getBaseClass();
+
+				// Saved and current base classes don't match, so just skip over all that data
+				if (rtti != nullptr && rtti->getRTTIId() != subObject.typeId)
+					rtti = nullptr;
+			}
+
+			subObject.rtti = rtti;
+		}
+
+		for (INT32 i = (INT32)lastSubObject - 1; i >= (INT32)firstSubObject; i--)
+		{
+			// Note: Not keeping a reference as decoding fields can add new entries to mStreamSubObjects
+			RTTITypeBase* subObjectRtti = mStreamSubObjects[i].rtti;
+			if (subObjectRtti == nullptr)
+				continue;
+
+			subObjectRtti->onDeserializationStarted(object.get(), mParams);
+
+			if (mDecodeAlloc != nullptr)
+				mDecodeAlloc->markFrame();
+
+			data->seek(mStreamSubObjects[i].offset);
+			decodeFields(data, dataEnd, object.get(), subObjectRtti);
+
+			if (mDecodeAlloc != nullptr)
+				mDecodeAlloc->clear();
+		}
+
+		for (INT32 i = (INT32)lastSubObject - 1; i >= (INT32)firstSubObject; i--)
+		{
+			RTTITypeBase* subObjectRtti = mStreamSubObjects[i].rtti;
+			if (subObjectRtti != nullptr)
+				subObjectRtti->onDeserializationEnded(object.get(), mParams);
+		}
+
+		mStreamSubObjects.resize(firstSubObject);
+		data->seek(objectEnd);
+	}
+
+	bool BinarySerializer::decodeFields(const SPtr<DataStream>& data, UINT32 dataEnd, IReflectable* object, 
+		RTTITypeBase* rtti)
+	{
+		while ((UINT32)data->tell() < dataEnd)
+		{
+			UINT32 metaData = 0;
+			if (data->read(&metaData, META_SIZE) != META_SIZE)
+			{
+				BS_EXCEPT(InternalErrorException, "Error decoding data.");
+			}
+
+			// We've reached a new object or a base class of the current one
+			if (isObjectMetaData(metaData))
+			{
+				data->seek(data->tell() - META_SIZE);
+				return false;
+			}
+
+			bool isArray;
+			SerializableFieldType fieldType;
+			UINT16 fieldId;
+			UINT8 fieldSize;
+			bool hasDynamicSize;
+			bool terminator;
+			decodeFieldMetaData(metaData, fieldId, fieldSize, isArray, fieldType, hasDynamicSize, terminator);
+
+			if (terminator)
+				return true;
+
+			RTTIField* curGenericField = nullptr;
+
+			if (rtti != nullptr)
+				curGenericField = rtti->findField(fieldId);
+
+			if (curGenericField != nullptr)
+			{
+				if (!hasDynamicSize && curGenericField->getTypeSize() != fieldSize)
+				{
+					BS_EXCEPT(InternalErrorException,
+						"Data type mismatch. Type size stored in file and actual type size don't match. ("
+						+ toString(curGenericField->getTypeSize()) + " vs. " + toString(fieldSize) + ")");
+				}
+
+				if (curGenericField->mIsVectorType != isArray)
+				{
+					BS_EXCEPT(InternalErrorException,
+						"Data type mismatch. One is array, other is a single type.");
+				}
+
+				if (curGenericField->mType != fieldType)
+				{
+					BS_EXCEPT(InternalErrorException,
+						"Data type mismatch. Field types don't match. " + toString(UINT32(curGenericField->mType)) + " vs. " + toString(UINT32(fieldType)));
+				}
+			}
+
+			if (isArray)
+			{
+				UINT32 arrayNumElems = 0;
+				if (data->read(&arrayNumElems, NUM_ELEM_FIELD_SIZE) != NUM_ELEM_FIELD_SIZE)
+				{
+					BS_EXCEPT(InternalErrorException, "Error decoding data.");
+				}
+
+				if (curGenericField != nullptr)
+					curGenericField->setArraySize(object, arrayNumElems);
+
+				switch (fieldType)
+				{
+				case SerializableFT_ReflectablePtr:
+				{
+					RTTIReflectablePtrFieldBase* curField = static_cast<RTTIReflectablePtrFieldBase*>(curGenericField);
+
+					for (UINT32 i = 0; i < arrayNumElems; i++)
+					{
+						UINT32 childObjectId = 0;
+						if (data->read(&childObjectId, COMPLEX_TYPE_FIELD_SIZE) != COMPLEX_TYPE_FIELD_SIZE)
+						{
+							BS_EXCEPT(InternalErrorException, "Error decoding data.");
+						}
+
+						if (curField != nullptr)
+						{
+							bool weakRef = (curField->getFlags() & RTTI_Flag_WeakRef) != 0;
+							curField->setArrayValue(object, i, decodeReferencedObject(data, dataEnd, childObjectId, weakRef));
+						}
+					}
+
+					break;
+				}
+				case SerializableFT_Reflectable:
+				{
+					RTTIReflectableFieldBase* curField = static_cast<RTTIReflectableFieldBase*>(curGenericField);
+
+					for (UINT32 i = 0; i < arrayNumElems; i++)
+					{
+						if (curField != nullptr)
+						{
+							SPtr<IReflectable> childObject = decodeEmbeddedObject(data, dataEnd);
+							if (childObject != nullptr)
+								curField->setArrayValue(object, i, *childObject);
+						}
+						else
+							skipObject(data, dataEnd, false);
+					}
+
+					break;
+				}
+				case SerializableFT_Plain:
+				{
+					RTTIPlainFieldBase* curField = static_cast<RTTIPlainFieldBase*>(curGenericField);
+
+					// Arrays of memcpy-able types stored in contiguous memory can be read all at once
+					UINT8* arrayData = nullptr;
+					if (curField != nullptr && !hasDynamicSize && arrayNumElems > 0)
+						arrayData = curField->getArrayData(object);
+
+					if (arrayData != nullptr)
+					{
+						UINT32 arraySize = arrayNumElems * fieldSize;
+						if (data->read(arrayData, arraySize) != arraySize)
+						{
+							BS_EXCEPT(InternalErrorException, "Error decoding data.");
+						}
+
+						break;
+					}
+
+					for (UINT32 i = 0; i < arrayNumElems; i++)
+					{
+						UINT32 typeSize = fieldSize;
+						if (hasDynamicSize)
+						{
+							data->read(&typeSize, sizeof(UINT32));
+							data->seek(data->tell() - sizeof(UINT32));
+						}
+
+						if (curField != nullptr)
+						{
+							UINT8* fieldData = readFieldData(data, typeSize);
+							curField->arrayElemFromBuffer(object, i, fieldData);
+							freeFieldData(fieldData);
+						}
+						else
+							data->skip(typeSize);
+					}
+
+					break;
+				}
+				default:
+					BS_EXCEPT(InternalErrorException,
+						"Error decoding data. Encountered a type I don't know how to decode. Type: " + toString(UINT32(fieldType)) +
+						", Is array: " + toString(isArray));
+				}
+			}
+			else
+			{
+				switch (fieldType)
+				{
+				case SerializableFT_ReflectablePtr:
+				{
+					RTTIReflectablePtrFieldBase* curField = static_cast<RTTIReflectablePtrFieldBase*>(curGenericField);
+
+					UINT32 childObjectId = 0;
+					if (data->read(&childObjectId, COMPLEX_TYPE_FIELD_SIZE) != COMPLEX_TYPE_FIELD_SIZE)
+					{
+						BS_EXCEPT(InternalErrorException, "Error decoding data.");
+					}
+
+					if (curField != nullptr)
+					{
+						bool weakRef = (curField->getFlags() & RTTI_Flag_WeakRef) != 0;
+						curField->setValue(object, decodeReferencedObject(data, dataEnd, childObjectId, weakRef));
+					}
+
+					break;
+				}
+				case SerializableFT_Reflectable:
+				{
+					RTTIReflectableFieldBase* curField = static_cast<RTTIReflectableFieldBase*>(curGenericField);
+
+					if (curField != nullptr)
+					{
+						SPtr<IReflectable> childObject = decodeEmbeddedObject(data, dataEnd);
+						if (childObject != nullptr)
+							curField->setValue(object, *childObject);
+					}
+					else
+						skipObject(data, dataEnd, false);
+
+					break;
+				}
+				case SerializableFT_Plain:
+				{
+					RTTIPlainFieldBase* curField = static_cast<RTTIPlainFieldBase*>(curGenericField);
+
+					UINT32 typeSize = fieldSize;
+					if (hasDynamicSize)
+					{
+						data->read(&typeSize, sizeof(UINT32));
+						data->seek(data->tell() - sizeof(UINT32));
+					}
+
+					if (curField != nullptr)
+					{
+						UINT8* fieldData = readFieldData(data, typeSize);
+						curField->fromBuffer(object, fieldData);
+						freeFieldData(fieldData);
+					}
+					else
+						data->skip(typeSize);
+
+					break;
+				}
+				case SerializableFT_DataBlock:
+				{
+					RTTIManagedDataBlockFieldBase* curField = static_cast<RTTIManagedDataBlockFieldBase*>(curGenericField);
+
+					UINT32 dataBlockSize = 0;
+					if (data->read(&dataBlockSize, DATA_BLOCK_TYPE_FIELD_SIZE) != DATA_BLOCK_TYPE_FIELD_SIZE)
+					{
+						BS_EXCEPT(InternalErrorException, "Error decoding data.");
+					}
+
+					UINT32 dataBlockOffset = (UINT32)data->tell();
+					if (curField != nullptr)
+					{
+						curField->setValue(object, data, dataBlockSize);
+						data->seek(dataBlockOffset + dataBlockSize);
+					}
+					else
+						data->skip(dataBlockSize);
+
+					break;
+				}
+				default:
+					BS_EXCEPT(InternalErrorException,
+						"Error decoding data. Encountered a type I don't know how to decode. Type: " + toString(UINT32(fieldType)) +
+						", Is array: " + toString(isArray));
+				}
+			}
+		}
+
+		return false;
+	}
+
+	void BinarySerializer::skipObject(const SPtr<DataStream>& data, UINT32 dataEnd, bool recordSubObjects)
+	{
+		ObjectMetaData objectMetaData;
+		objectMetaData.objectMeta = 0;
+		objectMetaData.typeId = 0;
+
+		if (data->read(&objectMetaData, sizeof(ObjectMetaData)) != sizeof(ObjectMetaData))
+		{
+			BS_EXCEPT(InternalErrorException, "Error decoding data.");
+		}
+
+		UINT32 objectId = 0;
+		UINT32 objectTypeId = 0;
+		bool objectIsBaseClass = false;
+		decodeObjectMetaData(objectMetaData, objectId, objectTypeId, objectIsBaseClass);
+
+		if (objectIsBaseClass)
+		{
+			BS_EXCEPT(InternalErrorException, "Encountered a base-class object while looking for a new object. " \
+				"Base class objects are only supposed to be parts of a larger object.");
+		}
+
+		while (true)
+		{
+			if (recordSubObjects)
+				mStreamSubObjects.push_back({ objectTypeId, (UINT32)data->tell(), nullptr });
+
+			// Terminator fields are only present at the end of embedded objects
+			if (decodeFields(data, dataEnd, nullptr, nullptr))
+				return;
+
+			if ((UINT32)data->tell() >= dataEnd)
+				return;
+
+			if (data->read(&objectMetaData, sizeof(ObjectMetaData)) != sizeof(ObjectMetaData))
+			{
+				BS_EXCEPT(InternalErrorException, "Error decoding data.");
+			}
+
+			decodeObjectMetaData(objectMetaData, objectId, objectTypeId, objectIsBaseClass);
+
+			// Found new object, we're done
+			if (!objectIsBaseClass)
+			{
+				data->seek(data->tell() - sizeof(ObjectMetaData));
+				return;
+			}
+		}
+	}
+
+	SPtr<IReflectable> BinarySerializer::decodeEmbeddedObject(const SPtr<DataStream>& data, UINT32 dataEnd)
+	{
+		ObjectMetaData objectMetaData;
+		objectMetaData.objectMeta = 0;
+		objectMetaData.typeId = 0;
+
+		if (data->read(&objectMetaData, sizeof(ObjectMetaData)) != sizeof(ObjectMetaData))
+		{
+			BS_EXCEPT(InternalErrorException, "Error decoding data.");
+		}
+
+		data->seek(data->tell() - sizeof(ObjectMetaData));
+
+		UINT32 objectId = 0;
+		UINT32 objectTypeId = 0;
+		bool objectIsBaseClass = false;
+		decodeObjectMetaData(objectMetaData, objectId, objectTypeId, objectIsBaseClass);
+
+		RTTITypeBase* childRtti = IReflectable::_getRTTIfromTypeId(objectTypeId);
+		if (childRtti == nullptr)
+		{
+			skipObject(data, dataEnd, false);
+			return nullptr;
+		}
+
+		SPtr<IReflectable> childObject = childRtti->newRTTIObject();
+		decodeObject(data, dataEnd, childObject);
+
+		return childObject;
+	}
+
+	SPtr<IReflectable> BinarySerializer::decodeReferencedObject(const SPtr<DataStream>& data, UINT32 dataEnd, 
+		UINT32 objectId, bool weakRef)
+	{
+		if (objectId == 0)
+			return nullptr;
+
+		INT32 objectIdx = findStreamObject(data, dataEnd, objectId);
+		if (objectIdx == -1)
+			return nullptr;
+
+		StreamObject& streamObject = mStreamObjects[objectIdx];
+		if (streamObject.object == nullptr)
+		{
+			RTTITypeBase* childRtti = IReflectable::_getRTTIfromTypeId(streamObject.typeId);
+			if (childRtti == nullptr)
+				return nullptr;
+
+			streamObject.object = childRtti->newRTTIObject();
+		}
+
+		SPtr<IReflectable> object = streamObject.object;
+
+		bool needsDecoding = !weakRef && !streamObject.isDecoded;
+		if (needsDecoding)
+		{
+			if (streamObject.decodeInProgress)
+			{
+				LOGWRN("Detected a circular reference when decoding. Referenced object's fields " \
+					"will be resolved in an undefined order (i.e. one of the objects will not " \
+					"be fully deserialized when assigned to its field). Use RTTI_Flag_WeakRef to " \
+					"get rid of this warning and tell the system which of the objects is allowed " \
+					"to be deserialized after it is assigned to its field.");
+			}
+			else
+			{
+				streamObject.decodeInProgress = true;
+
+				UINT32 position = (UINT32)data->tell();
+				data->seek(streamObject.offset);
+				decodeObject(data, dataEnd, object);
+				data->seek(position);
+
+				// Note: Decoding could have added new entries to mStreamObjects
+				mStreamObjects[objectIdx].decodeInProgress = false;
+				mStreamObjects[objectIdx].isDecoded = true;
+			}
+		}
+
+		return object;
+	}
+
+	INT32 BinarySerializer::findStreamObject(const SPtr<DataStream>& data, UINT32 dataEnd, UINT32 objectId)
+	{
+		UINT32* objectIdx = mStreamObjectIds.find(objectId);
+		if (objectIdx != nullptr)
+			return (INT32)*objectIdx;
+
+		if (mIndexedEnd >= dataEnd)
+			return -1;
+
+		// Objects referenced by ID are stored one after another following the root object, so keep indexing them until
+		// the requested one is found
+		UINT32 position = (UINT32)data->tell();
+		data->seek(mIndexedEnd);
+
+		INT32 output = -1;
+		while ((UINT32)data->tell() < dataEnd)
+		{
+			UINT32 offset = (UINT32)data->tell();
+
+			ObjectMetaData objectMetaData;
+			objectMetaData.objectMeta = 0;
+			objectMetaData.typeId = 0;
+
+			if (data->read(&objectMetaData, sizeof(ObjectMetaData)) != sizeof(ObjectMetaData))
+			{
+				BS_EXCEPT(InternalErrorException, "Error decoding data.");
+			}
+
+			data->seek(offset);
+
+			UINT32 curObjectId = 0;
+			UINT32 curObjectTypeId = 0;
+			bool curObjectIsBaseClass = false;
+			decodeObjectMetaData(objectMetaData, curObjectId, curObjectTypeId, curObjectIsBaseClass);
+
+			skipObject(data, dataEnd, false);
+
+			if (curObjectId == 0 || mStreamObjectIds.find(curObjectId) != nullptr)
+				continue;
+
+			UINT32 curObjectIdx = (UINT32)mStreamObjects.size();
+			mStreamObjectIds[curObjectId] = curObjectIdx;
+			mStreamObjects.push_back({ offset, curObjectTypeId, nullptr, false, false });
+
+			if (curObjectId == objectId)
+			{
+				output = (INT32)curObjectIdx;
+				break;
+			}
+		}
+
+		mIndexedEnd = (UINT32)data->tell();
+		data->seek(position);
+
+		return output;
+	}
+
+	UINT8* BinarySerializer::readFieldData(const SPtr<DataStream>& data, UINT32 size)
+	{
+		if (mDecodeAlloc == nullptr) // Guaranteed not to be a file stream, as we check in decode()
+		{
+			UINT8* fieldData = static_cast<MemoryDataStream*>(data.get())->getCurrentPtr();
+
+			data->skip(size);
+			return fieldData;
+		}
+
+		UINT8* fieldData = mDecodeAlloc->alloc(size);
+		if (data->read(fieldData, size) != size)
+		{
+			BS_EXCEPT(InternalErrorException, "Error decoding data.");
+		}
+
+		return fieldData;
+	}
+
+	void BinarySerializer::freeFieldData(UINT8* buffer)
+	{
+		if (mDecodeAlloc != nullptr)
+			mDecodeAlloc->dealloc(buffer);
+	}
+
 	UINT8* BinarySerializer::complexTypeToBuffer(IReflectable* object, UINT8* buffer, UINT32& bufferLength, 
 		UINT32* bytesWritten, std::function<UINT8*(UINT8*, UINT32, UINT32&)> flushBufferCallback, bool shallow)
 	{
@@ -7,6 +7,7 @@
 #include "Prerequisites/BsPrerequisitesUtil.h"
 #include "Serialization/BsSerializedObject.h"
 #include "Reflection/BsRTTIField.h"
+#include "Utility/BsIdHashMap.h"
 
 namespace bs
 {
@@ -20,8 +21,6 @@ namespace bs
 
 	// TODO - Low priority. I will probably want to extract a generalized Serializer class so we can re-use the code
 	// in text or other serializers
-	// TODO - Low priority. Encode does a chunk-based encode so that we don't need to know the buffer size in advance,
-	// and don't have to use a lot of memory for the buffer. Consider doing something similar for decode.
 	// TODO - Low priority. Add a simple encode method that doesn't require a callback, instead it calls the callback internally
 	// and creates the buffer internally.
 	/**
@@ -67,7 +66,9 @@ namespace bs
 			bool shallow = false, const UnorderedMap<String, UINT64>& params = UnorderedMap<String, UINT64>());
 
 		/**
-		 * Decodes an object from binary data.
+		 * Decodes an object from binary data. Fields are decoded directly from the stream into the new objects, without
+		 * building an intermediate representation. Field data of memory streams is referenced in place, while field data
+		 * of file streams is read into temporary buffers allocated from a frame allocator.
 		 *
 		 * @param[in]	data  		Binary data to decode.
 		 * @param[in]	dataLength	Length of the data in bytes.
@@ -140,6 +141,24 @@ namespace bs
 			bool decodeInProgress; // Used for error reporting circular references
 		};
 
+		/** Object referenced by its ID in a stream being decoded directly. */
+		struct StreamObject
+		{
+			UINT32 offset; // Position of the object meta data in the stream
+			UINT32 typeId;
+			SPtr<IReflectable> object;
+			bool isDecoded;
+			bool decodeInProgress; // Used for error reporting circular references
+		};
+
+		/** Part of an object belonging to a single class in its inheritance hierarchy, in a stream being decoded directly. */
+		struct StreamSubObject
+		{
+			UINT32 typeId;
+			UINT32 offset; // Position of the first field in the stream
+			RTTITypeBase* rtti;
+		};
+
 		/** Encodes a single IReflectable object. */
 		UINT8* encodeEntry(IReflectable* object, UINT32 objectId, UINT8* buffer, UINT32& bufferLength, UINT32* bytesWritten,
 			std::function<UINT8*(UINT8* buffer, UINT32 bytesWritten, UINT32& newBufferSize)> flushBufferCallback, bool shallow);
@@ -151,6 +170,52 @@ namespace bs
 		bool decodeEntry(const SPtr<DataStream>& data, UINT32 dataLength, UINT32& bytesRead, SPtr<SerializedObject>& output, 
 			bool copyData, bool streamDataBlock);
 
+		/**
+		 * Decodes a single IReflectable object directly from the stream, including any objects embedded in it or
+		 * referenced by it. The stream must be positioned at the object meta data, and will be positioned at the end of
+		 * the object when done.
+		 */
+		void decodeObject(const SPtr<DataStream>& data, UINT32 dataEnd, const SPtr<IReflectable>& object);
+
+		/**
+		 * Decodes fields of a single sub-object directly from the stream, until the next object meta data, terminator field
+		 * or the end of the data is reached. Fields are skipped if @p rtti is null. Returns true if a terminator field was
+		 * reached.
+		 */
+		bool decodeFields(const SPtr<DataStream>& data, UINT32 dataEnd, IReflectable* object, RTTITypeBase* rtti);
+
+		/**
+		 * Skips over an object stored in the stream, including its base classes and embedded objects. Optionally records
+		 * the position of each of its sub-objects in mStreamSubObjects.
+		 */
+		void skipObject(const SPtr<DataStream>& data, UINT32 dataEnd, bool recordSubObjects);
+
+		/** Decodes an object embedded in the stream at the current position. Returns null if its type is unknown. */
+		SPtr<IReflectable> decodeEmbeddedObject(const SPtr<DataStream>& data, UINT32 dataEnd);
+
+		/**
+		 * Returns the object with the specified ID, creating and decoding it if it wasn't already, unless @p weakRef is
+		 * true. Returns null if the object isn't present in the stream or its type is unknown.
+		 */
+		SPtr<IReflectable> decodeReferencedObject(const SPtr<DataStream>& data, UINT32 dataEnd, UINT32 objectId,
+			bool weakRef);
+
+		/**
+		 * Returns the index of the object with the specified ID in mStreamObjects, or -1 if it isn't present in the stream.
+		 * Objects are indexed on demand, by scanning the stream past the last indexed object.
+		 */
+		INT32 findStreamObject(const SPtr<DataStream>& data, UINT32 dataEnd, UINT32 objectId);
+
+		/**
+		 * Returns a pointer to the next @p size bytes of the stream, and advances the stream past them. Memory stream data
+		 * is referenced in place, while other data is copied into a temporary buffer that must be released by calling
+		 * freeFieldData().
+		 */
+		UINT8* readFieldData(const SPtr<DataStream>& data, UINT32 size);
+
+		/** Releases a buffer returned by readFieldData(). */
+		void freeFieldData(UINT8* buffer);
+
 		/**	Helper method for encoding a complex object and copying its data to a buffer. */
 		UINT8* complexTypeToBuffer(IReflectable* object, UINT8* buffer, UINT32& bufferLength, UINT32* bytesWritten,
 			std::function<UINT8*(UINT8* buffer, UINT32 bytesWritten, UINT32& newBufferSize)> flushBufferCallback, bool shallow);
@@ -201,12 +266,19 @@ namespace bs
 		UnorderedMap<SPtr<SerializedObject>, ObjectToDecode> mObjectMap;
 		UnorderedMap<UINT32, SPtr<SerializedObject>> mInterimObjectMap;
 
+		Vector<StreamObject> mStreamObjects;
+		IdHashMap<UINT32> mStreamObjectIds;
+		Vector<StreamSubObject> mStreamSubObjects;
+		UINT32 mIndexedEnd;
+		FrameAlloc* mDecodeAlloc;
+
 		UnorderedMap<String, UINT64> mParams;
 
 		static const int META_SIZE = 4; // Meta field size
 		static const int NUM_ELEM_FIELD_SIZE = 4; // Size of the field storing number of array elements
 		static const int COMPLEX_TYPE_FIELD_SIZE = 4; // Size of the field storing the size of a child complex type
 		static const int DATA_BLOCK_TYPE_FIELD_SIZE = 4;
+		static const UINT32 DECODE_ALLOC_BLOCK_SIZE = 64 * 1024; // Block size of the allocator used for field data
 	};
 
 	/** @} */
@@ -0,0 +1,210 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "Testing/BsCompressionTestSuite.h"
+#include "Utility/BsCompression.h"
+#include "FileSystem/BsDataStream.h"
+
+namespace bs
+{
+	static const UINT32 CHUNK_SIZE = 4096;
+
+	/**
+	 * Generates test data. Compressible data repeats short runs of text, while incompressible data is pseudo-random.
+	 * Size is deliberately not a multiple of the chunk size, so the last chunk is partial.
+	 */
+	static Vector<UINT8> generateData(UINT32 size, bool compressible)
+	{
+		Vector<UINT8> output(size);
+
+		UINT32 seed = 12345;
+		for (UINT32 i = 0; i < size; i++)
+		{
+			seed = seed * 1664525 + 1013904223;
+
+			if (compressible)
+				output[i] = (UINT8)("banshee engine "[(i + (i / 1000)) % 15]);
+			else
+				output[i] = (UINT8)(seed >> 24);
+		}
+
+		return output;
+	}
+
+	/** Compresses the provided data using chunked compression, and returns the compressed bytes. */
+	static Vector<UINT8> compressChunked(Vector<UINT8>& data)
+	{
+		SPtr<DataStream> input = bs_shared_ptr_new<MemoryDataStream>(data.data(), data.size(), false);
+		SPtr<MemoryDataStream> compressed = Compression::compressChunked(input, CHUNK_SIZE);
+
+		return Vector<UINT8>(compressed->getPtr(), compressed->getPtr() + compressed->size());
+	}
+
+	/** Creates a stream referencing the provided data. The data must outlive the stream. */
+	static SPtr<DataStream> createStream(Vector<UINT8>& data)
+	{
+		return bs_shared_ptr_new<MemoryDataStream>(data.data(), data.size(), false);
+	}
+
+	CompressionTestSuite::CompressionTestSuite()
+	{
+		BS_ADD_TEST(CompressionTestSuite::testChunkedRoundTrip);
+		BS_ADD_TEST(CompressionTestSuite::testChunkedRangeRead);
+		BS_ADD_TEST(CompressionTestSuite::testChunkedIncompressible);
+		BS_ADD_TEST(CompressionTestSuite::testChunkedCorruptIndex);
+	}
+
+	void CompressionTestSuite::testChunkedRoundTrip()
+	{
+		static const UINT32 NUM_CHUNKS = 40;
+
+		Vector<UINT8> data = generateData(CHUNK_SIZE * NUM_CHUNKS - 100, true);
+		Vector<UINT8> compressed = compressChunked(data);
+		BS_TEST_ASSERT(compressed.size() < data.size());
+
+		SPtr<MemoryDataStream> decompressed = Compression::decompressChunked(createStream(compressed));
+		BS_TEST_ASSERT(decompressed != nullptr);
+		if (decompressed == nullptr)
+			return;
+
+		BS_TEST_ASSERT(decompressed->size() == data.size());
+		BS_TEST_ASSERT(memcmp(decompressed->getPtr(), data.data(), data.size()) == 0);
+
+		// Decompression must start at the current stream position, not at the start of the buffer
+		Vector<UINT8> prefixed(16, 0xFF);
+		prefixed.insert(prefixed.end(), compressed.begin(), compressed.end());
+
+		SPtr<DataStream> prefixedStream = createStream(prefixed);
+		prefixedStream->skip(16);
+
+		decompressed = Compression::decompressChunked(prefixedStream);
+		BS_TEST_ASSERT(decompressed != nullptr && decompressed->size() == data.size() &&
+			memcmp(decompressed->getPtr(), data.data(), data.size()) == 0);
+
+		// Empty input
+		Vector<UINT8> empty;
+		Vector<UINT8> compressedEmpty = compressChunked(empty);
+
+		CompressedChunkReader emptyReader(createStream(compressedEmpty));
+		BS_TEST_ASSERT(emptyReader.isValid());
+		BS_TEST_ASSERT(emptyReader.getSize() == 0 && emptyReader.getNumChunks() == 0);
+	}
+
+	void CompressionTestSuite::testChunkedRangeRead()
+	{
+		static const UINT32 NUM_CHUNKS = 10;
+
+		UINT32 size = CHUNK_SIZE * NUM_CHUNKS - 100;
+		Vector<UINT8> data = generateData(size, true);
+		Vector<UINT8> compressed = compressChunked(data);
+
+		CompressedChunkReader reader(createStream(compressed));
+		BS_TEST_ASSERT(reader.isValid());
+		BS_TEST_ASSERT(reader.getSize() == size);
+		BS_TEST_ASSERT(reader.getChunkSize() == CHUNK_SIZE);
+		BS_TEST_ASSERT(reader.getNumChunks() == NUM_CHUNKS);
+
+		struct Range
+		{
+			UINT64 offset;
+			UINT64 size;
+		};
+
+		Range ranges[] =
+		{
+			{ 0, size }, // Everything
+			{ 10, 20 }, // Within a single chunk
+			{ 0, CHUNK_SIZE }, // Exactly one chunk
+			{ CHUNK_SIZE - 10, 20 }, // Crossing a single chunk boundary
+			{ CHUNK_SIZE + 1, CHUNK_SIZE * 3 }, // Spanning multiple chunks, partial on both ends
+			{ CHUNK_SIZE * (NUM_CHUNKS - 1), size - CHUNK_SIZE * (NUM_CHUNKS - 1) }, // Exactly the partial last chunk
+			{ size - 50, 50 }, // Ending exactly on the end of the last chunk
+			{ CHUNK_SIZE * 2 - 1, size - (CHUNK_SIZE * 2 - 1) }, // Crossing into the last chunk, until the end
+			{ size, 0 } // Empty range at the end
+		};
+
+		Vector<UINT8> output(size);
+		for (auto& range : ranges)
+		{
+			memset(output.data(), 0, output.size());
+
+			bool success = reader.read(range.offset, range.size, output.data());
+			BS_TEST_ASSERT(success);
+			BS_TEST_ASSERT(memcmp(output.data(), data.data() + range.offset, (size_t)range.size) == 0);
+		}
+
+		// Out of bounds
+		BS_TEST_ASSERT(!reader.read(size - 10, 11, output.data()));
+		BS_TEST_ASSERT(!reader.read(size + 1, 0, output.data()));
+	}
+
+	void CompressionTestSuite::testChunkedIncompressible()
+	{
+		static const UINT32 NUM_CHUNKS = 8;
+
+		UINT32 size = CHUNK_SIZE * NUM_CHUNKS - 100;
+		Vector<UINT8> data = generateData(size, false);
+		Vector<UINT8> compressed = compressChunked(data);
+
+		// Incompressible chunks are stored as they are, so the data can only grow by the size of the header and index
+		UINT32 indexSize = (NUM_CHUNKS + 1) * sizeof(UINT64);
+		BS_TEST_ASSERT(compressed.size() == Compression::CHUNKED_HEADER_SIZE + indexSize + size);
+
+		SPtr<MemoryDataStream> decompressed = Compression::decompressChunked(createStream(compressed));
+		BS_TEST_ASSERT(decompressed != nullptr && decompressed->size() == size &&
+			memcmp(decompressed->getPtr(), data.data(), size) == 0);
+
+		// Mix of compressible and incompressible chunks
+		Vector<UINT8> mixed = generateData(size, true);
+		memcpy(mixed.data() + CHUNK_SIZE * 2, data.data(), CHUNK_SIZE * 3);
+
+		Vector<UINT8> compressedMixed = compressChunked(mixed);
+		BS_TEST_ASSERT(compressedMixed.size() < mixed.size());
+
+		CompressedChunkReader reader(createStream(compressedMixed));
+		Vector<UINT8> output(CHUNK_SIZE * 2);
+
+		UINT64 offset = CHUNK_SIZE * 2 - CHUNK_SIZE / 2;
+		BS_TEST_ASSERT(reader.read(offset, CHUNK_SIZE * 2, output.data()));
+		BS_TEST_ASSERT(memcmp(output.data(), mixed.data() + offset, CHUNK_SIZE * 2) == 0);
+	}
+
+	void CompressionTestSuite::testChunkedCorruptIndex()
+	{
+		static const UINT32 NUM_CHUNKS = 4;
+		const UINT32 headerSize = Compression::CHUNKED_HEADER_SIZE;
+
+		Vector<UINT8> data = generateData(CHUNK_SIZE * NUM_CHUNKS, true);
+		Vector<UINT8> compressed = compressChunked(data);
+		BS_TEST_ASSERT(CompressedChunkReader(createStream(compressed)).isValid());
+
+		// Bad magic number
+		Vector<UINT8> badMagic = compressed;
+		badMagic[0] ^= 0xFF;
+
+		BS_TEST_ASSERT(!CompressedChunkReader(createStream(badMagic)).isValid());
+		BS_TEST_ASSERT(Compression::decompressChunked(createStream(badMagic)) == nullptr);
+
+		// Data ends in the middle of the offset index
+		Vector<UINT8> truncated(compressed.begin(), compressed.begin() + headerSize + sizeof(UINT64) * 2);
+
+		CompressedChunkReader truncatedReader(createStream(truncated));
+		BS_TEST_ASSERT(!truncatedReader.isValid());
+
+		UINT8 output[16];
+		BS_TEST_ASSERT(!truncatedReader.read(0, sizeof(output), output));
+		BS_TEST_ASSERT(Compression::decompressChunked(createStream(truncated)) == nullptr);
+
+		// Index complete, but chunk data missing
+		Vector<UINT8> missingData(compressed.begin(), compressed.end() - 1);
+		BS_TEST_ASSERT(!CompressedChunkReader(createStream(missingData)).isValid());
+
+		// Offsets that go backwards
+		Vector<UINT8> nonMonotonic = compressed;
+		UINT64* offsets = (UINT64*)(nonMonotonic.data() + headerSize);
+		offsets[1] = offsets[2] + 1;
+
+		BS_TEST_ASSERT(offsets[NUM_CHUNKS] == compressed.size() - headerSize - (NUM_CHUNKS + 1) * sizeof(UINT64));
+		BS_TEST_ASSERT(!CompressedChunkReader(createStream(nonMonotonic)).isValid());
+		BS_TEST_ASSERT(Compression::decompressChunked(createStream(nonMonotonic)) == nullptr);
+	}
+}
@@ -5,6 +5,7 @@
 #include "Debug/BsDebug.h"
 #include "Error/BsException.h"
 #include "FileSystem/BsFileSystem.h"
+#include "FileSystem/BsDataStream.h"
 
 #include <algorithm>
 #include <fstream>
@@ -84,6 +85,7 @@ namespace bs
 		BS_ADD_TEST(FileSystemTestSuite::testGetChildren);
 		BS_ADD_TEST(FileSystemTestSuite::testGetLastModifiedTime);
 		BS_ADD_TEST(FileSystemTestSuite::testGetTempDirectoryPath);
+		BS_ADD_TEST(FileSystemTestSuite::testMappedFileDataStream);
 	}
 
 	void FileSystemTestSuite::testExists_yes_file()
@@ -299,4 +301,40 @@ namespace bs
 		/* No judging. */
 		BS_TEST_ASSERT(!path.toString().empty());
 	}
+
+	void FileSystemTestSuite::testMappedFileDataStream()
+	{
+		Path path = mTestDirectory + "mapped-file";
+		createFile(path, "0123456789");
+
+		{
+			SPtr<MappedFileDataStream> stream = bs_shared_ptr_new<MappedFileDataStream>(path);
+			BS_TEST_ASSERT(stream->isMapped());
+			BS_TEST_ASSERT(stream->size() == 10);
+			BS_TEST_ASSERT(memcmp(stream->getPtr(), "0123456789", 10) == 0);
+
+			char buffer[4];
+			stream->seek(3);
+			BS_TEST_ASSERT(stream->read(buffer, 4) == 4);
+			BS_TEST_ASSERT(memcmp(buffer, "3456", 4) == 0);
+			BS_TEST_ASSERT(*stream->getCurrentPtr() == '7');
+
+			// Writes to mapped memory must never reach the file
+			stream->getPtr()[0] = 'X';
+
+			SPtr<DataStream> copy = stream->clone(true);
+			stream->close();
+
+			BS_TEST_ASSERT(copy->size() == 10);
+			BS_TEST_ASSERT(copy->getAsString() == "X123456789");
+		}
+
+		BS_TEST_ASSERT(readFile(path) == "0123456789");
+
+		SPtr<MappedFileDataStream> missing = bs_shared_ptr_new<MappedFileDataStream>(mTestDirectory + "no-such-file");
+		BS_TEST_ASSERT(missing->size() == 0);
+		BS_TEST_ASSERT(missing->eof());
+
+		FileSystem::remove(path);
+	}
 }
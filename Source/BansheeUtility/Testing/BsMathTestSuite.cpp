@@ -0,0 +1,266 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "Testing/BsMathTestSuite.h"
+#include "Math/BsMatrix4.h"
+#include "Math/BsQuaternion.h"
+#include "Math/BsAABox.h"
+#include "Math/BsSphere.h"
+#include "Math/BsConvexVolume.h"
+#include "Math/BsMath.h"
+#include "Utility/BsDynamicBVH.h"
+#include "Utility/BsOcclusionBuffer.h"
+
+namespace bs
+{
+	/** Checks if all elements of the two matrices are equal, within the provided tolerance. */
+	static bool matrixEquals(const Matrix4& a, const Matrix4& b, float tolerance = 1.0e-4f)
+	{
+		for (UINT32 i = 0; i < 4; i++)
+		{
+			for (UINT32 j = 0; j < 4; j++)
+			{
+				if (!Math::approxEquals(a[i][j], b[i][j], tolerance))
+					return false;
+			}
+		}
+
+		return true;
+	}
+
+	MathTestSuite::MathTestSuite()
+	{
+		BS_ADD_TEST(MathTestSuite::testMatrixMultiply);
+		BS_ADD_TEST(MathTestSuite::testTRS);
+		BS_ADD_TEST(MathTestSuite::testAABoxTransform);
+		BS_ADD_TEST(MathTestSuite::testFrustumIntersection);
+		BS_ADD_TEST(MathTestSuite::testDynamicBVH);
+		BS_ADD_TEST(MathTestSuite::testOcclusionBuffer);
+	}
+
+	void MathTestSuite::testMatrixMultiply()
+	{
+		Matrix4 a(
+			1.0f, 2.0f, 3.0f, 4.0f,
+			5.0f, 6.0f, 7.0f, 8.0f,
+			9.0f, 10.0f, 11.0f, 12.0f,
+			13.0f, 14.0f, 15.0f, 16.0f);
+
+		Matrix4 b(
+			-2.0f, 1.0f, 0.5f, 3.0f,
+			4.0f, -1.0f, 2.0f, 0.0f,
+			1.0f, 0.0f, -3.0f, 2.0f,
+			0.0f, 5.0f, 1.0f, -1.0f);
+
+		Matrix4 expected;
+		for (UINT32 i = 0; i < 4; i++)
+		{
+			for (UINT32 j = 0; j < 4; j++)
+			{
+				float sum = 0.0f;
+				for (UINT32 k = 0; k < 4; k++)
+					sum += a[i][k] * b[k][j];
+
+				expected[i][j] = sum;
+			}
+		}
+
+		BS_TEST_ASSERT(matrixEquals(a * b, expected));
+
+		Matrix4 affineA = Matrix4::TRS(Vector3(1.0f, 2.0f, 3.0f), Quaternion(Degree(30.0f), Degree(45.0f), Degree(10.0f)),
+			Vector3(2.0f, 1.0f, 0.5f));
+		Matrix4 affineB = Matrix4::TRS(Vector3(-4.0f, 0.0f, 1.0f), Quaternion(Degree(-60.0f), Degree(5.0f), Degree(90.0f)),
+			Vector3::ONE);
+
+		BS_TEST_ASSERT(matrixEquals(affineA.concatenateAffine(affineB), affineA * affineB));
+	}
+
+	void MathTestSuite::testTRS()
+	{
+		Vector3 translation(3.0f, -2.0f, 7.5f);
+		Quaternion rotation(Degree(25.0f), Degree(-70.0f), Degree(135.0f));
+		Vector3 scale(1.5f, 0.25f, 3.0f);
+
+		Matrix3 rot3x3;
+		rotation.toRotationMatrix(rot3x3);
+
+		Matrix4 expected(
+			scale.x * rot3x3[0][0], scale.y * rot3x3[0][1], scale.z * rot3x3[0][2], translation.x,
+			scale.x * rot3x3[1][0], scale.y * rot3x3[1][1], scale.z * rot3x3[1][2], translation.y,
+			scale.x * rot3x3[2][0], scale.y * rot3x3[2][1], scale.z * rot3x3[2][2], translation.z,
+			0.0f, 0.0f, 0.0f, 1.0f);
+
+		Matrix4 trs = Matrix4::TRS(translation, rotation, scale);
+		BS_TEST_ASSERT(matrixEquals(trs, expected));
+		BS_TEST_ASSERT(trs.isAffine());
+
+		Matrix4 inverse = Matrix4::inverseTRS(translation, rotation, scale);
+		BS_TEST_ASSERT(matrixEquals(trs * inverse, Matrix4::IDENTITY));
+	}
+
+	void MathTestSuite::testAABoxTransform()
+	{
+		AABox box(Vector3(-1.0f, 0.5f, 2.0f), Vector3(3.0f, 4.0f, 2.5f));
+		Matrix4 tfrm = Matrix4::TRS(Vector3(10.0f, -5.0f, 1.0f), Quaternion(Degree(40.0f), Degree(15.0f), Degree(-80.0f)),
+			Vector3(2.0f, 1.0f, 3.0f));
+
+		// Bounds of all eight transformed corners
+		Vector3 expectedMin = tfrm.multiplyAffine(box.getMin());
+		Vector3 expectedMax = expectedMin;
+		for (UINT32 i = 0; i < 8; i++)
+		{
+			Vector3 corner = box.getCorner((AABox::Corner)i);
+			corner = tfrm.multiplyAffine(corner);
+
+			expectedMin = Vector3::min(expectedMin, corner);
+			expectedMax = Vector3::max(expectedMax, corner);
+		}
+
+		AABox transformed = box;
+		transformed.transformAffine(tfrm);
+
+		BS_TEST_ASSERT(Math::approxEquals(transformed.getMin(), expectedMin, 1.0e-4f));
+		BS_TEST_ASSERT(Math::approxEquals(transformed.getMax(), expectedMax, 1.0e-4f));
+	}
+
+	void MathTestSuite::testFrustumIntersection()
+	{
+		// Five planes, so the last batch is only partially filled
+		Vector<Plane> planes;
+		planes.push_back(Plane(Vector3(1.0f, 0.0f, 0.0f), -10.0f));
+		planes.push_back(Plane(Vector3(-1.0f, 0.0f, 0.0f), -10.0f));
+		planes.push_back(Plane(Vector3(0.0f, 1.0f, 0.0f), -10.0f));
+		planes.push_back(Plane(Vector3(0.0f, -1.0f, 0.0f), -10.0f));
+		planes.push_back(Plane(Vector3(0.0f, 0.0f, 1.0f), -10.0f));
+
+		ConvexVolume volume(planes);
+
+		BS_TEST_ASSERT(volume.intersects(AABox(Vector3(-1.0f, -1.0f, -1.0f), Vector3(1.0f, 1.0f, 1.0f))));
+		BS_TEST_ASSERT(volume.intersects(AABox(Vector3(9.0f, 0.0f, 0.0f), Vector3(12.0f, 1.0f, 1.0f))));
+		BS_TEST_ASSERT(!volume.intersects(AABox(Vector3(11.0f, 0.0f, 0.0f), Vector3(12.0f, 1.0f, 1.0f))));
+		BS_TEST_ASSERT(!volume.intersects(AABox(Vector3(0.0f, 0.0f, -20.0f), Vector3(1.0f, 1.0f, -11.0f))));
+		BS_TEST_ASSERT(volume.intersects(AABox(Vector3(0.0f, 0.0f, 100.0f), Vector3(1.0f, 1.0f, 101.0f))));
+
+		BS_TEST_ASSERT(volume.intersects(Sphere(Vector3(0.0f, 10.5f, 0.0f), 1.0f)));
+		BS_TEST_ASSERT(!volume.intersects(Sphere(Vector3(0.0f, 0.0f, -12.0f), 1.0f)));
+		BS_TEST_ASSERT(!volume.intersects(Sphere(Vector3(-15.0f, 0.0f, 0.0f), 4.0f)));
+	}
+
+	void MathTestSuite::testDynamicBVH()
+	{
+		const UINT32 numObjects = 1000;
+
+		// Deterministic pseudo-random boxes scattered over a large area
+		UINT32 seed = 1234;
+		auto random = [&seed](float min, float max)
+		{
+			seed = seed * 1664525 + 1013904223;
+			return min + (max - min) * ((seed >> 8) / (float)(1 << 24));
+		};
+
+		auto randomBox = [&random]()
+		{
+			Vector3 center(random(-500.0f, 500.0f), random(-500.0f, 500.0f), random(-500.0f, 500.0f));
+			Vector3 halfSize(random(0.5f, 10.0f), random(0.5f, 10.0f), random(0.5f, 10.0f));
+
+			return AABox(center - halfSize, center + halfSize);
+		};
+
+		DynamicBVH bvh;
+		Vector<UINT32> ids;
+		Vector<bool> alive;
+		for (UINT32 i = 0; i < numObjects; i++)
+		{
+			ids.push_back(bvh.add(randomBox(), i));
+			alive.push_back(true);
+		}
+
+		// Move half of the objects, and remove a quarter
+		for (UINT32 i = 0; i < numObjects; i += 2)
+			bvh.update(ids[i], randomBox());
+
+		for (UINT32 i = 1; i < numObjects; i += 4)
+		{
+			bvh.remove(ids[i]);
+			alive[i] = false;
+		}
+
+		BS_TEST_ASSERT(bvh.getNumObjects() == numObjects - numObjects / 4);
+		BS_TEST_ASSERT(bvh.getHeight() < 32);
+
+		// Compare queries against brute force tests on the same bounds
+		Matrix4 proj = Matrix4::projectionPerspective(Degree(90.0f), 1.0f, 0.1f, 400.0f);
+		ConvexVolume frustum(proj);
+
+		Vector<UINT32> inside;
+		Vector<UINT32> intersecting;
+		bvh.query(frustum, inside, intersecting);
+
+		AABox queryBox(Vector3(-200.0f, -100.0f, -300.0f), Vector3(150.0f, 250.0f, 0.0f));
+		Vector<UINT32> boxResults;
+		bvh.query(queryBox, boxResults);
+
+		Vector<bool> inFrustum(numObjects, false);
+		for (auto& entry : inside)
+		{
+			BS_TEST_ASSERT(!inFrustum[entry]);
+			inFrustum[entry] = true;
+
+			const AABox& bounds = bvh.getFatBounds(ids[entry]);
+			BS_TEST_ASSERT(frustum.contains(bounds.getMin()) && frustum.contains(bounds.getMax()));
+		}
+
+		for (auto& entry : intersecting)
+		{
+			BS_TEST_ASSERT(!inFrustum[entry]);
+			inFrustum[entry] = true;
+		}
+
+		Vector<bool> inBox(numObjects, false);
+		for (auto& entry : boxResults)
+			inBox[entry] = true;
+
+		for (UINT32 i = 0; i < numObjects; i++)
+		{
+			if (!alive[i])
+			{
+				BS_TEST_ASSERT(!inFrustum[i] && !inBox[i]);
+				continue;
+			}
+
+			const AABox& bounds = bvh.getFatBounds(ids[i]);
+			BS_TEST_ASSERT(inFrustum[i] == frustum.intersects(bounds));
+			BS_TEST_ASSERT(inBox[i] == queryBox.intersects(bounds));
+		}
+	}
+
+	void MathTestSuite::testOcclusionBuffer()
+	{
+		// View at origin looking along -Z, with a 90 degree horizontal field of view
+		OcclusionBuffer buffer(256, 128);
+		buffer.clear(Matrix4::projectionPerspective(Degree(90.0f), 2.0f, 0.1f, 100.0f));
+		buffer.buildHiZ();
+
+		AABox hiddenBox(Vector3(-1.0f, -1.0f, -21.0f), Vector3(1.0f, 1.0f, -19.0f));
+		BS_TEST_ASSERT(buffer.isVisible(hiddenBox));
+		BS_TEST_ASSERT(buffer.getDepth(128, 64) == std::numeric_limits<float>::max());
+
+		// Wall in front of the view
+		buffer.clear(Matrix4::projectionPerspective(Degree(90.0f), 2.0f, 0.1f, 100.0f));
+		buffer.rasterize(AABox(Vector3(-5.0f, -5.0f, -10.5f), Vector3(5.0f, 5.0f, -9.5f)), Matrix4::IDENTITY);
+		buffer.buildHiZ();
+
+		BS_TEST_ASSERT(buffer.getDepth(128, 64) < 1.0f);
+		BS_TEST_ASSERT(!buffer.isVisible(hiddenBox));
+		BS_TEST_ASSERT(buffer.isVisible(AABox(Vector3(-1.0f, -1.0f, -6.0f), Vector3(1.0f, 1.0f, -4.0f))));
+		BS_TEST_ASSERT(buffer.isVisible(AABox(Vector3(8.0f, -1.0f, -21.0f), Vector3(12.0f, 1.0f, -19.0f))));
+		BS_TEST_ASSERT(buffer.isVisible(AABox(Vector3(-1.0f, -1.0f, -1.0f), Vector3(1.0f, 1.0f, 1.0f))));
+
+		// Floor below the view, extending behind it so it must be clipped by the near plane
+		buffer.clear(Matrix4::projectionPerspective(Degree(90.0f), 2.0f, 0.1f, 100.0f));
+		buffer.rasterize(AABox(Vector3(-100.0f, -100.0f, -100.0f), Vector3(100.0f, -1.0f, 100.0f)), Matrix4::IDENTITY);
+		buffer.buildHiZ();
+
+		BS_TEST_ASSERT(!buffer.isVisible(AABox(Vector3(-1.0f, -5.0f, -21.0f), Vector3(1.0f, -3.0f, -19.0f))));
+		BS_TEST_ASSERT(buffer.isVisible(AABox(Vector3(-1.0f, 0.0f, -21.0f), Vector3(1.0f, 0.5f, -19.0f))));
+	}
+}
@@ -0,0 +1,22 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "Testing/BsTestSuite.h"
+
+namespace bs
+{
+	class BS_UTILITY_EXPORT MathTestSuite : public TestSuite
+	{
+	public:
+		MathTestSuite();
+
+	private:
+		void testMatrixMultiply();
+		void testTRS();
+		void testAABoxTransform();
+		void testFrustumIntersection();
+		void testDynamicBVH();
+		void testOcclusionBuffer();
+	};
+}
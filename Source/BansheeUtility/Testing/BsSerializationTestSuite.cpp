@@ -0,0 +1,744 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "Testing/BsSerializationTestSuite.h"
+#include "Reflection/BsRTTIType.h"
+#include "Reflection/BsRTTIPlainField.h"
+#include "Serialization/BsMemorySerializer.h"
+#include "Serialization/BsBinarySerializer.h"
+#include "FileSystem/BsFileSystem.h"
+#include "FileSystem/BsDataStream.h"
+#include "Math/BsVector3.h"
+
+namespace bs
+{
+	/** @cond TEST */
+
+	struct TestPlainDesc
+	{
+		UINT32 width = 1;
+		UINT32 height = 2;
+	};
+
+	/** Data shared by the plain test objects. Defaults differ from test values, so decode must overwrite them. */
+	struct TestPlainData
+	{
+		TestPlainData()
+		{
+			arrInt = { 1, 2, 3 };
+			arrVec = { Vector3(1.0f, 2.0f, 3.0f) };
+			arrStr = { "a", "b" };
+			arrEmpty = { 7, 8 };
+		}
+
+		UINT32 intVal = 5;
+		float floatVal = 1.5f;
+		String strVal = "default";
+		TestPlainDesc desc;
+
+		Vector<UINT32> arrInt;
+		Vector<Vector3> arrVec;
+		Vector<String> arrStr;
+		Vector<UINT32> arrEmpty;
+	};
+
+	/** Object whose fields are registered through the BS_RTTI_MEMBER_PLAIN* macros. */
+	struct TestPlainObject : IReflectable, TestPlainData
+	{
+	public:
+		friend class TestPlainObjectRTTI;
+		static RTTITypeBase* getRTTIStatic();
+		RTTITypeBase* getRTTI() const override;
+	};
+
+	/** Object with the same data as TestPlainObject, but whose fields are registered through getter/setter methods. */
+	struct TestLegacyPlainObject : IReflectable, TestPlainData
+	{
+	public:
+		friend class TestLegacyPlainObjectRTTI;
+		static RTTITypeBase* getRTTIStatic();
+		RTTITypeBase* getRTTI() const override;
+	};
+
+	struct TestBoolArrayObject : IReflectable
+	{
+		Vector<bool> values = { false, false };
+
+	public:
+		friend class TestBoolArrayObjectRTTI;
+		static RTTITypeBase* getRTTIStatic();
+		RTTITypeBase* getRTTI() const override;
+	};
+
+	class TestPlainObjectRTTI : public RTTIType<TestPlainObject, IReflectable, TestPlainObjectRTTI>
+	{
+	private:
+		BS_BEGIN_RTTI_MEMBERS
+			BS_RTTI_MEMBER_PLAIN(intVal, 0)
+			BS_RTTI_MEMBER_PLAIN(floatVal, 1)
+			BS_RTTI_MEMBER_PLAIN(strVal, 2)
+			BS_RTTI_MEMBER_PLAIN_NAMED(width, desc.width, 3)
+			BS_RTTI_MEMBER_PLAIN_NAMED(height, desc.height, 4)
+			BS_RTTI_MEMBER_PLAIN_ARRAY(arrInt, 5)
+			BS_RTTI_MEMBER_PLAIN_ARRAY(arrVec, 6)
+			BS_RTTI_MEMBER_PLAIN_ARRAY(arrStr, 7)
+			BS_RTTI_MEMBER_PLAIN_ARRAY(arrEmpty, 8)
+		BS_END_RTTI_MEMBERS
+
+	public:
+		TestPlainObjectRTTI()
+			:mInitMembers(this)
+		{ }
+
+		const String& getRTTIName() override
+		{
+			static String name = "TestPlainObject";
+			return name;
+		}
+
+		UINT32 getRTTIId() override
+		{
+			return TID_TestPlainObject;
+		}
+
+		SPtr<IReflectable> newRTTIObject() override
+		{
+			return bs_shared_ptr_new<TestPlainObject>();
+		}
+	};
+
+	class TestLegacyPlainObjectRTTI : public RTTIType<TestLegacyPlainObject, IReflectable, TestLegacyPlainObjectRTTI>
+	{
+	private:
+		UINT32& getIntVal(TestLegacyPlainObject* obj) { return obj->intVal; }
+		void setIntVal(TestLegacyPlainObject* obj, UINT32& val) { obj->intVal = val; }
+
+		float& getFloatVal(TestLegacyPlainObject* obj) { return obj->floatVal; }
+		void setFloatVal(TestLegacyPlainObject* obj, float& val) { obj->floatVal = val; }
+
+		String& getStrVal(TestLegacyPlainObject* obj) { return obj->strVal; }
+		void setStrVal(TestLegacyPlainObject* obj, String& val) { obj->strVal = val; }
+
+		UINT32& getWidth(TestLegacyPlainObject* obj) { return obj->desc.width; }
+		void setWidth(TestLegacyPlainObject* obj, UINT32& val) { obj->desc.width = val; }
+
+		UINT32& getHeight(TestLegacyPlainObject* obj) { return obj->desc.height; }
+		void setHeight(TestLegacyPlainObject* obj, UINT32& val) { obj->desc.height = val; }
+
+		UINT32& getArrInt(TestLegacyPlainObject* obj, UINT32 idx) { return obj->arrInt[idx]; }
+		void setArrInt(TestLegacyPlainObject* obj, UINT32 idx, UINT32& val) { obj->arrInt[idx] = val; }
+		UINT32 getSizeArrInt(TestLegacyPlainObject* obj) { return (UINT32)obj->arrInt.size(); }
+		void setSizeArrInt(TestLegacyPlainObject* obj, UINT32 size) { obj->arrInt.resize(size); }
+
+		Vector3& getArrVec(TestLegacyPlainObject* obj, UINT32 idx) { return obj->arrVec[idx]; }
+		void setArrVec(TestLegacyPlainObject* obj, UINT32 idx, Vector3& val) { obj->arrVec[idx] = val; }
+		UINT32 getSizeArrVec(TestLegacyPlainObject* obj) { return (UINT32)obj->arrVec.size(); }
+		void setSizeArrVec(TestLegacyPlainObject* obj, UINT32 size) { obj->arrVec.resize(size); }
+
+		String& getArrStr(TestLegacyPlainObject* obj, UINT32 idx) { return obj->arrStr[idx]; }
+		void setArrStr(TestLegacyPlainObject* obj, UINT32 idx, String& val) { obj->arrStr[idx] = val; }
+		UINT32 getSizeArrStr(TestLegacyPlainObject* obj) { return (UINT32)obj->arrStr.size(); }
+		void setSizeArrStr(TestLegacyPlainObject* obj, UINT32 size) { obj->arrStr.resize(size); }
+
+		UINT32& getArrEmpty(TestLegacyPlainObject* obj, UINT32 idx) { return obj->arrEmpty[idx]; }
+		void setArrEmpty(TestLegacyPlainObject* obj, UINT32 idx, UINT32& val) { obj->arrEmpty[idx] = val; }
+		UINT32 getSizeArrEmpty(TestLegacyPlainObject* obj) { return (UINT32)obj->arrEmpty.size(); }
+		void setSizeArrEmpty(TestLegacyPlainObject* obj, UINT32 size) { obj->arrEmpty.resize(size); }
+
+	public:
+		TestLegacyPlainObjectRTTI()
+		{
+			// Same order in which the member macros register their fields (last to first)
+			addPlainArrayField("arrEmpty", 8, &TestLegacyPlainObjectRTTI::getArrEmpty, &TestLegacyPlainObjectRTTI::getSizeArrEmpty,
+				&TestLegacyPlainObjectRTTI::setArrEmpty, &TestLegacyPlainObjectRTTI::setSizeArrEmpty);
+			addPlainArrayField("arrStr", 7, &TestLegacyPlainObjectRTTI::getArrStr, &TestLegacyPlainObjectRTTI::getSizeArrStr,
+				&TestLegacyPlainObjectRTTI::setArrStr, &TestLegacyPlainObjectRTTI::setSizeArrStr);
+			addPlainArrayField("arrVec", 6, &TestLegacyPlainObjectRTTI::getArrVec, &TestLegacyPlainObjectRTTI::getSizeArrVec,
+				&TestLegacyPlainObjectRTTI::setArrVec, &TestLegacyPlainObjectRTTI::setSizeArrVec);
+			addPlainArrayField("arrInt", 5, &TestLegacyPlainObjectRTTI::getArrInt, &TestLegacyPlainObjectRTTI::getSizeArrInt,
+				&TestLegacyPlainObjectRTTI::setArrInt, &TestLegacyPlainObjectRTTI::setSizeArrInt);
+			addPlainField("height", 4, &TestLegacyPlainObjectRTTI::getHeight, &TestLegacyPlainObjectRTTI::setHeight);
+			addPlainField("width", 3, &TestLegacyPlainObjectRTTI::getWidth, &TestLegacyPlainObjectRTTI::setWidth);
+			addPlainField("strVal", 2, &TestLegacyPlainObjectRTTI::getStrVal, &TestLegacyPlainObjectRTTI::setStrVal);
+			addPlainField("floatVal", 1, &TestLegacyPlainObjectRTTI::getFloatVal, &TestLegacyPlainObjectRTTI::setFloatVal);
+			addPlainField("intVal", 0, &TestLegacyPlainObjectRTTI::getIntVal, &TestLegacyPlainObjectRTTI::setIntVal);
+		}
+
+		const String& getRTTIName() override
+		{
+			static String name = "TestLegacyPlainObject";
+			return name;
+		}
+
+		UINT32 getRTTIId() override
+		{
+			return TID_TestLegacyPlainObject;
+		}
+
+		SPtr<IReflectable> newRTTIObject() override
+		{
+			return bs_shared_ptr_new<TestLegacyPlainObject>();
+		}
+	};
+
+	class TestBoolArrayObjectRTTI : public RTTIType<TestBoolArrayObject, IReflectable, TestBoolArrayObjectRTTI>
+	{
+	private:
+		BS_BEGIN_RTTI_MEMBERS
+			BS_RTTI_MEMBER_PLAIN_ARRAY(values, 0)
+		BS_END_RTTI_MEMBERS
+
+	public:
+		TestBoolArrayObjectRTTI()
+			:mInitMembers(this)
+		{ }
+
+		const String& getRTTIName() override
+		{
+			static String name = "TestBoolArrayObject";
+			return name;
+		}
+
+		UINT32 getRTTIId() override
+		{
+			return TID_TestBoolArrayObject;
+		}
+
+		SPtr<IReflectable> newRTTIObject() override
+		{
+			return bs_shared_ptr_new<TestBoolArrayObject>();
+		}
+	};
+
+	RTTITypeBase* TestPlainObject::getRTTIStatic()
+	{
+		return TestPlainObjectRTTI::instance();
+	}
+
+	RTTITypeBase* TestPlainObject::getRTTI() const
+	{
+		return TestPlainObject::getRTTIStatic();
+	}
+
+	RTTITypeBase* TestLegacyPlainObject::getRTTIStatic()
+	{
+		return TestLegacyPlainObjectRTTI::instance();
+	}
+
+	RTTITypeBase* TestLegacyPlainObject::getRTTI() const
+	{
+		return TestLegacyPlainObject::getRTTIStatic();
+	}
+
+	RTTITypeBase* TestBoolArrayObject::getRTTIStatic()
+	{
+		return TestBoolArrayObjectRTTI::instance();
+	}
+
+	RTTITypeBase* TestBoolArrayObject::getRTTI() const
+	{
+		return TestBoolArrayObject::getRTTIStatic();
+	}
+
+	/** Node of an object graph, referencing other nodes through shared, weak and array reflectable pointer fields. */
+	struct TestNode : IReflectable
+	{
+		UINT32 id = 0;
+		String name;
+
+		SPtr<TestNode> child;
+		SPtr<TestNode> parent; /**< Weak reference, to allow cycles. */
+		Vector<SPtr<TestNode>> children;
+
+	public:
+		friend class TestNodeRTTI;
+		static RTTITypeBase* getRTTIStatic();
+		RTTITypeBase* getRTTI() const override;
+	};
+
+	struct TestDerivedNode : TestNode
+	{
+		float weight = 0.0f;
+		Vector<UINT32> values;
+
+	public:
+		friend class TestDerivedNodeRTTI;
+		static RTTITypeBase* getRTTIStatic();
+		RTTITypeBase* getRTTI() const override;
+	};
+
+	class TestNodeRTTI : public RTTIType<TestNode, IReflectable, TestNodeRTTI>
+	{
+	private:
+		BS_BEGIN_RTTI_MEMBERS
+			BS_RTTI_MEMBER_PLAIN(id, 0)
+			BS_RTTI_MEMBER_PLAIN(name, 1)
+			BS_RTTI_MEMBER_REFLPTR(child, 2)
+			BS_RTTI_MEMBER_REFLPTR_ARRAY(children, 3)
+		BS_END_RTTI_MEMBERS
+
+		SPtr<TestNode> getParent(TestNode* obj) { return obj->parent; }
+		void setParent(TestNode* obj, SPtr<TestNode> val) { obj->parent = val; }
+
+	public:
+		TestNodeRTTI()
+			:mInitMembers(this)
+		{
+			addReflectablePtrField("parent", 4, &TestNodeRTTI::getParent, &TestNodeRTTI::setParent, RTTI_Flag_WeakRef);
+		}
+
+		const String& getRTTIName() override
+		{
+			static String name = "TestNode";
+			return name;
+		}
+
+		UINT32 getRTTIId() override
+		{
+			return TID_TestNode;
+		}
+
+		SPtr<IReflectable> newRTTIObject() override
+		{
+			return bs_shared_ptr_new<TestNode>();
+		}
+	};
+
+	class TestDerivedNodeRTTI : public RTTIType<TestDerivedNode, TestNode, TestDerivedNodeRTTI>
+	{
+	private:
+		BS_BEGIN_RTTI_MEMBERS
+			BS_RTTI_MEMBER_PLAIN(weight, 0)
+			BS_RTTI_MEMBER_PLAIN_ARRAY(values, 1)
+		BS_END_RTTI_MEMBERS
+
+	public:
+		TestDerivedNodeRTTI()
+			:mInitMembers(this)
+		{ }
+
+		const String& getRTTIName() override
+		{
+			static String name = "TestDerivedNode";
+			return name;
+		}
+
+		UINT32 getRTTIId() override
+		{
+			return TID_TestDerivedNode;
+		}
+
+		SPtr<IReflectable> newRTTIObject() override
+		{
+			return bs_shared_ptr_new<TestDerivedNode>();
+		}
+	};
+
+	RTTITypeBase* TestNode::getRTTIStatic()
+	{
+		return TestNodeRTTI::instance();
+	}
+
+	RTTITypeBase* TestNode::getRTTI() const
+	{
+		return TestNode::getRTTIStatic();
+	}
+
+	RTTITypeBase* TestDerivedNode::getRTTIStatic()
+	{
+		return TestDerivedNodeRTTI::instance();
+	}
+
+	RTTITypeBase* TestDerivedNode::getRTTI() const
+	{
+		return TestDerivedNode::getRTTIStatic();
+	}
+
+	/** @endcond */
+
+	/** Assigns values different from the defaults to all fields of the provided object. */
+	void fillPlainData(TestPlainData& data)
+	{
+		data.intVal = 42;
+		data.floatVal = -3.25f;
+		data.strVal = "serialized";
+		data.desc.width = 1920;
+		data.desc.height = 1080;
+
+		data.arrInt = { 10, 20, 30, 40, 50 };
+		data.arrVec = { Vector3(0.5f, -1.0f, 2.0f), Vector3(3.0f, 4.0f, 5.0f), Vector3::ZERO };
+		data.arrStr = { "first", "", "third" };
+		data.arrEmpty.clear();
+	}
+
+	/** Encodes the object into memory and decodes it into a new object. */
+	template<class T>
+	SPtr<T> roundTrip(T& object)
+	{
+		MemorySerializer ms;
+		UINT32 size = 0;
+		UINT8* buffer = ms.encode(&object, size);
+
+		SPtr<T> output = std::static_pointer_cast<T>(ms.decode(buffer, size));
+		bs_free(buffer);
+
+		return output;
+	}
+
+	/** Returns the plain field with the specified name from the RTTI type of the provided object. */
+	RTTIPlainFieldBase* getPlainField(IReflectable& object, const String& name)
+	{
+		return static_cast<RTTIPlainFieldBase*>(object.getRTTI()->findField(name));
+	}
+
+	/**
+	 * Creates a graph of nodes, with the root and one child of derived type. One node is referenced from multiple fields,
+	 * and children reference the root through weak references.
+	 */
+	SPtr<TestDerivedNode> createNodeGraph(UINT32 numValues)
+	{
+		SPtr<TestDerivedNode> root = bs_shared_ptr_new<TestDerivedNode>();
+		root->id = 1;
+		root->name = "root";
+		root->weight = 2.5f;
+		for (UINT32 i = 0; i < numValues; i++)
+			root->values.push_back(i * 3);
+
+		SPtr<TestNode> shared = bs_shared_ptr_new<TestNode>();
+		shared->id = 2;
+		shared->name = "shared";
+		shared->parent = root;
+
+		SPtr<TestDerivedNode> leaf = bs_shared_ptr_new<TestDerivedNode>();
+		leaf->id = 3;
+		leaf->name = "leaf";
+		leaf->weight = -1.0f;
+		leaf->values = { 5 };
+		leaf->parent = root;
+
+		root->child = shared;
+		root->children = { shared, nullptr, leaf, shared };
+
+		return root;
+	}
+
+	/** Checks that a decoded graph matches the graph created by createNodeGraph(). */
+	bool isNodeGraphValid(const SPtr<IReflectable>& object, UINT32 numValues)
+	{
+		if (object == nullptr || object->getTypeId() != TID_TestDerivedNode)
+			return false;
+
+		SPtr<TestDerivedNode> root = std::static_pointer_cast<TestDerivedNode>(object);
+		if (root->id != 1 || root->name != "root" || root->weight != 2.5f || root->values.size() != numValues)
+			return false;
+
+		for (UINT32 i = 0; i < numValues; i++)
+		{
+			if (root->values[i] != i * 3)
+				return false;
+		}
+
+		SPtr<TestNode> shared = root->child;
+		if (shared == nullptr || shared->getTypeId() != TID_TestNode || shared->id != 2 || shared->name != "shared" || 
+			shared->parent != root)
+			return false;
+
+		if (root->children.size() != 4 || root->children[0] != shared || root->children[1] != nullptr || 
+			root->children[3] != shared)
+			return false;
+
+		SPtr<TestNode> leaf = root->children[2];
+		if (leaf == nullptr || leaf->getTypeId() != TID_TestDerivedNode || leaf->id != 3 || leaf->parent != root)
+			return false;
+
+		SPtr<TestDerivedNode> derivedLeaf = std::static_pointer_cast<TestDerivedNode>(leaf);
+		return derivedLeaf->weight == -1.0f && derivedLeaf->values == Vector<UINT32>({ 5 });
+	}
+
+	/** Clears the weak references in a graph created by createNodeGraph(), so the cycles don't keep it alive. */
+	void releaseNodeGraph(const SPtr<IReflectable>& object)
+	{
+		if (object == nullptr)
+			return;
+
+		SPtr<TestNode> root = std::static_pointer_cast<TestNode>(object);
+		if (root->child != nullptr)
+			root->child->parent = nullptr;
+
+		for (auto& child : root->children)
+		{
+			if (child != nullptr)
+				child->parent = nullptr;
+		}
+	}
+
+	SerializationTestSuite::SerializationTestSuite()
+	{
+		BS_ADD_TEST(SerializationTestSuite::testPlainMemberFields);
+		BS_ADD_TEST(SerializationTestSuite::testPlainArrayStorage);
+		BS_ADD_TEST(SerializationTestSuite::testPlainArrayRoundTrip);
+		BS_ADD_TEST(SerializationTestSuite::testPlainMemberFormat);
+		BS_ADD_TEST(SerializationTestSuite::testDecodeMemoryStream);
+		BS_ADD_TEST(SerializationTestSuite::testDecodeFileStream);
+		BS_ADD_TEST(SerializationTestSuite::testDecodeReferences);
+		BS_ADD_TEST(SerializationTestSuite::testDecodeBaseClassFields);
+		BS_ADD_TEST(SerializationTestSuite::testDecodeReflectablePtrArrays);
+	}
+
+	void SerializationTestSuite::testPlainMemberFields()
+	{
+		TestPlainObject object;
+		fillPlainData(object);
+
+		SPtr<TestPlainObject> output = roundTrip(object);
+		BS_TEST_ASSERT(output != nullptr);
+
+		BS_TEST_ASSERT(output->intVal == object.intVal);
+		BS_TEST_ASSERT(output->floatVal == object.floatVal);
+		BS_TEST_ASSERT(output->strVal == object.strVal);
+		BS_TEST_ASSERT(output->desc.width == object.desc.width);
+		BS_TEST_ASSERT(output->desc.height == object.desc.height);
+
+		BS_TEST_ASSERT(output->arrInt == object.arrInt);
+		BS_TEST_ASSERT(output->arrVec == object.arrVec);
+		BS_TEST_ASSERT(output->arrStr == object.arrStr);
+		BS_TEST_ASSERT(output->arrEmpty.empty());
+
+		// Fields named after a member-of-member expression access that exact member
+		RTTIPlainFieldBase* widthField = getPlainField(object, "width");
+		BS_TEST_ASSERT(widthField != nullptr && !widthField->mIsVectorType);
+
+		UINT32 width = 0;
+		widthField->toBuffer(&object, &width);
+		BS_TEST_ASSERT(width == object.desc.width);
+	}
+
+	void SerializationTestSuite::testPlainArrayStorage()
+	{
+		TestPlainObject object;
+		fillPlainData(object);
+
+		// Arrays of memcpy types expose their storage for bulk copies
+		BS_TEST_ASSERT(getPlainField(object, "arrInt")->getArrayData(&object) == (UINT8*)object.arrInt.data());
+		BS_TEST_ASSERT(getPlainField(object, "arrVec")->getArrayData(&object) == (UINT8*)object.arrVec.data());
+
+		// Types with a custom serialized form are serialized element by element
+		BS_TEST_ASSERT(getPlainField(object, "arrStr")->getArrayData(&object) == nullptr);
+
+		// Vector<bool> has no contiguous storage
+		TestBoolArrayObject boolObject;
+		BS_TEST_ASSERT(getPlainField(boolObject, "values")->getArrayData(&boolObject) == nullptr);
+
+		// Getter/setter based fields never expose their storage
+		TestLegacyPlainObject legacyObject;
+		BS_TEST_ASSERT(getPlainField(legacyObject, "arrInt")->getArrayData(&legacyObject) == nullptr);
+	}
+
+	void SerializationTestSuite::testPlainArrayRoundTrip()
+	{
+		const UINT32 numElements = 10000;
+
+		TestPlainObject object;
+		object.arrInt.resize(numElements);
+		object.arrVec.resize(numElements);
+		for (UINT32 i = 0; i < numElements; i++)
+		{
+			object.arrInt[i] = i * 7919;
+			object.arrVec[i] = Vector3((float)i, (float)i * 0.5f, -(float)i);
+		}
+
+		SPtr<TestPlainObject> output = roundTrip(object);
+		BS_TEST_ASSERT(output->arrInt == object.arrInt);
+		BS_TEST_ASSERT(output->arrVec == object.arrVec);
+
+		// Decoding a smaller array must replace the default contents, not append to them
+		object.arrInt = { 99 };
+		output = roundTrip(object);
+		BS_TEST_ASSERT(output->arrInt.size() == 1 && output->arrInt[0] == 99);
+
+		TestBoolArrayObject boolObject;
+		boolObject.values = { true, false, true, true, false };
+
+		SPtr<TestBoolArrayObject> boolOutput = roundTrip(boolObject);
+		BS_TEST_ASSERT(boolOutput->values == boolObject.values);
+	}
+
+	void SerializationTestSuite::testPlainMemberFormat()
+	{
+		TestPlainObject object;
+		fillPlainData(object);
+
+		TestLegacyPlainObject legacyObject;
+		fillPlainData(legacyObject);
+
+		MemorySerializer ms;
+		UINT32 size = 0;
+		UINT8* buffer = ms.encode(&object, size);
+
+		UINT32 legacySize = 0;
+		UINT8* legacyBuffer = ms.encode(&legacyObject, legacySize);
+
+		// Only the type ID in the object header differs, all field data must be encoded identically
+		const UINT32 headerSize = sizeof(UINT32) * 2;
+		BS_TEST_ASSERT(size == legacySize);
+		if (size == legacySize)
+			BS_TEST_ASSERT(memcmp(buffer + headerSize, legacyBuffer + headerSize, size - headerSize) == 0);
+
+		bs_free(buffer);
+		bs_free(legacyBuffer);
+	}
+
+	void SerializationTestSuite::testDecodeMemoryStream()
+	{
+		const UINT32 numValues = 100;
+
+		SPtr<TestDerivedNode> root = createNodeGraph(numValues);
+
+		MemorySerializer ms;
+		UINT32 size = 0;
+		UINT8* buffer = ms.encode(root.get(), size);
+
+		// Direct decode
+		BinarySerializer bs;
+		SPtr<IReflectable> output = bs.decode(bs_shared_ptr_new<MemoryDataStream>(buffer, size, false), size);
+		BS_TEST_ASSERT(isNodeGraphValid(output, numValues));
+
+		// Decode through the intermediate representation must produce the same result
+		SPtr<SerializedObject> intermediate = bs._decodeToIntermediate(
+			bs_shared_ptr_new<MemoryDataStream>(buffer, size, false), size, true);
+		SPtr<IReflectable> intermediateOutput = bs._decodeFromIntermediate(intermediate);
+		BS_TEST_ASSERT(isNodeGraphValid(intermediateOutput, numValues));
+
+		bs_free(buffer);
+
+		releaseNodeGraph(root);
+		releaseNodeGraph(output);
+		releaseNodeGraph(intermediateOutput);
+	}
+
+	void SerializationTestSuite::testDecodeFileStream()
+	{
+		// Large enough that field data spans multiple reads from the file
+		const UINT32 numValues = 100000;
+
+		SPtr<TestDerivedNode> root = createNodeGraph(numValues);
+
+		MemorySerializer ms;
+		UINT32 size = 0;
+		UINT8* buffer = ms.encode(root.get(), size);
+
+		Path filePath = FileSystem::getTempDirectoryPath();
+		filePath.append("SerializationTestSuite.bin");
+
+		SPtr<DataStream> outStream = FileSystem::createAndOpenFile(filePath);
+		outStream->write(buffer, size);
+		outStream->close();
+
+		bs_free(buffer);
+
+		SPtr<DataStream> inStream = FileSystem::openFile(filePath);
+		BS_TEST_ASSERT(inStream != nullptr && inStream->size() == size);
+
+		BinarySerializer bs;
+		SPtr<IReflectable> output = bs.decode(inStream, size);
+		inStream->close();
+
+		BS_TEST_ASSERT(isNodeGraphValid(output, numValues));
+
+		FileSystem::remove(filePath);
+
+		releaseNodeGraph(root);
+		releaseNodeGraph(output);
+	}
+
+	void SerializationTestSuite::testDecodeReferences()
+	{
+		SPtr<TestDerivedNode> root = createNodeGraph(0);
+		SPtr<TestDerivedNode> output = roundTrip(*root);
+
+		// Object referenced from multiple fields is decoded once
+		BS_TEST_ASSERT(output->child != nullptr && output->child != root->child);
+		BS_TEST_ASSERT(output->children[0] == output->child);
+		BS_TEST_ASSERT(output->children[3] == output->child);
+
+		// Weak references resolve to the decoded owner
+		BS_TEST_ASSERT(output->child->parent == output);
+		BS_TEST_ASSERT(output->children[2]->parent == output);
+		BS_TEST_ASSERT(output->parent == nullptr);
+
+		releaseNodeGraph(root);
+		releaseNodeGraph(output);
+	}
+
+	void SerializationTestSuite::testDecodeBaseClassFields()
+	{
+		SPtr<TestDerivedNode> root = createNodeGraph(16);
+		root->name = "derived";
+
+		SPtr<TestDerivedNode> output = roundTrip(*root);
+
+		// Fields of the base class
+		BS_TEST_ASSERT(output->id == root->id);
+		BS_TEST_ASSERT(output->name == "derived");
+		BS_TEST_ASSERT(output->child != nullptr && output->child->id == 2);
+
+		// Fields of the derived class
+		BS_TEST_ASSERT(output->weight == root->weight);
+		BS_TEST_ASSERT(output->values == root->values);
+
+		// Derived object referenced through a base class pointer keeps its type
+		SPtr<TestNode> leaf = output->children[2];
+		BS_TEST_ASSERT(leaf->getTypeId() == TID_TestDerivedNode);
+		BS_TEST_ASSERT(std::static_pointer_cast<TestDerivedNode>(leaf)->weight == -1.0f);
+
+		releaseNodeGraph(root);
+		releaseNodeGraph(output);
+	}
+
+	void SerializationTestSuite::testDecodeReflectablePtrArrays()
+	{
+		SPtr<TestDerivedNode> root = createNodeGraph(0);
+
+		// Long array of distinct objects, mixed with null entries
+		const UINT32 numChildren = 500;
+		for (UINT32 i = 0; i < numChildren; i++)
+		{
+			SPtr<TestNode> child;
+			if ((i % 5) != 0)
+			{
+				child = bs_shared_ptr_new<TestNode>();
+				child->id = 100 + i;
+				child->name = toString(i);
+			}
+
+			root->children.push_back(child);
+		}
+
+		SPtr<TestDerivedNode> output = roundTrip(*root);
+		BS_TEST_ASSERT(output->children.size() == root->children.size());
+
+		BS_TEST_ASSERT(output->children[0] == output->child);
+		BS_TEST_ASSERT(output->children[1] == nullptr);
+
+		bool allValid = true;
+		for (UINT32 i = 0; i < numChildren; i++)
+		{
+			const SPtr<TestNode>& child = output->children[4 + i];
+			if ((i % 5) == 0)
+				allValid &= child == nullptr;
+			else
+				allValid &= child != nullptr && child->id == 100 + i && child->name == toString(i);
+		}
+
+		BS_TEST_ASSERT(allValid);
+		releaseNodeGraph(output);
+
+		// Empty array
+		releaseNodeGraph(root);
+		root->children.clear();
+		output = roundTrip(*root);
+		BS_TEST_ASSERT(output->children.empty());
+
+		releaseNodeGraph(root);
+		releaseNodeGraph(output);
+	}
+}
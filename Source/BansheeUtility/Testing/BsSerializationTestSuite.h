@@ -0,0 +1,25 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "Testing/BsTestSuite.h"
+
+namespace bs
+{
+	class BS_UTILITY_EXPORT SerializationTestSuite : public TestSuite
+	{
+	public:
+		SerializationTestSuite();
+
+	private:
+		void testPlainMemberFields();
+		void testPlainArrayStorage();
+		void testPlainArrayRoundTrip();
+		void testPlainMemberFormat();
+		void testDecodeMemoryStream();
+		void testDecodeFileStream();
+		void testDecodeReferences();
+		void testDecodeBaseClassFields();
+		void testDecodeReflectablePtrArrays();
+	};
+}
@@ -0,0 +1,279 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "Testing/BsTaskSchedulerTestSuite.h"
+#include "Threading/BsTaskScheduler.h"
+#include "Threading/BsThreadPool.h"
+#include "Threading/BsParallel.h"
+
+namespace bs
+{
+	void TaskSchedulerTestSuite::startUp()
+	{
+		ThreadPool::startUp<TThreadPool<>>(BS_THREAD_HARDWARE_CONCURRENCY, TaskScheduler::MAX_WORKERS + 1);
+		TaskScheduler::startUp();
+	}
+
+	void TaskSchedulerTestSuite::shutDown()
+	{
+		TaskScheduler::shutDown();
+		ThreadPool::shutDown();
+	}
+
+	TaskSchedulerTestSuite::TaskSchedulerTestSuite()
+	{
+		BS_ADD_TEST(TaskSchedulerTestSuite::testManyTasks);
+		BS_ADD_TEST(TaskSchedulerTestSuite::testDependency);
+		BS_ADD_TEST(TaskSchedulerTestSuite::testMultipleDependencies);
+		BS_ADD_TEST(TaskSchedulerTestSuite::testNestedTasks);
+		BS_ADD_TEST(TaskSchedulerTestSuite::testCancel);
+		BS_ADD_TEST(TaskSchedulerTestSuite::testRequeue);
+		BS_ADD_TEST(TaskSchedulerTestSuite::testParallelFor);
+		BS_ADD_TEST(TaskSchedulerTestSuite::testParallelReduce);
+		BS_ADD_TEST(TaskSchedulerTestSuite::testParallelSort);
+	}
+
+	void TaskSchedulerTestSuite::testManyTasks()
+	{
+		const UINT32 numTasks = 10000;
+
+		std::atomic<UINT32> counter(0);
+		Vector<SPtr<Task>> tasks;
+		for (UINT32 i = 0; i < numTasks; i++)
+		{
+			SPtr<Task> task = Task::create("Test", [&counter]() { counter++; });
+			TaskScheduler::instance().addTask(task);
+
+			tasks.push_back(task);
+		}
+
+		for (auto& task : tasks)
+			task->wait();
+
+		BS_TEST_ASSERT(counter == numTasks);
+	}
+
+	void TaskSchedulerTestSuite::testDependency()
+	{
+		std::atomic<UINT32> order(0);
+		UINT32 firstOrder = 0;
+		UINT32 secondOrder = 0;
+
+		SPtr<Task> first = Task::create("First", [&]() { BS_THREAD_SLEEP(10); firstOrder = ++order; });
+		SPtr<Task> second = Task::create("Second", [&]() { secondOrder = ++order; }, TaskPriority::High, first);
+
+		// Queue the dependant first, it must still wait for its dependency
+		TaskScheduler::instance().addTask(second);
+		TaskScheduler::instance().addTask(first);
+
+		second->wait();
+
+		BS_TEST_ASSERT(first->isComplete());
+		BS_TEST_ASSERT(firstOrder == 1);
+		BS_TEST_ASSERT(secondOrder == 2);
+	}
+
+	void TaskSchedulerTestSuite::testMultipleDependencies()
+	{
+		const UINT32 numDependencies = 64;
+
+		std::atomic<UINT32> counter(0);
+		UINT32 counterInFinal = 0;
+
+		SPtr<Task> finalTask = Task::create("Final", [&]() { counterInFinal = counter; });
+
+		Vector<SPtr<Task>> dependencies;
+		for (UINT32 i = 0; i < numDependencies; i++)
+		{
+			SPtr<Task> task = Task::create("Dependency", [&counter]() { counter++; });
+			finalTask->addDependency(task);
+
+			dependencies.push_back(task);
+		}
+
+		TaskScheduler::instance().addTask(finalTask);
+		for (auto& task : dependencies)
+			TaskScheduler::instance().addTask(task);
+
+		finalTask->wait();
+		BS_TEST_ASSERT(counterInFinal == numDependencies);
+	}
+
+	void TaskSchedulerTestSuite::testNestedTasks()
+	{
+		const UINT32 numOuter = 16;
+		const UINT32 numInner = 64;
+
+		std::atomic<UINT32> counter(0);
+		Vector<SPtr<Task>> tasks;
+		for (UINT32 i = 0; i < numOuter; i++)
+		{
+			auto outerWorker = [&counter]()
+			{
+				Vector<SPtr<Task>> innerTasks;
+				for (UINT32 j = 0; j < numInner; j++)
+				{
+					SPtr<Task> task = Task::create("Inner", [&counter]() { counter++; });
+					TaskScheduler::instance().addTask(task);
+
+					innerTasks.push_back(task);
+				}
+
+				// Waiting from within a worker executes other tasks in the meantime
+				for (auto& task : innerTasks)
+					task->wait();
+			};
+
+			SPtr<Task> task = Task::create("Outer", outerWorker);
+			TaskScheduler::instance().addTask(task);
+
+			tasks.push_back(task);
+		}
+
+		for (auto& task : tasks)
+			task->wait();
+
+		BS_TEST_ASSERT(counter == numOuter * numInner);
+	}
+
+	void TaskSchedulerTestSuite::testCancel()
+	{
+		bool executed = false;
+
+		// Block the workers so the task doesn't start before it is canceled
+		Vector<SPtr<Task>> blockers;
+		std::atomic<bool> release(false);
+		for (UINT32 i = 0; i < TaskScheduler::instance().getNumWorkers(); i++)
+		{
+			SPtr<Task> blocker = Task::create("Blocker", [&release]() { while (!release) BS_THREAD_SLEEP(1); },
+				TaskPriority::VeryHigh);
+			TaskScheduler::instance().addTask(blocker);
+
+			blockers.push_back(blocker);
+		}
+
+		std::atomic<UINT32> numContinuationsExecuted(0);
+		auto continuationWorker = [&numContinuationsExecuted]() { numContinuationsExecuted++; };
+
+		SPtr<Task> task = Task::create("Canceled", [&executed]() { executed = true; }, TaskPriority::VeryLow);
+		SPtr<Task> continuation = Task::create("Continuation", continuationWorker, TaskPriority::Normal, task);
+		SPtr<Task> nestedContinuation = Task::create("NestedContinuation", continuationWorker, TaskPriority::Normal,
+			continuation);
+
+		TaskScheduler::instance().addTask(task);
+		TaskScheduler::instance().addTask(continuation);
+		TaskScheduler::instance().addTask(nestedContinuation);
+		task->cancel();
+
+		// Queued after its dependency was already canceled
+		SPtr<Task> lateContinuation = Task::create("LateContinuation", continuationWorker, TaskPriority::Normal, task);
+		TaskScheduler::instance().addTask(lateContinuation);
+
+		release = true;
+		for (auto& blocker : blockers)
+			blocker->wait();
+
+		// Cancellation propagates to all dependants, so waiting on them must not block
+		nestedContinuation->wait();
+		lateContinuation->wait();
+
+		BS_TEST_ASSERT(task->isCanceled());
+		BS_TEST_ASSERT(!executed);
+		BS_TEST_ASSERT(continuation->isCanceled());
+		BS_TEST_ASSERT(nestedContinuation->isCanceled());
+		BS_TEST_ASSERT(lateContinuation->isCanceled());
+		BS_TEST_ASSERT(numContinuationsExecuted == 0);
+
+		// Tasks that don't depend on the canceled task are unaffected
+		SPtr<Task> unrelated = Task::create("Unrelated", continuationWorker);
+		TaskScheduler::instance().addTask(unrelated);
+		unrelated->wait();
+
+		BS_TEST_ASSERT(unrelated->isComplete());
+		BS_TEST_ASSERT(numContinuationsExecuted == 1);
+	}
+
+	void TaskSchedulerTestSuite::testRequeue()
+	{
+		std::atomic<UINT32> counter(0);
+		SPtr<Task> task = Task::create("Requeued", [&counter]() { counter++; });
+
+		for (UINT32 i = 0; i < 100; i++)
+		{
+			TaskScheduler::instance().addTask(task);
+			task->wait();
+		}
+
+		BS_TEST_ASSERT(counter == 100);
+	}
+
+	void TaskSchedulerTestSuite::testParallelFor()
+	{
+		const UINT32 numElements = 100000;
+
+		Vector<UINT32> values(numElements, 0);
+		parallelFor(0, numElements, 1000, [&values](UINT32 i) { values[i] += i; });
+
+		bool allValid = true;
+		for (UINT32 i = 0; i < numElements; i++)
+			allValid &= values[i] == i;
+
+		BS_TEST_ASSERT(allValid);
+
+		// Nested
+		std::atomic<UINT32> counter(0);
+		parallelFor(0, 16, 1, [&counter](UINT32 i)
+		{
+			parallelFor(0, 1000, 10, [&counter](UINT32 j) { counter++; });
+		});
+
+		BS_TEST_ASSERT(counter == 16 * 1000);
+
+		// Empty and single chunk ranges
+		UINT32 numCalls = 0;
+		parallelFor(10, 10, 1, [&numCalls](UINT32 i) { numCalls++; });
+		BS_TEST_ASSERT(numCalls == 0);
+
+		parallelFor(0, 5, 100, [&numCalls](UINT32 i) { numCalls++; });
+		BS_TEST_ASSERT(numCalls == 5);
+	}
+
+	void TaskSchedulerTestSuite::testParallelReduce()
+	{
+		const UINT32 numElements = 100001;
+
+		UINT64 sum = parallelReduce(0, numElements, 1000, (UINT64)0,
+			[](UINT32 i) { return (UINT64)i; },
+			[](UINT64 a, UINT64 b) { return a + b; });
+
+		BS_TEST_ASSERT(sum == ((UINT64)numElements * (numElements - 1)) / 2);
+
+		UINT32 max = parallelReduce(0, 0, 1000, 0U,
+			[](UINT32 i) { return i; },
+			[](UINT32 a, UINT32 b) { return std::max(a, b); });
+
+		BS_TEST_ASSERT(max == 0);
+	}
+
+	void TaskSchedulerTestSuite::testParallelSort()
+	{
+		const UINT32 numElements = 50000;
+
+		Vector<UINT32> values(numElements);
+		UINT32 seed = 12345;
+		for (UINT32 i = 0; i < numElements; i++)
+		{
+			seed = seed * 1103515245 + 12345;
+			values[i] = seed >> 8;
+		}
+
+		Vector<UINT32> expected = values;
+		std::sort(expected.begin(), expected.end());
+
+		parallelSort(values.begin(), values.end(), std::less<UINT32>(), 1000);
+		BS_TEST_ASSERT(values == expected);
+
+		std::reverse(values.begin(), values.end());
+		parallelSort(values.begin(), values.end());
+		BS_TEST_ASSERT(values == expected);
+	}
+}
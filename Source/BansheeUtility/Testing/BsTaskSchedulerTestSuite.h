@@ -0,0 +1,27 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "Testing/BsTestSuite.h"
+
+namespace bs
+{
+	class BS_UTILITY_EXPORT TaskSchedulerTestSuite : public TestSuite
+	{
+	public:
+		TaskSchedulerTestSuite();
+		void startUp() override;
+		void shutDown() override;
+
+	private:
+		void testManyTasks();
+		void testDependency();
+		void testMultipleDependencies();
+		void testNestedTasks();
+		void testCancel();
+		void testRequeue();
+		void testParallelFor();
+		void testParallelReduce();
+		void testParallelSort();
+	};
+}
@@ -0,0 +1,89 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "Threading/BsParallel.h"
+#include "Threading/BsTaskScheduler.h"
+
+namespace bs
+{
+	/** Shared state of a single parallelForRange() call. */
+	struct ParallelForData
+	{
+		ParallelForData(const std::function<void(UINT32, UINT32)>* fn, UINT32 begin, UINT32 end, UINT32 grainSize,
+			UINT32 numChunks)
+			: fn(fn), begin(begin), end(end), grainSize(grainSize), numChunks(numChunks), nextChunk(0), numCompleted(0)
+		{ }
+
+		/** Claims the next unprocessed chunk and executes it. Returns false if there are no more chunks left. */
+		bool executeChunk()
+		{
+			UINT32 chunkIdx = nextChunk++;
+			if (chunkIdx >= numChunks)
+				return false;
+
+			UINT32 chunkBegin = begin + chunkIdx * grainSize;
+			UINT32 chunkEnd = chunkBegin + std::min(grainSize, end - chunkBegin);
+
+			(*fn)(chunkBegin, chunkEnd);
+
+			numCompleted++;
+			return true;
+		}
+
+		// Only accessed while there are unclaimed chunks, during which the caller is guaranteed to still be waiting
+		const std::function<void(UINT32, UINT32)>* fn;
+
+		UINT32 begin;
+		UINT32 end;
+		UINT32 grainSize;
+		UINT32 numChunks;
+
+		std::atomic<UINT32> nextChunk;
+		std::atomic<UINT32> numCompleted;
+	};
+
+	void parallelForRange(UINT32 begin, UINT32 end, UINT32 grainSize, const std::function<void(UINT32, UINT32)>& fn)
+	{
+		grainSize = std::max(grainSize, 1U);
+
+		UINT32 numChunks = getNumParallelChunks(begin, end, grainSize);
+		if (numChunks == 0)
+			return;
+
+		UINT32 numHelpers = 0;
+		if (TaskScheduler::isStarted())
+			numHelpers = std::min(TaskScheduler::instance().getNumWorkers(), numChunks - 1);
+
+		if (numHelpers == 0)
+		{
+			for (UINT32 chunkBegin = begin; chunkBegin < end; chunkBegin += grainSize)
+			{
+				UINT32 chunkEnd = chunkBegin + std::min(grainSize, end - chunkBegin);
+				fn(chunkBegin, chunkEnd);
+
+				if (chunkEnd == end)
+					break;
+			}
+
+			return;
+		}
+
+		// Helper tasks may start after this call returns (in which case they find no work), so they share ownership
+		SPtr<ParallelForData> data = bs_shared_ptr_new<ParallelForData>(&fn, begin, end, grainSize, numChunks);
+
+		auto helper = [data]()
+		{
+			while (data->executeChunk())
+			{ }
+		};
+
+		for (UINT32 i = 0; i < numHelpers; i++)
+			TaskScheduler::instance().addTask(Task::create("ParallelFor", helper, TaskPriority::High));
+
+		// Help out instead of blocking, then wait for chunks still being executed by the workers
+		while (data->executeChunk())
+		{ }
+
+		while (data->numCompleted.load() < numChunks)
+			std::this_thread::yield();
+	}
+}
@@ -0,0 +1,155 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "Prerequisites/BsPrerequisitesUtil.h"
+
+namespace bs
+{
+	/** @addtogroup Threading
+	 *  @{
+	 */
+
+	/** Returns the number of chunks the range [@p begin, @p end) is split into by the parallel algorithms. */
+	inline UINT32 getNumParallelChunks(UINT32 begin, UINT32 end, UINT32 grainSize)
+	{
+		if (end <= begin)
+			return 0;
+
+		grainSize = std::max(grainSize, 1U);
+		return (end - begin + grainSize - 1) / grainSize;
+	}
+
+	/**
+	 * Splits the range [@p begin, @p end) into chunks of @p grainSize elements and executes @p fn for each chunk. Chunks
+	 * are distributed between the TaskScheduler workers and the calling thread. The calling thread executes chunks
+	 * itself and only returns once all the chunks have been executed.
+	 *
+	 * @param[in]	begin		First index in the range.
+	 * @param[in]	end			One past the last index in the range.
+	 * @param[in]	grainSize	Maximum number of elements processed by a single call to @p fn. Should be large enough so
+	 *							that the work per chunk outweighs the cost of scheduling it.
+	 * @param[in]	fn			Function to execute for each chunk. Receives the first index in the chunk and one past the
+	 *							last index in the chunk. Will be called from multiple threads simultaneously.
+	 *
+	 * @note	If the TaskScheduler hasn't been started, or the range fits in a single chunk, the function executes
+	 *			all the chunks on the calling thread.
+	 */
+	BS_UTILITY_EXPORT void parallelForRange(UINT32 begin, UINT32 end, UINT32 grainSize,
+		const std::function<void(UINT32, UINT32)>& fn);
+
+	/**
+	 * Executes @p fn for each index in range [@p begin, @p end), distributing the work between the TaskScheduler workers
+	 * and the calling thread. Returns once @p fn has been executed for all indices.
+	 *
+	 * @param[in]	begin		First index in the range.
+	 * @param[in]	end			One past the last index in the range.
+	 * @param[in]	grainSize	Number of indices processed sequentially by a single worker before it grabs more work.
+	 * @param[in]	fn			Function to execute for each index. Will be called from multiple threads simultaneously.
+	 */
+	template<class Fn>
+	void parallelFor(UINT32 begin, UINT32 end, UINT32 grainSize, const Fn& fn)
+	{
+		parallelForRange(begin, end, grainSize,
+			[&fn](UINT32 chunkBegin, UINT32 chunkEnd)
+		{
+			for (UINT32 i = chunkBegin; i < chunkEnd; i++)
+				fn(i);
+		});
+	}
+
+	/**
+	 * Maps each index in the range [@p begin, @p end) to a value and combines all the values into a single result. Work
+	 * is distributed between the TaskScheduler workers and the calling thread.
+	 *
+	 * @param[in]	begin		First index in the range.
+	 * @param[in]	end			One past the last index in the range.
+	 * @param[in]	grainSize	Number of indices processed sequentially by a single worker before it grabs more work.
+	 * @param[in]	identity	Identity value of the reduction (e.g. zero for a sum). Used as the initial value of each
+	 *							chunk.
+	 * @param[in]	map			Function with signature T(UINT32) that returns the value for a single index. Will be
+	 *							called from multiple threads simultaneously.
+	 * @param[in]	reduce		Function with signature T(const T&, const T&) that combines two values. Must be
+	 *							associative. Values are always combined in index order, so the result is deterministic.
+	 * @return					Combined value of all the indices, or @p identity if the range is empty.
+	 */
+	template<class T, class MapFn, class ReduceFn>
+	T parallelReduce(UINT32 begin, UINT32 end, UINT32 grainSize, const T& identity, const MapFn& map,
+		const ReduceFn& reduce)
+	{
+		grainSize = std::max(grainSize, 1U);
+
+		UINT32 numChunks = getNumParallelChunks(begin, end, grainSize);
+		Vector<T> partialResults(numChunks, identity);
+
+		parallelForRange(begin, end, grainSize,
+			[&](UINT32 chunkBegin, UINT32 chunkEnd)
+		{
+			T result = identity;
+			for (UINT32 i = chunkBegin; i < chunkEnd; i++)
+				result = reduce(result, map(i));
+
+			partialResults[(chunkBegin - begin) / grainSize] = result;
+		});
+
+		T output = identity;
+		for (auto& entry : partialResults)
+			output = reduce(output, entry);
+
+		return output;
+	}
+
+	/**
+	 * Sorts the elements in range [@p first, @p last) using the provided comparison function. Sub-ranges of
+	 * @p grainSize elements are sorted in parallel, after which they are merged together in parallel passes. Work is
+	 * distributed between the TaskScheduler workers and the calling thread. The sort is not stable.
+	 *
+	 * @param[in]	first		Random access iterator to the first element to sort.
+	 * @param[in]	last		Random access iterator one past the last element to sort.
+	 * @param[in]	comp		Comparison function returning true if the first argument should be ordered before the
+	 *							second.
+	 * @param[in]	grainSize	Size of the sub-ranges initially sorted by a single worker.
+	 */
+	template<class RandomIt, class Compare>
+	void parallelSort(RandomIt first, RandomIt last, Compare comp, UINT32 grainSize = 4096)
+	{
+		UINT32 count = (UINT32)(last - first);
+		grainSize = std::max(grainSize, 2U);
+
+		if (count <= grainSize)
+		{
+			std::sort(first, last, comp);
+			return;
+		}
+
+		parallelForRange(0, count, grainSize,
+			[&](UINT32 chunkBegin, UINT32 chunkEnd)
+		{
+			std::sort(first + chunkBegin, first + chunkEnd, comp);
+		});
+
+		for (UINT32 width = grainSize; width < count; width *= 2)
+		{
+			UINT32 numMerges = (count + width * 2 - 1) / (width * 2);
+			parallelFor(0, numMerges, 1,
+				[&](UINT32 mergeIdx)
+			{
+				UINT32 start = mergeIdx * width * 2;
+				UINT32 middle = std::min(start + width, count);
+				UINT32 end = std::min(start + width * 2, count);
+
+				if (middle < end)
+					std::inplace_merge(first + start, first + middle, first + end, comp);
+			});
+		}
+	}
+
+	/** @copydoc parallelSort(RandomIt, RandomIt, Compare, UINT32) */
+	template<class RandomIt>
+	void parallelSort(RandomIt first, RandomIt last)
+	{
+		parallelSort(first, last, std::less<typename std::iterator_traits<RandomIt>::value_type>());
+	}
+
+	/** @} */
+}
@@ -2,20 +2,90 @@
 //**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
 #include "Threading/BsTaskScheduler.h"
 #include "Threading/BsThreadPool.h"
+#include "Allocators/BsPoolAlloc.h"
 
 namespace bs
 {
-	Task::Task(const PrivatelyConstruct& dummy, const String& name, std::function<void()> taskWorker, 
+	/** Number of times an idle worker will retry looking for a task before going to sleep. */
+	static const UINT32 WORKER_SPIN_COUNT = 64;
+
+	/** Size of a single element in the task pool. Allocations larger than this fall back to the general allocator. */
+	static const UINT32 TASK_POOL_ELEM_SIZE = 256;
+
+	/** Header prepended to every allocation made through MemoryAllocator<TaskAlloc>. */
+	struct TaskAllocHeader
+	{
+		UINT32 isPooled;
+		UINT32 padding[3];
+	};
+
+	/** Scheduler the current thread is a worker of, or null if the current thread is not a worker thread. */
+	static BS_THREADLOCAL TaskScheduler* sWorkerScheduler = nullptr;
+
+	/** Index of the worker running on the current thread. Only valid if sWorkerScheduler is not null. */
+	static BS_THREADLOCAL UINT32 sWorkerIdx = 0;
+
+	/** Returns the pool used for allocating tasks. */
+	static PoolAlloc<TASK_POOL_ELEM_SIZE, 128, 16, true>& getTaskPool()
+	{
+		static PoolAlloc<TASK_POOL_ELEM_SIZE, 128, 16, true> pool;
+		return pool;
+	}
+
+	void* MemoryAllocator<TaskAlloc>::allocate(size_t bytes)
+	{
+#if BS_PROFILING_ENABLED
+		incAllocCount();
+#endif
+
+		TaskAllocHeader* header;
+		if (bytes + sizeof(TaskAllocHeader) <= TASK_POOL_ELEM_SIZE)
+		{
+			header = (TaskAllocHeader*)getTaskPool().alloc();
+			header->isPooled = 1;
+		}
+		else
+		{
+			header = (TaskAllocHeader*)bs_alloc_aligned16((UINT32)(bytes + sizeof(TaskAllocHeader)));
+			header->isPooled = 0;
+		}
+
+		return header + 1;
+	}
+
+	void MemoryAllocator<TaskAlloc>::free(void* ptr)
+	{
+#if BS_PROFILING_ENABLED
+		incFreeCount();
+#endif
+
+		TaskAllocHeader* header = ((TaskAllocHeader*)ptr) - 1;
+		if (header->isPooled)
+			getTaskPool().free(header);
+		else
+			bs_free_aligned16(header);
+	}
+
+	Task::Task(const PrivatelyConstruct& dummy, const String& name, std::function<void()> taskWorker,
 		TaskPriority priority, SPtr<Task> dependency)
-		: mName(name), mPriority(priority), mTaskId(0), mTaskWorker(taskWorker), mTaskDependency(dependency), mState(0)
+		: mName(name), mPriority(priority), mTaskId(0), mTaskWorker(taskWorker), mState(0), mNumPendingDependencies(0)
 		, mParent(nullptr)
 	{
-
+		if (dependency != nullptr)
+			mDependencies.push_back(dependency);
 	}
 
 	SPtr<Task> Task::create(const String& name, std::function<void()> taskWorker, TaskPriority priority, SPtr<Task> dependency)
 	{
-		return bs_shared_ptr_new<Task>(PrivatelyConstruct(), name, taskWorker, priority, dependency);
+		return bs_shared_ptr_new<Task, TaskAlloc>(PrivatelyConstruct(), name, taskWorker, priority, dependency);
+	}
+
+	void Task::addDependency(const SPtr<Task>& dependency)
+	{
+		assert(mSelf == nullptr && "Dependencies must be registered before the task is queued.");
+
+		if (dependency != nullptr)
+			mDependencies.push_back(dependency);
 	}
 
 	bool Task::isComplete() const
@@ -40,127 +110,295 @@ namespace bs
 	}
 
 	TaskScheduler::TaskScheduler()
-		:mTaskQueue(&TaskScheduler::taskCompare), mMaxActiveTasks(0), mNextTaskId(0), mShutdown(false)
+		: mNumWorkers(0), mNumSharedTasks(0), mNumQueuedTasks(0), mMaxActiveTasks(0), mNextTaskId(0), mShutdown(false)
+		, mNumSleeping(0), mNumWaiting(0)
 	{
-		mMaxActiveTasks = BS_THREAD_HARDWARE_CONCURRENCY;
+		for (UINT32 i = 0; i < MAX_WORKERS; i++)
+			mWorkers[i] = nullptr;
+
+		Lock lock(mSleepMutex);
 
-		mTaskSchedulerThread = ThreadPool::instance().run("TaskScheduler", std::bind(&TaskScheduler::runMain, this));
+		mMaxActiveTasks = BS_THREAD_HARDWARE_CONCURRENCY;
+		while (mNumWorkers < mMaxActiveTasks && mNumWorkers < MAX_WORKERS)
+			spawnWorker();
 	}
 
 	TaskScheduler::~TaskScheduler()
 	{
-		// Wait until all tasks complete
+		// Stop the workers. Any tasks currently executing will be allowed to complete.
 		{
-			Lock activeTaskLock(mReadyMutex);
+			Lock lock(mSleepMutex);
+			mShutdown = true;
+		}
 
-			while (mActiveTasks.size() > 0)
-			{
-				SPtr<Task> task = mActiveTasks[0];
-				activeTaskLock.unlock();
+		mTaskReadyCond.notify_all();
+		mWorkerParkCond.notify_all();
 
-				task->wait();
-				activeTaskLock.lock();
-			}
-		}
+		UINT32 numWorkers = mNumWorkers.load();
+		for (UINT32 i = 0; i < numWorkers; i++)
+			mWorkers[i]->thread.blockUntilComplete();
 
-		// Start shutdown of the main queue worker and wait until it exits
+		// Release any tasks that never got the chance to execute
+		for (UINT32 i = 0; i < numWorkers; i++)
 		{
-			Lock lock(mReadyMutex);
+			while (Task* task = mWorkers[i]->queue.pop())
+				task->mSelf = nullptr;
 
-			mShutdown = true;
+			bs_delete(mWorkers[i]);
 		}
 
-		mTaskReadyCond.notify_one();
-
-		mTaskSchedulerThread.blockUntilComplete();
+		for (auto& queue : mSharedQueues)
+		{
+			while (!queue.empty())
+			{
+				queue.front()->mSelf = nullptr;
+				queue.pop();
+			}
+		}
 	}
 
 	void TaskScheduler::addTask(const SPtr<Task>& task)
 	{
-		Lock lock(mReadyMutex);
-
 		assert(task->mState != 1 && "Task is already executing, it cannot be executed again until it finishes.");
 
 		task->mParent = this;
 		task->mTaskId = mNextTaskId++;
 		task->mState.store(0); // Reset state in case the task is getting re-queued
+		task->mSelf = task;
+
+		// Start at one so the task cannot be queued by a dependency finishing while we're still registering it
+		task->mNumPendingDependencies.store(1);
+
+		bool dependencyCanceled = false;
+		for (auto& dependency : task->mDependencies)
+		{
+			ScopedSpinLock lock(dependency->mContinuationLock);
+
+			if (dependency->isCanceled())
+			{
+				dependencyCanceled = true;
+				continue;
+			}
 
-		mTaskQueue.insert(task);
+			if (dependency->isComplete())
+				continue;
 
-		// Wake main scheduler thread
-		mTaskReadyCond.notify_one();
+			task->mNumPendingDependencies++;
+			dependency->mContinuations.push_back(task.get());
+		}
+
+		// Tasks depending on a canceled task are canceled as well. They still pass through the queue so that their own
+		// continuations get canceled in turn.
+		if (dependencyCanceled)
+			task->mState.store(3);
+
+		if (task->mNumPendingDependencies.fetch_sub(1) == 1)
+			queueReadyTask(task.get());
 	}
 
 	void TaskScheduler::addWorker()
 	{
-		Lock lock(mReadyMutex);
+		Lock lock(mSleepMutex);
 
 		mMaxActiveTasks++;
 
-		// A spot freed up, queue new tasks on main scheduler thread if they exist
-		mTaskReadyCond.notify_one();
+		// Create a new thread if all existing threads are already in use, otherwise wake up a parked one
+		if (mMaxActiveTasks > mNumWorkers && mNumWorkers < MAX_WORKERS)
+			spawnWorker();
+		else
+			mWorkerParkCond.notify_all();
+	}
+
+	bool TaskScheduler::activateParkedWorker()
+	{
+		Lock lock(mSleepMutex);
+
+		if (mMaxActiveTasks >= mNumWorkers)
+			return false;
+
+		mMaxActiveTasks++;
+		mWorkerParkCond.notify_all();
+
+		return true;
 	}
 
 	void TaskScheduler::removeWorker()
 	{
-		Lock lock(mReadyMutex);
+		Lock lock(mSleepMutex);
 
 		if(mMaxActiveTasks > 0)
 			mMaxActiveTasks--;
 	}
 
-	void TaskScheduler::runMain()
+	void TaskScheduler::spawnWorker()
 	{
-		while(true)
-		{
-			Lock lock(mReadyMutex);
+		UINT32 workerIdx = mNumWorkers;
 
-			while((mTaskQueue.size() == 0 || (UINT32)mActiveTasks.size() >= mMaxActiveTasks) && !mShutdown)
-				mTaskReadyCond.wait(lock);
+		Worker* worker = bs_new<Worker>();
+		mWorkers[workerIdx] = worker;
+		mNumWorkers.store(workerIdx + 1, std::memory_order_release);
 
-			if(mShutdown)
-				break;
+		worker->thread = ThreadPool::instance().run("TaskWorker", std::bind(&TaskScheduler::runWorker, this, workerIdx));
+	}
+
+	void TaskScheduler::runWorker(UINT32 workerIdx)
+	{
+		sWorkerScheduler = this;
+		sWorkerIdx = workerIdx;
 
-			for(UINT32 i = 0; (i < mTaskQueue.size()) && ((UINT32)mActiveTasks.size() < mMaxActiveTasks); i++)
+		UINT32 numSpins = 0;
+		while (!mShutdown)
+		{
+			// Workers above the active limit don't take on new work, but their queues can still be stolen from
+			if (workerIdx < mMaxActiveTasks)
 			{
-				SPtr<Task> curTask = *mTaskQueue.begin();
-				mTaskQueue.erase(mTaskQueue.begin());
+				Task* task = findTask(workerIdx);
+				if (task != nullptr)
+				{
+					runTask(task);
+					numSpins = 0;
+
+					continue;
+				}
 
-				if(curTask->isCanceled())
+				if (numSpins++ < WORKER_SPIN_COUNT)
+				{
+					std::this_thread::yield();
 					continue;
+				}
+			}
 
-				if(curTask->mTaskDependency != nullptr && !curTask->mTaskDependency->isComplete())
+			numSpins = 0;
+
+			Lock lock(mSleepMutex);
+			while (!mShutdown)
+			{
+				if (workerIdx >= mMaxActiveTasks)
+				{
+					mWorkerParkCond.wait(lock);
 					continue;
+				}
 
-				curTask->mState.store(1);
-				mActiveTasks.push_back(curTask);
+				mNumSleeping++;
+				if (mNumQueuedTasks.load() > 0)
+				{
+					mNumSleeping--;
+					break;
+				}
 
-				ThreadPool::instance().run(curTask->mName, std::bind(&TaskScheduler::runTask, this, curTask));
+				mTaskReadyCond.wait(lock);
+				mNumSleeping--;
 			}
 		}
+
+		sWorkerScheduler = nullptr;
 	}
 
-	void TaskScheduler::runTask(SPtr<Task> task)
+	Task* TaskScheduler::findTask(UINT32 workerIdx)
 	{
-		task->mTaskWorker();
+		// Local queue first, as its tasks are most likely still in cache
+		Task* task = mWorkers[workerIdx]->queue.pop();
 
+		// Tasks queued from outside of the scheduler, in priority order
+		if (task == nullptr && mNumSharedTasks.load() > 0)
 		{
-			Lock lock(mReadyMutex);
+			ScopedSpinLock lock(mSharedQueueLock);
 
-			auto findIter = std::find(mActiveTasks.begin(), mActiveTasks.end(), task);
-			if (findIter != mActiveTasks.end())
-				mActiveTasks.erase(findIter);
+			for (INT32 i = NUM_PRIORITIES - 1; i >= 0; i--)
+			{
+				if (!mSharedQueues[i].empty())
+				{
+					task = mSharedQueues[i].front();
+					mSharedQueues[i].pop();
+					mNumSharedTasks--;
+
+					break;
+				}
+			}
 		}
 
+		// Steal from other workers
+		if (task == nullptr)
 		{
-			Lock lock(mCompleteMutex);
+			UINT32 numWorkers = mNumWorkers.load(std::memory_order_acquire);
+			for (UINT32 i = 1; i < numWorkers && task == nullptr; i++)
+			{
+				UINT32 victimIdx = (workerIdx + i) % numWorkers;
+				task = mWorkers[victimIdx]->queue.steal();
+			}
+		}
+
+		if (task != nullptr)
+			mNumQueuedTasks--;
+
+		return task;
+	}
+
+	void TaskScheduler::queueReadyTask(Task* task)
+	{
+		mNumQueuedTasks++;
+
+		bool queued = false;
+		if (sWorkerScheduler == this)
+			queued = mWorkers[sWorkerIdx]->queue.push(task);
+
+		if (!queued)
+		{
+			ScopedSpinLock lock(mSharedQueueLock);
+
+			mSharedQueues[getPriorityIdx(task->mPriority)].push(task);
+			mNumSharedTasks++;
+		}
+
+		// Wake a sleeping worker, if any
+		if (mNumSleeping.load() > 0)
+		{
+			Lock lock(mSleepMutex);
+			mTaskReadyCond.notify_one();
+		}
+	}
+
+	void TaskScheduler::runTask(Task* task)
+	{
+		UINT32 expectedState = 0;
+		if (task->mState.compare_exchange_strong(expectedState, 1))
+		{
+			task->mTaskWorker();
 			task->mState.store(2);
+		}
 
-			mTaskCompleteCond.notify_all();
+		finishTask(task);
+	}
+
+	void TaskScheduler::finishTask(Task* task)
+	{
+		// Take ownership, the task might get destroyed once we release it below
+		SPtr<Task> self = std::move(task->mSelf);
+
+		Vector<Task*> continuations;
+		{
+			ScopedSpinLock lock(task->mContinuationLock);
+			std::swap(continuations, task->mContinuations);
+		}
+
+		bool canceled = task->isCanceled();
+		for (auto& continuation : continuations)
+		{
+			if (canceled)
+			{
+				UINT32 expectedState = 0;
+				continuation->mState.compare_exchange_strong(expectedState, 3);
+			}
+
+			if (continuation->mNumPendingDependencies.fetch_sub(1) == 1)
+				queueReadyTask(continuation);
 		}
 
-		// Possibly this task was someones dependency, so wake the main scheduler thread
-		mTaskReadyCond.notify_one();
+		if (mNumWaiting.load() > 0)
+		{
+			Lock lock(mCompleteMutex);
+			mTaskCompleteCond.notify_all();
+		}
 	}
 
 	void TaskScheduler::waitUntilComplete(const Task* task)
@@ -168,25 +406,47 @@ namespace bs
 		if(task->isCanceled())
 			return;
 
+		// Worker threads help out with other tasks while they wait
+		if (sWorkerScheduler == this)
 		{
-			Lock lock(mCompleteMutex);
-			
-			while(!task->isComplete())
+			while (!task->isComplete() && !task->isCanceled())
 			{
-				addWorker();
-				mTaskCompleteCond.wait(lock);
-				removeWorker();
+				Task* otherTask = findTask(sWorkerIdx);
+				if (otherTask != nullptr)
+					runTask(otherTask);
+				else
+					std::this_thread::yield();
 			}
+
+			return;
 		}
+
+		// Let a parked worker use this thread's core while it is blocked. No new threads are created for this, and the
+		// worker is parked again once the wait ends.
+		bool activatedWorker = activateParkedWorker();
+
+		{
+			Lock lock(mCompleteMutex);
+			mNumWaiting++;
+
+			while(!task->isComplete() && !task->isCanceled())
+				mTaskCompleteCond.wait(lock);
+
+			mNumWaiting--;
+		}
+
+		if (activatedWorker)
+			removeWorker();
 	}
 
-	bool TaskScheduler::taskCompare(const SPtr<Task>& lhs, const SPtr<Task>& rhs)
+	UINT32 TaskScheduler::getPriorityIdx(TaskPriority priority)
 	{
-		// If one tasks priority is higher, that one goes first
-		if(lhs->mPriority > rhs->mPriority)
-			return true;
+		if (priority <= TaskPriority::VeryLow)
+			return 0;
+
+		if (priority >= TaskPriority::VeryHigh)
+			return NUM_PRIORITIES - 1;
 
-		// Otherwise we go by smaller id, as that task was queued earlier than the other
-		return lhs->mTaskId < rhs->mTaskId;
+		return (UINT32)priority - (UINT32)TaskPriority::VeryLow;
 	}
-}
\ No newline at end of file
+}
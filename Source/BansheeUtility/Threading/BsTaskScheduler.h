@@ -5,6 +5,7 @@
 #include "Prerequisites/BsPrerequisitesUtil.h"
 #include "Utility/BsModule.h"
 #include "Threading/BsThreadPool.h"
+#include "Threading/BsWorkStealingQueue.h"
 
 namespace bs
 {
@@ -25,7 +26,7 @@ namespace bs
 
 	/**
 	 * Represents a single task that may be queued in the TaskScheduler.
-	 * 			
+	 *
 	 * @note	Thread safe.
 	 */
 	class BS_UTILITY_EXPORT Task
@@ -33,7 +34,7 @@ namespace bs
 		struct PrivatelyConstruct {};
 
 	public:
-		Task(const PrivatelyConstruct& dummy, const String& name, std::function<void()> taskWorker, 
+		Task(const PrivatelyConstruct& dummy, const String& name, std::function<void()> taskWorker,
 			TaskPriority priority, SPtr<Task> dependency);
 
 		/**
@@ -45,9 +46,15 @@ namespace bs
 		 * @param[in]	dependency	(optional) Task dependency if one exists. If provided the task will
 		 * 							not be executed until its dependency is complete.
 		 */
-		static SPtr<Task> create(const String& name, std::function<void()> taskWorker, TaskPriority priority = TaskPriority::Normal, 
+		static SPtr<Task> create(const String& name, std::function<void()> taskWorker, TaskPriority priority = TaskPriority::Normal,
 			SPtr<Task> dependency = nullptr);
 
+		/**
+		 * Registers an additional task that must complete before this task can execute. Must be called before the task
+		 * is queued in the TaskScheduler.
+		 */
+		void addDependency(const SPtr<Task>& dependency);
+
 		/** Returns true if the task has completed. */
 		bool isComplete() const;
 
@@ -55,13 +62,18 @@ namespace bs
 		bool isCanceled() const;
 
 		/**
-		 * Blocks the current thread until the task has completed. 
-		 * 
-		 * @note	While waiting adds a new worker thread, so that the blocking threads core can be utilized.
+		 * Blocks the current thread until the task has completed.
+		 *
+		 * @note
+		 * If called from one of the scheduler's worker threads, the thread will execute other queued tasks while it waits.
+		 * Otherwise a parked worker (if any) is activated while waiting, so that the blocking threads core can be utilized.
 		 */
 		void wait();
 
-		/** Cancels the task and removes it from the TaskSchedulers queue. */
+		/**
+		 * Cancels the task and removes it from the TaskSchedulers queue. Any tasks depending on this task are canceled as
+		 * well, unless they already started executing.
+		 */
 		void cancel();
 
 	private:
@@ -71,22 +83,31 @@ namespace bs
 		TaskPriority mPriority;
 		UINT32 mTaskId;
 		std::function<void()> mTaskWorker;
-		SPtr<Task> mTaskDependency;
 		std::atomic<UINT32> mState; /**< 0 - Inactive, 1 - In progress, 2 - Completed, 3 - Canceled */
 
+		Vector<SPtr<Task>> mDependencies;
+		std::atomic<UINT32> mNumPendingDependencies;
+		Vector<Task*> mContinuations;
+		SpinLock mContinuationLock;
+
+		SPtr<Task> mSelf; /**< Keeps the task alive while it is queued in the scheduler. */
 		TaskScheduler* mParent;
 	};
 
 	/**
 	 * Represents a task scheduler running on multiple threads. You may queue tasks on it from any thread and they will be
 	 * executed in user specified order on any available thread.
-	 * 			
-	 * @note	
+	 *
+	 * @note
 	 * Thread safe.
 	 * @note
-	 * This type of task scheduler uses a global queue and is best used for coarse granularity of tasks. (Number of tasks 
-	 * in the order of hundreds. Higher number of tasks might require different queuing and locking mechanism, potentially 
-	 * at the cost of flexibility.)
+	 * Each worker thread owns a lock-free queue. Tasks queued from a worker thread (e.g. from within another task) are
+	 * placed in that worker's queue, and idle workers steal tasks from other workers' queues. Tasks queued from other
+	 * threads are placed in a shared queue ordered by priority. Priority is therefore only respected for tasks queued
+	 * from outside of the scheduler.
+	 * @note
+	 * Tasks can depend on any number of other tasks. A task only becomes ready once all of its dependencies complete, at
+	 * which point it is queued on the thread that completed its last dependency.
 	 * @note
 	 * By default the task scheduler will create as many threads as there are physical CPU cores. You may add or remove
 	 * threads using addWorker()/removeWorker() methods.
@@ -108,33 +129,105 @@ namespace bs
 
 		/** Returns the maximum available worker threads (maximum number of tasks that can be executed simultaneously). */
 		UINT32 getNumWorkers() const { return mMaxActiveTasks; }
+
+		/**
+		 * Maximum number of worker threads the scheduler will create. Workers run on ThreadPool threads, so the pool's
+		 * maximum capacity must account for them.
+		 */
+		static const UINT32 MAX_WORKERS = 64;
+
 	protected:
 		friend class Task;
 
-		/**	Main task scheduler method that dispatches tasks to other threads. */
-		void runMain();
+		/** Per-thread data for a single worker. */
+		struct Worker
+		{
+			WorkStealingQueue<Task*> queue;
+			HThread thread;
+		};
+
+		/**	Main method of a worker thread. Executes and steals tasks until shutdown. */
+		void runWorker(UINT32 workerIdx);
 
-		/**	Worker method that runs a single task. */
-		void runTask(SPtr<Task> task);
+		/**	Executes the provided task, and queues any tasks that were waiting on it. */
+		void runTask(Task* task);
+
+		/**
+		 * Finds a new task to execute. Checks the local queue of the provided worker first, followed by the shared queue
+		 * and the queues of other workers. Returns null if no tasks are available.
+		 */
+		Task* findTask(UINT32 workerIdx);
+
+		/** Queues a task that is ready for execution (i.e. has no pending dependencies). */
+		void queueReadyTask(Task* task);
+
+		/** Marks the task as finished and queues any continuations that were waiting on it. */
+		void finishTask(Task* task);
+
+		/**
+		 * Activates one of the workers parked by removeWorker(), if any. Returns true if a worker was activated, in which
+		 * case the caller must call removeWorker() once done.
+		 */
+		bool activateParkedWorker();
+
+		/** Creates a new worker thread. Caller must hold @p mSleepMutex. */
+		void spawnWorker();
 
 		/**	Blocks the calling thread until the specified task has completed. */
 		void waitUntilComplete(const Task* task);
 
-		/**	Method used for sorting tasks. */
-		static bool taskCompare(const SPtr<Task>& lhs, const SPtr<Task>& rhs);
+		/** Returns the index of the shared queue used for the specified priority. */
+		static UINT32 getPriorityIdx(TaskPriority priority);
 
-		HThread mTaskSchedulerThread;
-		Set<SPtr<Task>, std::function<bool(const SPtr<Task>&, const SPtr<Task>&)>> mTaskQueue;
-		Vector<SPtr<Task>> mActiveTasks;
-		UINT32 mMaxActiveTasks;
-		UINT32 mNextTaskId;
-		bool mShutdown;
+		static const UINT32 NUM_PRIORITIES = 5;
 
-		Mutex mReadyMutex;
-		Mutex mCompleteMutex;
+		Worker* mWorkers[MAX_WORKERS];
+		std::atomic<UINT32> mNumWorkers;
+
+		Queue<Task*> mSharedQueues[NUM_PRIORITIES];
+		std::atomic<INT32> mNumSharedTasks;
+		SpinLock mSharedQueueLock;
+
+		std::atomic<INT32> mNumQueuedTasks;
+		std::atomic<UINT32> mMaxActiveTasks;
+		std::atomic<UINT32> mNextTaskId;
+		std::atomic<bool> mShutdown;
+
+		std::atomic<UINT32> mNumSleeping;
+		Mutex mSleepMutex;
 		Signal mTaskReadyCond;
+		Signal mWorkerParkCond;
+
+		std::atomic<UINT32> mNumWaiting;
+		Mutex mCompleteMutex;
 		Signal mTaskCompleteCond;
 	};
 
 	/** @} */
-}
\ No newline at end of file
+	/** @addtogroup Internal-Utility
+	 *  @{
+	 */
+
+	/** @addtogroup Threading-Internal
+	 *  @{
+	 */
+
+	/** Allocator category used for Task objects. Allocations are served from a thread safe pool. */
+	class TaskAlloc
+	{ };
+
+	/** Specialized memory allocator that uses a pool allocator for Task objects. */
+	template<>
+	class BS_UTILITY_EXPORT MemoryAllocator<TaskAlloc> : public MemoryAllocatorBase
+	{
+	public:
+		/** Allocates the given number of bytes. */
+		static void* allocate(size_t bytes);
+
+		/** Frees memory previously allocated with allocate(). */
+		static void free(void* ptr);
+	};
+
+	/** @} */
+	/** @} */
+}
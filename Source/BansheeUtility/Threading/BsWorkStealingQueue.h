@@ -0,0 +1,119 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include <atomic>
+
+namespace bs
+{
+	/** @addtogroup Internal-Utility
+	 *  @{
+	 */
+
+	/** @addtogroup Threading-Internal
+	 *  @{
+	 */
+
+	/**
+	 * Lock-free double ended queue of a fixed capacity (Chase-Lev). A single owner thread pushes and pops elements from
+	 * the bottom of the queue in LIFO order, while any number of other threads may steal elements from the top of the
+	 * queue in FIFO order.
+	 *
+	 * @tparam	T			Type of the stored element. Must be a pointer type.
+	 * @tparam	Capacity	Maximum number of elements in the queue. Must be a power of two.
+	 *
+	 * @note	push() and pop() may only be called from the owner thread. steal() is thread safe.
+	 */
+	template<class T, int Capacity = 1024>
+	class WorkStealingQueue
+	{
+		static_assert(std::is_pointer<T>::value, "Only pointer types can be stored in a WorkStealingQueue.");
+		static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two.");
+
+	public:
+		WorkStealingQueue()
+			:mTop(0), mBottom(0)
+		{
+			for (int i = 0; i < Capacity; i++)
+				mElements[i].store(nullptr, std::memory_order_relaxed);
+		}
+
+		/** Pushes a new element to the bottom of the queue. Returns false if the queue is full. Owner thread only. */
+		bool push(T element)
+		{
+			INT64 bottom = mBottom.load(std::memory_order_relaxed);
+			INT64 top = mTop.load(std::memory_order_acquire);
+
+			if (bottom - top >= Capacity)
+				return false;
+
+			mElements[bottom & (Capacity - 1)].store(element, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+			mBottom.store(bottom + 1, std::memory_order_relaxed);
+
+			return true;
+		}
+
+		/** Pops the most recently pushed element. Returns null if the queue is empty. Owner thread only. */
+		T pop()
+		{
+			INT64 bottom = mBottom.load(std::memory_order_relaxed) - 1;
+			mBottom.store(bottom, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			INT64 top = mTop.load(std::memory_order_relaxed);
+
+			if (top > bottom)
+			{
+				// Empty
+				mBottom.store(bottom + 1, std::memory_order_relaxed);
+				return nullptr;
+			}
+
+			T element = mElements[bottom & (Capacity - 1)].load(std::memory_order_relaxed);
+			if (top == bottom)
+			{
+				// Last element, race against stealers for it
+				if (!mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+					element = nullptr;
+
+				mBottom.store(bottom + 1, std::memory_order_relaxed);
+			}
+
+			return element;
+		}
+
+		/**
+		 * Attempts to steal the oldest element in the queue. Returns null if the queue is empty or if another thread
+		 * grabbed the element first. Can be called from any thread.
+		 */
+		T steal()
+		{
+			INT64 top = mTop.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			INT64 bottom = mBottom.load(std::memory_order_acquire);
+
+			if (top >= bottom)
+				return nullptr;
+
+			T element = mElements[top & (Capacity - 1)].load(std::memory_order_relaxed);
+			if (!mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+				return nullptr;
+
+			return element;
+		}
+
+		/** Returns true if the queue has no elements. Result is only approximate if other threads access the queue. */
+		bool isEmpty() const
+		{
+			return mBottom.load(std::memory_order_relaxed) <= mTop.load(std::memory_order_relaxed);
+		}
+
+	private:
+		std::atomic<INT64> mTop;
+		std::atomic<INT64> mBottom;
+		std::atomic<T> mElements[Capacity];
+	};
+
+	/** @} */
+	/** @} */
+}
@@ -2,6 +2,8 @@
 //**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
 #include "Utility/BsCompression.h"
 #include "FileSystem/BsDataStream.h"
+#include "Threading/BsParallel.h"
+#include <atomic>
 
 // Third party
 #include "snappy.h"
@@ -10,6 +12,12 @@
 
 namespace bs
 {
+	const UINT32 Compression::DEFAULT_CHUNK_SIZE = 256 * 1024;
+	const UINT32 Compression::CHUNKED_HEADER_SIZE = sizeof(UINT32) * 3 + sizeof(UINT64);
+
+	/** Identifier written at the start of data compressed with Compression::compressChunked(). */
+	static const UINT32 CHUNKED_MAGIC = 0x4B434253;
+
 	/** Source accepting a data stream. Used for Snappy compression library. */
 	class DataStreamSource : public snappy::Source
 	{
@@ -21,6 +29,8 @@ namespace bs
 
 			if (mStream->isFile())
 				mReadBuffer = (char*)bs_alloc(2048);
+			else
+				mBufferOffset = mStream->tell();
 		}
 
 		virtual ~DataStreamSource()
@@ -191,4 +201,213 @@ namespace bs
 
 		return dst.GetOutput();
 	}
+
+	SPtr<MemoryDataStream> Compression::compressChunked(const SPtr<DataStream>& input, UINT32 chunkSize)
+	{
+		chunkSize = std::max(chunkSize, 1U);
+
+		// Reference the source data directly if possible, otherwise read it into memory
+		UINT64 size = input->size() - input->tell();
+		SPtr<MemoryDataStream> sourceStream;
+		const UINT8* source;
+		if (input->isFile())
+		{
+			sourceStream = bs_shared_ptr_new<MemoryDataStream>((size_t)size);
+			input->read(sourceStream->getPtr(), (size_t)size);
+
+			source = sourceStream->getPtr();
+		}
+		else
+		{
+			source = std::static_pointer_cast<MemoryDataStream>(input)->getCurrentPtr();
+			input->skip((size_t)size);
+		}
+
+		UINT32 numChunks = (UINT32)((size + chunkSize - 1) / chunkSize);
+
+		Vector<char*> chunks(numChunks);
+		Vector<size_t> chunkSizes(numChunks);
+		parallelFor(0, numChunks, 1,
+			[&](UINT32 i)
+		{
+			const char* chunkData = (const char*)source + (UINT64)i * chunkSize;
+			size_t rawSize = (size_t)std::min((UINT64)chunkSize, size - (UINT64)i * chunkSize);
+
+			chunks[i] = (char*)bs_alloc((UINT32)snappy::MaxCompressedLength(rawSize));
+			snappy::RawCompress(chunkData, rawSize, chunks[i], &chunkSizes[i]);
+
+			// Store incompressible chunks as they are, recognized on decompression by their size
+			if (chunkSizes[i] >= rawSize)
+			{
+				memcpy(chunks[i], chunkData, rawSize);
+				chunkSizes[i] = rawSize;
+			}
+		});
+
+		UINT64 totalSize = CHUNKED_HEADER_SIZE + (numChunks + 1) * sizeof(UINT64);
+		for (auto& entry : chunkSizes)
+			totalSize += entry;
+
+		SPtr<MemoryDataStream> output = bs_shared_ptr_new<MemoryDataStream>((size_t)totalSize);
+		output->write(&CHUNKED_MAGIC, sizeof(CHUNKED_MAGIC));
+		output->write(&chunkSize, sizeof(chunkSize));
+		output->write(&size, sizeof(size));
+		output->write(&numChunks, sizeof(numChunks));
+
+		UINT64 offset = 0;
+		output->write(&offset, sizeof(offset));
+		for (auto& entry : chunkSizes)
+		{
+			offset += entry;
+			output->write(&offset, sizeof(offset));
+		}
+
+		for (UINT32 i = 0; i < numChunks; i++)
+		{
+			output->write(chunks[i], chunkSizes[i]);
+			bs_free(chunks[i]);
+		}
+
+		output->seek(0);
+		return output;
+	}
+
+	SPtr<MemoryDataStream> Compression::decompressChunked(const SPtr<DataStream>& input)
+	{
+		CompressedChunkReader reader(input);
+		if (!reader.isValid())
+		{
+			LOGERR("Decompression failed, corrupt chunk index.");
+			return nullptr;
+		}
+
+		SPtr<MemoryDataStream> output = bs_shared_ptr_new<MemoryDataStream>((size_t)reader.getSize());
+		if (!reader.read(0, reader.getSize(), output->getPtr()))
+			return nullptr;
+
+		return output;
+	}
+
+	CompressedChunkReader::CompressedChunkReader(const SPtr<DataStream>& input)
+	{
+		UINT64 available = input->size() - input->tell();
+		if (input->isFile())
+		{
+			SPtr<MemoryDataStream> memStream = bs_shared_ptr_new<MemoryDataStream>((size_t)available);
+			input->read(memStream->getPtr(), (size_t)available);
+
+			mStream = memStream;
+		}
+		else
+			mStream = input;
+
+		const UINT8* data = std::static_pointer_cast<MemoryDataStream>(mStream)->getCurrentPtr();
+		if (available < Compression::CHUNKED_HEADER_SIZE)
+			return;
+
+		UINT32 magic = 0;
+		UINT32 numChunks = 0;
+		memcpy(&magic, data, sizeof(magic));
+		memcpy(&mChunkSize, data + 4, sizeof(mChunkSize));
+		memcpy(&mSize, data + 8, sizeof(mSize));
+		memcpy(&numChunks, data + 16, sizeof(numChunks));
+
+		if (magic != CHUNKED_MAGIC || mChunkSize == 0 || numChunks != (mSize + mChunkSize - 1) / mChunkSize)
+			return;
+
+		UINT64 indexSize = (numChunks + 1) * (UINT64)sizeof(UINT64);
+		if (available < Compression::CHUNKED_HEADER_SIZE + indexSize)
+			return;
+
+		mChunkOffsets.resize(numChunks + 1);
+		memcpy(mChunkOffsets.data(), data + Compression::CHUNKED_HEADER_SIZE, (size_t)indexSize);
+
+		mData = data + Compression::CHUNKED_HEADER_SIZE + indexSize;
+		UINT64 dataSize = available - Compression::CHUNKED_HEADER_SIZE - indexSize;
+
+		if (mChunkOffsets[0] != 0 || mChunkOffsets[numChunks] > dataSize)
+			return;
+
+		for (UINT32 i = 0; i < numChunks; i++)
+		{
+			if (mChunkOffsets[i + 1] < mChunkOffsets[i])
+				return;
+		}
+
+		mIsValid = true;
+	}
+
+	bool CompressedChunkReader::read(UINT64 offset, UINT64 size, UINT8* output) const
+	{
+		if (!mIsValid || offset > mSize || size > mSize - offset)
+			return false;
+
+		if (size == 0)
+			return true;
+
+		UINT32 firstChunk = (UINT32)(offset / mChunkSize);
+		UINT32 lastChunk = (UINT32)((offset + size - 1) / mChunkSize);
+
+		std::atomic<bool> failed(false);
+		parallelFor(firstChunk, lastChunk + 1, 1,
+			[&](UINT32 i)
+		{
+			UINT64 chunkStart = (UINT64)i * mChunkSize;
+			UINT32 chunkSize = getDecompressedChunkSize(i);
+
+			UINT64 copyStart = std::max(offset, chunkStart);
+			UINT64 copyEnd = std::min(offset + size, chunkStart + chunkSize);
+			UINT8* dst = output + (copyStart - offset);
+
+			bool success;
+			if (copyStart == chunkStart && copyEnd == chunkStart + chunkSize)
+				success = decompressChunk(i, dst);
+			else // Chunk only partially overlaps the range
+			{
+				UINT8* chunkData = (UINT8*)bs_alloc(chunkSize);
+				success = decompressChunk(i, chunkData);
+
+				if (success)
+					memcpy(dst, chunkData + (copyStart - chunkStart), (size_t)(copyEnd - copyStart));
+
+				bs_free(chunkData);
+			}
+
+			if (!success)
+				failed = true;
+		});
+
+		if (failed)
+		{
+			LOGERR("Decompression failed, corrupt data.");
+			return false;
+		}
+
+		return true;
+	}
+
+	bool CompressedChunkReader::decompressChunk(UINT32 idx, UINT8* output) const
+	{
+		const char* chunkData = (const char*)mData + mChunkOffsets[idx];
+		size_t compressedSize = (size_t)(mChunkOffsets[idx + 1] - mChunkOffsets[idx]);
+		UINT32 chunkSize = getDecompressedChunkSize(idx);
+
+		// Chunk was stored uncompressed
+		if (compressedSize == chunkSize)
+		{
+			memcpy(output, chunkData, chunkSize);
+			return true;
+		}
+
+		size_t uncompressedSize = 0;
+		if (!snappy::GetUncompressedLength(chunkData, compressedSize, &uncompressedSize) || uncompressedSize != chunkSize)
+			return false;
+
+		return snappy::RawUncompress(chunkData, compressedSize, (char*)output);
+	}
+
+	UINT32 CompressedChunkReader::getDecompressedChunkSize(UINT32 idx) const
+	{
+		return (UINT32)std::min((UINT64)mChunkSize, mSize - (UINT64)idx * mChunkSize);
+	}
 }
@@ -10,16 +10,108 @@ namespace bs
 	 *  @{
 	 */
 
+	/** Methods that data can be compressed with by Compression. Values are stored with the compressed data. */
+	enum class CompressionMethod
+	{
+		/** Data is not compressed. */
+		None = 0,
+		/** Whole stream is compressed as a single Snappy block. See Compression::compress(). */
+		Snappy = 1,
+		/** Stream is split into independently compressed Snappy chunks. See Compression::compressChunked(). */
+		SnappyChunked = 2
+	};
+
 	/** Performs generic compression and decompression on raw data. */
 	class BS_UTILITY_EXPORT Compression
 	{
 	public:
+		/** Default size of a single chunk of data, before compression, used by compressChunked(). */
+		static const UINT32 DEFAULT_CHUNK_SIZE;
+
+		/**
+		 * Size of the header at the start of data output by compressChunked(), in bytes. Header contains the magic 
+		 * number, chunk size, decompressed size and the number of chunks, and is followed by the chunk offset index.
+		 */
+		static const UINT32 CHUNKED_HEADER_SIZE;
+
 		/** Compresses the data from the provided data stream and outputs the new stream with compressed data. */
 		static SPtr<MemoryDataStream> compress(SPtr<DataStream>& input);
 
 		/** Decompresses the data from the provided data stream and outputs the new stream with decompressed data. */
 		static SPtr<MemoryDataStream> decompress(SPtr<DataStream>& input);
+
+		/**
+		 * Compresses the data from the current position of the provided stream until its end. Data is split into chunks
+		 * which are compressed independently, and in parallel. Output starts with an index of all the chunks, which allows
+		 * the data to be decompressed in parallel, or partially. Use decompressChunked() or CompressedChunkReader to
+		 * decompress the data.
+		 *
+		 * @param[in]	input		Stream containing the data to compress.
+		 * @param[in]	chunkSize	Size of a single chunk of data, before compression. Smaller chunks allow finer grained
+		 *							random access and parallelism, but compress worse.
+		 * @return					Stream containing the compressed data.
+		 */
+		static SPtr<MemoryDataStream> compressChunked(const SPtr<DataStream>& input, 
+			UINT32 chunkSize = DEFAULT_CHUNK_SIZE);
+
+		/**
+		 * Decompresses data compressed with compressChunked(), starting at the current position of the provided stream.
+		 * Chunks are decompressed in parallel. Returns null if the data is corrupt.
+		 */
+		static SPtr<MemoryDataStream> decompressChunked(const SPtr<DataStream>& input);
+	};
+
+	/**
+	 * Provides random access to data compressed with Compression::compressChunked(). Only the chunks covering the 
+	 * requested range are decompressed.
+	 */
+	class BS_UTILITY_EXPORT CompressedChunkReader
+	{
+	public:
+		/**
+		 * Reads the chunk index from the current position of the provided stream. If the stream is not a file stream its
+		 * data is referenced directly, in which case the stream must not be modified while the reader is in use. 
+		 * Otherwise the compressed data is read into memory.
+		 */
+		CompressedChunkReader(const SPtr<DataStream>& input);
+
+		/** Returns false if the chunk index could not be parsed, in which case no data can be read. */
+		bool isValid() const { return mIsValid; }
+
+		/** Returns the size of the data, in bytes, after decompression. */
+		UINT64 getSize() const { return mSize; }
+
+		/** Returns the size of a single chunk of data, in bytes, after decompression. */
+		UINT32 getChunkSize() const { return mChunkSize; }
+
+		/** Returns the number of chunks the data is split into. */
+		UINT32 getNumChunks() const { return (UINT32)mChunkOffsets.size() - 1; }
+
+		/**
+		 * Decompresses a range of the data. Chunks are decompressed in parallel.
+		 *
+		 * @param[in]	offset	Offset of the range to decompress, in bytes, from the start of the decompressed data.
+		 * @param[in]	size	Size of the range to decompress, in bytes.
+		 * @param[out]	output	Buffer to output the decompressed data to. Must be at least @p size bytes large.
+		 * @return				False if the range is out of bounds or the data is corrupt, true otherwise.
+		 */
+		bool read(UINT64 offset, UINT64 size, UINT8* output) const;
+
+	private:
+		/** Decompresses a single chunk into the output buffer, which must be large enough to hold the entire chunk. */
+		bool decompressChunk(UINT32 idx, UINT8* output) const;
+
+		/** Returns the size of the chunk at the specified index, in bytes, after decompression. */
+		UINT32 getDecompressedChunkSize(UINT32 idx) const;
+
+		SPtr<DataStream> mStream;
+		const UINT8* mData = nullptr;
+
+		UINT64 mSize = 0;
+		UINT32 mChunkSize = 0;
+		Vector<UINT64> mChunkOffsets;
+		bool mIsValid = false;
 	};
 
 	/** @} */
-}
\ No newline at end of file
+}
@@ -0,0 +1,483 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "Utility/BsDynamicBVH.h"
+#include "Math/BsConvexVolume.h"
+#include "Math/BsSphere.h"
+#include "Math/BsMath.h"
+
+namespace bs
+{
+	/** Returns the surface area of the box. */
+	static float getSurfaceArea(const AABox& box)
+	{
+		Vector3 size = box.getSize();
+		return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+	}
+
+	/** Returns a box encompassing both provided boxes. */
+	static AABox mergeBounds(const AABox& a, const AABox& b)
+	{
+		return AABox(Vector3::min(a.getMin(), b.getMin()), Vector3::max(a.getMax(), b.getMax()));
+	}
+
+	/** Returns the box expanded by the provided distance on each side. */
+	static AABox expandBounds(const AABox& box, float distance)
+	{
+		Vector3 offset(distance, distance, distance);
+		return AABox(box.getMin() - offset, box.getMax() + offset);
+	}
+
+	DynamicBVH::DynamicBVH(float margin)
+		:mRoot(NULL_NODE), mFreeList(NULL_NODE), mNumObjects(0), mMargin(margin)
+	{ }
+
+	UINT32 DynamicBVH::add(const AABox& bounds, UINT32 userData)
+	{
+		UINT32 leaf = allocateNode();
+		mNodes[leaf].bounds = expandBounds(bounds, mMargin);
+		mNodes[leaf].userData = userData;
+
+		insertLeaf(leaf);
+		mNumObjects++;
+
+		return leaf;
+	}
+
+	void DynamicBVH::remove(UINT32 id)
+	{
+		assert(mNodes[id].isLeaf() && mNodes[id].height == 0);
+
+		removeLeaf(id);
+		freeNode(id);
+		mNumObjects--;
+	}
+
+	bool DynamicBVH::update(UINT32 id, const AABox& bounds)
+	{
+		assert(mNodes[id].isLeaf() && mNodes[id].height == 0);
+
+		// Keep the stored bounds as long as they contain the object, unless the object shrunk considerably
+		const AABox& storedBounds = mNodes[id].bounds;
+		if (storedBounds.contains(bounds) && expandBounds(bounds, mMargin * 4.0f).contains(storedBounds))
+			return false;
+
+		removeLeaf(id);
+		mNodes[id].bounds = expandBounds(bounds, mMargin);
+		insertLeaf(id);
+
+		return true;
+	}
+
+	UINT32 DynamicBVH::getHeight() const
+	{
+		if (mRoot == NULL_NODE)
+			return 0;
+
+		return (UINT32)mNodes[mRoot].height;
+	}
+
+	void DynamicBVH::clear()
+	{
+		mNodes.clear();
+		mRoot = NULL_NODE;
+		mFreeList = NULL_NODE;
+		mNumObjects = 0;
+	}
+
+	void DynamicBVH::query(const ConvexVolume& volume, Vector<UINT32>& inside, Vector<UINT32>& intersecting) const
+	{
+		if (mRoot == NULL_NODE)
+			return;
+
+		Vector<Plane> planes = volume.getPlanes();
+		assert(planes.size() <= 32);
+
+		UINT32 numPlanes = std::min((UINT32)planes.size(), 32U);
+		UINT32 allPlanesMask = numPlanes == 32 ? 0xFFFFFFFF : ((1U << numPlanes) - 1);
+
+		// Each entry contains a node index, and a mask of planes the node's parent wasn't fully inside of
+		Vector<std::pair<UINT32, UINT32>> todo;
+		todo.push_back(std::make_pair(mRoot, allPlanesMask));
+
+		Vector<UINT32> subtree;
+		while (!todo.empty())
+		{
+			UINT32 idx = todo.back().first;
+			UINT32 planeMask = todo.back().second;
+			todo.pop_back();
+
+			const Node& node = mNodes[idx];
+			Vector3 center = node.bounds.getCenter();
+			Vector3 extents = node.bounds.getHalfSize();
+
+			bool outside = false;
+			for (UINT32 i = 0; i < numPlanes; i++)
+			{
+				if ((planeMask & (1U << i)) == 0)
+					continue;
+
+				const Plane& plane = planes[i];
+				float dist = center.dot(plane.normal) - plane.d;
+				float radius = extents.x * Math::abs(plane.normal.x) + extents.y * Math::abs(plane.normal.y) +
+					extents.z * Math::abs(plane.normal.z);
+
+				if (dist < -radius)
+				{
+					outside = true;
+					break;
+				}
+
+				// Fully on the inner side of this plane, so the children don't need to be tested against it
+				if (dist >= radius)
+					planeMask &= ~(1U << i);
+			}
+
+			if (outside)
+				continue;
+
+			if (node.isLeaf())
+			{
+				if (planeMask == 0)
+					inside.push_back(node.userData);
+				else
+					intersecting.push_back(node.userData);
+
+				continue;
+			}
+
+			if (planeMask == 0)
+			{
+				// Whole sub-tree is inside the volume, output all the leaves without further tests
+				subtree.push_back(idx);
+				while (!subtree.empty())
+				{
+					const Node& child = mNodes[subtree.back()];
+					subtree.pop_back();
+
+					if (child.isLeaf())
+						inside.push_back(child.userData);
+					else
+					{
+						subtree.push_back(child.children[0]);
+						subtree.push_back(child.children[1]);
+					}
+				}
+
+				continue;
+			}
+
+			todo.push_back(std::make_pair(node.children[1], planeMask));
+			todo.push_back(std::make_pair(node.children[0], planeMask));
+		}
+	}
+
+	void DynamicBVH::query(const AABox& box, Vector<UINT32>& output) const
+	{
+		queryLeaves([&box](const AABox& bounds) { return bounds.intersects(box); }, output);
+	}
+
+	void DynamicBVH::query(const Sphere& sphere, Vector<UINT32>& output) const
+	{
+		queryLeaves([&sphere](const AABox& bounds) { return bounds.intersects(sphere); }, output);
+	}
+
+	template<class TestFn>
+	void DynamicBVH::queryLeaves(const TestFn& test, Vector<UINT32>& output) const
+	{
+		if (mRoot == NULL_NODE)
+			return;
+
+		Vector<UINT32> todo;
+		todo.push_back(mRoot);
+
+		while (!todo.empty())
+		{
+			const Node& node = mNodes[todo.back()];
+			todo.pop_back();
+
+			if (!test(node.bounds))
+				continue;
+
+			if (node.isLeaf())
+				output.push_back(node.userData);
+			else
+			{
+				todo.push_back(node.children[1]);
+				todo.push_back(node.children[0]);
+			}
+		}
+	}
+
+	UINT32 DynamicBVH::allocateNode()
+	{
+		UINT32 idx;
+		if (mFreeList == NULL_NODE)
+		{
+			idx = (UINT32)mNodes.size();
+			mNodes.push_back(Node());
+		}
+		else
+		{
+			idx = mFreeList;
+			mFreeList = mNodes[idx].parent;
+		}
+
+		Node& node = mNodes[idx];
+		node.parent = NULL_NODE;
+		node.children[0] = NULL_NODE;
+		node.children[1] = NULL_NODE;
+		node.height = 0;
+		node.userData = 0;
+
+		return idx;
+	}
+
+	void DynamicBVH::freeNode(UINT32 idx)
+	{
+		mNodes[idx].parent = mFreeList;
+		mNodes[idx].height = -1;
+		mFreeList = idx;
+	}
+
+	void DynamicBVH::insertLeaf(UINT32 leaf)
+	{
+		if (mRoot == NULL_NODE)
+		{
+			mRoot = leaf;
+			mNodes[leaf].parent = NULL_NODE;
+			return;
+		}
+
+		// Find the best sibling for the new leaf, by descending towards the child whose surface area would increase the
+		// least
+		AABox leafBounds = mNodes[leaf].bounds;
+		UINT32 idx = mRoot;
+		while (!mNodes[idx].isLeaf())
+		{
+			const Node& node = mNodes[idx];
+
+			float area = getSurfaceArea(node.bounds);
+			float combinedArea = getSurfaceArea(mergeBounds(node.bounds, leafBounds));
+
+			// Cost of creating a new parent for this node and the new leaf
+			float cost = 2.0f * combinedArea;
+
+			// Minimum cost of pushing the leaf further down the tree
+			float inheritanceCost = 2.0f * (combinedArea - area);
+
+			float childCosts[2];
+			for (UINT32 i = 0; i < 2; i++)
+			{
+				const Node& child = mNodes[node.children[i]];
+
+				float childArea = getSurfaceArea(mergeBounds(child.bounds, leafBounds));
+				if (!child.isLeaf())
+					childArea -= getSurfaceArea(child.bounds);
+
+				childCosts[i] = childArea + inheritanceCost;
+			}
+
+			if (cost < childCosts[0] && cost < childCosts[1])
+				break;
+
+			idx = childCosts[0] < childCosts[1] ? node.children[0] : node.children[1];
+		}
+
+		UINT32 sibling = idx;
+
+		// Create a new parent for the sibling and the leaf
+		UINT32 oldParent = mNodes[sibling].parent;
+		UINT32 newParent = allocateNode();
+
+		mNodes[newParent].parent = oldParent;
+		mNodes[newParent].bounds = mergeBounds(leafBounds, mNodes[sibling].bounds);
+		mNodes[newParent].height = mNodes[sibling].height + 1;
+		mNodes[newParent].children[0] = sibling;
+		mNodes[newParent].children[1] = leaf;
+
+		if (oldParent != NULL_NODE)
+		{
+			if (mNodes[oldParent].children[0] == sibling)
+				mNodes[oldParent].children[0] = newParent;
+			else
+				mNodes[oldParent].children[1] = newParent;
+		}
+		else
+			mRoot = newParent;
+
+		mNodes[sibling].parent = newParent;
+		mNodes[leaf].parent = newParent;
+
+		refit(newParent);
+	}
+
+	void DynamicBVH::removeLeaf(UINT32 leaf)
+	{
+		if (leaf == mRoot)
+		{
+			mRoot = NULL_NODE;
+			return;
+		}
+
+		UINT32 parent = mNodes[leaf].parent;
+		UINT32 grandParent = mNodes[parent].parent;
+		UINT32 sibling = mNodes[parent].children[0] == leaf ? mNodes[parent].children[1] : mNodes[parent].children[0];
+
+		// Replace the parent with the sibling
+		if (grandParent != NULL_NODE)
+		{
+			if (mNodes[grandParent].children[0] == parent)
+				mNodes[grandParent].children[0] = sibling;
+			else
+				mNodes[grandParent].children[1] = sibling;
+
+			mNodes[sibling].parent = grandParent;
+			freeNode(parent);
+
+			refit(grandParent);
+		}
+		else
+		{
+			mRoot = sibling;
+			mNodes[sibling].parent = NULL_NODE;
+			freeNode(parent);
+		}
+	}
+
+	void DynamicBVH::refit(UINT32 idx)
+	{
+		while (idx != NULL_NODE)
+		{
+			idx = balance(idx);
+
+			Node& node = mNodes[idx];
+			const Node& child0 = mNodes[node.children[0]];
+			const Node& child1 = mNodes[node.children[1]];
+
+			node.height = 1 + std::max(child0.height, child1.height);
+			node.bounds = mergeBounds(child0.bounds, child1.bounds);
+
+			idx = node.parent;
+		}
+	}
+
+	UINT32 DynamicBVH::balance(UINT32 idxA)
+	{
+		Node& a = mNodes[idxA];
+		if (a.isLeaf() || a.height < 2)
+			return idxA;
+
+		UINT32 idxB = a.children[0];
+		UINT32 idxC = a.children[1];
+		Node& b = mNodes[idxB];
+		Node& c = mNodes[idxC];
+
+		INT32 heightDiff = c.height - b.height;
+
+		// Rotate C up
+		if (heightDiff > 1)
+		{
+			UINT32 idxF = c.children[0];
+			UINT32 idxG = c.children[1];
+			Node& f = mNodes[idxF];
+			Node& g = mNodes[idxG];
+
+			// Swap A and C
+			c.children[0] = idxA;
+			c.parent = a.parent;
+			a.parent = idxC;
+
+			if (c.parent != NULL_NODE)
+			{
+				if (mNodes[c.parent].children[0] == idxA)
+					mNodes[c.parent].children[0] = idxC;
+				else
+					mNodes[c.parent].children[1] = idxC;
+			}
+			else
+				mRoot = idxC;
+
+			// Keep the taller of C's children under C
+			if (f.height > g.height)
+			{
+				c.children[1] = idxF;
+				a.children[1] = idxG;
+				g.parent = idxA;
+
+				a.bounds = mergeBounds(b.bounds, g.bounds);
+				c.bounds = mergeBounds(a.bounds, f.bounds);
+
+				a.height = 1 + std::max(b.height, g.height);
+				c.height = 1 + std::max(a.height, f.height);
+			}
+			else
+			{
+				c.children[1] = idxG;
+				a.children[1] = idxF;
+				f.parent = idxA;
+
+				a.bounds = mergeBounds(b.bounds, f.bounds);
+				c.bounds = mergeBounds(a.bounds, g.bounds);
+
+				a.height = 1 + std::max(b.height, f.height);
+				c.height = 1 + std::max(a.height, g.height);
+			}
+
+			return idxC;
+		}
+
+		// Rotate B up
+		if (heightDiff < -1)
+		{
+			UINT32 idxD = b.children[0];
+			UINT32 idxE = b.children[1];
+			Node& d = mNodes[idxD];
+			Node& e = mNodes[idxE];
+
+			// Swap A and B
+			b.children[0] = idxA;
+			b.parent = a.parent;
+			a.parent = idxB;
+
+			if (b.parent != NULL_NODE)
+			{
+				if (mNodes[b.parent].children[0] == idxA)
+					mNodes[b.parent].children[0] = idxB;
+				else
+					mNodes[b.parent].children[1] = idxB;
+			}
+			else
+				mRoot = idxB;
+
+			// Keep the taller of B's children under B
+			if (d.height > e.height)
+			{
+				b.children[1] = idxD;
+				a.children[0] = idxE;
+				e.parent = idxA;
+
+				a.bounds = mergeBounds(c.bounds, e.bounds);
+				b.bounds = mergeBounds(a.bounds, d.bounds);
+
+				a.height = 1 + std::max(c.height, e.height);
+				b.height = 1 + std::max(a.height, d.height);
+			}
+			else
+			{
+				b.children[1] = idxE;
+				a.children[0] = idxD;
+				d.parent = idxA;
+
+				a.bounds = mergeBounds(c.bounds, d.bounds);
+				b.bounds = mergeBounds(a.bounds, e.bounds);
+
+				a.height = 1 + std::max(c.height, d.height);
+				b.height = 1 + std::max(a.height, e.height);
+			}
+
+			return idxB;
+		}
+
+		return idxA;
+	}
+}
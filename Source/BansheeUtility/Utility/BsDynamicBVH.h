@@ -0,0 +1,134 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "Prerequisites/BsPrerequisitesUtil.h"
+#include "Math/BsAABox.h"
+
+namespace bs
+{
+	/** @addtogroup General
+	 *  @{
+	 */
+
+	/**
+	 * Dynamic bounding volume hierarchy of axis aligned boxes. Objects can be added, removed and moved individually,
+	 * and the tree keeps itself balanced as it changes. Supports hierarchical queries against convex volumes (e.g.
+	 * frustums), boxes and spheres.
+	 *
+	 * Each object is stored with its bounds expanded by a margin. Moving an object only modifies the tree once its new
+	 * bounds no longer fit inside the expanded bounds, which makes updates of slowly moving objects cheap. Use a margin
+	 * of zero for static objects to keep their bounds tight.
+	 */
+	class BS_UTILITY_EXPORT DynamicBVH
+	{
+	public:
+		/** @param[in]	margin	Distance by which object bounds are expanded on each side when stored in the tree. */
+		DynamicBVH(float margin = 0.1f);
+
+		/**
+		 * Adds a new object to the tree.
+		 *
+		 * @param[in]	bounds		World bounds of the object.
+		 * @param[in]	userData	Value returned by queries when the object is found.
+		 * @return					Identifier of the object, to be used with the other methods.
+		 */
+		UINT32 add(const AABox& bounds, UINT32 userData);
+
+		/** Removes an object previously added with add(). */
+		void remove(UINT32 id);
+
+		/**
+		 * Updates the bounds of an object previously added with add(). Returns true if the tree was modified, or false if
+		 * the new bounds still fit within the bounds stored in the tree.
+		 */
+		bool update(UINT32 id, const AABox& bounds);
+
+		/** Changes the user data of an object previously added with add(). */
+		void setUserData(UINT32 id, UINT32 userData) { mNodes[id].userData = userData; }
+
+		/** Returns the user data of an object previously added with add(). */
+		UINT32 getUserData(UINT32 id) const { return mNodes[id].userData; }
+
+		/** Returns the expanded bounds the tree stores for an object previously added with add(). */
+		const AABox& getFatBounds(UINT32 id) const { return mNodes[id].bounds; }
+
+		/** Returns the number of objects in the tree. */
+		UINT32 getNumObjects() const { return mNumObjects; }
+
+		/** Returns the height of the tree. Zero if the tree is empty or contains a single object. */
+		UINT32 getHeight() const;
+
+		/** Removes all objects from the tree. */
+		void clear();
+
+		/**
+		 * Finds all objects whose bounds intersect the provided convex volume, and outputs their user data. Objects are
+		 * split depending on whether their stored bounds are fully inside the volume, or only intersect it (in which case
+		 * the caller will usually want to perform a more precise test).
+		 *
+		 * @param[in]	volume			Volume to test the objects against. Must have no more than 32 planes.
+		 * @param[out]	inside			User data of objects whose stored bounds are fully inside the volume. Appended to
+		 *								any existing entries.
+		 * @param[out]	intersecting	User data of objects whose stored bounds intersect the volume boundary. Appended to
+		 *								any existing entries.
+		 */
+		void query(const ConvexVolume& volume, Vector<UINT32>& inside, Vector<UINT32>& intersecting) const;
+
+		/**
+		 * Finds all objects whose stored bounds intersect the provided box, and appends their user data to @p output.
+		 */
+		void query(const AABox& box, Vector<UINT32>& output) const;
+
+		/**
+		 * Finds all objects whose stored bounds intersect the provided sphere, and appends their user data to
+		 * @p output.
+		 */
+		void query(const Sphere& sphere, Vector<UINT32>& output) const;
+
+	private:
+		static const UINT32 NULL_NODE = (UINT32)-1;
+
+		/** Single node in the tree. Leaf nodes represent objects. */
+		struct Node
+		{
+			bool isLeaf() const { return children[0] == NULL_NODE; }
+
+			AABox bounds;
+			UINT32 parent; /**< Parent of the node, or the next free node if the node is unused. */
+			UINT32 children[2];
+			INT32 height; /**< Zero for leaf nodes, -1 for unused nodes. */
+			UINT32 userData;
+		};
+
+		/** Returns an unused node, growing the node pool if needed. */
+		UINT32 allocateNode();
+
+		/** Returns a node to the pool of unused nodes. */
+		void freeNode(UINT32 idx);
+
+		/** Inserts a leaf node into the tree, at the location that results in the lowest surface area increase. */
+		void insertLeaf(UINT32 leaf);
+
+		/** Removes a leaf node from the tree, and removes its parent node. */
+		void removeLeaf(UINT32 leaf);
+
+		/** Performs a rotation at the provided node if it is imbalanced. Returns the root of the rotated sub-tree. */
+		UINT32 balance(UINT32 idx);
+
+		/** Recalculates bounds and heights of all nodes from the provided node up to the root. */
+		void refit(UINT32 idx);
+
+		/** Generic traversal that reports all leaves whose bounds pass the provided overlap test. */
+		template<class TestFn>
+		void queryLeaves(const TestFn& test, Vector<UINT32>& output) const;
+
+		Vector<Node> mNodes;
+		UINT32 mRoot;
+		UINT32 mFreeList;
+		UINT32 mNumObjects;
+		float mMargin;
+	};
+
+	/** @} */
+}
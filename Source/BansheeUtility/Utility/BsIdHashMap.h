@@ -0,0 +1,170 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "Prerequisites/BsPrerequisitesUtil.h"
+
+namespace bs
+{
+	/** @addtogroup General
+	 *  @{
+	 */
+
+	/**
+	 * Hash map from 64-bit IDs to values. Entries are stored in a single open-addressing table using linear probing, so
+	 * lookups touch contiguous memory and insertions don't allocate unless the table needs to grow.
+	 *
+	 * Pointers to values are invalidated whenever an entry is inserted or removed.
+	 */
+	template<class Value>
+	class IdHashMap
+	{
+		/** A single slot in the table. */
+		struct Entry
+		{
+			UINT64 key = 0;
+			Value value = Value();
+			bool used = false;
+		};
+
+	public:
+		IdHashMap() = default;
+
+		/** Returns the value stored under @p key, or null if there is no such entry. */
+		Value* find(UINT64 key)
+		{
+			if (mNumEntries == 0)
+				return nullptr;
+
+			UINT32 mask = (UINT32)mEntries.size() - 1;
+			for (UINT32 i = getHash(key) & mask; mEntries[i].used; i = (i + 1) & mask)
+			{
+				if (mEntries[i].key == key)
+					return &mEntries[i].value;
+			}
+
+			return nullptr;
+		}
+
+		/** @copydoc find(UINT64) */
+		const Value* find(UINT64 key) const
+		{
+			return const_cast<IdHashMap*>(this)->find(key);
+		}
+
+		/** Returns the value stored under @p key, inserting a default constructed value if there is no such entry. */
+		Value& operator[](UINT64 key)
+		{
+			// Keep the load factor at or below 3/4
+			if ((mNumEntries + 1) * 4 > (UINT32)mEntries.size() * 3)
+				grow();
+
+			UINT32 mask = (UINT32)mEntries.size() - 1;
+			UINT32 i = getHash(key) & mask;
+			for (; mEntries[i].used; i = (i + 1) & mask)
+			{
+				if (mEntries[i].key == key)
+					return mEntries[i].value;
+			}
+
+			mEntries[i].key = key;
+			mEntries[i].used = true;
+			mNumEntries++;
+
+			return mEntries[i].value;
+		}
+
+		/** Removes the entry stored under @p key, if any. Returns true if an entry was removed. */
+		bool erase(UINT64 key)
+		{
+			if (mNumEntries == 0)
+				return false;
+
+			UINT32 mask = (UINT32)mEntries.size() - 1;
+			UINT32 i = getHash(key) & mask;
+			for (; mEntries[i].used; i = (i + 1) & mask)
+			{
+				if (mEntries[i].key == key)
+					break;
+			}
+
+			if (!mEntries[i].used)
+				return false;
+
+			// Shift back any following entries that would become unreachable through the now empty slot
+			UINT32 empty = i;
+			for (UINT32 j = (i + 1) & mask; mEntries[j].used; j = (j + 1) & mask)
+			{
+				UINT32 home = getHash(mEntries[j].key) & mask;
+
+				bool reachable = empty <= j ? (home > empty && home <= j) : (home > empty || home <= j);
+				if (reachable)
+					continue;
+
+				mEntries[empty] = std::move(mEntries[j]);
+				empty = j;
+			}
+
+			mEntries[empty] = Entry();
+			mNumEntries--;
+
+			return true;
+		}
+
+		/** Removes all entries. Keeps the allocated table so it can be refilled without allocating. */
+		void clear()
+		{
+			if (mNumEntries == 0)
+				return;
+
+			for (auto& entry : mEntries)
+				entry = Entry();
+
+			mNumEntries = 0;
+		}
+
+		/** Returns the number of entries in the map. */
+		UINT32 size() const { return mNumEntries; }
+
+		/** Returns true if the map contains no entries. */
+		bool empty() const { return mNumEntries == 0; }
+
+	private:
+		/** Doubles the size of the table and re-inserts all the entries. */
+		void grow()
+		{
+			Vector<Entry> oldEntries(mEntries.empty() ? 16 : mEntries.size() * 2);
+			std::swap(oldEntries, mEntries);
+
+			UINT32 mask = (UINT32)mEntries.size() - 1;
+			for (auto& entry : oldEntries)
+			{
+				if (!entry.used)
+					continue;
+
+				UINT32 i = getHash(entry.key) & mask;
+				while (mEntries[i].used)
+					i = (i + 1) & mask;
+
+				mEntries[i] = std::move(entry);
+			}
+		}
+
+		/** Mixes the bits of the key, so sequential IDs don't form long probe sequences. */
+		static UINT32 getHash(UINT64 key)
+		{
+			key ^= key >> 33;
+			key *= 0xff51afd7ed558ccdULL;
+			key ^= key >> 33;
+			key *= 0xc4ceb9fe1a85ec53ULL;
+			key ^= key >> 33;
+
+			return (UINT32)key;
+		}
+
+		Vector<Entry> mEntries;
+		UINT32 mNumEntries = 0;
+	};
+
+	/** @} */
+}
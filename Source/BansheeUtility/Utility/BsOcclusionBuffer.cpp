@@ -0,0 +1,384 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "Utility/BsOcclusionBuffer.h"
+#include "Math/BsSIMD.h"
+#include "Math/BsMath.h"
+
+namespace bs
+{
+	/** Geometry is clipped at this clip space W, to avoid projecting points at or behind the view origin. */
+	static const float NEAR_CLIP_W = 0.01f;
+
+	/** Depth value of pixels not covered by any occluder. */
+	static const float EMPTY_DEPTH = std::numeric_limits<float>::max();
+
+	/** Indices of the triangles forming a box, referencing corners in the order output by getBoxCorners(). */
+	static const UINT32 BOX_INDICES[36] =
+	{
+		0, 1, 3, 0, 3, 2, // -Z
+		4, 6, 7, 4, 7, 5, // +Z
+		0, 4, 5, 0, 5, 1, // -Y
+		2, 3, 7, 2, 7, 6, // +Y
+		0, 2, 6, 0, 6, 4, // -X
+		1, 5, 7, 1, 7, 3  // +X
+	};
+
+	/** Outputs the corners of the box. Corner N uses the maximum X, Y or Z coordinate if its bit 0, 1 or 2 is set. */
+	static void getBoxCorners(const AABox& box, Vector3 (&corners)[8])
+	{
+		const Vector3& min = box.getMin();
+		const Vector3& max = box.getMax();
+
+		for (UINT32 i = 0; i < 8; i++)
+		{
+			corners[i] = Vector3(
+				(i & 1) ? max.x : min.x,
+				(i & 2) ? max.y : min.y,
+				(i & 4) ? max.z : min.z);
+		}
+	}
+
+	OcclusionBuffer::OcclusionBuffer(UINT32 width, UINT32 height)
+		:mWidth(std::max((width + 3) & ~3U, 4U)), mHeight(std::max(height, 1U)), mViewProj(Matrix4::IDENTITY)
+	{
+		UINT32 levelWidth = mWidth;
+		UINT32 levelHeight = mHeight;
+		while (true)
+		{
+			Level level;
+			level.width = levelWidth;
+			level.height = levelHeight;
+			level.depth.resize(levelWidth * levelHeight, EMPTY_DEPTH);
+
+			mLevels.push_back(level);
+
+			if (levelWidth == 1 && levelHeight == 1)
+				break;
+
+			levelWidth = std::max((levelWidth + 1) / 2, 1U);
+			levelHeight = std::max((levelHeight + 1) / 2, 1U);
+		}
+	}
+
+	void OcclusionBuffer::clear(const Matrix4& viewProj)
+	{
+		mViewProj = viewProj;
+
+		for (auto& level : mLevels)
+			std::fill(level.depth.begin(), level.depth.end(), EMPTY_DEPTH);
+	}
+
+	void OcclusionBuffer::rasterize(const Vector3* vertices, const UINT32* indices, UINT32 numIndices,
+		const Matrix4& world)
+	{
+		Matrix4 worldViewProj = mViewProj * world;
+		for (UINT32 i = 0; i + 2 < numIndices; i += 3)
+		{
+			Vector4 a = worldViewProj.multiply(Vector4(vertices[indices[i + 0]], 1.0f));
+			Vector4 b = worldViewProj.multiply(Vector4(vertices[indices[i + 1]], 1.0f));
+			Vector4 c = worldViewProj.multiply(Vector4(vertices[indices[i + 2]], 1.0f));
+
+			clipAndRasterize(a, b, c);
+		}
+	}
+
+	void OcclusionBuffer::rasterize(const AABox& box, const Matrix4& world)
+	{
+		Vector3 corners[8];
+		getBoxCorners(box, corners);
+
+		rasterize(corners, BOX_INDICES, 36, world);
+	}
+
+	void OcclusionBuffer::clipAndRasterize(const Vector4& a, const Vector4& b, const Vector4& c)
+	{
+		const Vector4* input[3] = { &a, &b, &c };
+
+		UINT32 numInside = 0;
+		for (UINT32 i = 0; i < 3; i++)
+		{
+			if (input[i]->w >= NEAR_CLIP_W)
+				numInside++;
+		}
+
+		if (numInside == 0)
+			return;
+
+		if (numInside == 3)
+		{
+			rasterizeTriangle(toScreen(a), toScreen(b), toScreen(c));
+			return;
+		}
+
+		// Clip against the near plane, resulting in a triangle or a quad
+		Vector4 clipped[4];
+		UINT32 numClipped = 0;
+		for (UINT32 i = 0; i < 3; i++)
+		{
+			const Vector4& current = *input[i];
+			const Vector4& next = *input[(i + 1) % 3];
+
+			bool currentInside = current.w >= NEAR_CLIP_W;
+			bool nextInside = next.w >= NEAR_CLIP_W;
+
+			if (currentInside)
+				clipped[numClipped++] = current;
+
+			if (currentInside != nextInside)
+			{
+				float t = (NEAR_CLIP_W - current.w) / (next.w - current.w);
+				clipped[numClipped++] = current + (next - current) * t;
+			}
+		}
+
+		Vector3 screen[4];
+		for (UINT32 i = 0; i < numClipped; i++)
+			screen[i] = toScreen(clipped[i]);
+
+		rasterizeTriangle(screen[0], screen[1], screen[2]);
+
+		if (numClipped == 4)
+			rasterizeTriangle(screen[0], screen[2], screen[3]);
+	}
+
+	Vector3 OcclusionBuffer::toScreen(const Vector4& clipPos) const
+	{
+		float invW = 1.0f / clipPos.w;
+
+		return Vector3(
+			(clipPos.x * invW * 0.5f + 0.5f) * mWidth,
+			(0.5f - clipPos.y * invW * 0.5f) * mHeight,
+			clipPos.z * invW);
+	}
+
+	void OcclusionBuffer::rasterizeTriangle(Vector3 a, Vector3 b, Vector3 c)
+	{
+		float area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+		if (Math::abs(area) < 1e-6f)
+			return;
+
+		// Both faces are rasterized, so make the winding consistent
+		if (area < 0.0f)
+		{
+			std::swap(b, c);
+			area = -area;
+		}
+
+		// Clamp before converting to integers, vertices close to the near plane can project very far off-screen
+		float maxPixelX = (float)(mWidth - 1);
+		float maxPixelY = (float)(mHeight - 1);
+
+		float boundsMinX = std::min(a.x, std::min(b.x, c.x));
+		float boundsMinY = std::min(a.y, std::min(b.y, c.y));
+		float boundsMaxX = std::max(a.x, std::max(b.x, c.x));
+		float boundsMaxY = std::max(a.y, std::max(b.y, c.y));
+
+		if (boundsMaxX < 0.0f || boundsMaxY < 0.0f || boundsMinX > maxPixelX + 1.0f || boundsMinY > maxPixelY + 1.0f)
+			return;
+
+		INT32 minX = Math::floorToInt(Math::clamp(boundsMinX, 0.0f, maxPixelX));
+		INT32 minY = Math::floorToInt(Math::clamp(boundsMinY, 0.0f, maxPixelY));
+		INT32 maxX = Math::ceilToInt(Math::clamp(boundsMaxX, 0.0f, maxPixelX));
+		INT32 maxY = Math::ceilToInt(Math::clamp(boundsMaxY, 0.0f, maxPixelY));
+
+		// Edge functions of the form e(x, y) = A * x + B * y + C, positive for points inside the triangle. Edge N is
+		// opposite of vertex N.
+		const Vector3* verts[3] = { &a, &b, &c };
+
+		float edgeA[3];
+		float edgeB[3];
+		float edgeC[3];
+		for (UINT32 i = 0; i < 3; i++)
+		{
+			const Vector3& start = *verts[(i + 1) % 3];
+			const Vector3& end = *verts[(i + 2) % 3];
+
+			edgeA[i] = start.y - end.y;
+			edgeB[i] = end.x - start.x;
+			edgeC[i] = -(edgeA[i] * start.x + edgeB[i] * start.y);
+		}
+
+		// Depth is linear in screen space, as barycentric weighted sum of vertex depths
+		float invArea = 1.0f / area;
+		float depthA = (edgeA[0] * a.z + edgeA[1] * b.z + edgeA[2] * c.z) * invArea;
+		float depthB = (edgeB[0] * a.z + edgeB[1] * b.z + edgeB[2] * c.z) * invArea;
+		float depthC = (edgeC[0] * a.z + edgeC[1] * b.z + edgeC[2] * c.z) * invArea;
+
+		SIMDFloat4 zero = SIMD::zero();
+		SIMDFloat4 laneOffsets = SIMD::set(0.5f, 1.5f, 2.5f, 3.5f);
+
+		SIMDFloat4 edgeA0 = SIMD::splat(edgeA[0]);
+		SIMDFloat4 edgeA1 = SIMD::splat(edgeA[1]);
+		SIMDFloat4 edgeA2 = SIMD::splat(edgeA[2]);
+		SIMDFloat4 depthStep = SIMD::splat(depthA);
+
+		float* depthBuffer = mLevels[0].depth.data();
+
+		// Process four horizontally adjacent pixels at once, the buffer width is guaranteed to be a multiple of four
+		INT32 startX = minX & ~3;
+		for (INT32 y = minY; y <= maxY; y++)
+		{
+			float pixelY = y + 0.5f;
+
+			SIMDFloat4 rowEdge0 = SIMD::splat(edgeB[0] * pixelY + edgeC[0]);
+			SIMDFloat4 rowEdge1 = SIMD::splat(edgeB[1] * pixelY + edgeC[1]);
+			SIMDFloat4 rowEdge2 = SIMD::splat(edgeB[2] * pixelY + edgeC[2]);
+			SIMDFloat4 rowDepth = SIMD::splat(depthB * pixelY + depthC);
+
+			float* row = depthBuffer + y * mWidth;
+			for (INT32 x = startX; x <= maxX; x += 4)
+			{
+				SIMDFloat4 pixelX = SIMD::add(SIMD::splat((float)x), laneOffsets);
+
+				SIMDFloat4 edge0 = SIMD::madd(rowEdge0, pixelX, edgeA0);
+				SIMDFloat4 edge1 = SIMD::madd(rowEdge1, pixelX, edgeA1);
+				SIMDFloat4 edge2 = SIMD::madd(rowEdge2, pixelX, edgeA2);
+
+				UINT32 outside = SIMD::lessMask(edge0, zero) | SIMD::lessMask(edge1, zero) | SIMD::lessMask(edge2, zero);
+				UINT32 covered = ~outside & 0xF;
+				if (covered == 0)
+					continue;
+
+				SIMDFloat4 depth = SIMD::madd(rowDepth, pixelX, depthStep);
+				if (covered == 0xF)
+					SIMD::store(row + x, SIMD::min(SIMD::load(row + x), depth));
+				else
+				{
+					float depthValues[4];
+					SIMD::store(depthValues, depth);
+
+					for (UINT32 i = 0; i < 4; i++)
+					{
+						if (covered & (1 << i))
+							row[x + i] = std::min(row[x + i], depthValues[i]);
+					}
+				}
+			}
+		}
+	}
+
+	void OcclusionBuffer::buildHiZ()
+	{
+		for (UINT32 i = 1; i < (UINT32)mLevels.size(); i++)
+		{
+			const Level& src = mLevels[i - 1];
+			Level& dst = mLevels[i];
+
+			for (UINT32 y = 0; y < dst.height; y++)
+			{
+				UINT32 srcY0 = y * 2;
+				UINT32 srcY1 = std::min(srcY0 + 1, src.height - 1);
+
+				const float* srcRow0 = &src.depth[srcY0 * src.width];
+				const float* srcRow1 = &src.depth[srcY1 * src.width];
+
+				for (UINT32 x = 0; x < dst.width; x++)
+				{
+					UINT32 srcX0 = x * 2;
+					UINT32 srcX1 = std::min(srcX0 + 1, src.width - 1);
+
+					float farthest = std::max(std::max(srcRow0[srcX0], srcRow0[srcX1]),
+						std::max(srcRow1[srcX0], srcRow1[srcX1]));
+
+					dst.depth[y * dst.width + x] = farthest;
+				}
+			}
+		}
+	}
+
+	bool OcclusionBuffer::isVisible(const AABox& bounds) const
+	{
+		const Vector3& boundsMin = bounds.getMin();
+		const Vector3& boundsMax = bounds.getMax();
+
+		// Project the eight corners, four at a time
+		SIMDFloat4 cornersX = SIMD::set(boundsMin.x, boundsMax.x, boundsMin.x, boundsMax.x);
+		SIMDFloat4 cornersY = SIMD::set(boundsMin.y, boundsMin.y, boundsMax.y, boundsMax.y);
+
+		SIMDFloat4 screenMinX = SIMD::splat(EMPTY_DEPTH);
+		SIMDFloat4 screenMinY = SIMD::splat(EMPTY_DEPTH);
+		SIMDFloat4 screenMaxX = SIMD::splat(-EMPTY_DEPTH);
+		SIMDFloat4 screenMaxY = SIMD::splat(-EMPTY_DEPTH);
+		SIMDFloat4 nearestDepth = SIMD::splat(EMPTY_DEPTH);
+
+		SIMDFloat4 halfWidth = SIMD::splat(mWidth * 0.5f);
+		SIMDFloat4 halfHeight = SIMD::splat(mHeight * 0.5f);
+		SIMDFloat4 nearClipW = SIMD::splat(NEAR_CLIP_W);
+
+		const Matrix4& m = mViewProj;
+		for (UINT32 i = 0; i < 2; i++)
+		{
+			SIMDFloat4 cornersZ = SIMD::splat(i == 0 ? boundsMin.z : boundsMax.z);
+
+			SIMDFloat4 clip[4];
+			for (UINT32 j = 0; j < 4; j++)
+			{
+				clip[j] = SIMD::madd(SIMD::splat(m[j][3]), cornersX, SIMD::splat(m[j][0]));
+				clip[j] = SIMD::madd(clip[j], cornersY, SIMD::splat(m[j][1]));
+				clip[j] = SIMD::madd(clip[j], cornersZ, SIMD::splat(m[j][2]));
+			}
+
+			// Bounds intersect the near plane, consider them visible
+			if (SIMD::lessMask(clip[3], nearClipW) != 0)
+				return true;
+
+			SIMDFloat4 screenX = SIMD::div(clip[0], clip[3]);
+			screenX = SIMD::madd(halfWidth, screenX, halfWidth);
+
+			SIMDFloat4 screenY = SIMD::div(clip[1], clip[3]);
+			screenY = SIMD::sub(halfHeight, SIMD::mul(screenY, halfHeight));
+
+			screenMinX = SIMD::min(screenMinX, screenX);
+			screenMinY = SIMD::min(screenMinY, screenY);
+			screenMaxX = SIMD::max(screenMaxX, screenX);
+			screenMaxY = SIMD::max(screenMaxY, screenY);
+			nearestDepth = SIMD::min(nearestDepth, SIMD::div(clip[2], clip[3]));
+		}
+
+		float minXValues[4], minYValues[4], maxXValues[4], maxYValues[4], depthValues[4];
+		SIMD::store(minXValues, screenMinX);
+		SIMD::store(minYValues, screenMinY);
+		SIMD::store(maxXValues, screenMaxX);
+		SIMD::store(maxYValues, screenMaxY);
+		SIMD::store(depthValues, nearestDepth);
+
+		float minX = std::min(std::min(minXValues[0], minXValues[1]), std::min(minXValues[2], minXValues[3]));
+		float minY = std::min(std::min(minYValues[0], minYValues[1]), std::min(minYValues[2], minYValues[3]));
+		float maxX = std::max(std::max(maxXValues[0], maxXValues[1]), std::max(maxXValues[2], maxXValues[3]));
+		float maxY = std::max(std::max(maxYValues[0], maxYValues[1]), std::max(maxYValues[2], maxYValues[3]));
+		float depth = std::min(std::min(depthValues[0], depthValues[1]), std::min(depthValues[2], depthValues[3]));
+
+		// Not our concern if the bounds are off-screen, leave that to frustum culling
+		if (maxX < 0.0f || maxY < 0.0f || minX >= (float)mWidth || minY >= (float)mHeight)
+			return true;
+
+		INT32 x0 = (INT32)std::max(minX, 0.0f);
+		INT32 y0 = (INT32)std::max(minY, 0.0f);
+		INT32 x1 = (INT32)std::min(maxX, (float)(mWidth - 1));
+		INT32 y1 = (INT32)std::min(maxY, (float)(mHeight - 1));
+
+		// Pick the level at which the bounds cover at most 4x4 texels
+		UINT32 levelIdx = 0;
+		while ((x1 - x0 > 3 || y1 - y0 > 3) && levelIdx + 1 < (UINT32)mLevels.size())
+		{
+			x0 >>= 1;
+			y0 >>= 1;
+			x1 >>= 1;
+			y1 >>= 1;
+			levelIdx++;
+		}
+
+		const Level& level = mLevels[levelIdx];
+		for (INT32 y = y0; y <= y1; y++)
+		{
+			const float* row = &level.depth[y * level.width];
+			for (INT32 x = x0; x <= x1; x++)
+			{
+				if (depth <= row[x])
+					return true;
+			}
+		}
+
+		return false;
+	}
+}
@@ -0,0 +1,109 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "Prerequisites/BsPrerequisitesUtil.h"
+#include "Math/BsMatrix4.h"
+#include "Math/BsAABox.h"
+
+namespace bs
+{
+	/** @addtogroup General
+	 *  @{
+	 */
+
+	/**
+	 * Low resolution depth buffer that occluder geometry is rasterized into on the CPU, and that object bounds can then be
+	 * tested against in order to determine if they are hidden behind the occluders.
+	 *
+	 * Usage: call clear() with the view-projection transform of the view, rasterize() the occluders, call buildHiZ() and
+	 * then test the objects using isVisible().
+	 *
+	 * Depth is stored as post-projection Z (i.e. clip space Z divided by W), and is expected to increase with distance
+	 * from the view. Any projection matrix produced by Matrix4 or the render API satisfies this.
+	 */
+	class BS_UTILITY_EXPORT OcclusionBuffer
+	{
+	public:
+		/**
+		 * @param[in]	width	Width of the buffer in pixels. Rounded up to a multiple of four.
+		 * @param[in]	height	Height of the buffer in pixels.
+		 */
+		OcclusionBuffer(UINT32 width = 256, UINT32 height = 128);
+
+		/**
+		 * Clears the buffer so that nothing is considered occluded, and sets up the transform used by the following
+		 * rasterize() and isVisible() calls.
+		 *
+		 * @param[in]	viewProj	Transform from world space to clip space.
+		 */
+		void clear(const Matrix4& viewProj);
+
+		/**
+		 * Rasterizes a triangle list into the buffer.
+		 *
+		 * @param[in]	vertices	Vertex positions, in local space of the occluder.
+		 * @param[in]	indices		Three indices into @p vertices per triangle.
+		 * @param[in]	numIndices	Number of entries in @p indices.
+		 * @param[in]	world		Transform from local space of the occluder to world space.
+		 *
+		 * @note	Occluders must be opaque and fully contained within the geometry they represent, otherwise objects
+		 *			that are actually visible might get culled.
+		 */
+		void rasterize(const Vector3* vertices, const UINT32* indices, UINT32 numIndices, const Matrix4& world);
+
+		/** Rasterizes a box into the buffer. Box is in local space and is transformed by @p world. */
+		void rasterize(const AABox& box, const Matrix4& world);
+
+		/**
+		 * Builds the hierarchical depth buffer used by isVisible(). Must be called after all the occluders for the frame
+		 * have been rasterized.
+		 */
+		void buildHiZ();
+
+		/**
+		 * Checks if any part of the provided world space bounds could be visible, or if the bounds are fully hidden behind
+		 * the occluders. The test is conservative, it might report hidden objects as visible but never the opposite.
+		 */
+		bool isVisible(const AABox& bounds) const;
+
+		/** Returns the width of the buffer, in pixels. */
+		UINT32 getWidth() const { return mWidth; }
+
+		/** Returns the height of the buffer, in pixels. */
+		UINT32 getHeight() const { return mHeight; }
+
+		/**
+		 * Returns the depth of the nearest occluder at the specified pixel, or the maximum float value if no occluder
+		 * covers the pixel.
+		 */
+		float getDepth(UINT32 x, UINT32 y) const { return mLevels[0].depth[y * mWidth + x]; }
+
+	private:
+		/** Single level of the hierarchical depth buffer. */
+		struct Level
+		{
+			UINT32 width;
+			UINT32 height;
+
+			/** Farthest depth of all the pixels covered by a texel. Level 0 contains per-pixel depth. */
+			Vector<float> depth;
+		};
+
+		/** Clips a triangle in clip space against the near plane and rasterizes the remaining part. */
+		void clipAndRasterize(const Vector4& a, const Vector4& b, const Vector4& c);
+
+		/** Rasterizes a triangle whose vertices are in pixel coordinates, with post-projection depth in the Z component. */
+		void rasterizeTriangle(Vector3 a, Vector3 b, Vector3 c);
+
+		/** Converts a clip space position into pixel coordinates and post-projection depth. */
+		Vector3 toScreen(const Vector4& clipPos) const;
+
+		UINT32 mWidth;
+		UINT32 mHeight;
+		Matrix4 mViewProj;
+		Vector<Level> mLevels;
+	};
+
+	/** @} */
+}
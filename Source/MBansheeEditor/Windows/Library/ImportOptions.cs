@@ -299,6 +299,28 @@ namespace BansheeEditor
             set { Internal_SetRootMotion(mCachedPtr, value); }
         }
 
+        /// <summary>
+        /// Determines if animation compression is enabled. When enabled the bone curves of imported animation clips will
+        /// be resampled at the animation sample rate and quantized, greatly reducing their size and the cost of evaluating
+        /// them, at the cost of some precision.
+        /// </summary>
+        public bool CompressAnimation
+        {
+            get { return Internal_GetCompressAnimation(mCachedPtr); }
+            set { Internal_SetCompressAnimation(mCachedPtr, value); }
+        }
+
+        /// <summary>
+        /// Determines if vertex order optimization is enabled. When enabled triangles of each sub-mesh are reordered to
+        /// make better use of the GPU vertex cache and to reduce overdraw, and vertices are reordered to match the order
+        /// in which triangles reference them.
+        /// </summary>
+        public bool OptimizeVertexOrder
+        {
+            get { return Internal_GetOptimizeVertexOrder(mCachedPtr); }
+            set { Internal_SetOptimizeVertexOrder(mCachedPtr, value); }
+        }
+
         /// <summary>
         /// Controls what type (if any) of collision mesh should be imported.
         /// </summary>
@@ -379,6 +401,18 @@ namespace BansheeEditor
         [MethodImpl(MethodImplOptions.InternalCall)]
         private static extern void Internal_SetRootMotion(IntPtr thisPtr, bool value);
 
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        private static extern bool Internal_GetCompressAnimation(IntPtr thisPtr);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        private static extern void Internal_SetCompressAnimation(IntPtr thisPtr, bool value);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        private static extern bool Internal_GetOptimizeVertexOrder(IntPtr thisPtr);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        private static extern void Internal_SetOptimizeVertexOrder(IntPtr thisPtr, bool value);
+
         [MethodImpl(MethodImplOptions.InternalCall)]
         private static extern AnimationSplitInfo[] Internal_GetAnimationClipSplits(IntPtr thisPtr);
 
@@ -51,6 +51,12 @@ namespace bs { namespace ct
 		 * quality shadows. Valid range is [1, 4].
 		 */
 		UINT32 shadowFilteringQuality = 4;
+
+		/**
+		 * Determines if objects hidden behind occluders are culled on the CPU before rendering. Only renderables marked
+		 * with Renderable::setUseAsOccluder() are used as occluders.
+		 */
+		bool occlusionCulling = true;
 	};
 
 	/** @} */
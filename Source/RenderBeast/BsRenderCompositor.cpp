@@ -258,12 +258,8 @@ namespace bs { namespace ct
 
 		// Prepare all visible objects. Note that this also prepares non-opaque objects.
 		const VisibilityInfo& visibility = inputs.view.getVisibilityMasks();
-		UINT32 numRenderables = (UINT32)inputs.scene.renderables.size();
-		for (UINT32 i = 0; i < numRenderables; i++)
+		for (auto& i : visibility.visibleRenderables)
 		{
-			if (!visibility.renderables[i])
-				continue;
-
 			RendererObject* rendererObject = inputs.scene.renderables[i];
 			rendererObject->updatePerCallBuffer(viewProps.viewProjTransform);
 
@@ -953,12 +949,8 @@ namespace bs { namespace ct
 
 		// Prepare objects for rendering
 		const VisibilityInfo& visibility = inputs.view.getVisibilityMasks();
-		UINT32 numRenderables = (UINT32)sceneInfo.renderables.size();
-		for (UINT32 i = 0; i < numRenderables; i++)
+		for (auto& i : visibility.visibleRenderables)
 		{
-			if (!visibility.renderables[i])
-				continue;
-
 			for (auto& element : sceneInfo.renderables[i]->elements)
 			{
 				bool isTransparent = (element.material->getShader()->getFlags() & (UINT32)ShaderFlags::Transparent) != 0;
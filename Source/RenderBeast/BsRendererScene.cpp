@@ -216,7 +216,8 @@ namespace bs {	namespace ct
 		renderable->setRendererId(renderableId);
 
 		mInfo.renderables.push_back(bs_new<RendererObject>());
-		mInfo.renderableCullInfos.push_back(CullInfo(renderable->getBounds(), renderable->getLayer()));
+		mInfo.renderableCullInfos.add(renderable->getBounds(), renderable->getLayer(), 
+			renderable->getMobility() != ObjectMobility::Movable);
 
 		RendererObject* rendererObject = mInfo.renderables.back();
 		rendererObject->renderable = renderable;
@@ -340,7 +341,7 @@ namespace bs {	namespace ct
 		UINT32 renderableId = renderable->getRendererId();
 
 		mInfo.renderables[renderableId]->updatePerObjectBuffer();
-		mInfo.renderableCullInfos[renderableId].bounds = renderable->getBounds();
+		mInfo.renderableCullInfos.setBounds(renderableId, renderable->getBounds());
 	}
 
 	void RendererScene::unregisterRenderable(Renderable* renderable)
@@ -373,7 +374,7 @@ namespace bs {	namespace ct
 		{
 			// Swap current last element with the one we want to erase
 			std::swap(mInfo.renderables[renderableId], mInfo.renderables[lastRenderableId]);
-			std::swap(mInfo.renderableCullInfos[renderableId], mInfo.renderableCullInfos[lastRenderableId]);
+			mInfo.renderableCullInfos.swap(renderableId, lastRenderableId);
 
 			lastRenerable->setRendererId(renderableId);
 
@@ -383,7 +384,7 @@ namespace bs {	namespace ct
 
 		// Last element is the one we want to erase
 		mInfo.renderables.erase(mInfo.renderables.end() - 1);
-		mInfo.renderableCullInfos.erase(mInfo.renderableCullInfos.end() - 1);
+		mInfo.renderableCullInfos.removeLast();
 
 		bs_delete(rendererObject);
 	}
@@ -507,7 +508,10 @@ namespace bs {	namespace ct
 		mOptions = options;
 
 		for (auto& entry : mInfo.views)
+		{
 			entry->setStateReductionMode(mOptions->stateReductionMode);
+			entry->setOcclusionCulling(mOptions->occlusionCulling);
+		}
 	}
 
 	RENDERER_VIEW_DESC RendererScene::createViewDesc(Camera* camera) const
@@ -565,6 +569,7 @@ namespace bs {	namespace ct
 		viewDesc.projType = camera->getProjectionType();
 
 		viewDesc.stateReduction = mOptions->stateReductionMode;
+		viewDesc.occlusionCulling = mOptions->occlusionCulling;
 		viewDesc.sceneCamera = camera;
 
 		return viewDesc;
@@ -35,7 +35,7 @@ namespace bs
 		
 		// Renderables
 		Vector<RendererObject*> renderables;
-		Vector<CullInfo> renderableCullInfos;
+		CullInfoArray renderableCullInfos;
 
 		// Lights
 		Vector<RendererLight> directionalLights;
@@ -9,6 +9,9 @@
 #include "BsLightRendering.h"
 #include "Material/BsGpuParamsSet.h"
 #include "BsRendererScene.h"
+#include "Math/BsSIMD.h"
+#include "Threading/BsParallel.h"
+#include "Profiling/BsRenderStats.h"
 
 namespace bs { namespace ct
 {
@@ -67,8 +70,229 @@ namespace bs { namespace ct
 		return get(VAR_Texture);
 	}
 
+	/** Number of objects culled by a single worker before it grabs more work. Must be a multiple of four. */
+	static const UINT32 CULL_GRAIN_SIZE = 1024;
+
+	/** Number of objects tested for occlusion by a single worker before it grabs more work. */
+	static const UINT32 OCCLUSION_GRAIN_SIZE = 256;
+
+	/** Maximum number of occluders rasterized per view. If there are more, only the largest on-screen are used. */
+	static const UINT32 MAX_OCCLUDERS = 32;
+
+	/** 
+	 * Minimum size of an occluder in order for it to be rasterized, as a ratio of its bounding radius and distance from
+	 * the view. Small occluders rarely hide anything and aren't worth the rasterization cost.
+	 */
+	static const float MIN_OCCLUDER_SIZE = 0.05f;
+
+	CullInfoArray::CullInfoArray()
+		:mStaticTree(0.0f)
+	{ }
+
+	void CullInfoArray::add(const Bounds& bounds, UINT64 layer, bool isStatic)
+	{
+		mSphereCenterX.push_back(0.0f);
+		mSphereCenterY.push_back(0.0f);
+		mSphereCenterZ.push_back(0.0f);
+		mSphereRadius.push_back(0.0f);
+
+		mBoxCenterX.push_back(0.0f);
+		mBoxCenterY.push_back(0.0f);
+		mBoxCenterZ.push_back(0.0f);
+		mBoxExtentX.push_back(0.0f);
+		mBoxExtentY.push_back(0.0f);
+		mBoxExtentZ.push_back(0.0f);
+
+		mLayers.push_back(layer);
+
+		UINT32 idx = size() - 1;
+		DynamicBVH& tree = isStatic ? mStaticTree : mDynamicTree;
+
+		mTreeIds.push_back(tree.add(bounds.getBox(), idx));
+		mIsStatic.push_back(isStatic);
+
+		setBounds(idx, bounds);
+	}
+
+	void CullInfoArray::setBounds(UINT32 idx, const Bounds& bounds)
+	{
+		const Sphere& sphere = bounds.getSphere();
+		const Vector3& sphereCenter = sphere.getCenter();
+
+		mSphereCenterX[idx] = sphereCenter.x;
+		mSphereCenterY[idx] = sphereCenter.y;
+		mSphereCenterZ[idx] = sphereCenter.z;
+		mSphereRadius[idx] = sphere.getRadius();
+
+		const AABox& box = bounds.getBox();
+		Vector3 boxCenter = box.getCenter();
+		Vector3 boxExtents = box.getHalfSize();
+
+		mBoxCenterX[idx] = boxCenter.x;
+		mBoxCenterY[idx] = boxCenter.y;
+		mBoxCenterZ[idx] = boxCenter.z;
+		mBoxExtentX[idx] = Math::abs(boxExtents.x);
+		mBoxExtentY[idx] = Math::abs(boxExtents.y);
+		mBoxExtentZ[idx] = Math::abs(boxExtents.z);
+
+		getTree(idx).update(mTreeIds[idx], box);
+	}
+
+	void CullInfoArray::swap(UINT32 a, UINT32 b)
+	{
+		std::swap(mSphereCenterX[a], mSphereCenterX[b]);
+		std::swap(mSphereCenterY[a], mSphereCenterY[b]);
+		std::swap(mSphereCenterZ[a], mSphereCenterZ[b]);
+		std::swap(mSphereRadius[a], mSphereRadius[b]);
+
+		std::swap(mBoxCenterX[a], mBoxCenterX[b]);
+		std::swap(mBoxCenterY[a], mBoxCenterY[b]);
+		std::swap(mBoxCenterZ[a], mBoxCenterZ[b]);
+		std::swap(mBoxExtentX[a], mBoxExtentX[b]);
+		std::swap(mBoxExtentY[a], mBoxExtentY[b]);
+		std::swap(mBoxExtentZ[a], mBoxExtentZ[b]);
+
+		std::swap(mLayers[a], mLayers[b]);
+
+		std::swap(mTreeIds[a], mTreeIds[b]);
+
+		bool isStaticA = mIsStatic[a];
+		mIsStatic[a] = mIsStatic[b];
+		mIsStatic[b] = isStaticA;
+
+		getTree(a).setUserData(mTreeIds[a], a);
+		getTree(b).setUserData(mTreeIds[b], b);
+	}
+
+	void CullInfoArray::removeLast()
+	{
+		mSphereCenterX.pop_back();
+		mSphereCenterY.pop_back();
+		mSphereCenterZ.pop_back();
+		mSphereRadius.pop_back();
+
+		mBoxCenterX.pop_back();
+		mBoxCenterY.pop_back();
+		mBoxCenterZ.pop_back();
+		mBoxExtentX.pop_back();
+		mBoxExtentY.pop_back();
+		mBoxExtentZ.pop_back();
+
+		mLayers.pop_back();
+
+		UINT32 idx = size();
+		getTree(idx).remove(mTreeIds[idx]);
+
+		mTreeIds.pop_back();
+		mIsStatic.pop_back();
+	}
+
+	void CullInfoArray::query(const ConvexVolume& volume, Vector<UINT32>& inside, Vector<UINT32>& intersecting) const
+	{
+		mDynamicTree.query(volume, inside, intersecting);
+		mStaticTree.query(volume, inside, intersecting);
+	}
+
+	void CullInfoArray::findIntersecting(const ConvexVolume& volume, Vector<UINT32>& output) const
+	{
+		Vector<UINT32> intersecting;
+		query(volume, output, intersecting);
+
+		// Objects fully inside the volume are already known to intersect it
+		output.reserve(output.size() + intersecting.size());
+		for (auto& entry : intersecting)
+		{
+			if (volume.intersects(getSphere(entry)))
+				output.push_back(entry);
+		}
+	}
+
+	/** 
+	 * Gathers the values of up to four objects whose indices are provided in @p indices. If less than four objects are
+	 * provided the remaining components are set to zero.
+	 */
+	static SIMDFloat4 loadCullGroup(const Vector<float>& values, const UINT32* indices, UINT32 count)
+	{
+		if (count == 4)
+			return SIMD::set(values[indices[0]], values[indices[1]], values[indices[2]], values[indices[3]]);
+
+		float padded[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+		for (UINT32 i = 0; i < count; i++)
+			padded[i] = values[indices[i]];
+
+		return SIMD::load(padded);
+	}
+
+	void CullInfoArray::cull(const Vector<Plane>& planes, UINT64 layers, const UINT32* indices, UINT32 count,
+		Vector<UINT32>& visibleIndices) const
+	{
+		// Four objects are tested against a plane at once, each bit in the mask representing one of the objects
+		for (UINT32 i = 0; i < count; i += 4)
+		{
+			const UINT32* groupIndices = indices + i;
+			UINT32 groupCount = std::min(4U, count - i);
+
+			UINT32 mask = 0;
+			for (UINT32 j = 0; j < groupCount; j++)
+			{
+				if ((mLayers[groupIndices[j]] & layers) != 0)
+					mask |= 1 << j;
+			}
+
+			if (mask == 0)
+				continue;
+
+			SIMDFloat4 sphereX = loadCullGroup(mSphereCenterX, groupIndices, groupCount);
+			SIMDFloat4 sphereY = loadCullGroup(mSphereCenterY, groupIndices, groupCount);
+			SIMDFloat4 sphereZ = loadCullGroup(mSphereCenterZ, groupIndices, groupCount);
+			SIMDFloat4 negRadius = SIMD::negate(loadCullGroup(mSphereRadius, groupIndices, groupCount));
+
+			SIMDFloat4 boxX = loadCullGroup(mBoxCenterX, groupIndices, groupCount);
+			SIMDFloat4 boxY = loadCullGroup(mBoxCenterY, groupIndices, groupCount);
+			SIMDFloat4 boxZ = loadCullGroup(mBoxCenterZ, groupIndices, groupCount);
+			SIMDFloat4 extentX = loadCullGroup(mBoxExtentX, groupIndices, groupCount);
+			SIMDFloat4 extentY = loadCullGroup(mBoxExtentY, groupIndices, groupCount);
+			SIMDFloat4 extentZ = loadCullGroup(mBoxExtentZ, groupIndices, groupCount);
+
+			for (auto& plane : planes)
+			{
+				SIMDFloat4 normalX = SIMD::splat(plane.normal.x);
+				SIMDFloat4 normalY = SIMD::splat(plane.normal.y);
+				SIMDFloat4 normalZ = SIMD::splat(plane.normal.z);
+				SIMDFloat4 negD = SIMD::splat(-plane.d);
+
+				// Sphere test
+				SIMDFloat4 sphereDist = SIMD::madd(negD, sphereX, normalX);
+				sphereDist = SIMD::madd(sphereDist, sphereY, normalY);
+				sphereDist = SIMD::madd(sphereDist, sphereZ, normalZ);
+
+				mask &= ~SIMD::lessMask(sphereDist, negRadius);
+
+				// More precise with the box
+				SIMDFloat4 boxDist = SIMD::madd(negD, boxX, normalX);
+				boxDist = SIMD::madd(boxDist, boxY, normalY);
+				boxDist = SIMD::madd(boxDist, boxZ, normalZ);
+
+				SIMDFloat4 effectiveRadius = SIMD::mul(extentX, SIMD::abs(normalX));
+				effectiveRadius = SIMD::madd(effectiveRadius, extentY, SIMD::abs(normalY));
+				effectiveRadius = SIMD::madd(effectiveRadius, extentZ, SIMD::abs(normalZ));
+
+				mask &= ~SIMD::lessMask(boxDist, SIMD::negate(effectiveRadius));
+
+				if (mask == 0)
+					break;
+			}
+
+			for (UINT32 j = 0; j < groupCount; j++)
+			{
+				if (mask & (1 << j))
+					visibleIndices.push_back(groupIndices[j]);
+			}
+		}
+	}
+
 	RendererViewData::RendererViewData()
-		:encodeDepth(false), depthEncodeNear(0.0f), depthEncodeFar(0.0f)
+		:encodeDepth(false), occlusionCulling(false), depthEncodeNear(0.0f), depthEncodeFar(0.0f)
 	{
 		
 	}
@@ -175,25 +399,27 @@ namespace bs { namespace ct
 		mTransparentQueue->clear();
 	}
 
-	void RendererView::determineVisible(const Vector<RendererObject*>& renderables, const Vector<CullInfo>& cullInfos,
+	void RendererView::determineVisible(const Vector<RendererObject*>& renderables, const CullInfoArray& cullInfos,
 		Vector<bool>* visibility)
 	{
 		mVisibility.renderables.clear();
 		mVisibility.renderables.resize(renderables.size(), false);
+		mVisibility.visibleRenderables.clear();
 
 		if (mRenderSettings->overlayOnly)
 			return;
 
-		calculateVisibility(cullInfos, mVisibility.renderables);
+		calculateVisibility(cullInfos, mVisibility.visibleRenderables);
+
+		if (mProperties.occlusionCulling)
+			cullOccluded(renderables, cullInfos, mVisibility.visibleRenderables);
 
 		// Update per-object param buffers and queue render elements
-		for(UINT32 i = 0; i < (UINT32)cullInfos.size(); i++)
+		for(auto& i : mVisibility.visibleRenderables)
 		{
-			if (!mVisibility.renderables[i])
-				continue;
+			mVisibility.renderables[i] = true;
 
-			const AABox& boundingBox = cullInfos[i].bounds.getBox();
-			float distanceToCamera = (mProperties.viewOrigin - boundingBox.getCenter()).length();
+			float distanceToCamera = (mProperties.viewOrigin - cullInfos.getBoxCenter(i)).length();
 
 			for (auto& renderElem : renderables[i]->elements)
 			{
@@ -210,12 +436,8 @@ namespace bs { namespace ct
 
 		if(visibility != nullptr)
 		{
-			for (UINT32 i = 0; i < (UINT32)renderables.size(); i++)
-			{
-				bool visible = (*visibility)[i];
-
-				(*visibility)[i] = visible || mVisibility.renderables[i];
-			}
+			for (auto& i : mVisibility.visibleRenderables)
+				(*visibility)[i] = true;
 		}
 
 		mOpaqueQueue->sort();
@@ -266,29 +488,113 @@ namespace bs { namespace ct
 		}
 	}
 
-	void RendererView::calculateVisibility(const Vector<CullInfo>& cullInfos, Vector<bool>& visibility) const
+	void RendererView::calculateVisibility(const CullInfoArray& cullInfos, Vector<UINT32>& visibleIndices) const
 	{
+		visibleIndices.clear();
+
+		if (cullInfos.size() == 0)
+			return;
+
 		UINT64 cameraLayers = mProperties.visibleLayers;
-		const ConvexVolume& worldFrustum = mProperties.cullFrustum;
 
-		for (UINT32 i = 0; i < (UINT32)cullInfos.size(); i++)
+		// Hierarchical culling first, objects fully inside the frustum only need to pass the layer test
+		Vector<UINT32> intersecting;
+		cullInfos.query(mProperties.cullFrustum, visibleIndices, intersecting);
+
+		auto iterFind = std::remove_if(visibleIndices.begin(), visibleIndices.end(),
+			[&](UINT32 idx) { return (cullInfos.getLayer(idx) & cameraLayers) == 0; });
+		visibleIndices.erase(iterFind, visibleIndices.end());
+
+		// Precisely cull the objects on the frustum boundary
+		Vector<Plane> planes = mProperties.cullFrustum.getPlanes();
+
+		UINT32 numIntersecting = (UINT32)intersecting.size();
+		UINT32 numChunks = getNumParallelChunks(0, numIntersecting, CULL_GRAIN_SIZE);
+		if (numChunks == 1)
+			cullInfos.cull(planes, cameraLayers, intersecting.data(), numIntersecting, visibleIndices);
+		else if (numChunks > 1)
 		{
-			if ((cullInfos[i].layer & cameraLayers) == 0)
+			// Each chunk outputs its own list, which are then concatenated
+			Vector<Vector<UINT32>> chunkIndices(numChunks);
+			parallelForRange(0, numIntersecting, CULL_GRAIN_SIZE,
+				[&](UINT32 begin, UINT32 end)
+			{
+				cullInfos.cull(planes, cameraLayers, &intersecting[begin], end - begin, 
+					chunkIndices[begin / CULL_GRAIN_SIZE]);
+			});
+
+			for (auto& entry : chunkIndices)
+				visibleIndices.insert(visibleIndices.end(), entry.begin(), entry.end());
+		}
+	}
+
+	void RendererView::cullOccluded(const Vector<RendererObject*>& renderables, const CullInfoArray& cullInfos,
+		Vector<UINT32>& visibleIndices)
+	{
+		// Pick the occluders, preferring the ones that cover the most of the view
+		Vector<std::pair<float, UINT32>> occluders;
+		for (auto& i : visibleIndices)
+		{
+			Renderable* renderable = renderables[i]->renderable;
+			if (!renderable->getUseAsOccluder())
 				continue;
 
-			// Do frustum culling
-			// Note: This is bound to be a bottleneck at some point. When it is ensure that intersect methods use vector
-			// operations, as it is trivial to update them. Also consider spatial partitioning.
-			const Sphere& boundingSphere = cullInfos[i].bounds.getSphere();
-			if (worldFrustum.intersects(boundingSphere))
-			{
-				// More precise with the box
-				const AABox& boundingBox = cullInfos[i].bounds.getBox();
+			AABox occluderBounds = renderable->getOccluderBounds();
+			occluderBounds.transformAffine(renderable->getMatrix());
 
-				if (worldFrustum.intersects(boundingBox))
-					visibility[i] = true;
-			}
+			float distance = (occluderBounds.getCenter() - mProperties.viewOrigin).length();
+			float size = occluderBounds.getRadius() / std::max(distance, 0.001f);
+			if (size < MIN_OCCLUDER_SIZE)
+				continue;
+
+			occluders.push_back(std::make_pair(size, i));
 		}
+
+		if (occluders.empty())
+			return;
+
+		if (occluders.size() > MAX_OCCLUDERS)
+		{
+			std::nth_element(occluders.begin(), occluders.begin() + MAX_OCCLUDERS, occluders.end(),
+				[](const std::pair<float, UINT32>& a, const std::pair<float, UINT32>& b) { return a.first > b.first; });
+
+			occluders.resize(MAX_OCCLUDERS);
+		}
+
+		if (mOcclusionBuffer == nullptr)
+			mOcclusionBuffer = bs_shared_ptr_new<OcclusionBuffer>();
+
+		mOcclusionBuffer->clear(mProperties.viewProjTransform);
+		for (auto& entry : occluders)
+		{
+			Renderable* renderable = renderables[entry.second]->renderable;
+			mOcclusionBuffer->rasterize(renderable->getOccluderBounds(), renderable->getMatrix());
+		}
+
+		mOcclusionBuffer->buildHiZ();
+
+		// Test the objects against the occluders
+		UINT32 numTested = (UINT32)visibleIndices.size();
+		Vector<UINT8> visible(numTested);
+
+		const OcclusionBuffer& occlusionBuffer = *mOcclusionBuffer;
+		parallelFor(0, numTested, OCCLUSION_GRAIN_SIZE,
+			[&](UINT32 i)
+		{
+			visible[i] = occlusionBuffer.isVisible(cullInfos.getBox(visibleIndices[i])) ? 1 : 0;
+		});
+
+		UINT32 numVisible = 0;
+		for (UINT32 i = 0; i < numTested; i++)
+		{
+			if (visible[i])
+				visibleIndices[numVisible++] = visibleIndices[i];
+		}
+
+		visibleIndices.resize(numVisible);
+
+		BS_ADD_RENDER_STAT(NumOcclusionCulled, numTested - numVisible);
+		BS_ADD_RENDER_STAT(NumOcclusionVisible, numVisible);
 	}
 
 	void RendererView::calculateVisibility(const Vector<Sphere>& bounds, Vector<bool>& visibility) const
@@ -570,6 +876,13 @@ namespace bs { namespace ct
 		for(UINT32 i = 0; i < numViews; i++)
 			mViews[i]->determineVisible(sceneInfo.renderables, sceneInfo.renderableCullInfos, &mVisibility.renderables);
 
+		mVisibility.visibleRenderables.clear();
+		for (UINT32 i = 0; i < (UINT32)mVisibility.renderables.size(); i++)
+		{
+			if (mVisibility.renderables[i])
+				mVisibility.visibleRenderables.push_back(i);
+		}
+
 		// Calculate light visibility for all views
 		UINT32 numRadialLights = (UINT32)sceneInfo.radialLights.size();
 		mVisibility.radialLights.resize(numRadialLights, false);
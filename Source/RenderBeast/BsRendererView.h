@@ -9,6 +9,8 @@
 #include "BsRendererObject.h"
 #include "Math/BsBounds.h"
 #include "Math/BsConvexVolume.h"
+#include "Utility/BsDynamicBVH.h"
+#include "Utility/BsOcclusionBuffer.h"
 #include "Renderer/BsLight.h"
 #include "BsLightGrid.h"
 #include "BsShadowRendering.h"
@@ -114,6 +116,12 @@ namespace bs { namespace ct
 		 */
 		bool encodeDepth : 1;
 
+		/** 
+		 * When enabled, objects hidden behind occluders (see Renderable::setUseAsOccluder()) are culled on the CPU before
+		 * being added to the render queues. 
+		 */
+		bool occlusionCulling : 1;
+
 		/**
 		 * Controls at which position to start encoding depth, in view space. Only relevant with @p encodeDepth is enabled.
 		 * Depth will be linearly interpolated between this value and @p depthEncodeFar.
@@ -185,20 +193,116 @@ namespace bs { namespace ct
 	struct VisibilityInfo
 	{
 		Vector<bool> renderables;
+		Vector<UINT32> visibleRenderables; /**< Indices of all renderables set to true in @p renderables. */
 		Vector<bool> radialLights;
 		Vector<bool> spotLights;
 		Vector<bool> reflProbes;
 	};
 
-	/** Information used for culling an object against a view. */
-	struct CullInfo
+	/**
+	 * Information used for culling a set of objects against a view (world bounds and layer of each object). Stored in
+	 * structure-of-arrays form so that multiple objects can be culled using a single SIMD operation. Objects are 
+	 * identified by their index in the array.
+	 *
+	 * Object bounds are also kept in bounding volume hierarchies, allowing large parts of the scene to be rejected or
+	 * accepted without testing the individual objects. Static objects are kept in a separate hierarchy with tight bounds,
+	 * so the moving objects don't degrade its quality.
+	 */
+	class CullInfoArray
 	{
-		CullInfo(const Bounds& bounds, UINT64 layer = -1)
-			:bounds(bounds), layer(layer)
-		{ }
+	public:
+		CullInfoArray();
+
+		/** 
+		 * Adds a new object to the end of the array. Objects marked as @p isStatic are expected to rarely (if ever) 
+		 * change their bounds.
+		 */
+		void add(const Bounds& bounds, UINT64 layer, bool isStatic);
+
+		/** Updates the bounds of the object at the specified index. */
+		void setBounds(UINT32 idx, const Bounds& bounds);
 
-		Bounds bounds;
-		UINT64 layer;
+		/** Swaps the objects at the two specified indices. */
+		void swap(UINT32 a, UINT32 b);
+
+		/** Removes the last object in the array. */
+		void removeLast();
+
+		/** Returns the number of objects in the array. */
+		UINT32 size() const { return (UINT32)mLayers.size(); }
+
+		/** Returns the bounding sphere of the object at the specified index. */
+		Sphere getSphere(UINT32 idx) const
+		{
+			return Sphere(Vector3(mSphereCenterX[idx], mSphereCenterY[idx], mSphereCenterZ[idx]), mSphereRadius[idx]);
+		}
+
+		/** Returns the center of the bounding box of the object at the specified index. */
+		Vector3 getBoxCenter(UINT32 idx) const { return Vector3(mBoxCenterX[idx], mBoxCenterY[idx], mBoxCenterZ[idx]); }
+
+		/** Returns the bounding box of the object at the specified index. */
+		AABox getBox(UINT32 idx) const
+		{
+			Vector3 center = getBoxCenter(idx);
+			Vector3 extents(mBoxExtentX[idx], mBoxExtentY[idx], mBoxExtentZ[idx]);
+
+			return AABox(center - extents, center + extents);
+		}
+
+		/** Returns the layer of the object at the specified index. */
+		UINT64 getLayer(UINT32 idx) const { return mLayers[idx]; }
+
+		/**
+		 * Uses the bounding volume hierarchies to find objects that might intersect the provided volume. Indices of 
+		 * objects whose bounds are fully inside the volume are appended to @p inside, while indices of objects that 
+		 * require a more precise test (see cull()) are appended to @p intersecting. Objects not output in either list are
+		 * guaranteed to be outside of the volume.
+		 */
+		void query(const ConvexVolume& volume, Vector<UINT32>& inside, Vector<UINT32>& intersecting) const;
+
+		/** 
+		 * Finds all objects whose bounding sphere intersects the provided volume, and appends their indices to
+		 * @p output. 
+		 */
+		void findIntersecting(const ConvexVolume& volume, Vector<UINT32>& output) const;
+
+		/**
+		 * Culls a set of objects against the provided set of planes and appends the indices of the objects that aren't 
+		 * culled to @p visibleIndices. An object is considered visible if it belongs to at least one of the provided 
+		 * @p layers, and both its bounding sphere and box intersect the volume formed by @p planes.
+		 *
+		 * @param[in]	planes			Planes forming the volume to cull against.
+		 * @param[in]	layers			Layer bitmask of the visible objects.
+		 * @param[in]	indices			Indices of the objects to cull.
+		 * @param[in]	count			Number of entries in @p indices.
+		 * @param[out]	visibleIndices	Vector to append the indices of the visible objects to. Visible objects are 
+		 *								output in the same order as they are provided in @p indices.
+		 */
+		void cull(const Vector<Plane>& planes, UINT64 layers, const UINT32* indices, UINT32 count,
+			Vector<UINT32>& visibleIndices) const;
+
+	private:
+		/** Returns the hierarchy the object at the specified index is stored in. */
+		DynamicBVH& getTree(UINT32 idx) { return mIsStatic[idx] ? mStaticTree : mDynamicTree; }
+
+		Vector<float> mSphereCenterX;
+		Vector<float> mSphereCenterY;
+		Vector<float> mSphereCenterZ;
+		Vector<float> mSphereRadius;
+
+		Vector<float> mBoxCenterX;
+		Vector<float> mBoxCenterY;
+		Vector<float> mBoxCenterZ;
+		Vector<float> mBoxExtentX;
+		Vector<float> mBoxExtentY;
+		Vector<float> mBoxExtentZ;
+
+		Vector<UINT64> mLayers;
+
+		Vector<UINT32> mTreeIds;
+		Vector<bool> mIsStatic;
+		DynamicBVH mDynamicTree;
+		DynamicBVH mStaticTree;
 	};
 
 	/**	Renderer information specific to a single render target. */
@@ -218,6 +322,9 @@ namespace bs { namespace ct
 		/** Sets state reduction mode that determines how do render queues group & sort renderables. */
 		void setStateReductionMode(StateReduction reductionMode);
 
+		/** Enables or disables CPU occlusion culling. See RendererViewData::occlusionCulling. */
+		void setOcclusionCulling(bool enable) { mProperties.occlusionCulling = enable; }
+
 		/** Updates the internal camera render settings. */
 		void setRenderSettings(const SPtr<RenderSettings>& settings);
 
@@ -269,7 +376,7 @@ namespace bs { namespace ct
 		 *									As a side-effect, per-view visibility data is also calculated and can be
 		 *									retrieved by calling getVisibilityMask().
 		 */
-		void determineVisible(const Vector<RendererObject*>& renderables, const Vector<CullInfo>& cullInfos,
+		void determineVisible(const Vector<RendererObject*>& renderables, const CullInfoArray& cullInfos,
 			Vector<bool>* visibility = nullptr);
 
 		/**
@@ -291,10 +398,11 @@ namespace bs { namespace ct
 			Vector<bool>* visibility = nullptr);
 
 		/**
-		 * Culls the provided set of bounds against the current frustum and outputs a set of visibility flags determining
-		 * which entry is or isn't visible by this view. Both inputs must be arrays of the same size.
+		 * Culls the provided set of bounds against the current frustum and outputs a list of indices of all the entries
+		 * visible by this view. Indices are output in traversal order of the culling hierarchy, not sorted. Culling is
+		 * distributed between the TaskScheduler workers for large sets of bounds.
 		 */
-		void calculateVisibility(const Vector<CullInfo>& cullInfos, Vector<bool>& visibility) const;
+		void calculateVisibility(const CullInfoArray& cullInfos, Vector<UINT32>& visibleIndices) const;
 
 		/**
 		 * Culls the provided set of bounds against the current frustum and outputs a set of visibility flags determining
@@ -375,6 +483,13 @@ namespace bs { namespace ct
 		 */
 		static Vector2 getNDCZToDeviceZ();
 	private:
+		/**
+		 * Rasterizes the largest visible occluders into the occlusion buffer, and removes any objects hidden behind them
+		 * from @p visibleIndices.
+		 */
+		void cullOccluded(const Vector<RendererObject*>& renderables, const CullInfoArray& cullInfos, 
+			Vector<UINT32>& visibleIndices);
+
 		RendererViewProperties mProperties;
 		RENDERER_VIEW_TARGET_DESC mTargetDesc;
 		Camera* mCamera;
@@ -390,6 +505,8 @@ namespace bs { namespace ct
 		VisibilityInfo mVisibility;
 		LightGrid mLightGrid;
 		UINT32 mViewIdx;
+
+		SPtr<OcclusionBuffer> mOcclusionBuffer;
 	};
 
 	/** Contains one or multiple RendererView%s that are in some way related. */
@@ -1123,11 +1123,11 @@ namespace bs { namespace ct
 			ShadowDepthDirectionalMat* depthDirMat = ShadowDepthDirectionalMat::get();
 			depthDirMat->bind(shadowParamsBuffer);
 
-			for (UINT32 j = 0; j < sceneInfo.renderables.size(); j++)
-			{
-				if (!cascadeCullVolume.intersects(sceneInfo.renderableCullInfos[j].bounds.getSphere()))
-					continue;
+			mShadowCasters.clear();
+			sceneInfo.renderableCullInfos.findIntersecting(cascadeCullVolume, mShadowCasters);
 
+			for (auto& j : mShadowCasters)
+			{
 				scene.prepareRenderable(j, frameInfo);
 
 				RendererObject* renderable = sceneInfo.renderables[j];
@@ -1233,11 +1233,12 @@ namespace bs { namespace ct
 		}
 
 		ConvexVolume worldFrustum(worldPlanes);
-		for (UINT32 i = 0; i < sceneInfo.renderables.size(); i++)
-		{
-			if (!worldFrustum.intersects(sceneInfo.renderableCullInfos[i].bounds.getSphere()))
-				continue;
 
+		mShadowCasters.clear();
+		sceneInfo.renderableCullInfos.findIntersecting(worldFrustum, mShadowCasters);
+
+		for (auto& i : mShadowCasters)
+		{
 			scene.prepareRenderable(i, frameInfo);
 
 			RendererObject* renderable = sceneInfo.renderables[i];
@@ -1407,12 +1408,13 @@ namespace bs { namespace ct
 
 		// First cull against a global volume
 		ConvexVolume boundingVolume(boundingPlanes);
-		for (UINT32 i = 0; i < sceneInfo.renderables.size(); i++)
-		{
-			const Sphere& bounds = sceneInfo.renderableCullInfos[i].bounds.getSphere();
-			if (!boundingVolume.intersects(bounds))
-				continue;
 
+		mShadowCasters.clear();
+		sceneInfo.renderableCullInfos.findIntersecting(boundingVolume, mShadowCasters);
+
+		for (auto& i : mShadowCasters)
+		{
+			Sphere bounds = sceneInfo.renderableCullInfos.getSphere(i);
 			scene.prepareRenderable(i, frameInfo);
 
 			for(UINT32 j = 0; j < 6; j++)
@@ -215,6 +215,10 @@ namespace bs
 		metaData.scriptClass->addInternalCall("Internal_SetKeyFrameReduction", (void*)&ScriptMeshImportOptions::internal_SetKeyFrameReduction);
 		metaData.scriptClass->addInternalCall("Internal_GetRootMotion", (void*)&ScriptMeshImportOptions::internal_GetRootMotion);
 		metaData.scriptClass->addInternalCall("Internal_SetRootMotion", (void*)&ScriptMeshImportOptions::internal_SetRootMotion);
+		metaData.scriptClass->addInternalCall("Internal_GetCompressAnimation", (void*)&ScriptMeshImportOptions::internal_GetCompressAnimation);
+		metaData.scriptClass->addInternalCall("Internal_SetCompressAnimation", (void*)&ScriptMeshImportOptions::internal_SetCompressAnimation);
+		metaData.scriptClass->addInternalCall("Internal_GetOptimizeVertexOrder", (void*)&ScriptMeshImportOptions::internal_GetOptimizeVertexOrder);
+		metaData.scriptClass->addInternalCall("Internal_SetOptimizeVertexOrder", (void*)&ScriptMeshImportOptions::internal_SetOptimizeVertexOrder);
 		metaData.scriptClass->addInternalCall("Internal_GetScale", (void*)&ScriptMeshImportOptions::internal_GetScale);
 		metaData.scriptClass->addInternalCall("Internal_SetScale", (void*)&ScriptMeshImportOptions::internal_SetScale);
 		metaData.scriptClass->addInternalCall("Internal_GetCollisionMeshType", (void*)&ScriptMeshImportOptions::internal_GetCollisionMeshType);
@@ -329,6 +333,26 @@ namespace bs
 		thisPtr->getMeshImportOptions()->setImportRootMotion(value);
 	}
 
+	bool ScriptMeshImportOptions::internal_GetCompressAnimation(ScriptMeshImportOptions* thisPtr)
+	{
+		return thisPtr->getMeshImportOptions()->getCompressAnimation();
+	}
+
+	void ScriptMeshImportOptions::internal_SetCompressAnimation(ScriptMeshImportOptions* thisPtr, bool value)
+	{
+		thisPtr->getMeshImportOptions()->setCompressAnimation(value);
+	}
+
+	bool ScriptMeshImportOptions::internal_GetOptimizeVertexOrder(ScriptMeshImportOptions* thisPtr)
+	{
+		return thisPtr->getMeshImportOptions()->getOptimizeVertexOrder();
+	}
+
+	void ScriptMeshImportOptions::internal_SetOptimizeVertexOrder(ScriptMeshImportOptions* thisPtr, bool value)
+	{
+		thisPtr->getMeshImportOptions()->setOptimizeVertexOrder(value);
+	}
+
 	float ScriptMeshImportOptions::internal_GetScale(ScriptMeshImportOptions* thisPtr)
 	{
 		return thisPtr->getMeshImportOptions()->getImportScale();
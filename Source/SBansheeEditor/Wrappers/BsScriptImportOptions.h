@@ -130,6 +130,10 @@ namespace bs
 		static void internal_SetKeyFrameReduction(ScriptMeshImportOptions* thisPtr, bool value);
 		static bool internal_GetRootMotion(ScriptMeshImportOptions* thisPtr);
 		static void internal_SetRootMotion(ScriptMeshImportOptions* thisPtr, bool value);
+		static bool internal_GetCompressAnimation(ScriptMeshImportOptions* thisPtr);
+		static void internal_SetCompressAnimation(ScriptMeshImportOptions* thisPtr, bool value);
+		static bool internal_GetOptimizeVertexOrder(ScriptMeshImportOptions* thisPtr);
+		static void internal_SetOptimizeVertexOrder(ScriptMeshImportOptions* thisPtr, bool value);
 		static float internal_GetScale(ScriptMeshImportOptions* thisPtr);
 		static void internal_SetScale(ScriptMeshImportOptions* thisPtr, float value);
 		static int internal_GetCollisionMeshType(ScriptMeshImportOptions* thisPtr);